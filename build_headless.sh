@@ -0,0 +1,31 @@
+#!/bin/sh
+# Builds the SDL-free headless simulation tool, batch runner and render benchmark into build/
+DIR_ABS_ROOT="$(cd "$(dirname "$0")" && pwd)"
+SOURCES_SIM="
+   $DIR_ABS_ROOT/source/helpers.c
+   $DIR_ABS_ROOT/source/rng.c
+   $DIR_ABS_ROOT/source/sim.c
+   $DIR_ABS_ROOT/source/replay.c
+   $DIR_ABS_ROOT/source/pool.c
+   $DIR_ABS_ROOT/source/ai.c
+   $DIR_ABS_ROOT/source/player.c
+   $DIR_ABS_ROOT/source/cli.c
+"
+
+mkdir -p "$DIR_ABS_ROOT/build"
+gcc -O2 -std=gnu11 -pthread \
+   -I"$DIR_ABS_ROOT/include" \
+   $SOURCES_SIM \
+   "$DIR_ABS_ROOT/source/headless.c" \
+   -o "$DIR_ABS_ROOT/build/tetris_headless" || exit 1
+gcc -O2 -std=gnu11 -pthread \
+   -I"$DIR_ABS_ROOT/include" \
+   $SOURCES_SIM \
+   "$DIR_ABS_ROOT/source/batch.c" \
+   -o "$DIR_ABS_ROOT/build/tetris_batch" || exit 1
+gcc -O2 -std=gnu11 -pthread \
+   -I"$DIR_ABS_ROOT/include" \
+   $SOURCES_SIM \
+   "$DIR_ABS_ROOT/source/render.c" \
+   "$DIR_ABS_ROOT/source/render_bench.c" \
+   -o "$DIR_ABS_ROOT/build/tetris_render_bench"
@@ -0,0 +1,118 @@
+#ifndef TETRIS_AI_H
+#define TETRIS_AI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+#include "pool.h"
+
+// AI - Placements
+//
+// A placement is the resting spot of the active tetro reached by rotating at
+// its current position, shifting sideways and dropping straight down, using
+// the same collision rules as the simulation.
+#define AI_PLACEMENTS_MAX (TETRO_ROTATION_COUNT * PLAY_FIELD_WIDTH * 2)
+#define AI_MOVES_MAX (TETRO_ROTATION_COUNT + PLAY_FIELD_WIDTH + 1)
+
+enum ai_move_e {
+   AI_MOVE_ROTATE_CW,
+   AI_MOVE_ROTATE_CCW,
+   AI_MOVE_LEFT,
+   AI_MOVE_RIGHT,
+   AI_MOVE_DROP
+};
+
+struct ai_placement_s {
+   // Quarter turns, positive clockwise
+   int rotation_steps;
+   int shift;
+   // Resting tetro
+   int rotation;
+   int x;
+   int y;
+};
+
+// AI - Heuristics
+struct ai_features_s {
+   int aggregate_height;
+   int max_height;
+   int holes;
+   int bumpiness;
+   int lines_cleared;
+};
+
+// Higher is better
+typedef float (*ai_heuristic_fn)(const struct ai_features_s * features, const void * context);
+
+struct ai_weights_s {
+   float aggregate_height;
+   float max_height;
+   float holes;
+   float bumpiness;
+   float lines_cleared;
+};
+
+struct ai_weights_s ai_weights_make_default(void);
+float ai_heuristic_weighted(const struct ai_features_s * features, const void * context);
+
+// AI - Decisions
+struct ai_s {
+   ai_heuristic_fn heuristic;
+   const void * heuristic_context;
+   // Statistics
+   uint64_t placements_evaluated;
+   uint64_t decisions;
+};
+
+struct ai_decision_s {
+   struct ai_placement_s placement;
+   float score;
+   // Plies fully searched, zero when the budget ran out within ply one
+   int depth;
+   enum ai_move_e moves[AI_MOVES_MAX];
+   int move_count;
+};
+
+bool ai_init(struct ai_s * ai, ai_heuristic_fn heuristic, const void * heuristic_context);
+int ai_enumerate_placements(const struct play_field_s * play_field, const struct tetro_world_s * tetro, struct ai_placement_s * out_placements);
+bool ai_evaluate_placement(const struct play_field_s * play_field, const struct tetro_world_s * tetro, const struct ai_placement_s * placement, struct play_field_s * out_play_field, struct ai_features_s * out_features);
+bool ai_decide(struct ai_s * ai, const struct play_field_s * play_field, const struct tetro_world_s * tetro, struct ai_decision_s * out_decision);
+
+// AI - Lookahead search
+//
+// Ply one places the active tetro, ply two the preview tetro, and every
+// deeper ply averages over all tetro types as if dealt uniformly at random.
+// Each ply only expands the best beam width placements by heuristic, the
+// root candidates are searched in parallel. Depths are searched one after
+// the other and the deepest one completed within the time budget decides.
+// The budget is checked after every scored placement at every ply, so a
+// decision overruns it by at most one placement. A root cut short picks the
+// best placement scored so far.
+#define AI_SEARCH_DEPTH_MAX 6
+#define AI_SEARCH_BEAM_MAX 32
+
+struct ai_search_config_s {
+   int depth;
+   int beam_width;
+   // Zero or less searches to full depth regardless of time
+   double time_budget_ms;
+};
+
+struct ai_search_config_s ai_search_config_make_default(void);
+bool ai_decide_lookahead(struct ai_s * ai, struct pool_s * pool, const struct ai_search_config_s * config, const struct play_field_s * play_field, const struct tetro_world_s * tetro, const struct tetro_world_s * tetro_next, struct ai_decision_s * out_decision);
+
+// AI - Input
+//
+// Turns a decision into per-tick custom key input for the active tetro,
+// re-checking the tetro every tick so gravity during the moves is harmless.
+struct ai_controller_s {
+   struct ai_decision_s decision;
+   bool active;
+   sim_input_t input_last;
+};
+
+bool ai_controller_init(struct ai_controller_s * controller);
+bool ai_controller_follow(struct ai_controller_s * controller, const struct ai_decision_s * decision);
+sim_input_t ai_controller_input(struct ai_controller_s * controller, const struct tetro_world_s * tetro);
+
+#endif
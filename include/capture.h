@@ -0,0 +1,41 @@
+#ifndef TETRIS_CAPTURE_H
+#define TETRIS_CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "render.h"
+
+// Capture - Framebuffer hashes for golden image tests
+//
+// Every captured frame is hashed on the calling thread. The hash, and the
+// texels when frames are streamed, go into a bounded ring that a background
+// thread drains to disk. Hashes are logged one line per frame, frames are
+// written as raw RGBA bytes or as 4:4:4 Y4M. Composition only waits on the
+// disk when the ring is full, which is counted as a stall.
+#define CAPTURE_RING_CAPACITY (16)
+
+enum capture_format_e {
+   CAPTURE_FORMAT_NONE,
+   CAPTURE_FORMAT_RAW_RGBA,
+   CAPTURE_FORMAT_Y4M
+};
+
+struct capture_s;
+
+// Y4M for paths ending in .y4m, raw RGBA otherwise
+enum capture_format_e capture_format_from_path(const char * path);
+const char * capture_format_name(enum capture_format_e format);
+
+// Either path may be NULL, frames are expected in the default RGBA packing
+struct capture_s * capture_create(const char * path_hashes, const char * path_frames, int width, int height, int frames_per_second);
+// Drains the ring before closing the files
+void * capture_destroy(struct capture_s * instance);
+bool capture_frame(struct capture_s * instance, const struct texture_rgba_s * frame, uint32_t tick);
+
+// FNV-1a over every texel, chained across frames by the combined hash
+uint64_t capture_texture_hash(uint64_t hash, const struct texture_rgba_s * texture);
+uint64_t capture_hash_combined(const struct capture_s * instance);
+unsigned long capture_frame_count(const struct capture_s * instance);
+unsigned long capture_stall_count(const struct capture_s * instance);
+
+#endif
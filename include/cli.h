@@ -0,0 +1,18 @@
+#ifndef TETRIS_CLI_H
+#define TETRIS_CLI_H
+
+#include <stdbool.h>
+
+// Command line - Arguments and time shared by the game and the SDL-free tools
+
+// Helpers - Arguments
+const char * help_args_key_value_first(int argc, char * argv[], const char * key);
+// Index of the key, -1 when missing
+int help_args_key_index(int argc, char * argv[], const char * key);
+bool help_args_key_present(int argc, char * argv[], const char * key);
+unsigned long help_args_unsigned_or(int argc, char * argv[], const char * key, unsigned long fallback);
+
+// Helpers - Time
+double help_time_in_seconds(void);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef TETRIS_HELPERS_H
+#define TETRIS_HELPERS_H
+
+#include <stdbool.h>
+
+// Helpers - Vectors
+struct vec_2i_s {
+   int x;
+   int y;
+};
+
+struct vec_2i_s vec_2i_make_xy(int x, int y);
+bool vec_2i_equals_xy(struct vec_2i_s v, int x, int y);
+struct vec_2i_s vec_2i_make_from_scaled(struct vec_2i_s v, int scale);
+
+// Helpers - Min Max
+int help_minmax_min_2i(int a, int b);
+int help_minmax_max_2i(int a, int b);
+
+// Helpers - Limits
+float help_limit_clamp_f(float floor, float value, float ceiling);
+int help_limit_clamp_i(int floor, int value, int ceiling);
+
+// Helpers - Regions
+struct region_2d_s {
+   struct vec_2i_s min;
+   struct vec_2i_s max;
+   struct vec_2i_s size;
+};
+
+struct region_2d_s region_2d_s_make(int min_x, int min_y, int width, int height);
+
+// Helpers - Bounds
+bool help_bounds_out_of_region(int min_x, int min_y, int width, int height, int x, int y);
+
+// Helpers - Time
+// Seconds from an arbitrary start, never stepped by wall clock changes
+double help_time_monotonic_in_seconds(void);
+
+#endif
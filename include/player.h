@@ -0,0 +1,36 @@
+#ifndef TETRIS_PLAYER_H
+#define TETRIS_PLAYER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+#include "ai.h"
+
+// Player - Drives a simulation without a keyboard
+enum player_kind_e {
+   // Mashes random gameplay keys
+   PLAYER_KIND_SCRIPTED,
+   // Places every tetro where the heuristic search says
+   PLAYER_KIND_BOT,
+   // Bot that also searches the preview tetro and beyond
+   PLAYER_KIND_LOOKAHEAD,
+   PLAYER_KIND_COUNT
+};
+
+struct player_s {
+   enum player_kind_e kind;
+   uint32_t script_state;
+   struct ai_weights_s bot_weights;
+   struct ai_s bot_ai;
+   struct ai_controller_s bot_controller;
+   // Lookahead only - Search runs on the pool if set
+   struct ai_search_config_s bot_search;
+   struct pool_s * bot_pool;
+};
+
+bool player_init(struct player_s * player, enum player_kind_e kind, uint32_t seed);
+sim_input_t player_input(struct player_s * player, const struct sim_s * sim);
+const char * player_kind_name(enum player_kind_e kind);
+bool player_kind_from_name(const char * name, enum player_kind_e * out_kind);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef TETRIS_POOL_H
+#define TETRIS_POOL_H
+
+#include <stdbool.h>
+
+// Pool - Work-stealing thread pool
+//
+// Jobs are index ranges. Every worker owns a slice of the range and takes
+// indices from its front, idle workers steal the back half of the fullest
+// remaining slice. The calling thread works as worker zero.
+typedef void (*pool_task_fn)(void * context, int index, int worker);
+
+struct pool_s;
+
+struct pool_s * pool_create(int thread_count);
+void * pool_destroy(struct pool_s * instance);
+int pool_thread_count(const struct pool_s * instance);
+bool pool_parallel_for(struct pool_s * instance, int count, pool_task_fn task, void * context);
+int pool_hardware_thread_count(void);
+
+#endif
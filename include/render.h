@@ -0,0 +1,634 @@
+#ifndef TETRIS_RENDER_H
+#define TETRIS_RENDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "helpers.h"
+#include "sim.h"
+
+// Software compositor into RGBA textures - No SDL dependency
+
+// Helpers - Colors
+typedef uint32_t color_rgba_t;
+
+// Channel order of color_rgba_t from the most significant byte down. RGBA by
+// default, a presenter may pick the layout of its target texture instead. Must be
+// selected before any color or texture is made.
+enum color_packing_e {
+   COLOR_PACKING_RGBA,
+   COLOR_PACKING_ARGB,
+   COLOR_PACKING_BGRA,
+   COLOR_PACKING_ABGR,
+   COLOR_PACKING_COUNT
+};
+
+bool color_packing_select(enum color_packing_e packing);
+enum color_packing_e color_packing_selected(void);
+const char * color_packing_name(enum color_packing_e packing);
+color_rgba_t color_rgba_alpha_mask(void);
+
+color_rgba_t color_rgba_make_rgba(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha);
+uint8_t color_rgba_channel_red(color_rgba_t color);
+uint8_t color_rgba_channel_green(color_rgba_t color);
+uint8_t color_rgba_channel_blue(color_rgba_t color);
+uint8_t color_rgba_channel_alpha(color_rgba_t color);
+
+// Helpers - Palette
+//
+// The four Game Boy shades used by the imported artwork.
+enum palette_shade_e {
+   PALETTE_SHADE_LIGHTEST,
+   PALETTE_SHADE_LIGHT,
+   PALETTE_SHADE_DARK,
+   PALETTE_SHADE_DARKEST,
+   PALETTE_SHADE_COUNT
+};
+
+color_rgba_t help_palette_shade_color(enum palette_shade_e shade);
+enum palette_shade_e help_palette_shade_nearest(color_rgba_t color);
+
+// Helpers - Texture
+struct texture_rgba_s {
+   color_rgba_t * texels;
+   int width;
+   int height;
+};
+
+int help_texture_rgba_texel_count(struct texture_rgba_s * instance);
+struct vec_2i_s help_texture_rgba_size(struct texture_rgba_s * instance);
+void * help_texture_rgba_destroy(struct texture_rgba_s * instance);
+bool help_texture_rgba_clear(struct texture_rgba_s * instance, color_rgba_t clear_color);
+bool help_texture_rgba_coords_out_of_bounds(struct texture_rgba_s * instance, int x, int y);
+bool help_texture_rgba_2d_coords_to_linear(struct texture_rgba_s * instance, int x, int y, int * out_linear);
+bool help_texture_rgba_plot_texel(struct texture_rgba_s * instance, int x, int y, color_rgba_t color);
+void help_texture_rgba_plot_aabb(struct texture_rgba_s * instance, int min_x, int min_y, int width, int height, color_rgba_t color);
+void help_texture_rgba_plot_horizontal_line(struct texture_rgba_s * instance, int min_x, int width, int y, color_rgba_t color);
+void help_texture_rgba_plot_vertical_line(struct texture_rgba_s * instance, int min_y, int height, int x, color_rgba_t color);
+void help_texture_rgba_plot_aabb_outline(struct texture_rgba_s * instance, int min_x, int min_y, int width, int height, color_rgba_t color);
+bool help_texture_rgba_access_texel(struct texture_rgba_s * instance, int x, int y, color_rgba_t * out_color);
+bool help_texture_rgba_copy_region(struct texture_rgba_s * target, const struct texture_rgba_s * source, struct region_2d_s region);
+struct texture_rgba_s * help_texture_rgba_make(int width, int height, color_rgba_t clear_color);
+
+// Logic - Sprites
+struct sprite_s {
+   struct vec_2i_s texture_min;
+   struct vec_2i_s texture_size;
+};
+
+struct sprite_s sprite_make(int tile_x, int tile_y, int tile_size);
+struct sprite_s sprite_make_xy_wh(int tile_x, int tile_y, int tiles_wide, int tiles_high, int tile_size);
+
+// Logic - Textured Sprite Rendering
+//
+// Copies the opaque texels of a sprite, optionally replaced by the tint color.
+// Target coordinates grow upwards from the bottom left. The sprite rectangle is
+// clipped against both textures once and then copied row span by row span.
+bool help_tex_sprite_render_tinted(struct sprite_s sprite, int x, int y, struct texture_rgba_s * texture_sprite, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color);
+// Same with target texels outside the clip region left untouched
+bool help_tex_sprite_render_tinted_clipped(struct sprite_s sprite, int x, int y, struct texture_rgba_s * texture_sprite, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color, struct region_2d_s clip);
+// Reference path - Bounds checks and flips every texel on its own
+bool help_tex_sprite_render_tinted_per_texel(struct sprite_s sprite, int x, int y, struct texture_rgba_s * texture_sprite, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color);
+
+// Logic - Tile kernel
+//
+// Blits a registered 8x8 sprite with its precomputed row masks, one vector
+// store per fully opaque row and a masked store per partially opaque row.
+// AVX2 or SSE2 is picked at runtime on x86, other targets loop per texel.
+// Returns false without drawing when the sprite has no masks or is clipped.
+struct sprite_map_s;
+bool help_tex_tile_render_masked(const struct sprite_map_s * sprite_map, int tile, int x, int y, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color);
+bool help_tex_tile_render_rows(struct sprite_s sprite, const uint8_t * row_masks, const struct texture_rgba_s * texture_sprite, int x, int y, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color);
+const char * help_tex_tile_kernel_name(void);
+
+// Helpers - Border rendering
+enum sprite_map_tile_e {
+   SPRITE_MAP_TILE_TETRO_BLOCK_I,
+   SPRITE_MAP_TILE_TETRO_BLOCK_O,
+   SPRITE_MAP_TILE_TETRO_BLOCK_Lr,
+   SPRITE_MAP_TILE_TETRO_BLOCK_L,
+   SPRITE_MAP_TILE_TETRO_BLOCK_S,
+   SPRITE_MAP_TILE_TETRO_BLOCK_T,
+   SPRITE_MAP_TILE_TETRO_BLOCK_Z,
+   SPRITE_MAP_TILE_BRICK,
+   SPRITE_MAP_TILE_HIGHLIGHT,
+   SPRITE_MAP_TILE_FONT_GLYPH_A,
+   SPRITE_MAP_TILE_FONT_GLYPH_B,
+   SPRITE_MAP_TILE_FONT_GLYPH_C,
+   SPRITE_MAP_TILE_FONT_GLYPH_D,
+   SPRITE_MAP_TILE_FONT_GLYPH_E,
+   SPRITE_MAP_TILE_FONT_GLYPH_F,
+   SPRITE_MAP_TILE_FONT_GLYPH_G,
+   SPRITE_MAP_TILE_FONT_GLYPH_H,
+   SPRITE_MAP_TILE_FONT_GLYPH_I,
+   SPRITE_MAP_TILE_FONT_GLYPH_J,
+   SPRITE_MAP_TILE_FONT_GLYPH_K,
+   SPRITE_MAP_TILE_FONT_GLYPH_L,
+   SPRITE_MAP_TILE_FONT_GLYPH_M,
+   SPRITE_MAP_TILE_FONT_GLYPH_N,
+   SPRITE_MAP_TILE_FONT_GLYPH_O,
+   SPRITE_MAP_TILE_FONT_GLYPH_P,
+   SPRITE_MAP_TILE_FONT_GLYPH_Q,
+   SPRITE_MAP_TILE_FONT_GLYPH_R,
+   SPRITE_MAP_TILE_FONT_GLYPH_S,
+   SPRITE_MAP_TILE_FONT_GLYPH_T,
+   SPRITE_MAP_TILE_FONT_GLYPH_U,
+   SPRITE_MAP_TILE_FONT_GLYPH_V,
+   SPRITE_MAP_TILE_FONT_GLYPH_W,
+   SPRITE_MAP_TILE_FONT_GLYPH_X,
+   SPRITE_MAP_TILE_FONT_GLYPH_Y,
+   SPRITE_MAP_TILE_FONT_GLYPH_Z,
+   SPRITE_MAP_TILE_FONT_GLYPH_0,
+   SPRITE_MAP_TILE_FONT_GLYPH_1,
+   SPRITE_MAP_TILE_FONT_GLYPH_2,
+   SPRITE_MAP_TILE_FONT_GLYPH_3,
+   SPRITE_MAP_TILE_FONT_GLYPH_4,
+   SPRITE_MAP_TILE_FONT_GLYPH_5,
+   SPRITE_MAP_TILE_FONT_GLYPH_6,
+   SPRITE_MAP_TILE_FONT_GLYPH_7,
+   SPRITE_MAP_TILE_FONT_GLYPH_8,
+   SPRITE_MAP_TILE_FONT_GLYPH_9,
+   SPRITE_MAP_TILE_FONT_GLYPH_PERIOD,
+   SPRITE_MAP_TILE_FONT_GLYPH_COMMA,
+   SPRITE_MAP_TILE_FONT_GLYPH_COLON,
+   SPRITE_MAP_TILE_FONT_GLYPH_HYPHEN,
+   SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_OPEN,
+   SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_CLOSED,
+   SPRITE_MAP_TILE_FONT_GLYPH_PIPE,
+   SPRITE_MAP_TILE_FONT_GLYPH_PLUS,
+   SPRITE_MAP_TILE_FONT_COPYRIGHT,
+   SPRITE_MAP_TILE_FONT_ARROW_RIGHT,
+   SPRITE_MAP_TILE_GAME_OVER_FILL,
+   SPRITE_MAP_TILE_HEART,
+   SPRITE_MAP_TILE_BG_TITLE_SCREEN,
+   SPRITE_MAP_TILE_BG_CONFIG_SCREEN,
+   SPRITE_MAP_TILE_BG_PLAY_SCREEN,
+   SPRITE_MAP_TILE_BG_INPUT_MAPPING_SCREEN,
+   SPRITE_MAP_TILE_SPEAKER,
+   SPRITE_MAP_TILE_NA,
+   SPRITE_MAP_TILE_COUNT
+};
+
+// Per row opacity of 8x8 sprites, taken from the texture when a tile is registered
+#define SPRITE_MAP_KERNEL_TILE_SIZE (8)
+
+struct sprite_map_s {
+   struct sprite_s tile_to_sprite[SPRITE_MAP_TILE_COUNT];
+   struct texture_rgba_s * texture;
+   int tile_size;
+   // Bit x of row y set for opaque texel x, rows bottom up like sprite rows
+   uint8_t tile_row_masks[SPRITE_MAP_TILE_COUNT][SPRITE_MAP_KERNEL_TILE_SIZE];
+   bool tile_row_masks_valid[SPRITE_MAP_TILE_COUNT];
+};
+
+bool help_sprite_map_tile(struct sprite_map_s * instance, enum sprite_map_tile_e tile, int sprite_tile_x, int sprite_tile_y);
+bool help_sprite_map_tile_extended(struct sprite_map_s * instance, enum sprite_map_tile_e tile, int sprite_tile_x, int sprite_tile_y, int sprite_tiles_wide, int sprite_tiles_high);
+struct sprite_map_s * help_sprite_map_create(struct texture_rgba_s * texture, int na_tile_x, int na_tile_y, int tile_size);
+struct sprite_s help_sprite_map_sprite_for(const struct sprite_map_s * instance, enum sprite_map_tile_e tile);
+bool help_sprite_map_register_tiles(struct sprite_map_s * instance);
+
+// Logic - Tint cache
+//
+// Tinted copies of single tile sprites baked into their own texture, so tinted
+// text is a plain blit. Entries are keyed by (tile, tint) and baked on first use,
+// the palette shades of every font glyph are baked up front.
+#define TINT_CACHE_CAPACITY (256)
+#define TINT_CACHE_SLOTS_PER_ROW (16)
+
+struct tint_cache_entry_s {
+   bool is_used;
+   enum sprite_map_tile_e tile;
+   color_rgba_t tint;
+   struct sprite_s sprite;
+   uint8_t row_masks[SPRITE_MAP_KERNEL_TILE_SIZE];
+   bool row_masks_valid;
+};
+
+struct tint_cache_s {
+   struct texture_rgba_s * texture;
+   int tile_size;
+   int entry_count;
+   int misses;
+   // Lookups of sprites larger than one tile, routed around the cache
+   int bypasses;
+   struct tint_cache_entry_s entries[TINT_CACHE_CAPACITY];
+};
+
+struct tint_cache_s * help_tint_cache_create(int tile_size);
+void * help_tint_cache_destroy(struct tint_cache_s * instance);
+const struct tint_cache_entry_s * help_tint_cache_entry_for(struct tint_cache_s * instance, const struct sprite_map_s * sprite_map, enum sprite_map_tile_e tile, color_rgba_t tint);
+struct font_render_s;
+bool help_tint_cache_bake_font_palette(struct tint_cache_s * instance, const struct sprite_map_s * sprite_map, const struct font_render_s * font_render);
+
+// Logic - Render commands
+//
+// Engine draws of one frame kept as compact commands instead of drawn right
+// away. Once recorded, commands entirely outside the target are culled and
+// horizontal neighbours of one tint, mostly glyphs of a text, are merged into
+// runs that are clip tested as a whole. The capacity is fixed, recording never
+// allocates and frames that overflow it are composed immediately instead.
+#define RENDER_COMMAND_CAPACITY (2048)
+
+enum render_command_kind_e {
+   RENDER_COMMAND_SPRITE,
+   RENDER_COMMAND_FILL,
+   RENDER_COMMAND_LAYER
+};
+
+// Bottom left corner and size, bottom up like every engine draw
+struct render_command_s {
+   uint8_t kind;
+   uint8_t do_tint;
+   // sprite_map_tile_e of sprites, render_layer_e of layers
+   uint16_t id;
+   int16_t x;
+   int16_t y;
+   int16_t width;
+   int16_t height;
+   // Tint of sprites, color of fills
+   color_rgba_t color;
+};
+
+struct render_command_run_s {
+   int first;
+   int count;
+   struct region_2d_s region;
+};
+
+struct render_commands_s {
+   struct render_command_s commands[RENDER_COMMAND_CAPACITY];
+   int count;
+   bool is_recording;
+   bool overflow;
+   struct render_command_run_s runs[RENDER_COMMAND_CAPACITY];
+   int run_count;
+   // Hash of the surviving commands, repeats compose exactly the previous frame
+   uint64_t signature;
+   bool is_repeat;
+   // Statistics
+   unsigned long long commands_total;
+   unsigned long long culled_total;
+   unsigned long long runs_total;
+   unsigned long repeats_total;
+   unsigned long frames;
+};
+
+struct render_commands_s * help_render_commands_create(void);
+void * help_render_commands_destroy(struct render_commands_s * instance);
+void help_render_commands_begin(struct render_commands_s * instance);
+bool help_render_commands_push(struct render_commands_s * instance, enum render_command_kind_e kind, int id, int x, int y, int width, int height, bool do_tint, color_rgba_t color);
+void help_render_commands_end(struct render_commands_s * instance, int target_width, int target_height);
+struct region_2d_s help_render_command_region(const struct render_command_s * command);
+
+// Logic - Geometry batches
+//
+// Recorded commands turned into textured quads for renderers that draw
+// triangles, so a frame is a single draw call sampling one atlas. Vertex colors
+// multiply the atlas while tints replace texels, hence the atlas stacks the
+// sprite texture over a white copy of its opaque texels and one white row.
+// Plain sprites sample the sheet in white, tinted ones the white copy in their
+// tint and fills the white row in their color. Atlas rows are stored top down
+// ready for upload, vertices are in target pixels from the top left.
+struct render_vertex_s {
+   float x;
+   float y;
+   float red;
+   float green;
+   float blue;
+   float alpha;
+   float u;
+   float v;
+};
+
+struct render_geometry_s {
+   struct texture_rgba_s * atlas;
+   int sheet_height;
+   struct render_vertex_s vertices[RENDER_COMMAND_CAPACITY * 4];
+   // Two triangles per quad, laid out once
+   int indices[RENDER_COMMAND_CAPACITY * 6];
+   int quad_count;
+   // Statistics
+   unsigned long long quads_total;
+   unsigned long batches;
+};
+
+struct render_geometry_s * help_render_geometry_create(const struct texture_rgba_s * tex_sprites);
+void * help_render_geometry_destroy(struct render_geometry_s * instance);
+// False for overflowing frames and frames with static layers, those are composed instead
+bool help_render_geometry_build(struct render_geometry_s * instance, const struct render_commands_s * commands, const struct sprite_map_s * sprite_map, int virtual_height, float origin_x, float origin_y, float scale);
+
+// Logic - Nametable
+//
+// Game Boy style tile grid over the virtual screen. The commands of a frame
+// are folded into a signature per covered tile. Tiles whose signature changed
+// since the last frame are dirty, only they are re-composited by executing the
+// commands clipped to the dirty rectangles.
+
+// Dirty tiles merged into rectangles, in tiles from the bottom left
+struct nametable_rect_s {
+   int tile_x;
+   int tile_y;
+   int tiles_wide;
+   int tiles_high;
+};
+
+struct nametable_s {
+   int tiles_wide;
+   int tiles_high;
+   int tile_size;
+   uint64_t * signatures;
+   uint64_t * signatures_previous;
+   bool * dirty;
+   bool is_valid;
+   struct nametable_rect_s * rects;
+   int rect_count;
+   // Statistics
+   int tiles_redrawn;
+   unsigned long long tiles_redrawn_total;
+   unsigned long long rects_total;
+   unsigned long frames;
+};
+
+struct nametable_s * help_nametable_create(int width, int height, int tile_size);
+void * help_nametable_destroy(struct nametable_s * instance);
+void help_nametable_invalidate(struct nametable_s * instance);
+// Missing or overflowing command lists mark every tile dirty
+void help_nametable_resolve(struct nametable_s * instance, const struct render_commands_s * commands);
+struct region_2d_s help_nametable_rect_texels(const struct nametable_s * instance, struct nametable_rect_s rect);
+
+// Logic - Static layers
+//
+// Background art and fixed labels of a screen, composed once into their own
+// texture and restored with a single copy per frame. The layer is rebuilt only
+// when a game state change moves to another screen.
+enum render_layer_e {
+   RENDER_LAYER_BLANK,
+   RENDER_LAYER_SPLASH,
+   RENDER_LAYER_TITLE,
+   RENDER_LAYER_CONFIG,
+   RENDER_LAYER_PLAY,
+   RENDER_LAYER_INPUT_MAPPING,
+   RENDER_LAYER_COUNT
+};
+
+struct layer_cache_s {
+   struct texture_rgba_s * texture;
+   enum render_layer_e layer;
+   bool is_valid;
+   int rebuilds;
+};
+
+enum render_layer_e help_render_layer_for_state(enum game_state_e game_state);
+struct layer_cache_s * help_layer_cache_create(int width, int height);
+void * help_layer_cache_destroy(struct layer_cache_s * instance);
+void help_layer_cache_invalidate(struct layer_cache_s * instance);
+
+// Logic - Indexed textures
+//
+// Game Boy style storage - Every 8 texels of a row are two bitplanes holding the
+// palette_shade_e index plus an opacity plane, the leftmost texel in bit 7. Rows
+// are stored flipped like texture_rgba_s. Sprites must start and end on a group
+// of 8 texels in the source, targets take any position.
+struct texture_2bpp_s {
+   uint8_t * groups;
+   int width;
+   int height;
+   int groups_per_row;
+};
+
+struct texture_2bpp_s * help_texture_2bpp_make(int width, int height, enum palette_shade_e clear_shade);
+void * help_texture_2bpp_destroy(struct texture_2bpp_s * instance);
+struct texture_2bpp_s * help_texture_2bpp_from_rgba(const struct texture_rgba_s * source);
+void help_texture_2bpp_fill(struct texture_2bpp_s * instance, int min_x, int min_y, int width, int height, enum palette_shade_e shade);
+bool help_tex_2bpp_sprite_render(struct sprite_s sprite, int x, int y, const struct texture_2bpp_s * texture_sprite, struct texture_2bpp_s * texture_target, bool do_tint, enum palette_shade_e tint_shade);
+// Expands indices through the palette, the only per texel color work of a frame
+bool help_texture_2bpp_resolve(const struct texture_2bpp_s * source, const color_rgba_t palette[PALETTE_SHADE_COUNT], struct texture_rgba_s * target);
+
+// Indexed counterparts of the engine textures, a palette swap recolors the whole screen
+struct render_indexed_s {
+   struct texture_2bpp_s * tex_virtual;
+   struct texture_2bpp_s * tex_sprites;
+   color_rgba_t palette[PALETTE_SHADE_COUNT];
+};
+
+struct render_indexed_s * help_render_indexed_create(const struct texture_rgba_s * tex_virtual, const struct texture_rgba_s * tex_sprites);
+void * help_render_indexed_destroy(struct render_indexed_s * instance);
+
+// Logic - Upscale
+//
+// Nearest neighbour integer scaling of the virtual screen into a 32 bit
+// framebuffer, centered and letterboxed. Rows are widened once by replicating
+// texels and repeated rows are copied with memcpy.
+enum upscale_kernel_e {
+   // Reference path - Maps every target pixel back to its source texel
+   UPSCALE_KERNEL_PER_PIXEL,
+   UPSCALE_KERNEL_SCALAR,
+   UPSCALE_KERNEL_SSE2,
+   UPSCALE_KERNEL_AVX2,
+   UPSCALE_KERNEL_COUNT
+};
+
+enum upscale_kernel_e help_upscale_kernel_best(void);
+bool help_upscale_kernel_supported(enum upscale_kernel_e kernel);
+const char * help_upscale_kernel_name(enum upscale_kernel_e kernel);
+int help_upscale_scale_max(int target_width, int target_height, int source_width, int source_height);
+// Borders only need clearing when the target framebuffer is new
+bool help_texture_rgba_upscale(const struct texture_rgba_s * source, void * target_pixels, int target_pitch, int target_width, int target_height, bool do_borders, color_rgba_t border_color, enum upscale_kernel_e kernel);
+
+// Helpers - Engine
+enum render_blitter_e {
+   RENDER_BLITTER_TILE_KERNEL,
+   RENDER_BLITTER_ROW_SPAN,
+   RENDER_BLITTER_PER_TEXEL,
+   RENDER_BLITTER_COUNT
+};
+
+struct engine_s {
+   struct font_render_s * font_render;
+   struct texture_rgba_s * tex_virtual;
+   struct texture_rgba_s * tex_sprites;
+   struct sprite_map_s * sprite_map;
+   // Optional - Tinted sprites are tinted per texel without it
+   struct tint_cache_s * tint_cache;
+   // Optional - Draws are issued immediately without it
+   struct render_commands_s * commands;
+   // Optional - Whole frames are composed without it, needs commands
+   struct nametable_s * nametable;
+   // Optional - Static layers are drawn every frame without it
+   struct layer_cache_s * layer_cache;
+   // Optional - Composes indices and resolves them into tex_virtual, caches above are bypassed
+   struct render_indexed_s * indexed;
+   // Optional - Text is laid out on every draw without it
+   struct text_cache_s * text_cache;
+   enum render_blitter_e blitter;
+};
+
+struct texture_rgba_s * help_engine_get_tex_virtual(struct engine_s * engine);
+struct texture_rgba_s * help_engine_get_tex_sprites(struct engine_s * engine);
+struct sprite_map_s * help_engine_get_sprite_map(struct engine_s * engine);
+
+// Helpers - Rendering (Simplified)
+bool help_render_engine_sprite(struct engine_s * engine, int x, int y, enum sprite_map_tile_e tile_type);
+bool help_render_engine_fill(struct engine_s * engine, int min_x, int min_y, int width, int height, color_rgba_t color);
+bool help_render_engine_aabb_outline(struct engine_s * engine, int min_x, int min_y, int width, int height, color_rgba_t color);
+
+// Helpers - Play field
+#define PLAY_FIELD_TILE_SIZE (8)
+#define PLAY_FIELD_OFFSET_HORI_TILES (2)
+#define PLAY_FIELD_OFFSET_HORI_PIXELS (PLAY_FIELD_OFFSET_HORI_TILES * PLAY_FIELD_TILE_SIZE)
+bool help_render_engine_sprite_at_tile(struct engine_s * engine, int tile_x, int tile_y, enum sprite_map_tile_e tile_type);
+bool help_render_engine_sprite_tinted(struct engine_s * engine, int x, int y, enum sprite_map_tile_e tile_type, bool do_tint, color_rgba_t tint);
+enum sprite_map_tile_e help_tetro_type_to_sprite_tile(enum tetro_type_e tetro_type);
+void help_play_field_render_to_texture(const struct play_field_s * play_field, struct engine_s * engine);
+
+// Helpers - Rendering stuff
+void help_tetro_render_to_texture_at_tile_without_position(const struct tetro_world_s * tetro, struct engine_s * engine, int tile_x, int tile_y);
+void help_tetro_render_to_texture(const struct tetro_world_s * tetro, struct engine_s * engine);
+
+// Helpers - Font rendering
+struct font_render_glyph_s {
+   bool is_mapped;
+   enum sprite_map_tile_e sprite_tile;
+};
+
+#define FONT_RENDER_MAX_GLYPHS (256)
+struct font_render_s {
+   struct font_render_glyph_s glyphs[FONT_RENDER_MAX_GLYPHS];
+};
+
+struct font_render_glyph_s font_render_glyph_make_mapped(enum sprite_map_tile_e sprite_tile);
+bool font_render_make(struct font_render_s * instance);
+bool help_font_render_ascii_code_in_valid(int ascii_code);
+bool help_font_render_map_ascii_to_sprite(struct font_render_s * instance, char character, enum sprite_map_tile_e sprite_tile);
+bool help_font_render_char_mapped(struct font_render_s * instance, char character);
+bool help_font_render_map_glyphs(struct font_render_s * instance);
+
+// Additional engine based rendering
+bool help_engine_render_tinted_text_at_tile_internal(struct engine_s * engine, const char * text, int tile_x, int tile_y, bool do_tint, color_rgba_t tint);
+bool help_engine_render_text_at_tile(struct engine_s * engine, const char * text, int tile_x, int tile_y);
+bool help_engine_render_tinted_text_at_tile(struct engine_s * engine, const char * text, int tile_x, int tile_y, color_rgba_t tint);
+// Right aligned to at least width tiles, like printf's %*d
+bool help_engine_render_number_at_tile(struct engine_s * engine, int number, int width, int tile_x, int tile_y);
+
+// Logic - Text layout
+//
+// Text is laid out into a run of glyph sprites at their final positions, so
+// upper casing, escapes and glyph lookups happen once per layout instead of
+// per draw. Strings longer than a run are laid out as consecutive chunks that
+// are cached on their own. Entries live in small sets picked by a hash of the
+// position and contents of a chunk, or of the position and width of a number,
+// and the contents are only compared when the hash matches. A changed string or
+// value is laid out again and everything else is reused.
+#define TEXT_RUN_CAPACITY (128)
+#define TEXT_CACHE_CAPACITY (64)
+#define TEXT_CACHE_WAYS (8)
+#define TEXT_CACHE_SETS (TEXT_CACHE_CAPACITY / TEXT_CACHE_WAYS)
+
+struct text_glyph_s {
+   int16_t x;
+   int16_t y;
+   uint16_t sprite_tile;
+   // Unsupported characters show the placeholder sprite, never tinted
+   bool is_placeholder;
+};
+
+struct text_run_s {
+   struct text_glyph_s glyphs[TEXT_RUN_CAPACITY];
+   int count;
+};
+
+struct text_cache_entry_s {
+   bool is_used;
+   uint32_t key_hash;
+   // Cursor at the first character, newlines return to origin_x
+   int tile_x;
+   int tile_y;
+   int origin_x;
+   bool is_number;
+   int number;
+   int number_width;
+   int length;
+   char text[TEXT_RUN_CAPACITY];
+   // Cursor after the last character, where the next chunk continues
+   struct vec_2i_s cursor_end;
+   struct text_run_s run;
+};
+
+struct text_cache_s {
+   struct text_cache_entry_s entries[TEXT_CACHE_CAPACITY];
+   // Round robin eviction within each set
+   int next_evicted[TEXT_CACHE_SETS];
+   // Statistics
+   unsigned long hits;
+   unsigned long layouts;
+};
+
+struct text_cache_s * help_text_cache_create(void);
+void * help_text_cache_destroy(struct text_cache_s * instance);
+// Lays out length characters continuing at the cursor, newlines return to origin_x
+void help_text_run_append(struct text_run_s * run, const struct font_render_s * font_render, const char * text, int length, int origin_x, struct vec_2i_s * cursor);
+void help_text_run_layout_number(struct text_run_s * run, const struct font_render_s * font_render, int number, int width, int tile_x, int tile_y);
+// Run of at most TEXT_RUN_CAPACITY characters continuing at the cursor, which is
+// advanced past them. NULL and the cursor unchanged when there is no cache.
+const struct text_run_s * help_text_cache_lookup(struct text_cache_s * instance, const struct font_render_s * font_render, const char * text, int length, int origin_x, struct vec_2i_s * cursor);
+const struct text_run_s * help_text_cache_lookup_number(struct text_cache_s * instance, const struct font_render_s * font_render, int number, int width, int tile_x, int tile_y);
+bool help_engine_render_text_run(struct engine_s * engine, const struct text_run_s * run, bool do_tint, color_rgba_t tint);
+
+// Logic - Frame composition
+//
+// Composes the whole virtual screen for the current simulation state. With
+// commands the frame is recorded first and executed in a separate pass, with
+// a nametable as well only the tiles that changed since the previous call are
+// redrawn.
+struct render_volumes_s {
+   float music;
+   float sfx;
+};
+
+// Everything composition reads from the simulation, copied out of it so frames
+// can be composed while the simulation keeps ticking
+struct render_state_s {
+   enum game_state_e game_state;
+   struct play_field_s play_field;
+   struct tetro_world_s tetro_active;
+   struct tetro_world_s tetro_next;
+   struct list_of_rows_s full_rows;
+   bool full_rows_highlighted;
+   struct sim_stats_s stats;
+   struct vec_2i_s game_music_cursor;
+   int game_over_lines_filled;
+   int game_over_lines_cleared;
+   bool keys_confirmed[CUSTOM_KEY_COUNT];
+   bool volume_overlay_visible;
+   bool volumes_known;
+   struct render_volumes_s volumes;
+   uint32_t tick;
+};
+
+// Volumes are optional, the overlay is skipped without them
+struct render_state_s render_state_make(const struct sim_s * sim, const struct render_volumes_s * volumes);
+
+// Records the frame into the engine commands without composing it
+bool help_engine_record_state(struct engine_s * engine, const struct render_state_s * state);
+bool help_engine_render_state(struct engine_s * engine, const struct render_state_s * state);
+bool help_engine_render_sim(struct engine_s * engine, const struct sim_s * sim, const struct render_volumes_s * volumes);
+// Executes recorded commands into the engine targets, leaving texels outside the clip region untouched
+bool help_engine_execute_commands(struct engine_s * engine, const struct render_commands_s * commands, struct region_2d_s clip);
+
+
+// Logic - Render state snapshots
+//
+// Lock-free triple buffer between the simulation thread and the thread that
+// composes. The simulation fills the back slot and publishes it by swapping it
+// with the middle one, the composer swaps the middle slot to the front when a
+// newer one was published. Neither side ever waits, states published faster
+// than frames are composed are skipped.
+struct render_snapshots_s;
+
+struct render_snapshots_s * help_render_snapshots_create(void);
+void * help_render_snapshots_destroy(struct render_snapshots_s * instance);
+struct render_state_s * help_render_snapshots_back(struct render_snapshots_s * instance);
+void help_render_snapshots_publish(struct render_snapshots_s * instance);
+// Newest published state, the previous one again when nothing was published since
+const struct render_state_s * help_render_snapshots_acquire(struct render_snapshots_s * instance, bool * out_is_new);
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef TETRIS_REPLAY_H
+#define TETRIS_REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sim.h"
+
+// Replay - Format
+//
+// Little-endian, fixed layout so a replay file can be used in place once mapped:
+//    struct replay_header_s
+//    struct replay_run_s[run_count] at runs_offset
+//    struct replay_keyframe_s[keyframe_count] at keyframes_offset (8-byte aligned)
+// A replay is the seed and randomizer of the game plus the run-length encoded
+// input word of every tick. Keyframes are full simulation snapshots every
+// keyframe_interval ticks for seeking, serialized field by field and only used
+// by builds with the same state_version.
+#define REPLAY_MAGIC "TRPL"
+#define REPLAY_VERSION (3)
+// Oldest version with the same header and runs, its keyframes are ignored
+#define REPLAY_VERSION_MIN (2)
+#define REPLAY_BUILD_INFO_SIZE (24)
+#define REPLAY_RUN_LENGTH_MAX (0xFFFF)
+#define REPLAY_KEYFRAME_INTERVAL_DEFAULT (SIM_TICKS_PER_SECOND * 10)
+
+struct replay_header_s {
+   char magic[4];
+   uint16_t version;
+   uint16_t header_size;
+   uint32_t seed;
+   uint32_t randomizer;
+   uint32_t tick_count;
+   uint32_t run_count;
+   uint32_t runs_offset;
+   uint32_t keyframe_count;
+   uint32_t keyframes_offset;
+   uint32_t keyframe_interval;
+   uint32_t keyframe_size;
+   // SIM_STATE_VERSION of the keyframe snapshots
+   uint32_t state_version;
+   // Simulation state hash after the last tick, used to validate playback
+   uint64_t final_state_hash;
+   char build_info[REPLAY_BUILD_INFO_SIZE];
+};
+
+struct replay_run_s {
+   sim_input_t input;
+   uint16_t length;
+};
+
+struct replay_keyframe_s {
+   // Input cursor position of the first tick after the snapshot
+   uint32_t tick;
+   uint32_t run;
+   uint32_t run_tick;
+   uint32_t reserved;
+   // sim_state_serialize output
+   uint8_t state[SIM_STATE_SERIAL_SIZE];
+};
+
+// Replay - Recording
+struct replay_recorder_s {
+   struct replay_header_s header;
+   struct replay_run_s * runs;
+   uint32_t run_capacity;
+   struct replay_keyframe_s * keyframes;
+   uint32_t keyframe_capacity;
+};
+
+struct replay_recorder_s * replay_recorder_create(uint32_t seed, enum tetro_randomizer_e randomizer, uint32_t keyframe_interval);
+void * replay_recorder_destroy(struct replay_recorder_s * instance);
+bool replay_recorder_push(struct replay_recorder_s * instance, const struct sim_s * sim, sim_input_t input);
+bool replay_recorder_write(struct replay_recorder_s * instance, const char * path, uint64_t final_state_hash);
+
+// Replay - Playback
+struct replay_s {
+   const struct replay_header_s * header;
+   const struct replay_run_s * runs;
+   // Empty when written by a build with a different simulation state version
+   const struct replay_keyframe_s * keyframes;
+   uint32_t keyframe_count;
+   // Backing storage, either a file mapping or borrowed memory
+   void * data;
+   size_t size;
+   bool mapped;
+};
+
+struct replay_cursor_s {
+   uint32_t run;
+   uint32_t run_tick;
+   uint32_t tick;
+};
+
+struct replay_s * replay_open(const char * path);
+struct replay_s * replay_from_memory(const void * data, size_t size);
+void * replay_destroy(struct replay_s * instance);
+bool replay_sim_init(const struct replay_s * replay, struct sim_s * sim);
+struct replay_cursor_s replay_cursor_make(void);
+bool replay_cursor_next(const struct replay_s * replay, struct replay_cursor_s * cursor, sim_input_t * out_input);
+bool replay_seek(const struct replay_s * replay, struct sim_s * sim, struct replay_cursor_s * cursor, uint32_t tick);
+bool replay_simulate_to_end(const struct replay_s * replay, struct sim_s * sim);
+bool replay_validate(const struct replay_s * replay);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef TETRIS_RNG_H
+#define TETRIS_RNG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Helpers - Random number generation
+//
+// PCG32 (XSH RR) - 16 bytes of state per generator, so every simulation
+// owns an independent and reproducible stream.
+struct rng_s {
+   uint64_t state;
+   uint64_t increment;
+};
+
+bool rng_seed(struct rng_s * rng, uint64_t seed, uint64_t stream);
+uint32_t rng_next_u32(struct rng_s * rng);
+uint32_t rng_next_below(struct rng_s * rng, uint32_t bound);
+
+#endif
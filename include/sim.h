@@ -0,0 +1,357 @@
+#ifndef TETRIS_SIM_H
+#define TETRIS_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "helpers.h"
+#include "rng.h"
+
+// Simulation - Timing
+#define SIM_TICKS_PER_SECOND (50)
+#define SIM_FIXED_DELTA_TIME (1.0 / SIM_TICKS_PER_SECOND)
+// Whole ticks covering at least the given milliseconds
+#define SIM_TICKS_FROM_MS(ms) ((uint32_t)((((ms) * SIM_TICKS_PER_SECOND) + 999) / 1000))
+// No timer pending, only input changes the state
+#define SIM_TICKS_NEVER (UINT32_MAX)
+
+// Helpers - Tetro
+#define TETRO_MAX_SIZE (4)
+enum tetro_type_e {
+   TETRO_TYPE_I,
+   TETRO_TYPE_Lr,
+   TETRO_TYPE_L,
+   TETRO_TYPE_S,
+   TETRO_TYPE_Z,
+   TETRO_TYPE_T,
+   TETRO_TYPE_O,
+   TETRO_TYPE_COUNT
+};
+
+// Tetro cell (tx, ty) is bit (ty * TETRO_MAX_SIZE + tx)
+typedef uint16_t tetro_mask;
+#define TETRO_MASK_BIT(tx, ty) ((tetro_mask)(1u << ((ty) * TETRO_MAX_SIZE + (tx))))
+#define TETRO_ROTATION_COUNT (4)
+
+enum tetro_mask_e {
+   TETRO_MASK_DESIGN,
+   TETRO_MASK_LEFT,
+   TETRO_MASK_RIGHT,
+   TETRO_MASK_COUNT
+};
+
+struct tetro_world_s {
+   enum tetro_type_e type;
+   int rotation;
+   struct vec_2i_s tile_pos;
+};
+
+enum rotation_e {
+   ROTATION_CW,
+   ROTATION_CCW
+};
+
+int help_tetro_size(enum tetro_type_e type);
+tetro_mask help_tetro_mask(enum tetro_type_e type, int rotation, enum tetro_mask_e which);
+bool help_tetro_mask_cell(tetro_mask mask, int tx, int ty);
+tetro_mask help_tetro_world_mask(const struct tetro_world_s * tetro, enum tetro_mask_e which);
+struct tetro_world_s tetro_world_make(enum tetro_type_e type, int rotation, int tile_x, int tile_y);
+struct tetro_world_s help_tetro_world_make_type_at_tile(enum tetro_type_e type, int tile_x, int tile_y);
+struct tetro_world_s help_tetro_world_clone_at_position(const struct tetro_world_s * tetro, int x, int y);
+bool help_tetro_world_rotate_ccw(struct tetro_world_s * tetro);
+bool help_tetro_world_rotate_cw(struct tetro_world_s * tetro);
+
+// Helpers - Tetro spawning
+enum tetro_randomizer_e {
+   // Independent uniform type per spawn
+   TETRO_RANDOMIZER_CLASSIC,
+   // Every run of seven spawns is a shuffled permutation of all types
+   TETRO_RANDOMIZER_BAG_7
+};
+
+struct tetro_spawn_s {
+   uint8_t type;
+   uint8_t rotation;
+};
+
+struct tetro_randomizer_s {
+   struct rng_s rng;
+   enum tetro_randomizer_e policy;
+   uint8_t bag[TETRO_TYPE_COUNT];
+   int bag_remaining;
+};
+
+bool help_tetro_randomizer_init(struct tetro_randomizer_s * randomizer, uint64_t seed, enum tetro_randomizer_e policy);
+struct tetro_spawn_s help_tetro_randomizer_next(struct tetro_randomizer_s * randomizer);
+int help_tetro_randomizer_fill(struct tetro_randomizer_s * randomizer, struct tetro_spawn_s * out_spawns, int count);
+struct tetro_world_s help_tetro_world_make_at_spawn(struct tetro_spawn_s spawn);
+struct tetro_world_s help_tetro_world_make_random_at_spawn(struct tetro_randomizer_s * randomizer);
+
+// Helpers - Input
+enum custom_key_e {
+   CUSTOM_KEY_UP,
+   CUSTOM_KEY_DOWN,
+   CUSTOM_KEY_LEFT,
+   CUSTOM_KEY_RIGHT,
+   CUSTOM_KEY_A,
+   CUSTOM_KEY_B,
+   CUSTOM_KEY_START,
+   CUSTOM_KEY_SELECT,
+   CUSTOM_KEY_VOLUME_UP,
+   CUSTOM_KEY_VOLUME_DOWN,
+   CUSTOM_KEY_COUNT
+};
+
+enum key_state_e {
+   KEY_STATE_NONE,
+   KEY_STATE_PRESSED,
+   KEY_STATE_HELD,
+   KEY_STATE_RELEASED
+};
+
+struct input_s {
+   enum key_state_e key_states[CUSTOM_KEY_COUNT];
+};
+
+// One bit per custom key that is down during a tick
+typedef uint16_t sim_input_t;
+#define SIM_INPUT_KEY(key) ((sim_input_t)(1u << (key)))
+
+bool help_input_init(struct input_s * instance);
+enum key_state_e help_input_determine_key_state(enum key_state_e current_state, bool currently_pressed);
+bool help_input_determine_intermediate_state(struct input_s * instance, sim_input_t keys_down);
+bool help_input_key_in_state(const struct input_s * input, enum custom_key_e key, enum key_state_e state);
+bool help_input_key_none(const struct input_s * input, enum custom_key_e key);
+bool help_input_key_pressed(const struct input_s * input, enum custom_key_e key);
+bool help_input_key_held(const struct input_s * input, enum custom_key_e key);
+bool help_input_key_released(const struct input_s * input, enum custom_key_e key);
+bool help_input_key_pressed_or_held(const struct input_s * input, enum custom_key_e key);
+bool help_input_any_key_pressed(const struct input_s * input);
+
+// Helpers - FSM
+enum game_state_e {
+   GAME_STATE_SPLASH,
+   GAME_STATE_INPUT_MAPPING,
+   GAME_STATE_TITLE,
+   GAME_STATE_GAME_MUSIC_CONFIG,
+   GAME_STATE_NEW_GAME,
+   GAME_STATE_CONTROL,
+   GAME_STATE_PLACE,
+   GAME_STATE_REMOVE_LINES,
+   GAME_STATE_CONSOLIDATE_PLAY_FIELD,
+   GAME_STATE_RESPAWN,
+   GAME_STATE_GAME_OVER,
+   GAME_STATE_GAME_OVER_TRANSITION_FILL,
+   GAME_STATE_GAME_OVER_TRANSITION_CLEAR,
+   GAME_STATE_PAUSE,
+   GAME_STATE_QUIT,
+   GAME_STATE_NONE
+};
+
+// Helpers - Play field
+#define PLAY_FIELD_WIDTH (10)
+#define PLAY_FIELD_HEIGHT (18)
+
+struct play_field_cell_s {
+   enum tetro_type_e type;
+   bool occupied;
+};
+
+// One occupancy bit per column and one packed tetro type per column, per row
+typedef uint16_t play_field_row_t;
+#define PLAY_FIELD_COLUMN_BIT(x) ((play_field_row_t)(1u << (x)))
+#define PLAY_FIELD_ROW_FULL ((play_field_row_t)((1u << PLAY_FIELD_WIDTH) - 1))
+#define PLAY_FIELD_TYPE_BITS (3)
+#define PLAY_FIELD_TYPE_MASK ((1u << PLAY_FIELD_TYPE_BITS) - 1)
+
+struct play_field_s {
+   play_field_row_t rows[PLAY_FIELD_HEIGHT];
+   uint32_t types[PLAY_FIELD_HEIGHT];
+};
+
+struct play_field_cell_s help_play_field_cell_make(enum tetro_type_e type, bool occupied);
+struct play_field_cell_s help_play_field_cell_make_non_occupied(void);
+struct play_field_s help_play_field_make_non_occupied(void);
+bool help_play_field_coords_out_of_bounds(const struct play_field_s * play_field, int x, int y);
+bool help_play_field_cell_occupied(const struct play_field_s * play_field, int x, int y);
+enum tetro_type_e help_play_field_cell_type(const struct play_field_s * play_field, int x, int y);
+bool help_play_field_set_cell(struct play_field_s * play_field, int x, int y, struct play_field_cell_s new_cell);
+bool help_play_field_access_cell(const struct play_field_s * play_field, int x, int y, struct play_field_cell_s * out_cell);
+bool help_play_field_clear_row(struct play_field_s * play_field, int row);
+bool help_play_field_clear(struct play_field_s * play_field);
+bool help_play_field_row_empty(const struct play_field_s * play_field, int row);
+bool help_play_field_row_full(const struct play_field_s * play_field, int row);
+bool help_play_field_row_mask_collides(const struct play_field_s * play_field, int row, int x, play_field_row_t row_mask);
+bool help_play_field_consolidate(struct play_field_s * play_field);
+
+// Helpers - Tetro gameplay
+play_field_row_t help_tetro_mask_row(tetro_mask mask, int ty);
+bool help_tetro_mask_collides(tetro_mask mask, const struct play_field_s * play_field, int tile_x, int tile_y);
+bool help_tetro_move_collides(const struct tetro_world_s * TETRO, const struct play_field_s * play_field, int dx, int dy);
+bool help_tetro_rotation_collides(const struct tetro_world_s * TETRO, const struct play_field_s * play_field, enum rotation_e rotation);
+bool help_tetro_drop(const struct tetro_world_s * TETRO, struct play_field_s * play_field, int * out_plot_row_min, int * out_plot_row_max);
+
+// Helpers - Lists
+struct list_of_rows_s {
+   int list[PLAY_FIELD_HEIGHT];
+   int count;
+};
+
+struct list_of_rows_s list_of_rows_make_empty(void);
+bool list_of_rows_append(struct list_of_rows_s * lor, int row);
+
+// Helpers - Line deletion
+struct list_of_rows_s help_play_field_list_of_full_rows(const struct play_field_s * play_field);
+
+// Simulation - Events
+enum sim_sfx_e {
+   SIM_SFX_SPLASH,
+   SIM_SFX_INVALID,
+   SIM_SFX_SELECT,
+   SIM_SFX_MOVE,
+   SIM_SFX_ROTATE,
+   SIM_SFX_PLACE,
+   SIM_SFX_HIGHLIGHT,
+   SIM_SFX_DESTROY,
+   SIM_SFX_GAME_OVER,
+   SIM_SFX_DROP,
+   SIM_SFX_BLIP,
+   SIM_SFX_INCREASE,
+   SIM_SFX_DECREASE,
+   SIM_SFX_PAUSE,
+   SIM_SFX_UN_PAUSE,
+   SIM_SFX_COUNT
+};
+
+enum sim_music_e {
+   SIM_MUSIC_NONE,
+   SIM_MUSIC_TITLE,
+   SIM_MUSIC_GAME_A_TYPE,
+   SIM_MUSIC_GAME_B_TYPE,
+   SIM_MUSIC_GAME_C_TYPE,
+   SIM_MUSIC_GAME_OVER,
+   SIM_MUSIC_COUNT
+};
+
+enum sim_event_type_e {
+   // Audio
+   SIM_EVENT_SFX,
+   SIM_EVENT_MUSIC_PLAY,
+   SIM_EVENT_MUSIC_STOP,
+   SIM_EVENT_MUSIC_PAUSE,
+   SIM_EVENT_MUSIC_RESUME,
+   SIM_EVENT_AUDIO_STOP_ALL,
+   SIM_EVENT_AUDIO_RESUME_ALL,
+   SIM_EVENT_VOLUME_ADJUST,
+   // Rendering
+   SIM_EVENT_GAME_STATE_CHANGED,
+   SIM_EVENT_TETRO_SPAWNED,
+   SIM_EVENT_TETRO_MOVED,
+   SIM_EVENT_TETRO_PLACED,
+   SIM_EVENT_ROWS_FULL,
+   SIM_EVENT_ROWS_CLEARED,
+   // Host
+   SIM_EVENT_QUIT
+};
+
+struct sim_event_s {
+   enum sim_event_type_e type;
+   // Sfx, music, game state, row count or volume step direction depending on type
+   int value;
+   bool loop;
+};
+
+#define SIM_MAX_EVENTS_PER_TICK (32)
+struct sim_events_s {
+   struct sim_event_s list[SIM_MAX_EVENTS_PER_TICK];
+   int count;
+};
+
+bool sim_events_clear(struct sim_events_s * events);
+
+// Simulation - State
+//
+// Replay keyframes store this state through sim_state_serialize, so bump
+// SIM_STATE_VERSION whenever a field is added, removed or reordered.
+struct sim_stats_s {
+   int score;
+   int lines;
+   int level;
+};
+
+struct sim_s {
+   // Input
+   struct input_s input;
+   bool keybr_key_confirmed[CUSTOM_KEY_COUNT];
+   // Game state transitions
+   enum game_state_e game_state;
+   enum game_state_e next_game_state;
+   bool init_splash;
+   bool close_requested;
+   // Play field and tetros
+   struct play_field_s play_field;
+   struct tetro_world_s tetro_active;
+   struct tetro_world_s tetro_next;
+   struct tetro_randomizer_s tetro_randomizer;
+   // Play field row highlighting and removal
+   int plot_row_min;
+   int plot_row_max;
+   struct list_of_rows_s list_of_full_rows;
+   // Game over transition
+   int game_over_transition_field_lines_filled;
+   int game_over_transition_field_lines_cleared;
+   // Game type and music config
+   enum sim_music_e configured_game_music;
+   struct vec_2i_s game_music_cursor;
+   // Stats
+   struct sim_stats_s stats;
+   // Timers - In simulation ticks
+   uint32_t tick;
+   uint32_t tick_splash_start;
+   uint32_t tick_last_tetro_drop;
+   uint32_t tick_last_tetro_player_move;
+   uint32_t tick_last_tetro_player_drop;
+   uint32_t tick_last_row_deletion_timer;
+   uint32_t tick_last_game_over_transition_row;
+   uint32_t tick_last_quit;
+   uint32_t tick_until_show_volume_overlay;
+};
+
+// Simulation - API
+bool sim_init(struct sim_s * instance, uint32_t seed, enum tetro_randomizer_e randomizer);
+bool sim_step(struct sim_s * instance, sim_input_t keys_down, struct sim_events_s * out_events);
+
+enum game_state_e sim_game_state(const struct sim_s * instance);
+const struct play_field_s * sim_play_field(const struct sim_s * instance);
+const struct tetro_world_s * sim_tetro_active(const struct sim_s * instance);
+const struct tetro_world_s * sim_tetro_next(const struct sim_s * instance);
+const struct list_of_rows_s * sim_full_rows(const struct sim_s * instance);
+bool sim_full_rows_highlighted(const struct sim_s * instance);
+struct sim_stats_s sim_stats(const struct sim_s * instance);
+struct vec_2i_s sim_game_music_cursor(const struct sim_s * instance);
+// Music the game state plays, paused while in GAME_STATE_PAUSE
+enum sim_music_e sim_current_music(const struct sim_s * instance, bool * out_loop);
+bool sim_key_confirmed(const struct sim_s * instance, enum custom_key_e key);
+int sim_game_over_lines_filled(const struct sim_s * instance);
+int sim_game_over_lines_cleared(const struct sim_s * instance);
+bool sim_volume_overlay_visible(const struct sim_s * instance);
+bool sim_close_requested(const struct sim_s * instance);
+uint32_t sim_tick(const struct sim_s * instance);
+// Ticks that can run with unchanged input until one of them may change the state on its own
+uint32_t sim_ticks_until_timer(const struct sim_s * instance);
+double sim_time_simulated(const struct sim_s * instance);
+uint64_t sim_state_hash(const struct sim_s * instance);
+
+// Simulation - Serialization
+//
+// Every field of struct sim_s in declaration order as one little-endian 32-bit
+// word, 64-bit values as two, independent of host byte order, enum size and
+// struct padding.
+#define SIM_STATE_VERSION (1)
+#define SIM_STATE_WORD_COUNT (CUSTOM_KEY_COUNT * 2 + TETRO_TYPE_COUNT + PLAY_FIELD_HEIGHT * 3 + 38)
+#define SIM_STATE_SERIAL_SIZE (SIM_STATE_WORD_COUNT * 4)
+
+bool sim_state_serialize(const struct sim_s * instance, uint8_t * out_bytes);
+// False and the instance unchanged when a field is out of range
+bool sim_state_deserialize(struct sim_s * instance, const uint8_t * bytes);
+
+#endif
@@ -0,0 +1,553 @@
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+#include <stdatomic.h>
+#include "helpers.h"
+#include "ai.h"
+
+// Constants
+static const float AI_SCORE_TOP_OUT = -1000000.0f;
+
+// AI - Heuristics
+struct ai_weights_s ai_weights_make_default(void)
+{
+   // Classic four feature weights for ten wide fields
+   struct ai_weights_s weights;
+
+   weights.aggregate_height = -0.510066f;
+   weights.max_height = 0.0f;
+   weights.holes = -0.35663f;
+   weights.bumpiness = -0.184483f;
+   weights.lines_cleared = 0.760666f;
+
+   return weights;
+}
+
+float ai_heuristic_weighted(const struct ai_features_s * features, const void * context)
+{
+   const struct ai_weights_s * WEIGHTS = context;
+
+   return (
+      WEIGHTS->aggregate_height * features->aggregate_height +
+      WEIGHTS->max_height * features->max_height +
+      WEIGHTS->holes * features->holes +
+      WEIGHTS->bumpiness * features->bumpiness +
+      WEIGHTS->lines_cleared * features->lines_cleared
+   );
+}
+
+// Helpers - Field analysis
+int help_ai_clear_full_rows(play_field_row_t * rows)
+{
+   // Compact non-full rows downwards
+   int row_new = 0;
+   for (int row_old = 0; row_old < PLAY_FIELD_HEIGHT; ++row_old)
+   {
+      if (PLAY_FIELD_ROW_FULL != rows[row_old])
+      {
+         rows[row_new++] = rows[row_old];
+      }
+   }
+
+   const int LINES_CLEARED = PLAY_FIELD_HEIGHT - row_new;
+   for (; row_new < PLAY_FIELD_HEIGHT; ++row_new)
+   {
+      rows[row_new] = 0;
+   }
+
+   return LINES_CLEARED;
+}
+
+void help_ai_features_measure(const play_field_row_t * rows, struct ai_features_s * out_features)
+{
+   int heights[PLAY_FIELD_WIDTH] = { 0 };
+
+   // Top down - First occupied cell per column sets its height, empty cells below any set cell are holes
+   play_field_row_t covered = 0;
+   int holes = 0;
+   for (int row = PLAY_FIELD_HEIGHT - 1; row >= 0; --row)
+   {
+      const play_field_row_t ROW = rows[row];
+      play_field_row_t topped = ROW & (play_field_row_t)~covered;
+      while (topped)
+      {
+         const int COLUMN = __builtin_ctz(topped);
+         heights[COLUMN] = row + 1;
+         topped &= (play_field_row_t)(topped - 1);
+      }
+      holes += __builtin_popcount(covered & (play_field_row_t)~ROW);
+      covered |= ROW;
+   }
+
+   // Surface
+   int aggregate_height = 0;
+   int max_height = 0;
+   int bumpiness = 0;
+   for (int column = 0; column < PLAY_FIELD_WIDTH; ++column)
+   {
+      aggregate_height += heights[column];
+      max_height = (heights[column] > max_height) ? heights[column] : max_height;
+      if (column > 0)
+      {
+         const int STEP = heights[column] - heights[column - 1];
+         bumpiness += (STEP < 0) ? -STEP : STEP;
+      }
+   }
+
+   out_features->aggregate_height = aggregate_height;
+   out_features->max_height = max_height;
+   out_features->holes = holes;
+   out_features->bumpiness = bumpiness;
+}
+
+// AI - Placements
+int ai_enumerate_placements(const struct play_field_s * play_field, const struct tetro_world_s * tetro, struct ai_placement_s * out_placements)
+{
+   if (NULL == play_field || NULL == tetro || NULL == out_placements) return 0;
+
+   // Rotations reachable in place - None, one and two clockwise, one counter-clockwise
+   const int ROTATION_STEPS[TETRO_ROTATION_COUNT] = { 0, 1, 2, -1 };
+   tetro_mask masks_seen[TETRO_ROTATION_COUNT];
+   int mask_seen_count = 0;
+   int placement_count = 0;
+   for (int i_rotation = 0; i_rotation < TETRO_ROTATION_COUNT; ++i_rotation)
+   {
+      // Rotate step by step with the sweep collision of every step
+      const int STEPS = ROTATION_STEPS[i_rotation];
+      struct tetro_world_s rotated = *tetro;
+      bool rotation_blocked = false;
+      for (int step = 0; step < (STEPS < 0 ? -STEPS : STEPS) && false == rotation_blocked; ++step)
+      {
+         const enum rotation_e ROTATION = (STEPS > 0) ? ROTATION_CW : ROTATION_CCW;
+         rotation_blocked = help_tetro_rotation_collides(&rotated, play_field, ROTATION);
+         if (ROTATION_CW == ROTATION)
+         {
+            help_tetro_world_rotate_cw(&rotated);
+         }
+         else
+         {
+            help_tetro_world_rotate_ccw(&rotated);
+         }
+      }
+      if (rotation_blocked) continue;
+
+      // Symmetric tetros repeat their design - Skip identical shapes at the same position
+      const tetro_mask DESIGN = help_tetro_world_mask(&rotated, TETRO_MASK_DESIGN);
+      bool mask_seen = false;
+      for (int i_seen = 0; i_seen < mask_seen_count; ++i_seen)
+      {
+         mask_seen = mask_seen || (masks_seen[i_seen] == DESIGN);
+      }
+      if (mask_seen) continue;
+      masks_seen[mask_seen_count++] = DESIGN;
+      if (help_tetro_mask_collides(DESIGN, play_field, rotated.tile_pos.x, rotated.tile_pos.y)) continue;
+
+      // Shift both directions until blocked, dropping at every column
+      for (int direction = -1; direction <= 1; direction += 2)
+      {
+         for (int shift = (direction < 0) ? 0 : 1; ; shift += 1)
+         {
+            const int X = rotated.tile_pos.x + (direction * shift);
+            if (help_tetro_mask_collides(DESIGN, play_field, X, rotated.tile_pos.y)) break;
+
+            int y = rotated.tile_pos.y;
+            while (false == help_tetro_mask_collides(DESIGN, play_field, X, y - 1))
+            {
+               --y;
+            }
+
+            struct ai_placement_s * placement = out_placements + placement_count++;
+            placement->rotation_steps = STEPS;
+            placement->shift = direction * shift;
+            placement->rotation = rotated.rotation;
+            placement->x = X;
+            placement->y = y;
+         }
+      }
+   }
+
+   return placement_count;
+}
+
+bool ai_evaluate_placement(const struct play_field_s * play_field, const struct tetro_world_s * tetro, const struct ai_placement_s * placement, struct play_field_s * out_play_field, struct ai_features_s * out_features)
+{
+   if (NULL == play_field || NULL == tetro || NULL == placement || NULL == out_play_field || NULL == out_features) return false;
+
+   // Occupancy only, tetro types are irrelevant to the search
+   memcpy(out_play_field->rows, play_field->rows, sizeof(out_play_field->rows));
+   memset(out_play_field->types, 0, sizeof(out_play_field->types));
+
+   // Plot tetro rows
+   const tetro_mask DESIGN = help_tetro_mask(tetro->type, placement->rotation, TETRO_MASK_DESIGN);
+   for (int ty = 0; ty < TETRO_MAX_SIZE; ++ty)
+   {
+      const int ROW = placement->y + ty;
+      const play_field_row_t ROW_MASK = help_tetro_mask_row(DESIGN, ty);
+      if (0 == ROW_MASK || ROW < 0 || ROW >= PLAY_FIELD_HEIGHT) continue;
+
+      out_play_field->rows[ROW] |= (placement->x >= 0) ? (play_field_row_t)(ROW_MASK << placement->x) : (play_field_row_t)(ROW_MASK >> -placement->x);
+   }
+
+   out_features->lines_cleared = help_ai_clear_full_rows(out_play_field->rows);
+   help_ai_features_measure(out_play_field->rows, out_features);
+
+   // Success
+   return true;
+}
+
+// AI - Decisions
+bool ai_init(struct ai_s * ai, ai_heuristic_fn heuristic, const void * heuristic_context)
+{
+   if (NULL == ai || NULL == heuristic) return false;
+
+   ai->heuristic = heuristic;
+   ai->heuristic_context = heuristic_context;
+   ai->placements_evaluated = 0;
+   ai->decisions = 0;
+
+   // Success
+   return true;
+}
+
+bool help_ai_decision_plan_moves(struct ai_decision_s * decision)
+{
+   const struct ai_placement_s * PLACEMENT = &decision->placement;
+   decision->move_count = 0;
+
+   for (int step = 0; step < PLACEMENT->rotation_steps; ++step)
+   {
+      decision->moves[decision->move_count++] = AI_MOVE_ROTATE_CW;
+   }
+   for (int step = 0; step < -PLACEMENT->rotation_steps; ++step)
+   {
+      decision->moves[decision->move_count++] = AI_MOVE_ROTATE_CCW;
+   }
+   for (int step = 0; step < PLACEMENT->shift; ++step)
+   {
+      decision->moves[decision->move_count++] = AI_MOVE_RIGHT;
+   }
+   for (int step = 0; step < -PLACEMENT->shift; ++step)
+   {
+      decision->moves[decision->move_count++] = AI_MOVE_LEFT;
+   }
+   decision->moves[decision->move_count++] = AI_MOVE_DROP;
+
+   return true;
+}
+
+bool ai_decide(struct ai_s * ai, const struct play_field_s * play_field, const struct tetro_world_s * tetro, struct ai_decision_s * out_decision)
+{
+   if (NULL == ai || NULL == play_field || NULL == tetro || NULL == out_decision) return false;
+
+   struct ai_placement_s placements[AI_PLACEMENTS_MAX];
+   const int PLACEMENT_COUNT = ai_enumerate_placements(play_field, tetro, placements);
+   if (0 == PLACEMENT_COUNT) return false;
+
+   // Best scoring placement, first one wins ties
+   int i_best = 0;
+   float score_best = -FLT_MAX;
+   for (int i_placement = 0; i_placement < PLACEMENT_COUNT; ++i_placement)
+   {
+      struct play_field_s play_field_after;
+      struct ai_features_s features;
+      ai_evaluate_placement(play_field, tetro, placements + i_placement, &play_field_after, &features);
+
+      const float SCORE = ai->heuristic(&features, ai->heuristic_context);
+      if (SCORE > score_best)
+      {
+         score_best = SCORE;
+         i_best = i_placement;
+      }
+   }
+   ai->placements_evaluated += (uint64_t)PLACEMENT_COUNT;
+   ++ai->decisions;
+
+   out_decision->placement = placements[i_best];
+   out_decision->score = score_best;
+   out_decision->depth = 1;
+   help_ai_decision_plan_moves(out_decision);
+
+   // Success
+   return true;
+}
+
+// Helpers - Search
+double help_ai_time_in_ms(void)
+{
+   return help_time_monotonic_in_seconds() * 1000.0;
+}
+
+struct ai_search_ply_s {
+   struct ai_placement_s placements[AI_PLACEMENTS_MAX];
+   struct play_field_s play_fields[AI_PLACEMENTS_MAX];
+   float scores[AI_PLACEMENTS_MAX];
+   int lines[AI_PLACEMENTS_MAX];
+   int ranked[AI_PLACEMENTS_MAX];
+   int count;
+};
+
+bool help_ai_search_deadline_passed(double deadline_ms, atomic_bool * expired)
+{
+   // Any worker noticing the deadline stops the others as well
+   if (atomic_load_explicit(expired, memory_order_relaxed)) return true;
+   if (deadline_ms > 0.0 && help_ai_time_in_ms() > deadline_ms)
+   {
+      atomic_store_explicit(expired, true, memory_order_relaxed);
+      return true;
+   }
+
+   return false;
+}
+
+bool help_ai_search_ply_expand(const struct ai_s * ai, struct ai_search_ply_s * ply, const struct play_field_s * play_field, const struct tetro_world_s * tetro, int lines_before, int beam_width, double deadline_ms, atomic_bool * expired)
+{
+   // Score every placement with the lines cleared since the root
+   const int PLACEMENT_COUNT = ai_enumerate_placements(play_field, tetro, ply->placements);
+   bool is_complete = true;
+   ply->count = PLACEMENT_COUNT;
+   for (int i_placement = 0; i_placement < PLACEMENT_COUNT; ++i_placement)
+   {
+      struct ai_features_s features;
+      ai_evaluate_placement(play_field, tetro, ply->placements + i_placement, ply->play_fields + i_placement, &features);
+      features.lines_cleared += lines_before;
+      ply->lines[i_placement] = features.lines_cleared;
+      ply->scores[i_placement] = ai->heuristic(&features, ai->heuristic_context);
+      ply->ranked[i_placement] = i_placement;
+
+      // Out of time - Keep the placements scored so far, at least one
+      if (i_placement + 1 < PLACEMENT_COUNT && help_ai_search_deadline_passed(deadline_ms, expired))
+      {
+         ply->count = i_placement + 1;
+         is_complete = false;
+         break;
+      }
+   }
+
+   // Partial selection sort - Only the beam needs to be in order
+   const int RANKED = (beam_width < ply->count) ? beam_width : ply->count;
+   for (int i_rank = 0; i_rank < RANKED; ++i_rank)
+   {
+      int i_best = i_rank;
+      for (int i_other = i_rank + 1; i_other < ply->count; ++i_other)
+      {
+         if (ply->scores[ply->ranked[i_other]] > ply->scores[ply->ranked[i_best]])
+         {
+            i_best = i_other;
+         }
+      }
+      const int SWAP = ply->ranked[i_rank];
+      ply->ranked[i_rank] = ply->ranked[i_best];
+      ply->ranked[i_best] = SWAP;
+   }
+
+   return is_complete;
+}
+
+struct ai_search_s {
+   const struct ai_s * ai;
+   const struct ai_search_config_s * config;
+   const struct tetro_world_s * tetro_next;
+   const struct ai_search_ply_s * root;
+   int depth;
+   double deadline_ms;
+   atomic_bool expired;
+   // Per root candidate
+   float values[AI_SEARCH_BEAM_MAX];
+   uint64_t placements_evaluated[AI_SEARCH_BEAM_MAX];
+};
+
+float help_ai_search_value(struct ai_search_s * search, const struct play_field_s * play_field, int lines_before, int ply_index, uint64_t * placements_evaluated)
+{
+   // Give up once the budget is spent, the whole depth is discarded
+   if (help_ai_search_deadline_passed(search->deadline_ms, &search->expired)) return 0.0f;
+
+   // Preview tetro is known, later ones are averaged over every type
+   const bool PREVIEW = (1 == ply_index);
+   const int TYPE_COUNT = PREVIEW ? 1 : TETRO_TYPE_COUNT;
+   const bool LEAF = (ply_index + 1 >= search->depth);
+   struct ai_search_ply_s ply;
+   float value_sum = 0.0f;
+   for (int i_type = 0; i_type < TYPE_COUNT; ++i_type)
+   {
+      struct tetro_spawn_s spawn;
+      spawn.type = (uint8_t)i_type;
+      spawn.rotation = 0;
+      const struct tetro_world_s TETRO = PREVIEW ? *search->tetro_next : help_tetro_world_make_at_spawn(spawn);
+
+      const bool COMPLETE = help_ai_search_ply_expand(search->ai, &ply, play_field, &TETRO, lines_before, LEAF ? 0 : search->config->beam_width, search->deadline_ms, &search->expired);
+      *placements_evaluated += (uint64_t)ply.count;
+      if (false == COMPLETE) return 0.0f;
+      if (0 == ply.count)
+      {
+         value_sum += AI_SCORE_TOP_OUT;
+         continue;
+      }
+
+      // Leaves take the heuristic directly, inner plies recurse into the beam
+      float value_best = -FLT_MAX;
+      if (LEAF)
+      {
+         for (int i_placement = 0; i_placement < ply.count; ++i_placement)
+         {
+            value_best = (ply.scores[i_placement] > value_best) ? ply.scores[i_placement] : value_best;
+         }
+      }
+      else
+      {
+         const int BEAM = (search->config->beam_width < ply.count) ? search->config->beam_width : ply.count;
+         for (int i_rank = 0; i_rank < BEAM; ++i_rank)
+         {
+            const int I_PLACEMENT = ply.ranked[i_rank];
+            const float VALUE = help_ai_search_value(search, ply.play_fields + I_PLACEMENT, ply.lines[I_PLACEMENT], ply_index + 1, placements_evaluated);
+            value_best = (VALUE > value_best) ? VALUE : value_best;
+         }
+      }
+      if (atomic_load_explicit(&search->expired, memory_order_relaxed)) return 0.0f;
+      value_sum += value_best;
+   }
+
+   return value_sum / (float)TYPE_COUNT;
+}
+
+void help_ai_search_task(void * context, int index, int worker)
+{
+   (void)worker;
+   struct ai_search_s * search = context;
+   const int I_PLACEMENT = search->root->ranked[index];
+
+   search->placements_evaluated[index] = 0;
+   search->values[index] = help_ai_search_value(search, search->root->play_fields + I_PLACEMENT, search->root->lines[I_PLACEMENT], 1, search->placements_evaluated + index);
+}
+
+// AI - Lookahead search
+struct ai_search_config_s ai_search_config_make_default(void)
+{
+   struct ai_search_config_s config;
+
+   config.depth = 3;
+   config.beam_width = 8;
+   config.time_budget_ms = 15.0;
+
+   return config;
+}
+
+bool ai_decide_lookahead(struct ai_s * ai, struct pool_s * pool, const struct ai_search_config_s * config, const struct play_field_s * play_field, const struct tetro_world_s * tetro, const struct tetro_world_s * tetro_next, struct ai_decision_s * out_decision)
+{
+   if (NULL == ai || NULL == config || NULL == play_field || NULL == tetro || NULL == tetro_next || NULL == out_decision) return false;
+
+   const double TIME_START = help_ai_time_in_ms();
+   const int DEPTH = help_limit_clamp_i(1, config->depth, AI_SEARCH_DEPTH_MAX);
+   const int BEAM_WIDTH = help_limit_clamp_i(1, config->beam_width, AI_SEARCH_BEAM_MAX);
+
+   // Every ply checks the budget between placements, the root included
+   struct ai_search_ply_s root;
+   struct ai_search_s search;
+   search.ai = ai;
+   search.config = config;
+   search.tetro_next = tetro_next;
+   search.root = &root;
+   search.deadline_ms = (config->time_budget_ms > 0.0) ? TIME_START + config->time_budget_ms : 0.0;
+   atomic_init(&search.expired, false);
+
+   // Ply one on the calling thread - Cut short, the best placement scored so far decides
+   const bool ROOT_COMPLETE = help_ai_search_ply_expand(ai, &root, play_field, tetro, 0, BEAM_WIDTH, search.deadline_ms, &search.expired);
+   if (0 == root.count) return false;
+   ai->placements_evaluated += (uint64_t)root.count;
+   ++ai->decisions;
+
+   int i_best = root.ranked[0];
+   float score_best = root.scores[i_best];
+   int depth_completed = ROOT_COMPLETE ? 1 : 0;
+
+   // Deepen while the budget lasts
+   const int BEAM = (BEAM_WIDTH < root.count) ? BEAM_WIDTH : root.count;
+   for (int depth = 2; ROOT_COMPLETE && depth <= DEPTH; ++depth)
+   {
+      search.depth = depth;
+      atomic_store(&search.expired, false);
+      if (pool)
+      {
+         pool_parallel_for(pool, BEAM, help_ai_search_task, &search);
+      }
+      else
+      {
+         for (int i_rank = 0; i_rank < BEAM; ++i_rank)
+         {
+            help_ai_search_task(&search, i_rank, 0);
+         }
+      }
+      for (int i_rank = 0; i_rank < BEAM; ++i_rank)
+      {
+         ai->placements_evaluated += search.placements_evaluated[i_rank];
+      }
+      if (atomic_load(&search.expired)) break;
+
+      // Best root candidate at this depth, ties keep the better ply one rank
+      int i_rank_best = 0;
+      for (int i_rank = 1; i_rank < BEAM; ++i_rank)
+      {
+         i_rank_best = (search.values[i_rank] > search.values[i_rank_best]) ? i_rank : i_rank_best;
+      }
+      i_best = root.ranked[i_rank_best];
+      score_best = search.values[i_rank_best];
+      depth_completed = depth;
+   }
+
+   out_decision->placement = root.placements[i_best];
+   out_decision->score = score_best;
+   out_decision->depth = depth_completed;
+   help_ai_decision_plan_moves(out_decision);
+
+   // Success
+   return true;
+}
+
+// AI - Input
+bool ai_controller_init(struct ai_controller_s * controller)
+{
+   if (NULL == controller) return false;
+
+   controller->active = false;
+   controller->input_last = 0;
+
+   // Success
+   return true;
+}
+
+bool ai_controller_follow(struct ai_controller_s * controller, const struct ai_decision_s * decision)
+{
+   if (NULL == controller || NULL == decision) return false;
+
+   controller->decision = *decision;
+   controller->active = true;
+
+   // Success
+   return true;
+}
+
+sim_input_t ai_controller_input(struct ai_controller_s * controller, const struct tetro_world_s * tetro)
+{
+   if (NULL == controller || NULL == tetro || false == controller->active) return 0;
+
+   // Rotate first - Rotation keys act on press so release every other tick
+   const struct ai_placement_s * TARGET = &controller->decision.placement;
+   sim_input_t input = 0;
+   if (tetro->rotation != TARGET->rotation)
+   {
+      const sim_input_t KEY_ROTATE = SIM_INPUT_KEY((TARGET->rotation_steps > 0) ? CUSTOM_KEY_A : CUSTOM_KEY_B);
+      input = (controller->input_last & KEY_ROTATE) ? 0 : KEY_ROTATE;
+   }
+   // Then shift - Held keys repeat on the simulation move timer
+   else if (tetro->tile_pos.x != TARGET->x)
+   {
+      input = SIM_INPUT_KEY((tetro->tile_pos.x < TARGET->x) ? CUSTOM_KEY_RIGHT : CUSTOM_KEY_LEFT);
+   }
+   // Then soft drop until placed
+   else
+   {
+      input = SIM_INPUT_KEY(CUSTOM_KEY_DOWN);
+   }
+
+   controller->input_last = input;
+   return input;
+}
@@ -0,0 +1,258 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sim.h"
+#include "player.h"
+#include "pool.h"
+#include "cli.h"
+
+// Constants
+const char * ARG_KEY_GAMES = "-games";
+const char * ARG_KEY_THREADS = "-threads";
+const char * ARG_KEY_SEED = "-seed";
+const char * ARG_KEY_TICKS = "-ticks";
+const char * ARG_KEY_RANDOMIZER = "-randomizer";
+const char * ARG_VALUE_RANDOMIZER_BAG = "bag";
+const char * ARG_KEY_SCALING = "-scaling";
+const char * ARG_KEY_PLAYER = "-player";
+const char * ARG_KEY_BUDGET_MS = "-budget-ms";
+
+// Batch - Games
+struct game_result_s {
+   int score;
+   int lines;
+   int level;
+   int pieces;
+   uint32_t ticks;
+   bool finished;
+};
+
+struct batch_s {
+   uint32_t seed_base;
+   enum tetro_randomizer_e randomizer;
+   enum player_kind_e player_kind;
+   uint32_t ticks_max;
+   // Lookahead search budget, zero keeps results independent of machine load and thread count
+   double time_budget_ms;
+   int game_count;
+   struct game_result_s * results;
+};
+
+void help_batch_run_game(void * context, int index, int worker)
+{
+   (void)worker;
+   struct batch_s * batch = context;
+   struct game_result_s * result = batch->results + index;
+   memset(result, 0, sizeof(*result));
+
+   // Every game has its own seed, independent of the worker running it
+   const uint32_t SEED = batch->seed_base + (uint32_t)index;
+   struct sim_s sim;
+   struct player_s player;
+   sim_init(&sim, SEED, batch->randomizer);
+   player_init(&player, batch->player_kind, SEED);
+   player.bot_search.time_budget_ms = batch->time_budget_ms;
+
+   // Play until the first game over or the tick limit
+   struct sim_events_s events;
+   while (sim_tick(&sim) < batch->ticks_max && false == result->finished)
+   {
+      sim_step(&sim, player_input(&player, &sim), &events);
+
+      for (int i_event = 0; i_event < events.count; ++i_event)
+      {
+         const struct sim_event_s * EVENT = events.list + i_event;
+         if (SIM_EVENT_TETRO_PLACED == EVENT->type)
+         {
+            ++result->pieces;
+         }
+         if (SIM_EVENT_GAME_STATE_CHANGED == EVENT->type && GAME_STATE_GAME_OVER_TRANSITION_FILL == EVENT->value)
+         {
+            result->finished = true;
+         }
+      }
+   }
+
+   const struct sim_stats_s STATS = sim_stats(&sim);
+   result->score = STATS.score;
+   result->lines = STATS.lines;
+   result->level = STATS.level;
+   result->ticks = sim_tick(&sim);
+}
+
+struct batch_summary_s {
+   int games_finished;
+   double ticks;
+   double score_total;
+   double lines_total;
+   double pieces_total;
+   int score_max;
+   int lines_max;
+   int level_max;
+   uint64_t results_hash;
+};
+
+struct batch_summary_s help_batch_summarize(const struct batch_s * batch)
+{
+   struct batch_summary_s summary;
+   memset(&summary, 0, sizeof(summary));
+
+   // FNV-1a over all results, identical across thread counts
+   summary.results_hash = 0xCBF29CE484222325ULL;
+   for (int i_game = 0; i_game < batch->game_count; ++i_game)
+   {
+      const struct game_result_s * RESULT = batch->results + i_game;
+      summary.games_finished += RESULT->finished ? 1 : 0;
+      summary.ticks += RESULT->ticks;
+      summary.score_total += RESULT->score;
+      summary.lines_total += RESULT->lines;
+      summary.pieces_total += RESULT->pieces;
+      summary.score_max = (RESULT->score > summary.score_max) ? RESULT->score : summary.score_max;
+      summary.lines_max = (RESULT->lines > summary.lines_max) ? RESULT->lines : summary.lines_max;
+      summary.level_max = (RESULT->level > summary.level_max) ? RESULT->level : summary.level_max;
+
+      const uint32_t FIELDS[] = { RESULT->score, RESULT->lines, RESULT->level, RESULT->pieces, RESULT->ticks, RESULT->finished };
+      for (size_t i_field = 0; i_field < sizeof(FIELDS) / sizeof(FIELDS[0]); ++i_field)
+      {
+         summary.results_hash ^= FIELDS[i_field];
+         summary.results_hash *= 0x100000001B3ULL;
+      }
+   }
+
+   return summary;
+}
+
+bool help_batch_run(struct batch_s * batch, int thread_count, double * out_time_elapsed)
+{
+   struct pool_s * pool = pool_create(thread_count);
+   if (NULL == pool) return false;
+
+   const double TIME_START = help_time_in_seconds();
+   const bool SUCCESS_RUN = pool_parallel_for(pool, batch->game_count, help_batch_run_game, batch);
+   *out_time_elapsed = help_time_in_seconds() - TIME_START;
+
+   pool_destroy(pool);
+   return SUCCESS_RUN;
+}
+
+// Logic - Main
+int main(int argc, char * argv[])
+{
+   const int HARDWARE_THREADS = pool_hardware_thread_count();
+   const char * ARG_RANDOMIZER = help_args_key_value_first(argc, argv, ARG_KEY_RANDOMIZER);
+
+   struct batch_s batch;
+   batch.seed_base = (uint32_t)help_args_unsigned_or(argc, argv, ARG_KEY_SEED, 1);
+   batch.randomizer = (ARG_RANDOMIZER && strcmp(ARG_RANDOMIZER, ARG_VALUE_RANDOMIZER_BAG) == 0) ? TETRO_RANDOMIZER_BAG_7 : TETRO_RANDOMIZER_CLASSIC;
+   batch.player_kind = PLAYER_KIND_SCRIPTED;
+   const char * ARG_PLAYER = help_args_key_value_first(argc, argv, ARG_KEY_PLAYER);
+   if (ARG_PLAYER && false == player_kind_from_name(ARG_PLAYER, &batch.player_kind))
+   {
+      printf("\nUnknown player [%s]", ARG_PLAYER);
+      return EXIT_FAILURE;
+   }
+   batch.ticks_max = (uint32_t)help_args_unsigned_or(argc, argv, ARG_KEY_TICKS, SIM_TICKS_PER_SECOND * 60 * 60);
+   const char * ARG_BUDGET_MS = help_args_key_value_first(argc, argv, ARG_KEY_BUDGET_MS);
+   batch.time_budget_ms = ARG_BUDGET_MS ? strtod(ARG_BUDGET_MS, NULL) : 0.0;
+   batch.game_count = (int)help_args_unsigned_or(argc, argv, ARG_KEY_GAMES, 1000);
+   batch.results = calloc((size_t)(batch.game_count > 0 ? batch.game_count : 1), sizeof(struct game_result_s));
+   if (NULL == batch.results)
+   {
+      printf("\nFailed to allocate results for %d games", batch.game_count);
+      return EXIT_FAILURE;
+   }
+   const int THREADS = (int)help_args_unsigned_or(argc, argv, ARG_KEY_THREADS, HARDWARE_THREADS);
+
+   // Log batch configuration
+   const int DW = 20;
+   printf("Batch Runner");
+   printf("\n\t%-*s: %d", DW, "games", batch.game_count);
+   printf("\n\t%-*s: %u", DW, "first seed", batch.seed_base);
+   printf("\n\t%-*s: %s", DW, "randomizer", (TETRO_RANDOMIZER_BAG_7 == batch.randomizer) ? "7-bag" : "classic");
+   printf("\n\t%-*s: %s", DW, "player", player_kind_name(batch.player_kind));
+   printf("\n\t%-*s: %u", DW, "tick limit per game", batch.ticks_max);
+   if (PLAYER_KIND_LOOKAHEAD == batch.player_kind)
+   {
+      printf("\n\t%-*s: %.1f ms%s", DW, "search budget", batch.time_budget_ms, (batch.time_budget_ms > 0.0) ? " (results depend on timing)" : " (depth limited)");
+   }
+   printf("\n\t%-*s: %d", DW, "hardware threads", HARDWARE_THREADS);
+
+   // Scaling from one thread up to the requested count
+   if (help_args_key_present(argc, argv, ARG_KEY_SCALING))
+   {
+      printf("\n\nScaling");
+      printf("\n\t%8s %10s %14s %16s %8s  %s", "threads", "time [s]", "games/s", "ticks/s", "speedup", "results");
+      double time_single = 0.0;
+      uint64_t results_hash_single = 0;
+      bool identical_all = true;
+      for (int threads = 1; ; threads = help_minmax_min_2i(threads * 2, THREADS))
+      {
+         double time_elapsed = 0.0;
+         if (false == help_batch_run(&batch, threads, &time_elapsed))
+         {
+            printf("\nFailed to run batch on %d threads", threads);
+            free(batch.results);
+            return EXIT_FAILURE;
+         }
+         const struct batch_summary_s SUMMARY = help_batch_summarize(&batch);
+         if (1 == threads)
+         {
+            time_single = time_elapsed;
+            results_hash_single = SUMMARY.results_hash;
+         }
+         identical_all = identical_all && (SUMMARY.results_hash == results_hash_single);
+         printf(
+            "\n\t%8d %10.3f %14.1f %16.0f %7.2fx  %s",
+            threads,
+            time_elapsed,
+            batch.game_count / time_elapsed,
+            SUMMARY.ticks / time_elapsed,
+            time_single / time_elapsed,
+            (SUMMARY.results_hash == results_hash_single) ? "identical" : "DIFFERENT"
+         );
+
+         if (threads >= THREADS) break;
+      }
+
+      // Same seeds must play the same games whatever the thread count
+      if (false == identical_all)
+      {
+         printf("\n\nResults differ between thread counts");
+         free(batch.results);
+         return EXIT_FAILURE;
+      }
+   }
+
+   // Batch on requested thread count
+   double time_elapsed = 0.0;
+   if (false == help_batch_run(&batch, THREADS, &time_elapsed))
+   {
+      printf("\nFailed to run batch on %d threads", THREADS);
+      free(batch.results);
+      return EXIT_FAILURE;
+   }
+   const struct batch_summary_s SUMMARY = help_batch_summarize(&batch);
+   const double GAMES = (batch.game_count > 0) ? batch.game_count : 1;
+
+   // Report
+   printf("\n\nResults (%d threads)", THREADS);
+   printf("\n\t%-*s: %d", DW, "games finished", SUMMARY.games_finished);
+   printf("\n\t%-*s: %.1f / %d", DW, "score mean/max", SUMMARY.score_total / GAMES, SUMMARY.score_max);
+   printf("\n\t%-*s: %.1f / %d", DW, "lines mean/max", SUMMARY.lines_total / GAMES, SUMMARY.lines_max);
+   printf("\n\t%-*s: %d", DW, "level max", SUMMARY.level_max);
+   printf("\n\t%-*s: %.1f", DW, "pieces mean", SUMMARY.pieces_total / GAMES);
+   printf("\n\t%-*s: %.0f", DW, "ticks", SUMMARY.ticks);
+   printf("\n\t%-*s: %016llx", DW, "results hash", (unsigned long long)SUMMARY.results_hash);
+   printf("\n\t%-*s: %.3f s", DW, "wall time", time_elapsed);
+   if (time_elapsed > 0.0)
+   {
+      printf("\n\t%-*s: %.1f", DW, "games per second", batch.game_count / time_elapsed);
+      printf("\n\t%-*s: %.0f", DW, "ticks per second", SUMMARY.ticks / time_elapsed);
+   }
+   printf("\n");
+
+   // Back to OS
+   free(batch.results);
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,319 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "capture.h"
+
+// Capture - Internals
+struct capture_slot_s {
+   unsigned long frame;
+   uint32_t tick;
+   uint64_t hash;
+   color_rgba_t * texels;
+};
+
+struct capture_s {
+   int width;
+   int height;
+   enum capture_format_e format;
+   FILE * file_hashes;
+   FILE * file_frames;
+   // >> Planes or bytes of one frame, only touched by the writer
+   uint8_t * conversion;
+   // Ring shared with the writer
+   struct capture_slot_s slots[CAPTURE_RING_CAPACITY];
+   int slot_head;
+   int slot_count;
+   bool shutdown;
+   pthread_mutex_t lock;
+   pthread_cond_t slot_filled;
+   pthread_cond_t slot_freed;
+   pthread_t writer;
+   bool is_writer_running;
+   // Statistics, only touched by the capturing thread
+   uint64_t hash_combined;
+   unsigned long frames;
+   unsigned long stalls;
+};
+
+void help_capture_write_frame(struct capture_s * instance, const struct capture_slot_s * slot)
+{
+   if (instance->file_hashes)
+   {
+      fprintf(instance->file_hashes, "%lu %u %016llx\n", slot->frame, slot->tick, (unsigned long long)slot->hash);
+   }
+   if (NULL == instance->file_frames) return;
+
+   // Rows are stored top down already
+   const int TEXEL_COUNT = instance->width * instance->height;
+   uint8_t * bytes = instance->conversion;
+   if (CAPTURE_FORMAT_RAW_RGBA == instance->format)
+   {
+      for (int i_texel = 0; i_texel < TEXEL_COUNT; ++i_texel)
+      {
+         const color_rgba_t TEXEL = slot->texels[i_texel];
+         bytes[i_texel * 4 + 0] = color_rgba_channel_red(TEXEL);
+         bytes[i_texel * 4 + 1] = color_rgba_channel_green(TEXEL);
+         bytes[i_texel * 4 + 2] = color_rgba_channel_blue(TEXEL);
+         bytes[i_texel * 4 + 3] = color_rgba_channel_alpha(TEXEL);
+      }
+      fwrite(bytes, 4, TEXEL_COUNT, instance->file_frames);
+      return;
+   }
+
+   // Y4M - BT.601 limited range, one full resolution plane each for Y, U and V
+   uint8_t * plane_y = bytes;
+   uint8_t * plane_u = bytes + TEXEL_COUNT;
+   uint8_t * plane_v = bytes + TEXEL_COUNT * 2;
+   for (int i_texel = 0; i_texel < TEXEL_COUNT; ++i_texel)
+   {
+      const color_rgba_t TEXEL = slot->texels[i_texel];
+      const int RED = color_rgba_channel_red(TEXEL);
+      const int GREEN = color_rgba_channel_green(TEXEL);
+      const int BLUE = color_rgba_channel_blue(TEXEL);
+      plane_y[i_texel] = (uint8_t)(((66 * RED + 129 * GREEN + 25 * BLUE + 128) >> 8) + 16);
+      plane_u[i_texel] = (uint8_t)(((-38 * RED - 74 * GREEN + 112 * BLUE + 128) >> 8) + 128);
+      plane_v[i_texel] = (uint8_t)(((112 * RED - 94 * GREEN - 18 * BLUE + 128) >> 8) + 128);
+   }
+   fputs("FRAME\n", instance->file_frames);
+   fwrite(bytes, 3, TEXEL_COUNT, instance->file_frames);
+}
+
+void * help_capture_writer(void * data)
+{
+   struct capture_s * instance = data;
+   for (;;)
+   {
+      // Wait for a filled slot, leave once drained after shutdown
+      pthread_mutex_lock(&instance->lock);
+      while (0 == instance->slot_count && false == instance->shutdown)
+      {
+         pthread_cond_wait(&instance->slot_filled, &instance->lock);
+      }
+      if (0 == instance->slot_count)
+      {
+         pthread_mutex_unlock(&instance->lock);
+         break;
+      }
+      const struct capture_slot_s * SLOT = instance->slots + instance->slot_head;
+      pthread_mutex_unlock(&instance->lock);
+
+      // Slot belongs to the writer until freed
+      help_capture_write_frame(instance, SLOT);
+
+      pthread_mutex_lock(&instance->lock);
+      instance->slot_head = (instance->slot_head + 1) % CAPTURE_RING_CAPACITY;
+      instance->slot_count -= 1;
+      pthread_cond_signal(&instance->slot_freed);
+      pthread_mutex_unlock(&instance->lock);
+   }
+
+   return NULL;
+}
+
+// Capture - API
+enum capture_format_e capture_format_from_path(const char * path)
+{
+   if (NULL == path) return CAPTURE_FORMAT_NONE;
+
+   const size_t LENGTH = strlen(path);
+   const char * EXTENSION_Y4M = ".y4m";
+   const size_t EXTENSION_LENGTH = strlen(EXTENSION_Y4M);
+   return (LENGTH >= EXTENSION_LENGTH && strcmp(path + LENGTH - EXTENSION_LENGTH, EXTENSION_Y4M) == 0) ? CAPTURE_FORMAT_Y4M : CAPTURE_FORMAT_RAW_RGBA;
+}
+
+const char * capture_format_name(enum capture_format_e format)
+{
+   switch (format)
+   {
+      case CAPTURE_FORMAT_NONE:
+         return "none";
+      case CAPTURE_FORMAT_RAW_RGBA:
+         return "raw rgba";
+      case CAPTURE_FORMAT_Y4M:
+         return "y4m 4:4:4";
+      default:
+         return "unknown";
+   }
+}
+
+struct capture_s * capture_create(const char * path_hashes, const char * path_frames, int width, int height, int frames_per_second)
+{
+   if (width <= 0 || height <= 0 || frames_per_second <= 0) return NULL;
+
+   struct capture_s * instance = malloc(sizeof(struct capture_s));
+   if (NULL == instance) return NULL;
+
+   instance->width = width;
+   instance->height = height;
+   instance->format = capture_format_from_path(path_frames);
+   instance->file_hashes = NULL;
+   instance->file_frames = NULL;
+   instance->conversion = NULL;
+   instance->slot_head = 0;
+   instance->slot_count = 0;
+   instance->shutdown = false;
+   instance->is_writer_running = false;
+   instance->hash_combined = 0xcbf29ce484222325ull;
+   instance->frames = 0;
+   instance->stalls = 0;
+   for (int i_slot = 0; i_slot < CAPTURE_RING_CAPACITY; ++i_slot)
+   {
+      instance->slots[i_slot].texels = NULL;
+   }
+
+   // Files first, nothing to unwind on the thread yet
+   bool success_files = true;
+   if (path_hashes)
+   {
+      instance->file_hashes = fopen(path_hashes, "w");
+      success_files = success_files && instance->file_hashes;
+   }
+   if (path_frames)
+   {
+      instance->file_frames = fopen(path_frames, "wb");
+      success_files = success_files && instance->file_frames;
+   }
+   if (instance->file_frames)
+   {
+      // Texels only travel through the ring when frames are written
+      const size_t TEXEL_COUNT = (size_t)width * height;
+      instance->conversion = malloc(TEXEL_COUNT * 4);
+      success_files = success_files && instance->conversion;
+      for (int i_slot = 0; i_slot < CAPTURE_RING_CAPACITY; ++i_slot)
+      {
+         instance->slots[i_slot].texels = malloc(TEXEL_COUNT * sizeof(color_rgba_t));
+         success_files = success_files && instance->slots[i_slot].texels;
+      }
+      if (success_files && CAPTURE_FORMAT_Y4M == instance->format)
+      {
+         fprintf(instance->file_frames, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, frames_per_second);
+      }
+   }
+   if (false == success_files)
+   {
+      capture_destroy(instance);
+      return NULL;
+   }
+
+   // Writer
+   pthread_mutex_init(&instance->lock, NULL);
+   pthread_cond_init(&instance->slot_filled, NULL);
+   pthread_cond_init(&instance->slot_freed, NULL);
+   if (0 != pthread_create(&instance->writer, NULL, help_capture_writer, instance))
+   {
+      pthread_cond_destroy(&instance->slot_freed);
+      pthread_cond_destroy(&instance->slot_filled);
+      pthread_mutex_destroy(&instance->lock);
+      capture_destroy(instance);
+      return NULL;
+   }
+   instance->is_writer_running = true;
+
+   // Success
+   return instance;
+}
+
+void * capture_destroy(struct capture_s * instance)
+{
+   if (NULL == instance) return NULL;
+
+   // Let the writer drain the ring
+   if (instance->is_writer_running)
+   {
+      pthread_mutex_lock(&instance->lock);
+      instance->shutdown = true;
+      pthread_cond_broadcast(&instance->slot_filled);
+      pthread_mutex_unlock(&instance->lock);
+      pthread_join(instance->writer, NULL);
+      pthread_cond_destroy(&instance->slot_freed);
+      pthread_cond_destroy(&instance->slot_filled);
+      pthread_mutex_destroy(&instance->lock);
+   }
+
+   if (instance->file_hashes)
+   {
+      fclose(instance->file_hashes);
+   }
+   if (instance->file_frames)
+   {
+      fclose(instance->file_frames);
+   }
+   for (int i_slot = 0; i_slot < CAPTURE_RING_CAPACITY; ++i_slot)
+   {
+      free(instance->slots[i_slot].texels);
+   }
+   free(instance->conversion);
+   free(instance);
+
+   return NULL;
+}
+
+bool capture_frame(struct capture_s * instance, const struct texture_rgba_s * frame, uint32_t tick)
+{
+   if (NULL == instance || NULL == frame) return false;
+   if (frame->width != instance->width || frame->height != instance->height) return false;
+
+   // Hash here, the writer only formats
+   const uint64_t HASH = capture_texture_hash(0xcbf29ce484222325ull, frame);
+   instance->hash_combined = (instance->hash_combined ^ HASH) * 0x100000001b3ull;
+
+   // Reserve the slot after the filled ones, a full ring waits for the writer
+   pthread_mutex_lock(&instance->lock);
+   if (CAPTURE_RING_CAPACITY == instance->slot_count)
+   {
+      instance->stalls += 1;
+   }
+   while (CAPTURE_RING_CAPACITY == instance->slot_count)
+   {
+      pthread_cond_wait(&instance->slot_freed, &instance->lock);
+   }
+   struct capture_slot_s * slot = instance->slots + ((instance->slot_head + instance->slot_count) % CAPTURE_RING_CAPACITY);
+   pthread_mutex_unlock(&instance->lock);
+
+   // Reserved slots are not read until counted
+   slot->frame = instance->frames;
+   slot->tick = tick;
+   slot->hash = HASH;
+   if (slot->texels)
+   {
+      memcpy(slot->texels, frame->texels, sizeof(color_rgba_t) * frame->width * frame->height);
+   }
+
+   pthread_mutex_lock(&instance->lock);
+   instance->slot_count += 1;
+   pthread_cond_signal(&instance->slot_filled);
+   pthread_mutex_unlock(&instance->lock);
+   instance->frames += 1;
+
+   return true;
+}
+
+uint64_t capture_texture_hash(uint64_t hash, const struct texture_rgba_s * texture)
+{
+   if (NULL == texture) return hash;
+
+   const int TEXEL_COUNT = texture->width * texture->height;
+   for (int i_texel = 0; i_texel < TEXEL_COUNT; ++i_texel)
+   {
+      hash ^= texture->texels[i_texel];
+      hash *= 0x100000001b3ull;
+   }
+   return hash;
+}
+
+uint64_t capture_hash_combined(const struct capture_s * instance)
+{
+   return instance ? instance->hash_combined : 0;
+}
+
+unsigned long capture_frame_count(const struct capture_s * instance)
+{
+   return instance ? instance->frames : 0;
+}
+
+unsigned long capture_stall_count(const struct capture_s * instance)
+{
+   return instance ? instance->stalls : 0;
+}
@@ -0,0 +1,55 @@
+#include <stdlib.h>
+#include <string.h>
+#include "helpers.h"
+#include "cli.h"
+
+// Helpers - Arguments
+const char * help_args_key_value_first(int argc, char * argv[], const char * key)
+{
+   if (NULL == argv || NULL == key) return NULL;
+
+   for (int i_key = 0; i_key < argc - 1; ++i_key)
+   {
+      if (strcmp(argv[i_key], key) == 0)
+      {
+         // Found matching key-value pair
+         return argv[i_key + 1];
+      }
+   }
+
+   // No match found
+   return NULL;
+}
+
+int help_args_key_index(int argc, char * argv[], const char * key)
+{
+   if (NULL == argv || NULL == key) return -1;
+
+   for (int i_key = 0; i_key < argc; ++i_key)
+   {
+      if (strcmp(argv[i_key], key) == 0)
+      {
+         return i_key;
+      }
+   }
+
+   // No match found
+   return -1;
+}
+
+bool help_args_key_present(int argc, char * argv[], const char * key)
+{
+   return help_args_key_index(argc, argv, key) >= 0;
+}
+
+unsigned long help_args_unsigned_or(int argc, char * argv[], const char * key, unsigned long fallback)
+{
+   const char * ARG_VALUE = help_args_key_value_first(argc, argv, key);
+   return ARG_VALUE ? strtoul(ARG_VALUE, NULL, 10) : fallback;
+}
+
+// Helpers - Time
+double help_time_in_seconds(void)
+{
+   return help_time_monotonic_in_seconds();
+}
@@ -0,0 +1,441 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sim.h"
+#include "replay.h"
+#include "player.h"
+#include "cli.h"
+
+// Constants
+const char * ARG_KEY_SEED = "-seed";
+const char * ARG_KEY_TICKS = "-ticks";
+const char * ARG_KEY_RANDOMIZER = "-randomizer";
+const char * ARG_VALUE_RANDOMIZER_BAG = "bag";
+const char * ARG_KEY_RECORD = "-record";
+const char * ARG_KEY_PLAY = "-play";
+const char * ARG_KEY_VALIDATE = "-validate";
+const char * ARG_KEY_SEEK = "-seek";
+const char * ARG_KEY_PLAYER = "-player";
+const char * ARG_KEY_BENCH_AI = "-bench-ai";
+const char * ARG_KEY_THREADS = "-threads";
+const char * ARG_KEY_DEPTH = "-depth";
+const char * ARG_KEY_BEAM = "-beam";
+const char * ARG_KEY_BUDGET_MS = "-budget-ms";
+const double AI_TICK_MS = 1000.0 / SIM_TICKS_PER_SECOND;
+
+// Helpers - Run statistics
+struct run_stats_s {
+   int games_finished;
+   int pieces_placed;
+};
+
+void help_run_stats_count(struct run_stats_s * run_stats, const struct sim_events_s * events)
+{
+   for (int i_event = 0; i_event < events->count; ++i_event)
+   {
+      const struct sim_event_s * EVENT = events->list + i_event;
+      if (SIM_EVENT_TETRO_PLACED == EVENT->type)
+      {
+         ++run_stats->pieces_placed;
+      }
+      if (SIM_EVENT_GAME_STATE_CHANGED == EVENT->type && GAME_STATE_GAME_OVER == EVENT->value)
+      {
+         ++run_stats->games_finished;
+      }
+   }
+}
+
+void help_run_report(const char * title, const struct sim_s * sim, uint32_t seed, enum tetro_randomizer_e randomizer, struct run_stats_s run_stats, double time_elapsed)
+{
+   const double TICKS_SIMULATED = (double)sim_tick(sim);
+   const double TIME_SIMULATED = TICKS_SIMULATED / SIM_TICKS_PER_SECOND;
+   const struct sim_stats_s STATS = sim_stats(sim);
+   const int DW = 20;
+   printf("%s", title);
+   printf("\n\t%-*s: %u", DW, "seed", seed);
+   printf("\n\t%-*s: %s", DW, "randomizer", (TETRO_RANDOMIZER_BAG_7 == randomizer) ? "7-bag" : "classic");
+   printf("\n\t%-*s: %.0f", DW, "ticks", TICKS_SIMULATED);
+   printf("\n\t%-*s: %d", DW, "games finished", run_stats.games_finished);
+   printf("\n\t%-*s: %d", DW, "pieces placed", run_stats.pieces_placed);
+   printf("\n\t%-*s: %d / %d / %d", DW, "score/lines/level", STATS.score, STATS.lines, STATS.level);
+   printf("\n\t%-*s: %016llx", DW, "state hash", (unsigned long long)sim_state_hash(sim));
+   printf("\n\t%-*s: %.3f s", DW, "wall time", time_elapsed);
+   if (time_elapsed > 0.0)
+   {
+      printf("\n\t%-*s: %.0f", DW, "ticks per second", TICKS_SIMULATED / time_elapsed);
+      printf("\n\t%-*s: %.0fx", DW, "real time factor", TIME_SIMULATED / time_elapsed);
+   }
+   printf("\n");
+}
+
+// Logic - Modes
+int help_mode_validate(int argc, char * argv[], int i_first_path)
+{
+   // Every argument after the key is a replay path
+   int replays_valid = 0;
+   int replays_invalid = 0;
+   double ticks_total = 0.0;
+   const double TIME_START = help_time_in_seconds();
+   for (int i_path = i_first_path; i_path < argc; ++i_path)
+   {
+      struct replay_s * replay = replay_open(argv[i_path]);
+      const bool VALID = replay && replay_validate(replay);
+      if (VALID)
+      {
+         ++replays_valid;
+         ticks_total += replay->header->tick_count;
+      }
+      else
+      {
+         ++replays_invalid;
+         printf("\nReplay [%s] failed validation", argv[i_path]);
+      }
+      replay_destroy(replay);
+   }
+   const double TIME_ELAPSED = help_time_in_seconds() - TIME_START;
+
+   // Report
+   const int DW = 20;
+   printf("\nReplay Validation");
+   printf("\n\t%-*s: %d", DW, "valid", replays_valid);
+   printf("\n\t%-*s: %d", DW, "invalid", replays_invalid);
+   printf("\n\t%-*s: %.0f", DW, "ticks", ticks_total);
+   printf("\n\t%-*s: %.3f s", DW, "wall time", TIME_ELAPSED);
+   if (TIME_ELAPSED > 0.0)
+   {
+      printf("\n\t%-*s: %.0f", DW, "ticks per second", ticks_total / TIME_ELAPSED);
+   }
+   printf("\n");
+
+   return (0 == replays_invalid) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int help_mode_seek(const char * path, uint32_t tick)
+{
+   struct replay_s * replay = replay_open(path);
+   if (NULL == replay)
+   {
+      return EXIT_FAILURE;
+   }
+
+   // Seek through keyframes
+   struct sim_s sim_seeked;
+   struct replay_cursor_s cursor_seeked;
+   const double TIME_START_SEEK = help_time_in_seconds();
+   const bool SUCCESS_SEEK = replay_seek(replay, &sim_seeked, &cursor_seeked, tick);
+   const double TIME_SEEK = help_time_in_seconds() - TIME_START_SEEK;
+
+   // Reference - Re-simulate from tick zero
+   struct sim_s sim_linear;
+   struct replay_cursor_s cursor_linear = replay_cursor_make();
+   sim_input_t input;
+   const double TIME_START_LINEAR = help_time_in_seconds();
+   replay_sim_init(replay, &sim_linear);
+   while (cursor_linear.tick < cursor_seeked.tick && replay_cursor_next(replay, &cursor_linear, &input))
+   {
+      sim_step(&sim_linear, input, NULL);
+   }
+   const double TIME_LINEAR = help_time_in_seconds() - TIME_START_LINEAR;
+
+   // Report
+   const bool MATCHES_LINEAR = SUCCESS_SEEK && (sim_state_hash(&sim_seeked) == sim_state_hash(&sim_linear));
+   const int DW = 20;
+   printf("Replay Seek");
+   printf("\n\t%-*s: %u", DW, "tick", cursor_seeked.tick);
+   printf("\n\t%-*s: %u every %u ticks", DW, "keyframes", replay->keyframe_count, replay->header->keyframe_interval);
+   printf("\n\t%-*s: %.3f ms", DW, "seek time", TIME_SEEK * 1000.0);
+   printf("\n\t%-*s: %.3f ms", DW, "from zero time", TIME_LINEAR * 1000.0);
+   printf("\n\t%-*s: %s", DW, "matches from zero", MATCHES_LINEAR ? "yes" : "no");
+   printf("\n");
+
+   replay_destroy(replay);
+   return MATCHES_LINEAR ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int help_mode_play(const char * path)
+{
+   struct replay_s * replay = replay_open(path);
+   if (NULL == replay)
+   {
+      return EXIT_FAILURE;
+   }
+
+   struct sim_s sim;
+   if (false == replay_sim_init(replay, &sim))
+   {
+      printf("\nFailed to initialize game simulation");
+      replay_destroy(replay);
+      return EXIT_FAILURE;
+   }
+
+   // Play back unthrottled
+   struct sim_events_s events;
+   struct run_stats_s run_stats = { 0 };
+   struct replay_cursor_s cursor = replay_cursor_make();
+   sim_input_t input;
+   const double TIME_START = help_time_in_seconds();
+   while (replay_cursor_next(replay, &cursor, &input))
+   {
+      sim_step(&sim, input, &events);
+      help_run_stats_count(&run_stats, &events);
+   }
+   const double TIME_ELAPSED = help_time_in_seconds() - TIME_START;
+
+   help_run_report("Replay Playback", &sim, replay->header->seed, (enum tetro_randomizer_e)replay->header->randomizer, run_stats, TIME_ELAPSED);
+   const bool MATCHES_RECORDING = (sim_state_hash(&sim) == replay->header->final_state_hash);
+   printf("\t%-*s: %s\n", 20, "matches recording", MATCHES_RECORDING ? "yes" : "no");
+
+   replay_destroy(replay);
+   return MATCHES_RECORDING ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int help_mode_player(uint32_t seed, enum tetro_randomizer_e randomizer, enum player_kind_e player_kind, const struct ai_search_config_s * search, struct pool_s * pool, unsigned long ticks, const char * record_path)
+{
+   // Simulation
+   struct sim_s sim;
+   if (false == sim_init(&sim, seed, randomizer))
+   {
+      printf("\nFailed to initialize game simulation");
+      return EXIT_FAILURE;
+   }
+   struct player_s player;
+   player_init(&player, player_kind, seed);
+   player.bot_search = *search;
+   player.bot_pool = pool;
+
+   // Optional recording
+   struct replay_recorder_s * recorder = NULL;
+   if (record_path)
+   {
+      recorder = replay_recorder_create(seed, randomizer, REPLAY_KEYFRAME_INTERVAL_DEFAULT);
+      if (NULL == recorder) return EXIT_FAILURE;
+   }
+
+   // Run unthrottled
+   struct sim_events_s events;
+   struct run_stats_s run_stats = { 0 };
+   const double TIME_START = help_time_in_seconds();
+   for (unsigned long tick = 0; tick < ticks && false == sim_close_requested(&sim); ++tick)
+   {
+      const sim_input_t INPUT = player_input(&player, &sim);
+      if (recorder)
+      {
+         replay_recorder_push(recorder, &sim, INPUT);
+      }
+
+      sim_step(&sim, INPUT, &events);
+      help_run_stats_count(&run_stats, &events);
+   }
+   const double TIME_ELAPSED = help_time_in_seconds() - TIME_START;
+
+   help_run_report("Headless Simulation", &sim, seed, randomizer, run_stats, TIME_ELAPSED);
+   printf("\t%-*s: %s\n", 20, "player", player_kind_name(player_kind));
+
+   // Persist recording
+   bool success_record = true;
+   if (recorder)
+   {
+      success_record = replay_recorder_write(recorder, record_path, sim_state_hash(&sim));
+      printf("\t%-*s: %s (%u runs)\n", 20, "recorded", record_path, recorder->header.run_count);
+      replay_recorder_destroy(recorder);
+   }
+
+   return success_record ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int help_mode_bench_ai(uint32_t seed, enum tetro_randomizer_e randomizer, const struct ai_search_config_s * search, struct pool_s * pool, unsigned long ticks)
+{
+   // Collect realistic boards by letting the bot play
+   struct sim_s sim;
+   if (false == sim_init(&sim, seed, randomizer))
+   {
+      printf("\nFailed to initialize game simulation");
+      return EXIT_FAILURE;
+   }
+   struct player_s player;
+   player_init(&player, PLAYER_KIND_BOT, seed);
+
+   const int POSITION_CAPACITY = 4096;
+   struct ai_position_s {
+      struct play_field_s play_field;
+      struct tetro_world_s tetro;
+      struct tetro_world_s tetro_next;
+   } * positions = malloc(sizeof(*positions) * POSITION_CAPACITY);
+   if (NULL == positions)
+   {
+      printf("\nFailed to allocate benchmark positions");
+      return EXIT_FAILURE;
+   }
+   int position_count = 0;
+   for (unsigned long tick = 0; tick < ticks && position_count < POSITION_CAPACITY; ++tick)
+   {
+      // Every fresh plan marks a new tetro in control
+      const bool PLANNING = (GAME_STATE_CONTROL == sim_game_state(&sim) && false == player.bot_controller.active);
+      if (PLANNING)
+      {
+         positions[position_count].play_field = *sim_play_field(&sim);
+         positions[position_count].tetro = *sim_tetro_active(&sim);
+         positions[position_count].tetro_next = *sim_tetro_next(&sim);
+         ++position_count;
+      }
+      sim_step(&sim, player_input(&player, &sim), NULL);
+   }
+   if (0 == position_count)
+   {
+      printf("\nNo positions collected within %lu ticks", ticks);
+      free(positions);
+      return EXIT_FAILURE;
+   }
+
+   // Decide over all positions repeatedly for a fixed wall time
+   const double TIME_TARGET = 1.0;
+   struct ai_weights_s weights = ai_weights_make_default();
+   struct ai_s ai;
+   ai_init(&ai, ai_heuristic_weighted, &weights);
+   double score_sum = 0.0;
+   int passes = 0;
+   const double TIME_START = help_time_in_seconds();
+   double time_elapsed = 0.0;
+   do
+   {
+      for (int i_position = 0; i_position < position_count; ++i_position)
+      {
+         struct ai_decision_s decision;
+         if (ai_decide(&ai, &positions[i_position].play_field, &positions[i_position].tetro, &decision))
+         {
+            score_sum += decision.score;
+         }
+      }
+      ++passes;
+      time_elapsed = help_time_in_seconds() - TIME_START;
+   } while (time_elapsed < TIME_TARGET);
+
+   // Report
+   const struct sim_stats_s STATS = sim_stats(&sim);
+   const int DW = 20;
+   printf("AI Benchmark");
+   printf("\n\t%-*s: %u", DW, "seed", seed);
+   printf("\n\t%-*s: %d", DW, "positions", position_count);
+   printf("\n\t%-*s: %d", DW, "lines while playing", STATS.lines);
+   printf("\n\t%-*s: %d", DW, "passes", passes);
+   printf("\n\t%-*s: %llu", DW, "decisions", (unsigned long long)ai.decisions);
+   printf("\n\t%-*s: %llu", DW, "placements", (unsigned long long)ai.placements_evaluated);
+   printf("\n\t%-*s: %.1f", DW, "placements/decision", (double)ai.placements_evaluated / (double)ai.decisions);
+   printf("\n\t%-*s: %.3f s", DW, "wall time", time_elapsed);
+   printf("\n\t%-*s: %.0f", DW, "decisions/s", (double)ai.decisions / time_elapsed);
+   printf("\n\t%-*s: %.0f", DW, "placements/s", (double)ai.placements_evaluated / time_elapsed);
+   printf("\n\t%-*s: %.3f us", DW, "per decision", 1000000.0 * time_elapsed / (double)ai.decisions);
+   printf("\n\t%-*s: %.3f", DW, "checksum", score_sum / (double)passes);
+   printf("\n");
+
+   // Lookahead once per position, timing every decision against one tick
+   struct ai_s ai_lookahead;
+   ai_init(&ai_lookahead, ai_heuristic_weighted, &weights);
+   double latency_sum = 0.0;
+   double latency_max = 0.0;
+   double overrun_max = 0.0;
+   int decisions_over_tick = 0;
+   int depth_sum = 0;
+   int depth_full = 0;
+   int lookahead_count = 0;
+   const double TIME_START_LOOKAHEAD = help_time_in_seconds();
+   for (int i_position = 0; i_position < position_count && help_time_in_seconds() - TIME_START_LOOKAHEAD < TIME_TARGET * 4.0; ++i_position)
+   {
+      struct ai_decision_s decision;
+      const double TIME_DECISION = help_time_in_seconds();
+      if (false == ai_decide_lookahead(&ai_lookahead, pool, search, &positions[i_position].play_field, &positions[i_position].tetro, &positions[i_position].tetro_next, &decision)) continue;
+      const double LATENCY_MS = (help_time_in_seconds() - TIME_DECISION) * 1000.0;
+
+      latency_sum += LATENCY_MS;
+      latency_max = (LATENCY_MS > latency_max) ? LATENCY_MS : latency_max;
+      if (search->time_budget_ms > 0.0 && LATENCY_MS - search->time_budget_ms > overrun_max)
+      {
+         overrun_max = LATENCY_MS - search->time_budget_ms;
+      }
+      decisions_over_tick += (LATENCY_MS > AI_TICK_MS) ? 1 : 0;
+      depth_sum += decision.depth;
+      depth_full += (decision.depth == search->depth) ? 1 : 0;
+      ++lookahead_count;
+   }
+   const double TIME_LOOKAHEAD = help_time_in_seconds() - TIME_START_LOOKAHEAD;
+   printf("AI Lookahead Benchmark");
+   printf("\n\t%-*s: %d / %d / %.1f ms", DW, "depth/beam/budget", search->depth, search->beam_width, search->time_budget_ms);
+   printf("\n\t%-*s: %d", DW, "threads", pool ? pool_thread_count(pool) : 1);
+   printf("\n\t%-*s: %d", DW, "decisions", lookahead_count);
+   if (lookahead_count > 0)
+   {
+      printf("\n\t%-*s: %.1f", DW, "mean depth", (double)depth_sum / lookahead_count);
+      printf("\n\t%-*s: %d", DW, "full depth", depth_full);
+      printf("\n\t%-*s: %.0f", DW, "placements/s", (double)ai_lookahead.placements_evaluated / TIME_LOOKAHEAD);
+      printf("\n\t%-*s: %.3f ms", DW, "mean latency", latency_sum / lookahead_count);
+      printf("\n\t%-*s: %.3f ms", DW, "max latency", latency_max);
+      printf("\n\t%-*s: %.3f ms", DW, "worst overrun", overrun_max);
+      printf("\n\t%-*s: %d", DW, "over one tick", decisions_over_tick);
+   }
+   printf("\n");
+
+   free(positions);
+   return EXIT_SUCCESS;
+}
+
+// Logic - Main
+int main(int argc, char * argv[])
+{
+   const uint32_t SEED = (uint32_t)help_args_unsigned_or(argc, argv, ARG_KEY_SEED, 1);
+   const unsigned long TICKS = help_args_unsigned_or(argc, argv, ARG_KEY_TICKS, SIM_TICKS_PER_SECOND * 60 * 60);
+   const char * ARG_RANDOMIZER = help_args_key_value_first(argc, argv, ARG_KEY_RANDOMIZER);
+   const enum tetro_randomizer_e RANDOMIZER = (ARG_RANDOMIZER && strcmp(ARG_RANDOMIZER, ARG_VALUE_RANDOMIZER_BAG) == 0) ? TETRO_RANDOMIZER_BAG_7 : TETRO_RANDOMIZER_CLASSIC;
+   // Batch replay validation
+   const int I_ARG_VALIDATE = help_args_key_index(argc, argv, ARG_KEY_VALIDATE);
+   if (I_ARG_VALIDATE >= 0)
+   {
+      return help_mode_validate(argc, argv, I_ARG_VALIDATE + 1);
+   }
+
+   // Replay playback
+   const char * ARG_PLAY = help_args_key_value_first(argc, argv, ARG_KEY_PLAY);
+   const char * ARG_SEEK = help_args_key_value_first(argc, argv, ARG_KEY_SEEK);
+   if (ARG_PLAY && ARG_SEEK)
+   {
+      return help_mode_seek(ARG_PLAY, (uint32_t)strtoul(ARG_SEEK, NULL, 10));
+   }
+   if (ARG_PLAY)
+   {
+      return help_mode_play(ARG_PLAY);
+   }
+
+   const char * ARG_PLAYER = help_args_key_value_first(argc, argv, ARG_KEY_PLAYER);
+   enum player_kind_e player_kind = PLAYER_KIND_SCRIPTED;
+   if (ARG_PLAYER && false == player_kind_from_name(ARG_PLAYER, &player_kind))
+   {
+      printf("\nUnknown player [%s]", ARG_PLAYER);
+      return EXIT_FAILURE;
+   }
+
+   // Lookahead search settings
+   struct ai_search_config_s search = ai_search_config_make_default();
+   search.depth = (int)help_args_unsigned_or(argc, argv, ARG_KEY_DEPTH, (unsigned long)search.depth);
+   search.beam_width = (int)help_args_unsigned_or(argc, argv, ARG_KEY_BEAM, (unsigned long)search.beam_width);
+   // >> Only the benchmark measures the budget, runs and recordings search depth limited to stay reproducible
+   const bool BENCH_AI = (help_args_key_index(argc, argv, ARG_KEY_BENCH_AI) >= 0);
+   const char * ARG_BUDGET_MS = help_args_key_value_first(argc, argv, ARG_KEY_BUDGET_MS);
+   search.time_budget_ms = ARG_BUDGET_MS ? strtod(ARG_BUDGET_MS, NULL) : (BENCH_AI ? search.time_budget_ms : 0.0);
+
+   // Lookahead search pool, none searches on the calling thread
+   const int THREADS = (int)help_args_unsigned_or(argc, argv, ARG_KEY_THREADS, (unsigned long)pool_hardware_thread_count());
+   struct pool_s * pool = ((BENCH_AI || PLAYER_KIND_LOOKAHEAD == player_kind) && THREADS > 1) ? pool_create(THREADS) : NULL;
+
+   // Placement search benchmark
+   if (BENCH_AI)
+   {
+      const int EXIT_CODE = help_mode_bench_ai(SEED, RANDOMIZER, &search, pool, TICKS);
+      pool_destroy(pool);
+      return EXIT_CODE;
+   }
+
+   // Scripted or bot player
+   const int EXIT_CODE = help_mode_player(SEED, RANDOMIZER, player_kind, &search, pool, TICKS, help_args_key_value_first(argc, argv, ARG_KEY_RECORD));
+   pool_destroy(pool);
+   return EXIT_CODE;
+}
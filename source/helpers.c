@@ -0,0 +1,116 @@
+#include <time.h>
+#include "helpers.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Helpers - Vectors
+struct vec_2i_s vec_2i_make_xy(int x, int y)
+{
+   struct vec_2i_s v;
+
+   v.x = x;
+   v.y = y;
+
+   return v;
+}
+
+bool vec_2i_equals_xy(struct vec_2i_s v, int x, int y)
+{
+   return (v.x == x && v.y == y);
+}
+
+struct vec_2i_s vec_2i_make_from_scaled(struct vec_2i_s v, int scale)
+{
+   return vec_2i_make_xy(
+      v.x * scale,
+      v.y * scale
+   );
+}
+
+// Helpers - Min Max
+int help_minmax_min_2i(int a, int b)
+{
+   return (a < b) ? a : b;
+}
+
+int help_minmax_max_2i(int a, int b)
+{
+   return (a > b) ? a : b;
+}
+
+// Helpers - Limits
+float help_limit_clamp_f(float floor, float value, float ceiling)
+{
+   if (value < floor)
+   {
+      return floor;
+   }
+   else if (value > ceiling)
+   {
+      return ceiling;
+   }
+   else
+   {
+      return value;
+   }
+}
+
+int help_limit_clamp_i(int floor, int value, int ceiling)
+{
+   if (value < floor)
+   {
+      return floor;
+   }
+   else if (value > ceiling)
+   {
+      return ceiling;
+   }
+   else
+   {
+      return value;
+   }
+}
+
+// Helpers - Regions
+struct region_2d_s region_2d_s_make(int min_x, int min_y, int width, int height)
+{
+   struct region_2d_s region;
+
+   region.min = vec_2i_make_xy(min_x, min_y);
+   region.size = vec_2i_make_xy(width, height);
+   region.max = vec_2i_make_xy(
+      min_x + width - 1,
+      min_y + height - 1
+   );
+
+   return region;
+}
+
+// Helpers - Bounds
+bool help_bounds_out_of_region(int min_x, int min_y, int width, int height, int x, int y)
+{
+   const struct region_2d_s REGION = region_2d_s_make(min_x, min_y, width, height);
+   return (
+      x < REGION.min.x ||
+      x > REGION.max.x ||
+      y < REGION.min.y ||
+      y > REGION.max.y
+   ) ? true : false;
+}
+
+// Helpers - Time
+double help_time_monotonic_in_seconds(void)
+{
+#ifdef _WIN32
+   LARGE_INTEGER frequency, counter;
+   QueryPerformanceFrequency(&frequency);
+   QueryPerformanceCounter(&counter);
+   return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (double)now.tv_sec + ((double)now.tv_nsec / 1000000000.0);
+#endif
+}
@@ -5,103 +5,46 @@
 #include <time.h>
 #include <ctype.h>
 #include <math.h>
+#include <stdatomic.h>
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
+#include "helpers.h"
+#include "cli.h"
+#include "sim.h"
+#include "replay.h"
+#include "player.h"
+#include "render.h"
+#include "capture.h"
 
 // Constants
 const char * ARG_KEY_DIR_ABS_RES = "-abs_res_dir";
-const bool CONFIG_DO_RENDER_TETRO_COLLISION_MASKS = false;
 const bool CONFIG_DO_SET_RANDOM_SEED = true;
-
-// Helpers - Arguments
-const char * help_args_key_value_first(int argc, char * argv[], const char * key)
-{
-   if (NULL == argv || NULL == key) return NULL;
-
-   for (int i_key = 0; i_key < argc; ++i_key)
-   {
-      const char * ARG_KEY = argv[i_key];
-      if (strcmp(ARG_KEY, key) == 0)
-      {
-         // Found matching key-value pair
-         const char * ARG_VALUE = argv[i_key + 1];
-         return ARG_VALUE;
-      }
-   }
-
-   // No match found
-   return NULL;
-}
-
-// Helpers - Colors
-typedef uint32_t color_rgba_t;
-
-color_rgba_t color_rgba_make_rgba(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
-{
-   color_rgba_t color = 0x00;
-
-   color |= red;
-   color <<= 8;
-
-   color |= green;
-   color <<= 8;
-
-   color |= blue;
-   color <<= 8;
-
-   color |= alpha;
-
-   return color;
-}
-
-uint8_t color_rgba_channel_red(color_rgba_t color)
-{
-   return (uint8_t)(color >> 24);
-}
-
-uint8_t color_rgba_channel_green(color_rgba_t color)
-{
-   return (uint8_t)(color >> 16);
-}
-
-uint8_t color_rgba_channel_blue(color_rgba_t color)
-{
-   return (uint8_t)(color >> 8);
-}
-
-uint8_t color_rgba_channel_alpha(color_rgba_t color)
-{
-   return (uint8_t)color;
-}
-
-// Helpers - Vectors
-struct vec_2i_s {
-   int x;
-   int y;
-};
-
-struct vec_2i_s vec_2i_make_xy(int x, int y)
-{
-   struct vec_2i_s v;
-
-   v.x = x;
-   v.y = y;
-
-   return v;
-}
-
-bool vec_2i_equals_xy(struct vec_2i_s v, int x, int y)
-{
-   return (v.x == x && v.y == y);
-}
-
-struct vec_2i_s vec_2i_make_from_scaled(struct vec_2i_s v, int scale)
-{
-   return vec_2i_make_xy(
-      v.x * scale,
-      v.y * scale
-   );
-}
+const char * ARG_KEY_SEED = "-seed";
+const char * ARG_KEY_RANDOMIZER = "-randomizer";
+const char * ARG_VALUE_RANDOMIZER_BAG = "bag";
+const char * ARG_KEY_RECORD = "-record";
+const char * ARG_KEY_PLAY = "-play";
+const char * ARG_KEY_BOT = "-bot";
+const char * ARG_KEY_BUDGET_MS = "-budget-ms";
+const char * ARG_KEY_ZERO_COPY = "-zero-copy";
+const char * ARG_KEY_INDEXED = "-indexed";
+const char * ARG_KEY_SURFACE = "-surface";
+const char * ARG_KEY_SIM_THREAD = "-sim-thread";
+const char * ARG_KEY_PACING = "-pacing";
+const char * ARG_VALUE_PACING_LOW_LATENCY = "low-latency";
+const char * ARG_KEY_LATENCY_LOG = "-latency-log";
+const char * ARG_KEY_CAPTURE = "-capture";
+const char * ARG_KEY_CAPTURE_FRAMES = "-capture-frames";
+const char * ARG_KEY_CAPTURE_TICKS = "-capture-ticks";
+const char * ARG_KEY_GEOMETRY = "-geometry";
+const char * ARG_KEY_BACKEND_BENCH = "-backend-bench";
+// Ticks captured without replay or explicit count, one minute
+const uint32_t CAPTURE_TICKS_DEFAULT = SIM_TICKS_PER_SECOND * 60;
+const int REPLAY_SPEEDS[] = { 1, 2, 8, 0 };
+const int REPLAY_SEEK_STEP_TICKS = SIM_TICKS_PER_SECOND * 10;
+const double REPLAY_UNTHROTTLED_FRAME_BUDGET = 0.012;
+// Longest idle sleep, bounds the ticks caught up on waking when no timer is pending
+const int IDLE_WAIT_MAX_MS = 250;
 
 // Helpers - SDL
 struct vec_2i_s help_sdl_window_size(SDL_Window * sdl_window)
@@ -135,198 +78,157 @@ double help_sdl_time_in_seconds(void)
    return (double)SDL_GetTicksNS() * NANO_SEC_TO_SEC;
 }
 
-// Helpers - Min Max
-int help_minmax_min_2i(int a, int b)
-{
-   return (a < b) ? a : b;
-}
-
-int help_minmax_max_2i(int a, int b)
-{
-   return (a > b) ? a : b;
-}
-
-// Helpers - Virtual
-int help_virtual_max_render_scale(struct vec_2i_s actual_window_size, struct vec_2i_s virtual_window_size)
-{
-   const int MAX_RENDER_SCALE_HORIZONTAL = actual_window_size.x / virtual_window_size.x;
-   const int MAX_RENDER_SCALE_VERTICAL = actual_window_size.y / virtual_window_size.y;
-   return help_minmax_min_2i(MAX_RENDER_SCALE_HORIZONTAL, MAX_RENDER_SCALE_VERTICAL);
-}
-
-SDL_FRect help_virtual_max_render_scale_region(struct vec_2i_s actual_window_size, struct vec_2i_s virtual_window_size)
-{
-   const int MAX_RENDER_SCALE = help_virtual_max_render_scale(actual_window_size, virtual_window_size);
-   const struct vec_2i_s VIRTUAL_WINDOW_SIZE_SCALED = vec_2i_make_from_scaled(virtual_window_size, MAX_RENDER_SCALE);
-   return help_sdl_f_rect_make(
-      (actual_window_size.x - VIRTUAL_WINDOW_SIZE_SCALED.x) * 0.5f,
-      (actual_window_size.y - VIRTUAL_WINDOW_SIZE_SCALED.y) * 0.5f,
-      VIRTUAL_WINDOW_SIZE_SCALED.x,
-      VIRTUAL_WINDOW_SIZE_SCALED.y
-   );
-}
-
-// Helpers - Texture
-struct texture_rgba_s {
-   color_rgba_t * texels;
-   int width;
-   int height;
-};
-
-int help_texture_rgba_texel_count(struct texture_rgba_s * instance)
-{
-   return instance ? (instance->width * instance->height) : 0;
-}
-
-struct vec_2i_s help_texture_rgba_size(struct texture_rgba_s * instance)
-{
-   return instance ? vec_2i_make_xy(instance->width, instance->height) : vec_2i_make_xy(0, 0);
-}
-
-void * help_texture_rgba_destroy(struct texture_rgba_s * instance)
+bool help_sdl_format_color_packing(SDL_PixelFormat format, enum color_packing_e * out_packing)
 {
-   if (instance)
+   // Packed 32 bit formats only, padding bytes stand in for alpha
+   switch (format)
    {
-      free(instance->texels);
+      case SDL_PIXELFORMAT_RGBA8888:
+      case SDL_PIXELFORMAT_RGBX8888:
+         *out_packing = COLOR_PACKING_RGBA;
+         return true;
+      case SDL_PIXELFORMAT_ARGB8888:
+      case SDL_PIXELFORMAT_XRGB8888:
+         *out_packing = COLOR_PACKING_ARGB;
+         return true;
+      case SDL_PIXELFORMAT_BGRA8888:
+      case SDL_PIXELFORMAT_BGRX8888:
+         *out_packing = COLOR_PACKING_BGRA;
+         return true;
+      case SDL_PIXELFORMAT_ABGR8888:
+      case SDL_PIXELFORMAT_XBGR8888:
+         *out_packing = COLOR_PACKING_ABGR;
+         return true;
+      default:
+         return false;
    }
-
-   free(instance);
-
-   return NULL;
 }
 
-bool help_texture_rgba_clear(struct texture_rgba_s * instance, color_rgba_t clear_color)
+SDL_PixelFormat help_sdl_renderer_negotiate_format(SDL_Renderer * sdl_renderer, enum color_packing_e * out_packing)
 {
-   if (NULL == instance) return false;
-
-   for (int i = 0; i < help_texture_rgba_texel_count(instance); ++i)
+   // Renderers list their preferred texture format first
+   const SDL_PixelFormat * FORMATS = SDL_GetPointerProperty(SDL_GetRendererProperties(sdl_renderer), SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, NULL);
+   for (int i_format = 0; FORMATS && SDL_PIXELFORMAT_UNKNOWN != FORMATS[i_format]; ++i_format)
    {
-      instance->texels[i] = clear_color;
+      if (help_sdl_format_color_packing(FORMATS[i_format], out_packing))
+      {
+         return FORMATS[i_format];
+      }
    }
 
-   return true;
-}
-
-bool help_texture_rgba_coords_out_of_bounds(struct texture_rgba_s * instance, int x, int y)
-{
-   return (
-      NULL == instance ||
-      x < 0 ||
-      x >= instance->width ||
-      y < 0 ||
-      y >= instance->height
-   ) ? true : false;
+   // No packed match - Renderer converts from our default
+   *out_packing = COLOR_PACKING_RGBA;
+   return SDL_PIXELFORMAT_RGBA8888;
 }
 
-bool help_texture_rgba_2d_coords_to_linear(struct texture_rgba_s * instance, int x, int y, int * out_linear)
+bool help_sdl_window_surface_present(SDL_Window * sdl_window, const struct texture_rgba_s * tex_virtual, SDL_Surface ** surface_bordered, struct vec_2i_s * surface_bordered_size)
 {
-   if (
-      NULL == instance ||
-      NULL == out_linear ||
-      help_texture_rgba_coords_out_of_bounds(instance, x, y)
-   ) return false;
-
-   *out_linear = (y * instance->width) + x;
-   return true;
-}
+   SDL_Surface * sdl_surface = SDL_GetWindowSurface(sdl_window);
+   if (NULL == sdl_surface) return false;
 
-bool help_texture_rgba_plot_texel(struct texture_rgba_s * instance, int x, int y, color_rgba_t color)
-{
-   const int FLIPPED_Y = help_texture_rgba_size(instance).y - 1 - y;
+   // Too small for even one texel per texel - Nothing to show
+   if (help_upscale_scale_max(sdl_surface->w, sdl_surface->h, tex_virtual->width, tex_virtual->height) < 1) return true;
 
-   int texel_index;
-   if (help_texture_rgba_2d_coords_to_linear(instance, x, FLIPPED_Y, &texel_index))
+   // Letterbox borders stay put until the window hands out another surface
+   const bool DO_BORDERS = (sdl_surface != *surface_bordered || false == vec_2i_equals_xy(*surface_bordered_size, sdl_surface->w, sdl_surface->h));
+   if (SDL_MUSTLOCK(sdl_surface) && !SDL_LockSurface(sdl_surface)) return false;
+   const bool SUCCESS_UPSCALE = help_texture_rgba_upscale(
+      tex_virtual,
+      sdl_surface->pixels,
+      sdl_surface->pitch,
+      sdl_surface->w,
+      sdl_surface->h,
+      DO_BORDERS,
+      color_rgba_make_rgba(0x00, 0x00, 0x00, 0xFF),
+      help_upscale_kernel_best()
+   );
+   if (SDL_MUSTLOCK(sdl_surface))
    {
-      instance->texels[texel_index] = color;
-      return true;
+      SDL_UnlockSurface(sdl_surface);
    }
+   *surface_bordered = SUCCESS_UPSCALE ? sdl_surface : NULL;
+   *surface_bordered_size = vec_2i_make_xy(sdl_surface->w, sdl_surface->h);
 
-   return false;
+   // Success
+   return SUCCESS_UPSCALE && SDL_UpdateWindowSurface(sdl_window);
 }
 
-void help_texture_rgba_plot_aabb(struct texture_rgba_s * instance, int min_x, int min_y, int width, int height, color_rgba_t color)
-{
-   for (int box_y = min_y; box_y < (min_y + height); ++box_y)
-   {
-      for (int box_x = min_x; box_x < (min_x + width); ++box_x)
-      {
-         help_texture_rgba_plot_texel(instance, box_x, box_y, color);
-      }
-   }
-}
+// Geometry vertices are handed to the renderer as they are
+SDL_COMPILE_TIME_ASSERT(render_vertex_layout, sizeof(struct render_vertex_s) == sizeof(SDL_Vertex));
 
-void help_texture_rgba_plot_horizontal_line(struct texture_rgba_s * instance, int min_x, int width, int y, color_rgba_t color)
+SDL_Texture * help_sdl_geometry_atlas_upload(SDL_Renderer * sdl_renderer, const struct texture_rgba_s * atlas, SDL_PixelFormat format)
 {
-   for (int sx = min_x; sx < (min_x + width); ++sx)
-   {
-      help_texture_rgba_plot_texel(instance, sx, y, color);
-   }
-}
+   SDL_Texture * sdl_texture = SDL_CreateTexture(sdl_renderer, format, SDL_TEXTUREACCESS_STATIC, atlas->width, atlas->height);
+   if (NULL == sdl_texture) return NULL;
 
-void help_texture_rgba_plot_vertical_line(struct texture_rgba_s * instance, int min_y, int height, int x, color_rgba_t color)
-{
-   for (int sy = min_y; sy < (min_y + height); ++sy)
+   // Uploaded once - Texels sampled whole, transparent ones blended away
+   const bool SUCCESS_ATLAS = (
+      SDL_UpdateTexture(sdl_texture, NULL, atlas->texels, sizeof(color_rgba_t) * atlas->width) &&
+      SDL_SetTextureScaleMode(sdl_texture, SDL_SCALEMODE_NEAREST) &&
+      SDL_SetTextureBlendMode(sdl_texture, SDL_BLENDMODE_BLEND)
+   );
+   if (false == SUCCESS_ATLAS)
    {
-      help_texture_rgba_plot_texel(instance, x, sy, color);
+      SDL_DestroyTexture(sdl_texture);
+      return NULL;
    }
+
+   // Success
+   return sdl_texture;
 }
 
-void help_texture_rgba_plot_aabb_outline(struct texture_rgba_s * instance, int min_x, int min_y, int width, int height, color_rgba_t color)
+bool help_sdl_render_geometry(SDL_Renderer * sdl_renderer, SDL_Texture * sdl_texture_atlas, const struct render_geometry_s * geometry, SDL_FRect virtual_region)
 {
-   help_texture_rgba_plot_horizontal_line(instance, min_x, width, min_y, color);
-   help_texture_rgba_plot_horizontal_line(instance, min_x, width, min_y + height - 1, color);
+   // Quads reaching past the virtual screen are cut off like composed sprites
+   SDL_Rect clip;
+   clip.x = (int)virtual_region.x;
+   clip.y = (int)virtual_region.y;
+   clip.w = (int)virtual_region.w;
+   clip.h = (int)virtual_region.h;
+   const bool SUCCESS_CLIP = SDL_SetRenderClipRect(sdl_renderer, &clip);
+   const bool SUCCESS_GEOMETRY = SDL_RenderGeometry(
+      sdl_renderer,
+      sdl_texture_atlas,
+      (const SDL_Vertex *)geometry->vertices,
+      geometry->quad_count * 4,
+      geometry->indices,
+      geometry->quad_count * 6
+   );
+   SDL_SetRenderClipRect(sdl_renderer, NULL);
 
-   help_texture_rgba_plot_vertical_line(instance, min_y, height, min_x, color);
-   help_texture_rgba_plot_vertical_line(instance, min_y, height, min_x + height - 1, color);
+   return SUCCESS_CLIP && SUCCESS_GEOMETRY;
 }
 
-bool help_texture_rgba_access_texel(struct texture_rgba_s * instance, int x, int y, color_rgba_t * out_color)
+// Helpers - Virtual
+int help_virtual_max_render_scale(struct vec_2i_s actual_window_size, struct vec_2i_s virtual_window_size)
 {
-   if (NULL == instance || NULL == out_color) return false;
-
-   const int FLIPPED_Y = help_texture_rgba_size(instance).y - 1 - y;
-
-   int texel_index;
-   if (help_texture_rgba_2d_coords_to_linear(instance, x, FLIPPED_Y, &texel_index))
-   {
-      *out_color = instance->texels[texel_index];
-      return true;
-   }
-
-   return false;
+   const int MAX_RENDER_SCALE_HORIZONTAL = actual_window_size.x / virtual_window_size.x;
+   const int MAX_RENDER_SCALE_VERTICAL = actual_window_size.y / virtual_window_size.y;
+   return help_minmax_min_2i(MAX_RENDER_SCALE_HORIZONTAL, MAX_RENDER_SCALE_VERTICAL);
 }
 
-struct texture_rgba_s * help_texture_rgba_make(int width, int height, color_rgba_t clear_color)
+SDL_FRect help_virtual_max_render_scale_region(struct vec_2i_s actual_window_size, struct vec_2i_s virtual_window_size)
 {
-   // Allocate instance
-   struct texture_rgba_s * instance = malloc(sizeof(struct texture_rgba_s));
-   if (NULL == instance)
-   {
-      printf("\nFailed to create texture rgba instance");
-      return NULL;
-   }
-
-   // Null instance
-   instance->texels = NULL;
-   instance->width = width;
-   instance->height = height;
-
-   // Allocate texels
-   const int TEXEL_COUNT = width * height;
-   instance->texels = malloc(sizeof(color_rgba_t) * TEXEL_COUNT);
-   if (NULL == instance->texels)
-   {
-      printf("\nFailed to allocate texture rgba for [%s] texels", TEXEL_COUNT);
-      return help_texture_rgba_destroy(instance);
-   }
-
-   // Initial clear
-   help_texture_rgba_clear(instance, clear_color);
+   const int MAX_RENDER_SCALE = help_virtual_max_render_scale(actual_window_size, virtual_window_size);
+   const struct vec_2i_s VIRTUAL_WINDOW_SIZE_SCALED = vec_2i_make_from_scaled(virtual_window_size, MAX_RENDER_SCALE);
+   return help_sdl_f_rect_make(
+      (actual_window_size.x - VIRTUAL_WINDOW_SIZE_SCALED.x) * 0.5f,
+      (actual_window_size.y - VIRTUAL_WINDOW_SIZE_SCALED.y) * 0.5f,
+      VIRTUAL_WINDOW_SIZE_SCALED.x,
+      VIRTUAL_WINDOW_SIZE_SCALED.y
+   );
+}
 
-   // Success
-   return instance;
+SDL_FRect help_virtual_max_render_scale_region_aligned(struct vec_2i_s actual_window_size, struct vec_2i_s virtual_window_size)
+{
+   // Whole pixel origin so quad edges never straddle pixels
+   SDL_FRect region = help_virtual_max_render_scale_region(actual_window_size, virtual_window_size);
+   region.x = floorf(region.x);
+   region.y = floorf(region.y);
+   return region;
 }
 
+// Helpers - Texture
 struct texture_rgba_s * help_texture_rgba_from_png(const char * dir_abs_file)
 {
    // Load image to convert
@@ -388,1690 +290,110 @@ struct texture_rgba_s * help_texture_rgba_from_png(const char * dir_abs_file)
    return img_texture;
 }
 
-// Logic - Sprites
-struct sprite_s {
-   struct vec_2i_s texture_min;
-   struct vec_2i_s texture_size;
-};
-
-struct sprite_s sprite_make(int tile_x, int tile_y, int tile_size)
-{
-   struct sprite_s sprite;
-
-   sprite.texture_min = vec_2i_make_xy(tile_x * tile_size, tile_y * tile_size);
-   sprite.texture_size = vec_2i_make_xy(tile_size, tile_size);
-
-   return sprite;
-}
-
-struct sprite_s sprite_make_xy_wh(int tile_x, int tile_y, int tiles_wide, int tiles_high, int tile_size)
+// Helpers - Input
+sim_input_t help_input_sample_keyboard(void)
 {
-   struct sprite_s sprite;
+   const bool * KEYBOARD_STATE = SDL_GetKeyboardState(NULL);
 
-   sprite.texture_min = vec_2i_make_xy(tile_x * tile_size, tile_y * tile_size);
-   sprite.texture_size = vec_2i_make_xy(tiles_wide * tile_size, tiles_high * tile_size);
+   sim_input_t keys_down = 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_W] ? SIM_INPUT_KEY(CUSTOM_KEY_UP) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_S] ? SIM_INPUT_KEY(CUSTOM_KEY_DOWN) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_A] ? SIM_INPUT_KEY(CUSTOM_KEY_LEFT) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_D] ? SIM_INPUT_KEY(CUSTOM_KEY_RIGHT) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_UP] ? SIM_INPUT_KEY(CUSTOM_KEY_A) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_LEFT] ? SIM_INPUT_KEY(CUSTOM_KEY_B) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_RETURN] ? SIM_INPUT_KEY(CUSTOM_KEY_START) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_DELETE] ? SIM_INPUT_KEY(CUSTOM_KEY_SELECT) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_KP_PLUS] ? SIM_INPUT_KEY(CUSTOM_KEY_VOLUME_UP) : 0;
+   keys_down |= KEYBOARD_STATE[SDL_SCANCODE_KP_MINUS] ? SIM_INPUT_KEY(CUSTOM_KEY_VOLUME_DOWN) : 0;
 
-   return sprite;
+   return keys_down;
 }
 
-// Logic - Textured Sprite Rendering
-bool help_tex_sprite_render_tinted(
-   struct sprite_s sprite,
-   int x,
-   int y,
-   struct texture_rgba_s * texture_sprite,
-   struct texture_rgba_s * texture_target,
-   bool do_tint,
-   color_rgba_t tint_color
-)
-{
-   if (NULL == texture_sprite || NULL == texture_target) return false;
-
-   for (int spr_y = 0; spr_y < sprite.texture_size.y; ++spr_y)
-   {
-      for (int spr_x = 0; spr_x < sprite.texture_size.x; ++spr_x)
-      {
-         // Access sprite source texture texel
-         color_rgba_t source_texel_color;
-         const bool SUCCESS_ACCESS_SOURCE_TEXEL = help_texture_rgba_access_texel(
-            texture_sprite,
-            sprite.texture_min.x + spr_x,
-            sprite.texture_min.y + sprite.texture_size.y - 1 - spr_y,
-            &source_texel_color
-         );
-         const color_rgba_t SAFE_SOURCE_TEXEL_COLOR = SUCCESS_ACCESS_SOURCE_TEXEL ? source_texel_color : color_rgba_make_rgba(0xFF, 0x00, 0xFF, 0xFF);
-
-         const bool DONT_RENDER_TRANSPARENT_TEXELS = true;
-         if (DONT_RENDER_TRANSPARENT_TEXELS && (0x00 == color_rgba_channel_alpha(SAFE_SOURCE_TEXEL_COLOR)))
-         {
-            continue;
-         }
-
-         // Plot sprite source texture color into target texture
-         // Tint target texels here for now
-         const bool SUCCESS_PLOTTING_TEXEL = help_texture_rgba_plot_texel(
-            texture_target,
-            x + spr_x,
-            y + spr_y,
-            do_tint ? tint_color : SAFE_SOURCE_TEXEL_COLOR
-         );
-      }
-   }
-
-   return true;
-}
+// Helpers - Audio
+typedef int audio_mixer_sample_id_t;
+const audio_mixer_sample_id_t AUDIO_MIXER_SAMPLE_ID_INVALID = -1;
 
-// Helpers - Tetro
-#define TETRO_MAX_SIZE (4)
-enum tetro_type_e {
-   TETRO_TYPE_I,
-   TETRO_TYPE_Lr,
-   TETRO_TYPE_L,
-   TETRO_TYPE_S,
-   TETRO_TYPE_Z,
-   TETRO_TYPE_T,
-   TETRO_TYPE_O,
-   TETRO_TYPE_COUNT
+struct sdl_audio_data_s {
+   SDL_AudioSpec spec;
+   Uint8 * data;
+   Uint32 length;
 };
 
-typedef bool tetro_mask[TETRO_MAX_SIZE][TETRO_MAX_SIZE];
-
-struct tetro_s {
-   enum tetro_type_e type;
-   int size;
-   tetro_mask design;
-   tetro_mask left;
-   tetro_mask right;
+struct audio_mixer_sample_s {
+   struct sdl_audio_data_s * audio;
+   bool active;
+   Uint32 playback_position;
+   bool is_music;
+   bool loop_music;
 };
 
-struct tetro_world_s {
-   struct tetro_s data;
-   struct vec_2i_s tile_pos;
+#define AUDIO_MIXER_MAX_SAMPLE_STORE_COUNT (64)
+#define AUDIO_MIXER_MAX_SAMPLE_QUEUED_COUNT (64)
+
+struct audio_mixer_s {
+   // Playback
+   SDL_AudioDeviceID playback_device_id;
+   SDL_AudioStream * playback_stream;
+   // Audio sample source
+   struct sdl_audio_data_s samples_store[AUDIO_MIXER_MAX_SAMPLE_STORE_COUNT];
+   int samples_store_count;
+   // Queued samples
+   struct audio_mixer_sample_s samples_queued[AUDIO_MIXER_MAX_SAMPLE_QUEUED_COUNT];
+   // Channel volume
+   float volume_music;
+   float volume_sfx;
+   // Channel pause
+   bool pause_music;
+   bool pause_sfx;
 };
 
-struct tetro_world_s tetro_world_make(struct tetro_s tetro, int tile_x, int tile_y)
+void * audio_mixer_destroy(struct audio_mixer_s * instance)
 {
-   struct tetro_world_s tetro_world;
+   if (instance)
+   {
+      // Converted samples
+      for (int i = 0; i < instance->samples_store_count; ++i)
+      {
+         SDL_free(instance->samples_store[i].data);
+      }
 
-   tetro_world.data = tetro;
-   tetro_world.tile_pos = vec_2i_make_xy(tile_x, tile_y);
+      // Unbind device and stream
+      SDL_UnbindAudioStream(instance->playback_stream);
 
-   return tetro_world;
-}
+      // Playback stream
+      SDL_DestroyAudioStream(instance->playback_stream);
 
-bool help_tetro_init_mask(tetro_mask out_mask)
-{
-   if (NULL == out_mask) return false;
+      // Playback audio device
+      SDL_CloseAudioDevice(instance->playback_device_id);
 
-   for (int py = 0; py < TETRO_MAX_SIZE; ++py)
-   {
-      for (int px = 0; px < TETRO_MAX_SIZE; ++px)
-      {
-         out_mask[px][py] = false;
-      }
+      // Instance
+      free(instance);
    }
 
-   return true;
+   return NULL;
 }
 
-struct tetro_s help_tetro_make_typed_unfinished(enum tetro_type_e type, int size)
+struct SDL_AudioSpec audio_mixer_sdl_audio_spec_make_desired(SDL_AudioFormat desired_format, int desired_channels, int desired_frequency)
 {
-   struct tetro_s tetro;
+   struct SDL_AudioSpec desired_spec;
 
-   tetro.type = type;
-   tetro.size = size;
-   help_tetro_init_mask(tetro.design);
-   help_tetro_init_mask(tetro.left);
-   help_tetro_init_mask(tetro.right);
+   desired_spec.format = desired_format;
+   desired_spec.channels = desired_channels;
+   desired_spec.freq = desired_frequency;
 
-   return tetro;
+   return desired_spec;
 }
 
-bool help_tetro_drop_mask(tetro_mask mask, int size, const char * pattern)
+void audio_mixer_sdl_audio_spec_log(struct SDL_AudioSpec spec)
 {
-   if (NULL == mask || NULL == pattern) return false;
+   printf("Format: %#x | Frequency: %d | Channels: %d", spec.format, spec.freq, spec.channels);
+}
 
-   const int TETRO_CELL_COUNT = size * size;
-   if (strlen(pattern) != TETRO_CELL_COUNT)
-   {
-      printf("\nFailed to plot tetro mask because pattern length does not match tetro cell count");
-      return false;
-   }
-
-   int i_pattern = 0;
-   for (int py = size - 1; py >= 0; --py)
-   {
-      for (int px = 0; px < size; ++px)
-      {
-         // Plot pattern
-         // Assumes that cells have been nulled to non-plotted during init
-         const bool PLOT_CELL = (pattern[i_pattern++] == '#') ? true : false;
-         if (PLOT_CELL)
-         {
-            mask[px][py] = true;
-         }
-      }
-   }
-
-   // Success
-   return true;
-}
-
-bool help_tetro_drop_design(struct tetro_s * out_tetro, const char * pattern)
-{
-   if (NULL == out_tetro || NULL == pattern) return false;
-
-   return help_tetro_drop_mask(out_tetro->design, out_tetro->size, pattern);
-}
-
-bool help_tetro_drop_left(struct tetro_s * out_tetro, const char * pattern)
-{
-   if (NULL == out_tetro || NULL == pattern) return false;
-
-   return help_tetro_drop_mask(out_tetro->left, out_tetro->size, pattern);
-}
-
-bool help_tetro_drop_right(struct tetro_s * out_tetro, const char * pattern)
-{
-   if (NULL == out_tetro || NULL == pattern) return false;
-
-   return help_tetro_drop_mask(out_tetro->right, out_tetro->size, pattern);
-}
-
-struct tetro_s help_tetro_make_type_I(void)
-{
-   struct tetro_s tetro_I = help_tetro_make_typed_unfinished(TETRO_TYPE_I, 4);
-   help_tetro_drop_design(
-      &tetro_I,
-      "..#."
-      "..#."
-      "..#."
-      "..#."
-   );
-   help_tetro_drop_left(
-      &tetro_I,
-      "##.."
-      "##.#"
-      "...#"
-      "...#"
-   );
-   help_tetro_drop_right(
-      &tetro_I,
-      "...#"
-      "...#"
-      "##.#"
-      "##.."
-   );
-
-   return tetro_I;
-}
-
-struct tetro_s help_tetro_make_type_O(void)
-{
-   struct tetro_s tetro_O = help_tetro_make_typed_unfinished(TETRO_TYPE_O, 2);
-   help_tetro_drop_design(
-      &tetro_O,
-      "##"
-      "##"
-   );
-   help_tetro_drop_left(
-      &tetro_O,
-      ".."
-      ".."
-   );
-   help_tetro_drop_right(
-      &tetro_O,
-      ".."
-      ".."
-   );
-
-   return tetro_O;
-}
-
-struct tetro_s help_tetro_make_type_Lr(void)
-{
-   struct tetro_s tetro_Lr = help_tetro_make_typed_unfinished(TETRO_TYPE_Lr, 3);
-   help_tetro_drop_design(
-      &tetro_Lr,
-      ".#."
-      ".#."
-      "##."
-   );
-   help_tetro_drop_left(
-      &tetro_Lr,
-      "#.."
-      "#.#"
-      "..#"
-   );
-   help_tetro_drop_right(
-      &tetro_Lr,
-      "#.#"
-      "#.#"
-      "..."
-   );
-
-   return tetro_Lr;
-}
-
-struct tetro_s help_tetro_make_type_L(void)
-{
-   struct tetro_s tetro_L = help_tetro_make_typed_unfinished(TETRO_TYPE_L, 3);
-   help_tetro_drop_design(
-      &tetro_L,
-      ".#."
-      ".#."
-      ".##"
-   );
-   help_tetro_drop_left(
-      &tetro_L,
-      "#.#"
-      "#.#"
-      "..."
-   );
-   help_tetro_drop_right(
-      &tetro_L,
-      "..#"
-      "#.#"
-      "#.."
-   );
-
-   return tetro_L;
-}
-
-struct tetro_s help_tetro_make_type_S(void)
-{
-   struct tetro_s tetro_S = help_tetro_make_typed_unfinished(TETRO_TYPE_S, 3);
-   help_tetro_drop_design(
-      &tetro_S,
-      "..."
-      ".##"
-      "##."
-   );
-   help_tetro_drop_left(
-      &tetro_S,
-      ".##"
-      "..."
-      "..#"
-   );
-   help_tetro_drop_right(
-      &tetro_S,
-      "#.."
-      "#.."
-      "..#"
-   );
-
-   return tetro_S;
-}
-
-struct tetro_s help_tetro_make_type_Z(void)
-{
-   struct tetro_s tetro_Z = help_tetro_make_typed_unfinished(TETRO_TYPE_Z, 3);
-   help_tetro_drop_design(
-      &tetro_Z,
-      "..."
-      "##."
-      ".##"
-   );
-   help_tetro_drop_left(
-      &tetro_Z,
-      "..#"
-      "..#"
-      "#.."
-   );
-   help_tetro_drop_right(
-      &tetro_Z,
-      "##."
-      "..."
-      "#.."
-   );
-
-   return tetro_Z;
-}
-
-struct tetro_s help_tetro_make_type_T(void)
-{
-   struct tetro_s tetro_T = help_tetro_make_typed_unfinished(TETRO_TYPE_T, 3);
-   help_tetro_drop_design(
-      &tetro_T,
-      "..."
-      "###"
-      ".#."
-   );
-   help_tetro_drop_left(
-      &tetro_T,
-      ".##"
-      "..."
-      "#.#"
-   );
-   help_tetro_drop_right(
-      &tetro_T,
-      "##."
-      "..."
-      "#.#"
-   );
-
-   return tetro_T;
-}
-
-void help_tetro_rotate_mask_ccw(tetro_mask mask, int size)
-{
-   tetro_mask rotated;
-   memcpy(rotated, mask, sizeof(rotated));
-
-   // Rotate
-   for (int row = 0; row < size; ++row)
-   {
-      for (int col = 0; col < size; ++col)
-      {
-         rotated[col][row] = mask[row][size - 1 - col];
-      }
-   }
-
-   // Reflect
-   memcpy(mask, rotated, sizeof(rotated));
-}
-
-void help_tetro_rotate_mask_cw(tetro_mask mask, int size)
-{
-   tetro_mask rotated;
-   memcpy(rotated, mask, sizeof(rotated));
-
-   // Rotate
-   for (int row = 0; row < size; ++row)
-   {
-      for (int col = 0; col < size; ++col)
-      {
-         rotated[col][row] = mask[size - 1 - row][col];
-      }
-   }
-
-   // Reflect
-   memcpy(mask, rotated, sizeof(rotated));
-}
-
-bool help_tetro_world_rotate_ccw(struct tetro_world_s * tetro)
-{
-   if (NULL == tetro) return false;
-
-   help_tetro_rotate_mask_ccw(tetro->data.design, tetro->data.size);
-   help_tetro_rotate_mask_ccw(tetro->data.left, tetro->data.size);
-   help_tetro_rotate_mask_ccw(tetro->data.right, tetro->data.size);
-
-   // Success
-   return true;
-}
-
-bool help_tetro_world_rotate_cw(struct tetro_world_s * tetro)
-{
-   if (NULL == tetro) return false;
-
-   help_tetro_rotate_mask_cw(tetro->data.design, tetro->data.size);
-   help_tetro_rotate_mask_cw(tetro->data.left, tetro->data.size);
-   help_tetro_rotate_mask_cw(tetro->data.right, tetro->data.size);
-
-   // Success
-   return true;
-}
-
-struct tetro_world_s help_tetro_world_make_type_at_tile(enum tetro_type_e type, int tile_x, int tile_y)
-{
-   switch (type)
-   {
-      case TETRO_TYPE_I:
-         return tetro_world_make(help_tetro_make_type_I(), tile_x, tile_y);
-         break;
-      case TETRO_TYPE_O:
-         return tetro_world_make(help_tetro_make_type_O(), tile_x, tile_y);
-         break;
-      case TETRO_TYPE_Lr:
-         return tetro_world_make(help_tetro_make_type_Lr(), tile_x, tile_y);
-         break;
-      case TETRO_TYPE_L:
-         return tetro_world_make(help_tetro_make_type_L(), tile_x, tile_y);
-         break;
-      case TETRO_TYPE_S:
-         return tetro_world_make(help_tetro_make_type_S(), tile_x, tile_y);
-         break;
-      case TETRO_TYPE_Z:
-         return tetro_world_make(help_tetro_make_type_Z(), tile_x, tile_y);
-         break;
-      case TETRO_TYPE_T:
-         return tetro_world_make(help_tetro_make_type_T(), tile_x, tile_y);
-         break;
-      default:
-         printf("\nAttempting to spawn un-supported tetro type");
-         break;
-   }
-}
-
-// Helpers - Input
-enum custom_key_e {
-   CUSTOM_KEY_UP,
-   CUSTOM_KEY_DOWN,
-   CUSTOM_KEY_LEFT,
-   CUSTOM_KEY_RIGHT,
-   CUSTOM_KEY_A,
-   CUSTOM_KEY_B,
-   CUSTOM_KEY_START,
-   CUSTOM_KEY_SELECT,
-   CUSTOM_KEY_VOLUME_UP,
-   CUSTOM_KEY_VOLUME_DOWN,
-   CUSTOM_KEY_COUNT
-};
-
-enum key_state_e {
-   KEY_STATE_NONE,
-   KEY_STATE_PRESSED,
-   KEY_STATE_HELD,
-   KEY_STATE_RELEASED
-};
-
-struct input_s {
-   enum key_state_e key_states[CUSTOM_KEY_COUNT];
-};
-
-struct input_s * help_input_make(void)
-{
-   struct input_s * instance = malloc(sizeof(struct input_s));
-   if (NULL == instance)
-   {
-      printf("\nFailed to allocate input instance");
-      return NULL;
-   }
-
-   // Initialize custom key states
-   for (int custom_key = 0; custom_key < CUSTOM_KEY_COUNT; ++custom_key)
-   {
-      instance->key_states[custom_key] = KEY_STATE_NONE;
-   }
-
-   // Success
-   return instance;
-}
-
-void help_input_destroy(struct input_s * input)
-{
-   free(input);
-}
-
-enum key_state_e help_input_determine_key_state(enum key_state_e current_state, bool currently_pressed)
-{
-   switch (current_state)
-   {
-      case KEY_STATE_NONE:
-         return currently_pressed ? KEY_STATE_PRESSED : KEY_STATE_NONE;
-         break;
-      case KEY_STATE_PRESSED:
-         return currently_pressed ? KEY_STATE_HELD : KEY_STATE_RELEASED;
-         break;
-      case KEY_STATE_HELD:
-         return currently_pressed ? KEY_STATE_HELD : KEY_STATE_RELEASED;
-         break;
-      case KEY_STATE_RELEASED:
-         return currently_pressed ? KEY_STATE_PRESSED : KEY_STATE_NONE;
-         break;
-   }
-}
-
-bool help_input_determine_intermediate_state(struct input_s * instance)
-{
-   if (NULL == instance) return false;
-
-   const bool * KEYBOARD_STATE = SDL_GetKeyboardState(NULL);
-   const enum key_state_e NEW_STATE_UP = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_UP], KEYBOARD_STATE[SDL_SCANCODE_W]);
-   const enum key_state_e NEW_STATE_DOWN = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_DOWN], KEYBOARD_STATE[SDL_SCANCODE_S]);
-   const enum key_state_e NEW_STATE_LEFT = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_LEFT], KEYBOARD_STATE[SDL_SCANCODE_A]);
-   const enum key_state_e NEW_STATE_RIGHT = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_RIGHT], KEYBOARD_STATE[SDL_SCANCODE_D]);
-   const enum key_state_e NEW_STATE_A = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_A], KEYBOARD_STATE[SDL_SCANCODE_UP]);
-   const enum key_state_e NEW_STATE_B = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_B], KEYBOARD_STATE[SDL_SCANCODE_LEFT]);
-   const enum key_state_e NEW_STATE_START = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_START], KEYBOARD_STATE[SDL_SCANCODE_RETURN]);
-   const enum key_state_e NEW_STATE_SELECT = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_SELECT], KEYBOARD_STATE[SDL_SCANCODE_DELETE]);
-   const enum key_state_e NEW_STATE_VOLUME_UP = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_VOLUME_UP], KEYBOARD_STATE[SDL_SCANCODE_KP_PLUS]);
-   const enum key_state_e NEW_STATE_VOLUME_DOWN = help_input_determine_key_state(instance->key_states[CUSTOM_KEY_VOLUME_DOWN], KEYBOARD_STATE[SDL_SCANCODE_KP_MINUS]);
-
-   instance->key_states[CUSTOM_KEY_UP] = NEW_STATE_UP;
-   instance->key_states[CUSTOM_KEY_DOWN] = NEW_STATE_DOWN;
-   instance->key_states[CUSTOM_KEY_LEFT] = NEW_STATE_LEFT;
-   instance->key_states[CUSTOM_KEY_RIGHT] = NEW_STATE_RIGHT;
-   instance->key_states[CUSTOM_KEY_A] = NEW_STATE_A;
-   instance->key_states[CUSTOM_KEY_B] = NEW_STATE_B;
-   instance->key_states[CUSTOM_KEY_START] = NEW_STATE_START;
-   instance->key_states[CUSTOM_KEY_SELECT] = NEW_STATE_SELECT;
-   instance->key_states[CUSTOM_KEY_VOLUME_UP] = NEW_STATE_VOLUME_UP;
-   instance->key_states[CUSTOM_KEY_VOLUME_DOWN] = NEW_STATE_VOLUME_DOWN;
-
-   // Success
-   return true;
-}
-
-bool help_input_key_in_state(struct input_s * input, enum custom_key_e key, enum key_state_e state)
-{
-   if (NULL == input) return false;
-
-   return input->key_states[key] == state;
-}
-
-bool help_input_key_none(struct input_s * input, enum custom_key_e key)
-{
-   return help_input_key_in_state(input, key, KEY_STATE_NONE);
-}
-
-bool help_input_key_pressed(struct input_s * input, enum custom_key_e key)
-{
-   return help_input_key_in_state(input, key, KEY_STATE_PRESSED);
-}
-
-bool help_input_key_held(struct input_s * input, enum custom_key_e key)
-{
-   return help_input_key_in_state(input, key, KEY_STATE_HELD);
-}
-
-bool help_input_key_released(struct input_s * input, enum custom_key_e key)
-{
-   return help_input_key_in_state(input, key, KEY_STATE_RELEASED);
-}
-
-bool help_input_key_pressed_or_held(struct input_s * input, enum custom_key_e key)
-{
-   return (
-      help_input_key_in_state(input, key, KEY_STATE_PRESSED) ||
-      help_input_key_in_state(input, key, KEY_STATE_HELD)
-   );
-}
-
-bool help_input_any_key_pressed(struct input_s * input)
-{
-   if (NULL == input) return false;
-
-   for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
-   {
-      if (help_input_key_pressed(input, key))
-      {
-         // At least one of the keys was pressed
-         return true;
-      }
-   }
-
-   // No key was pressed
-   return false;
-}
-
-// Helpers - Border rendering
-enum sprite_map_tile_e {
-   SPRITE_MAP_TILE_TETRO_BLOCK_I,
-   SPRITE_MAP_TILE_TETRO_BLOCK_O,
-   SPRITE_MAP_TILE_TETRO_BLOCK_Lr,
-   SPRITE_MAP_TILE_TETRO_BLOCK_L,
-   SPRITE_MAP_TILE_TETRO_BLOCK_S,
-   SPRITE_MAP_TILE_TETRO_BLOCK_T,
-   SPRITE_MAP_TILE_TETRO_BLOCK_Z,
-   SPRITE_MAP_TILE_BRICK,
-   SPRITE_MAP_TILE_HIGHLIGHT,
-   SPRITE_MAP_TILE_FONT_GLYPH_A,
-   SPRITE_MAP_TILE_FONT_GLYPH_B,
-   SPRITE_MAP_TILE_FONT_GLYPH_C,
-   SPRITE_MAP_TILE_FONT_GLYPH_D,
-   SPRITE_MAP_TILE_FONT_GLYPH_E,
-   SPRITE_MAP_TILE_FONT_GLYPH_F,
-   SPRITE_MAP_TILE_FONT_GLYPH_G,
-   SPRITE_MAP_TILE_FONT_GLYPH_H,
-   SPRITE_MAP_TILE_FONT_GLYPH_I,
-   SPRITE_MAP_TILE_FONT_GLYPH_J,
-   SPRITE_MAP_TILE_FONT_GLYPH_K,
-   SPRITE_MAP_TILE_FONT_GLYPH_L,
-   SPRITE_MAP_TILE_FONT_GLYPH_M,
-   SPRITE_MAP_TILE_FONT_GLYPH_N,
-   SPRITE_MAP_TILE_FONT_GLYPH_O,
-   SPRITE_MAP_TILE_FONT_GLYPH_P,
-   SPRITE_MAP_TILE_FONT_GLYPH_Q,
-   SPRITE_MAP_TILE_FONT_GLYPH_R,
-   SPRITE_MAP_TILE_FONT_GLYPH_S,
-   SPRITE_MAP_TILE_FONT_GLYPH_T,
-   SPRITE_MAP_TILE_FONT_GLYPH_U,
-   SPRITE_MAP_TILE_FONT_GLYPH_V,
-   SPRITE_MAP_TILE_FONT_GLYPH_W,
-   SPRITE_MAP_TILE_FONT_GLYPH_X,
-   SPRITE_MAP_TILE_FONT_GLYPH_Y,
-   SPRITE_MAP_TILE_FONT_GLYPH_Z,
-   SPRITE_MAP_TILE_FONT_GLYPH_0,
-   SPRITE_MAP_TILE_FONT_GLYPH_1,
-   SPRITE_MAP_TILE_FONT_GLYPH_2,
-   SPRITE_MAP_TILE_FONT_GLYPH_3,
-   SPRITE_MAP_TILE_FONT_GLYPH_4,
-   SPRITE_MAP_TILE_FONT_GLYPH_5,
-   SPRITE_MAP_TILE_FONT_GLYPH_6,
-   SPRITE_MAP_TILE_FONT_GLYPH_7,
-   SPRITE_MAP_TILE_FONT_GLYPH_8,
-   SPRITE_MAP_TILE_FONT_GLYPH_9,
-   SPRITE_MAP_TILE_FONT_GLYPH_PERIOD,
-   SPRITE_MAP_TILE_FONT_GLYPH_COMMA,
-   SPRITE_MAP_TILE_FONT_GLYPH_COLON,
-   SPRITE_MAP_TILE_FONT_GLYPH_HYPHEN,
-   SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_OPEN,
-   SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_CLOSED,
-   SPRITE_MAP_TILE_FONT_GLYPH_PIPE,
-   SPRITE_MAP_TILE_FONT_GLYPH_PLUS,
-   SPRITE_MAP_TILE_FONT_COPYRIGHT,
-   SPRITE_MAP_TILE_FONT_ARROW_RIGHT,
-   SPRITE_MAP_TILE_GAME_OVER_FILL,
-   SPRITE_MAP_TILE_HEART,
-   SPRITE_MAP_TILE_BG_TITLE_SCREEN,
-   SPRITE_MAP_TILE_BG_CONFIG_SCREEN,
-   SPRITE_MAP_TILE_BG_PLAY_SCREEN,
-   SPRITE_MAP_TILE_BG_INPUT_MAPPING_SCREEN,
-   SPRITE_MAP_TILE_SPEAKER,
-   SPRITE_MAP_TILE_NA,
-   SPRITE_MAP_TILE_COUNT
-};
-
-struct sprite_map_s {
-   struct sprite_s tile_to_sprite[SPRITE_MAP_TILE_COUNT];
-   struct texture_rgba_s * texture;
-   int tile_size;
-};
-
-bool help_sprite_map_tile(struct sprite_map_s * instance, enum sprite_map_tile_e tile, int sprite_tile_x, int sprite_tile_y)
-{
-   if (NULL == instance) return false;
-
-   instance->tile_to_sprite[tile] = sprite_make(sprite_tile_x, sprite_tile_y, instance->tile_size);
-
-   return true;
-}
-
-bool help_sprite_map_tile_extended(struct sprite_map_s * instance, enum sprite_map_tile_e tile, int sprite_tile_x, int sprite_tile_y, int sprite_tiles_wide, int sprite_tiles_high)
-{
-   if (NULL == instance) return false;
-
-   instance->tile_to_sprite[tile] = sprite_make_xy_wh(sprite_tile_x, sprite_tile_y, sprite_tiles_wide, sprite_tiles_high, instance->tile_size);
-
-   return true;
-}
-
-struct sprite_map_s * help_sprite_map_create(struct texture_rgba_s * texture, int na_tile_x, int na_tile_y, int tile_size)
-{
-   if (NULL == texture) return NULL;
-
-   struct sprite_map_s * instance = malloc(sizeof(struct sprite_map_s));
-
-   if (instance)
-   {
-      instance->texture = texture;
-      instance->tile_size = tile_size;
-      help_sprite_map_tile(instance, SPRITE_MAP_TILE_NA, na_tile_x, na_tile_y);
-   }
-
-   return instance;
-}
-
-struct sprite_s help_sprite_map_sprite_for(const struct sprite_map_s * instance, enum sprite_map_tile_e tile)
-{
-   if (NULL == instance) return sprite_make(7, 4, 8);
-
-   // Assume that all tiles are mapped for now
-   return instance->tile_to_sprite[tile];
-}
-
-// Helpers - Regions
-struct region_2d_s {
-   struct vec_2i_s min;
-   struct vec_2i_s max;
-   struct vec_2i_s size;
-};
-
-struct region_2d_s region_2d_s_make(int min_x, int min_y, int width, int height)
-{
-   struct region_2d_s region;
-
-   region.min = vec_2i_make_xy(min_x, min_y);
-   region.size = vec_2i_make_xy(width, height);
-   region.max = vec_2i_make_xy(
-      min_x + width - 1,
-      min_y + height - 1
-   );
-
-   return region;
-}
-
-// Helpers - FSM
-enum game_state_e {
-   GAME_STATE_SPLASH,
-   GAME_STATE_INPUT_MAPPING,
-   GAME_STATE_TITLE,
-   GAME_STATE_GAME_MUSIC_CONFIG,
-   GAME_STATE_NEW_GAME,
-   GAME_STATE_CONTROL,
-   GAME_STATE_PLACE,
-   GAME_STATE_REMOVE_LINES,
-   GAME_STATE_CONSOLIDATE_PLAY_FIELD,
-   GAME_STATE_RESPAWN,
-   GAME_STATE_GAME_OVER,
-   GAME_STATE_GAME_OVER_TRANSITION_FILL,
-   GAME_STATE_GAME_OVER_TRANSITION_CLEAR,
-   GAME_STATE_PAUSE,
-   GAME_STATE_QUIT,
-   GAME_STATE_NONE
-};
-
-// Helpers - Bounds
-bool help_bounds_out_of_region(int min_x, int min_y, int width, int height, int x, int y)
-{
-   const struct region_2d_s REGION = region_2d_s_make(min_x, min_y, width, height);
-   return (
-      x < REGION.min.x ||
-      x > REGION.max.x ||
-      y < REGION.min.y ||
-      y > REGION.max.y
-   ) ? true : false;
-}
-
-// Helpers - Engine
-struct engine_s {
-   struct font_render_s * font_render;
-   struct texture_rgba_s * tex_virtual;
-   struct texture_rgba_s * tex_sprites;
-   struct sprite_map_s * sprite_map;
-};
-
-struct texture_rgba_s * help_engine_get_tex_virtual(struct engine_s * engine)
-{
-   return engine ? engine->tex_virtual : NULL;
-}
-
-struct texture_rgba_s * help_engine_get_tex_sprites(struct engine_s * engine)
-{
-   return engine ? engine->tex_sprites : NULL;
-}
-
-struct sprite_map_s * help_engine_get_sprite_map(struct engine_s * engine)
-{
-   return engine ? engine->sprite_map : NULL;
-}
-
-// Helpers - Playing field
-struct play_field_cell_s {
-   enum tetro_type_e type;
-   bool occupied;
-};
-
-// Helpers - Rendering (Simplified)
-bool help_render_engine_sprite(struct engine_s * engine, int x, int y, enum sprite_map_tile_e tile_type)
-{
-   if (NULL == engine) return false;
-
-   return help_tex_sprite_render_tinted(
-      help_sprite_map_sprite_for(help_engine_get_sprite_map(engine), tile_type),
-      x,
-      y,
-      help_engine_get_tex_sprites(engine),
-      help_engine_get_tex_virtual(engine),
-      false,
-      color_rgba_make_rgba(0, 0, 0, 0xFF)
-   );
-}
-
-// Helpers - Play field
-#define PLAY_FIELD_TILE_SIZE (8)
-#define PLAY_FIELD_WIDTH (10)
-#define PLAY_FIELD_HEIGHT (18)
-#define PLAY_FIELD_OFFSET_HORI_TILES (2)
-#define PLAY_FIELD_OFFSET_HORI_PIXELS (PLAY_FIELD_OFFSET_HORI_TILES * PLAY_FIELD_TILE_SIZE)
-
-bool help_render_engine_sprite_at_tile(struct engine_s * engine, int tile_x, int tile_y, enum sprite_map_tile_e tile_type)
-{
-   return help_render_engine_sprite(engine, tile_x * PLAY_FIELD_TILE_SIZE, tile_y * PLAY_FIELD_TILE_SIZE, tile_type);
-}
-
-bool help_render_engine_sprite_tinted(struct engine_s * engine, int x, int y, enum sprite_map_tile_e tile_type, bool do_tint, color_rgba_t tint)
-{
-   if (NULL == engine) return false;
-
-   return help_tex_sprite_render_tinted(
-      help_sprite_map_sprite_for(help_engine_get_sprite_map(engine), tile_type),
-      x,
-      y,
-      help_engine_get_tex_sprites(engine),
-      help_engine_get_tex_virtual(engine),
-      do_tint,
-      tint
-   );
-}
-
-struct play_field_s {
-   struct play_field_cell_s cells[PLAY_FIELD_WIDTH][PLAY_FIELD_HEIGHT];
-};
-
-struct play_field_cell_s help_play_field_cell_make(enum tetro_type_e type, bool occupied)
-{
-   struct play_field_cell_s cell;
-
-   cell.type = type;
-   cell.occupied = occupied;
-
-   return cell;
-}
-
-struct play_field_cell_s help_play_field_cell_make_non_occupied(void)
-{
-   return help_play_field_cell_make(TETRO_TYPE_O, false);
-}
-
-struct play_field_s help_play_field_make_non_occupied(void)
-{
-   struct play_field_s fresh_play_field;
-
-   // Populate cells
-   for (int y = 0; y < PLAY_FIELD_HEIGHT; ++y)
-   {
-      for (int x = 0; x < PLAY_FIELD_WIDTH; ++x)
-      {
-         fresh_play_field.cells[x][y] = help_play_field_cell_make_non_occupied();
-      }
-   }
-
-   // Success
-   return fresh_play_field;
-}
-
-bool help_play_field_coords_out_of_bounds(struct play_field_s * play_field, int x, int y)
-{
-   if (NULL == play_field) return true;
-
-   return help_bounds_out_of_region(0, 0, PLAY_FIELD_WIDTH, PLAY_FIELD_HEIGHT, x, y);
-}
-
-bool help_play_field_set_cell(struct play_field_s * play_field, int x, int y, struct play_field_cell_s new_cell)
-{
-   if (help_play_field_coords_out_of_bounds(play_field, x, y)) return false;
-
-   play_field->cells[x][y] = new_cell;
-
-   return true;
-}
-
-bool help_play_field_access_cell(struct play_field_s * play_field, int x, int y, struct play_field_cell_s * out_cell)
-{
-   if (NULL == play_field || NULL == out_cell || help_play_field_coords_out_of_bounds(play_field, x, y)) return false;
-
-   *out_cell = play_field->cells[x][y];
-
-   return true;
-}
-
-bool help_play_field_clear_row(struct play_field_s * play_field, int row)
-{
-   if (NULL == play_field) return false;
-
-   bool row_cleared = true;
-   for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
-   {
-      const bool CELL_CLEARED = help_play_field_set_cell(play_field, col, row, help_play_field_cell_make_non_occupied());
-      if (false == CELL_CLEARED)
-      {
-         row_cleared = false;
-      }
-   }
-
-   return row_cleared;
-}
-
-bool help_play_field_clear(struct play_field_s * play_field)
-{
-   if (NULL == play_field) return false;
-
-   for (int row = 0; row < PLAY_FIELD_HEIGHT; ++row)
-   {
-      help_play_field_clear_row(play_field, row);
-   }
-
-   return true;
-}
-
-bool help_play_field_row_empty(struct play_field_s * play_field, int row)
-{
-   if (
-      NULL == play_field ||
-      row < 0 ||
-      row >= PLAY_FIELD_HEIGHT
-   ) return true;
-
-   int occupied_cell_count = 0;
-   for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
-   {
-      if (true == play_field->cells[col][row].occupied)
-      {
-         ++occupied_cell_count;
-      }
-   }
-
-   return (0 == occupied_cell_count);
-}
-
-enum sprite_map_tile_e help_tetro_type_to_sprite_tile(enum tetro_type_e tetro_type)
-{
-   switch(tetro_type)
-   {
-      case TETRO_TYPE_I:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_I;
-         break;
-      case TETRO_TYPE_O:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_O;
-         break;
-      case TETRO_TYPE_L:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_L;
-         break;
-      case TETRO_TYPE_Lr:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_Lr;
-         break;
-      case TETRO_TYPE_S:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_S;
-         break;
-      case TETRO_TYPE_Z:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_Z;
-         break;
-      case TETRO_TYPE_T:
-         return SPRITE_MAP_TILE_TETRO_BLOCK_T;
-         break;
-      default:
-         return SPRITE_MAP_TILE_NA;
-         break;
-   }
-}
-
-void help_play_field_render_to_texture(struct play_field_s * play_field, struct engine_s * engine)
-{
-   if (NULL == play_field || NULL == engine) return;
-
-   // Render with play field offset
-   for (int y = 0; y < PLAY_FIELD_HEIGHT; ++y)
-   {
-      for (int x = 0; x < PLAY_FIELD_WIDTH; ++x)
-      {
-         /*
-         // Render background
-         help_texture_rgba_plot_aabb(
-            help_engine_get_tex_virtual(engine),
-            PLAY_FIELD_OFFSET_HORI_PIXELS + (x * PLAY_FIELD_TILE_SIZE),
-            y * PLAY_FIELD_TILE_SIZE,
-            PLAY_FIELD_TILE_SIZE,
-            PLAY_FIELD_TILE_SIZE,
-            color_rgba_make_rgba(0, 50, 0, 0xFF)
-         );
-         */
-
-         // Render placed cell by type
-         const struct play_field_cell_s * CELL = &play_field->cells[x][y];
-         if (false == CELL->occupied)
-         {
-            // Don't render non-occupied cells
-            continue;
-         }
-
-         // Cell occupied
-         help_render_engine_sprite(
-            engine,
-            PLAY_FIELD_OFFSET_HORI_PIXELS + (x * PLAY_FIELD_TILE_SIZE),
-            y * PLAY_FIELD_TILE_SIZE,
-            help_tetro_type_to_sprite_tile(CELL->type)
-         );
-      }
-   }
-}
-
-bool help_play_field_consolidate(struct play_field_s * play_field)
-{
-   if (NULL == play_field) return false;
-
-   struct play_field_s play_field_consolidated = help_play_field_make_non_occupied();
-
-   int row_new = 0;
-   for (int row_old = 0; row_old < PLAY_FIELD_HEIGHT; ++row_old)
-   {
-      // Ignore empty rows
-      if (help_play_field_row_empty(play_field, row_old))
-      {
-         continue;
-      }
-
-      // Copy non-empty row to new play field
-      for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
-      {
-         struct play_field_cell_s cell_old;
-         if (help_play_field_access_cell(play_field, col, row_old, &cell_old))
-         {
-            help_play_field_set_cell(&play_field_consolidated, col, row_new, cell_old);
-         }
-      }
-      
-      // To next row
-      ++row_new;
-   }
-
-   // Replace old with new play field
-   memcpy(play_field->cells, play_field_consolidated.cells, sizeof(play_field_consolidated));
-
-   // Success
-   return true;
-}
-
-// Helpers - Tetro spawning
-struct tetro_world_s help_tetro_world_make_random_at_spawn(void)
-{
-   const enum tetro_type_e RANDOM_TETRO_TYPE = rand() % TETRO_TYPE_COUNT;
-
-   // Make tetro at some position
-   struct tetro_world_s random_tetro = help_tetro_world_make_type_at_tile(RANDOM_TETRO_TYPE, 0, 0);
-
-   for (int rotation = 0; rotation < rand() % 8; ++rotation)
-   {
-      help_tetro_world_rotate_cw(&random_tetro);
-   }
-
-   // Position to spawn based on tetro size
-   const int TETRO_SIZE = random_tetro.data.size;
-   random_tetro.tile_pos.x = ((PLAY_FIELD_WIDTH - 1) / 2) - (TETRO_SIZE / 2) + 1;
-   random_tetro.tile_pos.y = (PLAY_FIELD_HEIGHT - 1) - (TETRO_SIZE - 1);
-
-   // Success
-   return random_tetro;
-}
-
-struct tetro_world_s help_tetro_world_clone_at_position(const struct tetro_world_s * tetro, int x, int y)
-{
-   struct tetro_world_s clone = *tetro;
-
-   clone.tile_pos.x = x;
-   clone.tile_pos.y = y;
-
-   return clone;
-}
-
-// Helpers - Rendering stuff
-void help_tetro_render_to_texture_at_tile_without_position(struct tetro_world_s * tetro, struct engine_s * engine, int tile_x, int tile_y)
-{
-   if (NULL == tetro || NULL == engine) return;
-
-   // Render tetro at tile position
-   for (int ty = 0; ty < tetro->data.size; ++ty)
-   {
-      for (int tx = 0; tx < tetro->data.size; ++tx)
-      {
-         // Design cells
-         const bool IS_DESIGN_CELL = tetro->data.design[tx][ty];
-         if (IS_DESIGN_CELL)
-         {
-            help_render_engine_sprite(
-               engine,
-               (tile_x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
-               (tile_y* PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
-               help_tetro_type_to_sprite_tile(tetro->data.type)
-            );
-         }
-
-         // Tetro debug rendering configured ?
-         if (false == CONFIG_DO_RENDER_TETRO_COLLISION_MASKS)
-         {
-            continue;
-         }
-
-         // CCW collision mask
-         const bool IS_CCW_COLLISION_CELL = tetro->data.left[tx][ty];
-         if (IS_CCW_COLLISION_CELL)
-         {
-            // Render CCW cells a full-sized tile
-            help_texture_rgba_plot_aabb_outline(
-               help_engine_get_tex_virtual(engine),
-               (tile_x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
-               (tile_y* PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
-               PLAY_FIELD_TILE_SIZE,
-               PLAY_FIELD_TILE_SIZE,
-               color_rgba_make_rgba(150, 0, 0, 255)
-            );
-         }
-
-         // CW collision mask
-         const bool IS_CW_COLLISION_CELL = tetro->data.right[tx][ty];
-         if (IS_CW_COLLISION_CELL)
-         {
-            // Render CW cells a less than tile-size tile
-            const int INSET = 2;
-            help_texture_rgba_plot_aabb_outline(
-               help_engine_get_tex_virtual(engine),
-               (tile_x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE) + INSET,
-               (tile_y* PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE) + INSET,
-               PLAY_FIELD_TILE_SIZE - (2 * INSET),
-               PLAY_FIELD_TILE_SIZE - (2 * INSET),
-               color_rgba_make_rgba(0, 150, 0, 255)
-            );
-         }
-      }
-   }
-}
-
-void help_tetro_render_to_texture(struct tetro_world_s * tetro, struct engine_s * engine)
-{
-   if (NULL == tetro || NULL == engine) return;
-
-   // Render tetro at position with play field offset
-   for (int ty = 0; ty < tetro->data.size; ++ty)
-   {
-      for (int tx = 0; tx < tetro->data.size; ++tx)
-      {
-         // Design cells
-         const bool IS_DESIGN_CELL = tetro->data.design[tx][ty];
-         if (IS_DESIGN_CELL)
-         {
-            help_render_engine_sprite(
-               engine,
-               PLAY_FIELD_OFFSET_HORI_PIXELS + (tetro->tile_pos.x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
-               (tetro->tile_pos.y * PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
-               help_tetro_type_to_sprite_tile(tetro->data.type)
-            );
-         }
-
-         // Tetro debug rendering configured ?
-         if (false == CONFIG_DO_RENDER_TETRO_COLLISION_MASKS)
-         {
-            continue;
-         }
-
-         // CCW collision mask
-         const bool IS_CCW_COLLISION_CELL = tetro->data.left[tx][ty];
-         if (IS_CCW_COLLISION_CELL)
-         {
-            // Render CCW cells a full-sized tile
-            help_texture_rgba_plot_aabb_outline(
-               help_engine_get_tex_virtual(engine),
-               PLAY_FIELD_OFFSET_HORI_PIXELS + (tetro->tile_pos.x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
-               (tetro->tile_pos.y * PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
-               PLAY_FIELD_TILE_SIZE,
-               PLAY_FIELD_TILE_SIZE,
-               color_rgba_make_rgba(150, 0, 0, 255)
-            );
-         }
-
-         // CW collision mask
-         const bool IS_CW_COLLISION_CELL = tetro->data.right[tx][ty];
-         if (IS_CW_COLLISION_CELL)
-         {
-            // Render CW cells a less than tile-size tile
-            const int INSET = 2;
-            help_texture_rgba_plot_aabb_outline(
-               help_engine_get_tex_virtual(engine),
-               PLAY_FIELD_OFFSET_HORI_PIXELS + (tetro->tile_pos.x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE) + INSET,
-               (tetro->tile_pos.y * PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE) + INSET,
-               PLAY_FIELD_TILE_SIZE - (2 * INSET),
-               PLAY_FIELD_TILE_SIZE - (2 * INSET),
-               color_rgba_make_rgba(0, 150, 0, 255)
-            );
-         }
-      }
-   }
-}
-
-// Helpers - Tetro gameplay
-bool help_tetro_move_collides(const struct tetro_world_s * TETRO, struct play_field_s * play_field, int dx, int dy)
-{
-   if (NULL == TETRO || NULL == play_field) return true;
-
-   const struct tetro_world_s TETRO_MOVED = help_tetro_world_clone_at_position(TETRO, TETRO->tile_pos.x + dx, TETRO->tile_pos.y + dy);
-
-   // Does any tetro design cell overlap an occupied play field cell ?
-   for (int ty = 0; ty < TETRO_MOVED.data.size; ++ty)
-   {
-      for (int tx = 0; tx < TETRO_MOVED.data.size; ++tx)
-      {
-         // Ignore non-plotted design cells
-         const bool DESIGN_CELL_PLOTTED = TETRO_MOVED.data.design[tx][ty];
-         if (false == DESIGN_CELL_PLOTTED)
-         {
-            continue;
-         }
-
-         // Out-of play field bounds is considered a collision
-         const struct vec_2i_s TETRO_TILE_CELL_POS = vec_2i_make_xy(TETRO_MOVED.tile_pos.x + tx, TETRO_MOVED.tile_pos.y + ty);
-         if (help_play_field_coords_out_of_bounds(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y))
-         {
-            return true;
-         }
-
-         // Overlapping occupied play field cell is considered a collision
-         if (play_field->cells[TETRO_TILE_CELL_POS.x][TETRO_TILE_CELL_POS.y].occupied)
-         {
-            return true;
-         }
-      }
-   }
-
-   // No collision detected
-   return false;
-}
-
-enum rotation_e {
-   ROTATION_CW,
-   ROTATION_CCW
-};
-
-bool help_tetro_rotation_collides(const struct tetro_world_s * TETRO, struct play_field_s * play_field, enum rotation_e rotation)
-{
-   if (NULL == TETRO || NULL == play_field) return true;
-
-   // Does any tetro design cell overlap an occupied play field cell ?
-   for (int ty = 0; ty < TETRO->data.size; ++ty)
-   {
-      for (int tx = 0; tx < TETRO->data.size; ++tx)
-      {
-         // Ignore non-plotted rotation cells
-         const bool ROTATION_CELL_PLOTTED = (ROTATION_CW == rotation) ? TETRO->data.right[tx][ty] : TETRO->data.left[tx][ty];
-         if (false == ROTATION_CELL_PLOTTED)
-         {
-            continue;
-         }
-
-         // Out-of play field bounds is considered a collision
-         const struct vec_2i_s TETRO_TILE_CELL_POS = vec_2i_make_xy(TETRO->tile_pos.x + tx, TETRO->tile_pos.y + ty);
-         if (help_play_field_coords_out_of_bounds(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y))
-         {
-            return true;
-         }
-
-         // Overlapping occupied play field cell is considered a collision
-         struct play_field_cell_s corresp_field_cell;
-         if (help_play_field_access_cell(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y, &corresp_field_cell))
-         {
-            if (corresp_field_cell.occupied)
-            {
-               // Rotation collides with play field
-               return true;
-            }
-         }
-      }
-   }
-
-   // No collision detected
-   return false;
-}
-
-bool help_tetro_drop(const struct tetro_world_s * TETRO, struct play_field_s * play_field, int * out_plot_row_min, int * out_plot_row_max)
-{
-   if (NULL == TETRO || NULL == play_field || NULL == out_plot_row_min || NULL == out_plot_row_max) return false;
-
-   // Keep track of play field region plotted for line deletion
-   int plot_row_min = 0;
-   int plot_row_max = PLAY_FIELD_HEIGHT - 1;
-
-   // Plotting
-   for (int ty = 0; ty < TETRO->data.size; ++ty)
-   {
-      for (int tx = 0; tx < TETRO->data.size; ++tx)
-      {
-         // Ignore non-plotted design cells
-         const bool DESIGN_CELL_PLOTTED = TETRO->data.design[tx][ty];
-         if (false == DESIGN_CELL_PLOTTED)
-         {
-            continue;
-         }
-
-         // Ignore cells out of play field
-         const struct vec_2i_s TETRO_TILE_CELL_POS = vec_2i_make_xy(TETRO->tile_pos.x + tx, TETRO->tile_pos.y + ty);
-         const bool DESIGN_CELL_OUT_OF_PLAY_FIELD_BOUNDS = help_play_field_coords_out_of_bounds(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y);
-         if (DESIGN_CELL_OUT_OF_PLAY_FIELD_BOUNDS)
-         {
-            continue;
-         }
-
-         // Overlapping occupied play field cell is considered a collision
-         const bool PLAY_FIELD_CELL_OCCUPIED = play_field->cells[TETRO_TILE_CELL_POS.x][TETRO_TILE_CELL_POS.y].occupied;
-         if (PLAY_FIELD_CELL_OCCUPIED)
-         {
-            // This should never happen
-            printf("\nPlotting on occupied play field cell!");
-            continue;
-         }
-
-         // Plot design cell into the play field
-         play_field->cells[TETRO_TILE_CELL_POS.x][TETRO_TILE_CELL_POS.y] = help_play_field_cell_make(TETRO->data.type, true);
-
-         // Keep track of plotted row range
-         if (TETRO_TILE_CELL_POS.y < plot_row_max)
-         {
-            plot_row_max = TETRO_TILE_CELL_POS.y;
-         }
-         if (TETRO_TILE_CELL_POS.y > plot_row_min)
-         {
-            plot_row_min = TETRO_TILE_CELL_POS.y;
-         }
-      }
-   }
-
-   // Communicate plot region
-   *out_plot_row_min = plot_row_max;
-   *out_plot_row_max = plot_row_min;
-
-   // Success
-   return true;
-}
-
-// Helpers - Lists
-struct list_of_rows_s {
-   int list[PLAY_FIELD_HEIGHT];
-   int count;
-};
-
-struct list_of_rows_s list_of_rows_make_empty(void)
-{
-   struct list_of_rows_s lor;
-
-   lor.count = 0;
-
-   return lor;
-}
-
-bool list_of_rows_append(struct list_of_rows_s * lor, int row)
-{
-   if (NULL == lor || lor->count >= PLAY_FIELD_HEIGHT) return false;
-
-   lor->list[lor->count++] = row;
-
-   return true;
-}
-
-// Helpers - Line deletion
-struct list_of_rows_s help_play_field_list_of_full_rows(struct play_field_s * play_field)
-{
-   struct list_of_rows_s lor = list_of_rows_make_empty();
-   if (NULL == play_field) return lor;
-
-   for (int row = 0; row < PLAY_FIELD_HEIGHT; ++row)
-   {
-      // Row full ?
-      int occupied_columns = 0;
-      for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
-      {
-         if (play_field->cells[col][row].occupied)
-         {
-            ++occupied_columns;
-         }
-      }
-
-      if (PLAY_FIELD_WIDTH == occupied_columns)
-      {
-         const bool ROW_ADDED = list_of_rows_append(&lor, row);
-         if (false == ROW_ADDED)
-         {
-            // This should never occur
-            printf("\nFull play field row %d could not be added to full list of rows !", row);
-         }
-      }
-   }
-
-   return lor;
-}
-
-// Helpers - Font rendering
-struct font_render_glyph_s {
-   bool is_mapped;
-   enum sprite_map_tile_e sprite_tile;
-};
-
-#define FONT_RENDER_MAX_GLYPHS (256)
-struct font_render_s {
-   struct font_render_glyph_s glyphs[FONT_RENDER_MAX_GLYPHS];
-};
-
-struct font_render_glyph_s font_render_glyph_make_mapped(enum sprite_map_tile_e sprite_tile)
-{
-   struct font_render_glyph_s glyph;
-
-   glyph.is_mapped = true;
-   glyph.sprite_tile = sprite_tile;
-
-   return glyph;
-}
-
-bool font_render_make(struct font_render_s * instance)
-{
-   if (NULL == instance) return false;
-
-   // Start with all glyphs as non-mapped
-   for (int ascii_code = 0; ascii_code < FONT_RENDER_MAX_GLYPHS; ++ascii_code)
-   {
-      struct font_render_glyph_s * new_glyph = instance->glyphs + ascii_code;
-
-      // Un-mapped glyphs are un-usable, so the type does not matter
-      new_glyph->is_mapped = false;
-   }
-
-   return true;
-}
-
-bool help_font_render_ascii_code_in_valid(int ascii_code)
-{
-   return (ascii_code < 0 || ascii_code >= FONT_RENDER_MAX_GLYPHS) ? true : false;
-}
-
-bool help_font_render_map_ascii_to_sprite(struct font_render_s * instance, char character, enum sprite_map_tile_e sprite_tile)
-{
-   const int ASCII_CODE = (int)character;
-   if (NULL == instance | help_font_render_ascii_code_in_valid(ASCII_CODE)) return false;
-
-   instance->glyphs[ASCII_CODE] = font_render_glyph_make_mapped(sprite_tile);
-
-   return true;
-}
-
-bool help_font_render_char_mapped(struct font_render_s * instance, char character)
-{
-   return instance && instance->glyphs[(int)character].is_mapped;
-}
-
-// Additional engine based rendering
-bool help_engine_render_tinted_text_at_tile_internal(struct engine_s * engine, const char * text, int tile_x, int tile_y, bool do_tint, color_rgba_t tint)
-{
-   if (NULL == engine || NULL == text) return false;
-
-   struct vec_2i_s tile_cursor = vec_2i_make_xy(tile_x, tile_y);
-
-   for (int i_char = 0; i_char < strlen(text); ++i_char)
-   {
-      const char TEXT_CHAR_UPPERCASED = toupper(text[i_char]);
-
-      if ('\n' == TEXT_CHAR_UPPERCASED)
-      {
-         // Newline
-         tile_cursor.x = tile_x;
-         tile_cursor.y -= 1;
-      }
-      else if ('\t' == TEXT_CHAR_UPPERCASED)
-      {
-         // Horizontal tab
-         const int SPACES_PER_TAB = 1;
-         tile_cursor.x += SPACES_PER_TAB;
-      }
-      else if (' ' == TEXT_CHAR_UPPERCASED)
-      {
-         // Space
-         tile_cursor.x += 1;
-      }
-      else if (help_font_render_char_mapped(engine->font_render, TEXT_CHAR_UPPERCASED))
-      {
-         // Renderable font character
-         const int CHAR_ASCII = (int)TEXT_CHAR_UPPERCASED;
-         help_render_engine_sprite_tinted(
-            engine,
-            tile_cursor.x * PLAY_FIELD_TILE_SIZE,
-            tile_cursor.y * PLAY_FIELD_TILE_SIZE,
-            engine->font_render->glyphs[CHAR_ASCII].sprite_tile,
-            do_tint,
-            tint
-         );
-
-         tile_cursor.x += 1;
-      }
-      else
-      {
-         // Not supported
-         printf("\nCannot render un-supported ascii glyph '%d'", (int)TEXT_CHAR_UPPERCASED);
-
-         // Render debug thing
-         help_render_engine_sprite(
-            engine,
-            tile_cursor.x * PLAY_FIELD_TILE_SIZE,
-            tile_cursor.y * PLAY_FIELD_TILE_SIZE,
-            SPRITE_MAP_TILE_NA
-         );
-
-         tile_cursor.x += 1;
-      }
-   }
-
-   // Success
-   return true;
-}
-
-bool help_engine_render_text_at_tile(struct engine_s * engine, const char * text, int tile_x, int tile_y)
-{
-   return help_engine_render_tinted_text_at_tile_internal(engine, text, tile_x, tile_y, false, color_rgba_make_rgba(0xFF, 0, 0xFF, 0xFF));
-}
-
-bool help_engine_render_tinted_text_at_tile(struct engine_s * engine, const char * text, int tile_x, int tile_y, color_rgba_t tint)
-{
-   return help_engine_render_tinted_text_at_tile_internal(engine, text, tile_x, tile_y, true, tint);
-}
-
-// Helpers - Levels
-struct score_level_mapping_s {
-   int threshold_score;
-   int mapped_level;
-};
-
-struct score_level_mapping_s score_level_mapping_make(int threshold_score, int mapped_level)
-{
-   struct score_level_mapping_s mapping;
-
-   mapping.threshold_score = threshold_score;
-   mapping.mapped_level = mapped_level;
-
-   return mapping;
-}
-
-// Helpers - Limits
-float help_limit_clamp_f(float floor, float value, float ceiling)
-{
-   if (value < floor)
-   {
-      return floor;
-   }
-   else if (value > ceiling)
-   {
-      return ceiling;
-   }
-   else
-   {
-      return value;
-   }
-}
-
-int help_limit_clamp_i(int floor, int value, int ceiling)
-{
-   if (value < floor)
-   {
-      return floor;
-   }
-   else if (value > ceiling)
-   {
-      return ceiling;
-   }
-   else
-   {
-      return value;
-   }
-}
-
-// Helpers - Audio
-typedef int audio_mixer_sample_id_t;
-const audio_mixer_sample_id_t AUDIO_MIXER_SAMPLE_ID_INVALID = -1;
-
-struct sdl_audio_data_s {
-   SDL_AudioSpec spec;
-   Uint8 * data;
-   Uint32 length;
-};
-
-struct audio_mixer_sample_s {
-   struct sdl_audio_data_s * audio;
-   bool active;
-   Uint32 playback_position;
-   bool is_music;
-   bool loop_music;
-};
-
-#define AUDIO_MIXER_MAX_SAMPLE_STORE_COUNT (64)
-#define AUDIO_MIXER_MAX_SAMPLE_QUEUED_COUNT (64)
-
-struct audio_mixer_s {
-   // Playback
-   SDL_AudioDeviceID playback_device_id;
-   SDL_AudioStream * playback_stream;
-   // Audio sample source
-   struct sdl_audio_data_s samples_store[AUDIO_MIXER_MAX_SAMPLE_STORE_COUNT];
-   int samples_store_count;
-   // Queued samples
-   struct audio_mixer_sample_s samples_queued[AUDIO_MIXER_MAX_SAMPLE_QUEUED_COUNT];
-   // Channel volume
-   float volume_music;
-   float volume_sfx;
-   // Channel pause
-   bool pause_music;
-   bool pause_sfx;
-};
-
-void * audio_mixer_destroy(struct audio_mixer_s * instance)
-{
-   if (instance)
-   {
-      // Converted samples
-      for (int i = 0; i < instance->samples_store_count; ++i)
-      {
-         SDL_free(instance->samples_store[i].data);
-      }
-
-      // Unbind device and stream
-      SDL_UnbindAudioStream(instance->playback_stream);
-
-      // Playback stream
-      SDL_DestroyAudioStream(instance->playback_stream);
-
-      // Playback audio device
-      SDL_CloseAudioDevice(instance->playback_device_id);
-
-      // Instance
-      free(instance);
-   }
-
-   return NULL;
-}
-
-struct SDL_AudioSpec audio_mixer_sdl_audio_spec_make_desired(SDL_AudioFormat desired_format, int desired_channels, int desired_frequency)
-{
-   struct SDL_AudioSpec desired_spec;
-
-   desired_spec.format = desired_format;
-   desired_spec.channels = desired_channels;
-   desired_spec.freq = desired_frequency;
-
-   return desired_spec;
-}
-
-void audio_mixer_sdl_audio_spec_log(struct SDL_AudioSpec spec)
-{
-   printf("Format: %#x | Frequency: %d | Channels: %d", spec.format, spec.freq, spec.channels);
-}
-
-struct audio_mixer_s * audio_mixer_create(SDL_AudioStreamCallback mixer_callback)
-{
-   struct audio_mixer_s * instance = malloc(sizeof(struct audio_mixer_s));
-   if (NULL == instance) return NULL;
+struct audio_mixer_s * audio_mixer_create(SDL_AudioStreamCallback mixer_callback)
+{
+   struct audio_mixer_s * instance = malloc(sizeof(struct audio_mixer_s));
+   if (NULL == instance) return NULL;
 
    // Zero instance
    instance->playback_device_id = 0;
@@ -2465,35 +787,458 @@ bool audio_mixer_stop_music(struct audio_mixer_s * instance)
       }
    }
 
-   return true;
+   return true;
+}
+
+bool audio_mixer_stop_sfx(struct audio_mixer_s * instance)
+{
+   if (NULL == instance) return false;
+
+   // De-activate all music samples
+   for (int i_sample = 0; i_sample < AUDIO_MIXER_MAX_SAMPLE_QUEUED_COUNT; ++i_sample)
+   {
+      struct audio_mixer_sample_s * const sample = instance->samples_queued + i_sample;
+      const bool SAMPLE_IS_SFX = (false == sample->is_music);
+      if (SAMPLE_IS_SFX)
+      {
+         sample->active = false;
+      }
+   }
+
+   return true;
+}
+
+bool audio_mixer_stop_music_and_sfx(struct audio_mixer_s * instance)
+{
+   return audio_mixer_stop_music(instance) && audio_mixer_stop_sfx(instance);
+}
+
+bool audio_mixer_pause_music_and_sfx(struct audio_mixer_s * instance)
+{
+   return audio_mixer_pause_music(instance) && audio_mixer_pause_sfx(instance);
+}
+
+// Logic - Frame pacing
+//
+// Without vsync frames are limited to the display refresh by sleeping most of
+// the way and spinning the rest, since sleeps overshoot. Low latency pacing
+// wakes as late as the smoothed cost of sampling input, ticking, composing and
+// presenting allows, so the presented frame shows the freshest input.
+struct frame_pacing_s {
+   bool is_limited;
+   bool is_late_sampling;
+   double period;
+   double next_present;
+   // >> Smoothed seconds from input sample to present, rises at once and decays slowly
+   double work_estimate;
+   double time_input_sample;
+   // Latency log and statistics
+   FILE * log;
+   double latency_total;
+   double latency_max;
+   unsigned long frames;
+};
+
+void help_frame_pacing_sleep_until(double deadline)
+{
+   const double SPIN_SECONDS = 0.002;
+   const double REMAINING = deadline - help_sdl_time_in_seconds();
+   if (REMAINING > SPIN_SECONDS)
+   {
+      SDL_DelayNS((Uint64)((REMAINING - SPIN_SECONDS) * 1000000000.0));
+   }
+   while (help_sdl_time_in_seconds() < deadline)
+   {
+      // Spin
+   }
+}
+
+void help_frame_pacing_wait(struct frame_pacing_s * pacing)
+{
+   if (false == pacing->is_limited) return;
+
+   // Fell behind or idled - Start over from now instead of rushing frames
+   const double NOW = help_sdl_time_in_seconds();
+   if (pacing->next_present < NOW)
+   {
+      pacing->next_present = NOW;
+   }
+
+   const double WAKE_MARGIN = 0.001;
+   const double WAKE = pacing->is_late_sampling ? pacing->next_present - pacing->work_estimate - WAKE_MARGIN : pacing->next_present;
+   help_frame_pacing_sleep_until(WAKE);
+}
+
+void help_frame_pacing_input_sampled(struct frame_pacing_s * pacing)
+{
+   pacing->time_input_sample = help_sdl_time_in_seconds();
+}
+
+void help_frame_pacing_presented(struct frame_pacing_s * pacing)
+{
+   const double TIME_PRESENTED = help_sdl_time_in_seconds();
+   const double LATENCY = TIME_PRESENTED - pacing->time_input_sample;
+   pacing->work_estimate = (LATENCY > pacing->work_estimate) ? LATENCY : (pacing->work_estimate * 0.9 + LATENCY * 0.1);
+   pacing->next_present += pacing->period;
+
+   // Statistics
+   pacing->latency_total += LATENCY;
+   pacing->latency_max = (LATENCY > pacing->latency_max) ? LATENCY : pacing->latency_max;
+   if (pacing->log)
+   {
+      fprintf(pacing->log, "%lu,%.6f,%.6f,%.3f\n", pacing->frames, pacing->time_input_sample, TIME_PRESENTED, LATENCY * 1000.0);
+   }
+   ++pacing->frames;
+}
+
+// Logic - Game loop
+//
+// Simulation side of the game, ticked either from the main loop or from a
+// thread of its own. Every call publishes the newest tick as a render state
+// snapshot, so composing and presenting never wait on the simulation and a
+// slow present never holds back ticks.
+struct game_loop_s {
+   // Simulation and its input sources
+   struct sim_s sim;
+   struct sim_events_s sim_events;
+   struct replay_s * replay;
+   struct replay_cursor_s replay_cursor;
+   bool replay_finished;
+   struct replay_recorder_s * replay_recorder;
+   struct player_s * bot_player;
+   // >> Exactly one tick per advance whatever the wall clock says, frames are then reproducible
+   bool is_lockstep;
+   // >> Input of the last tick, new keyboard input takes effect with the next one
+   sim_input_t keys_ticked;
+   // Audio
+   struct audio_mixer_s * audio_mixer;
+   audio_mixer_sample_id_t sfx_samples[SIM_SFX_COUNT];
+   audio_mixer_sample_id_t music_samples[SIM_MUSIC_COUNT];
+   // Integration
+   double last_time_tick;
+   double fixed_delta_time_accumulator;
+   // Shared with the main thread
+   struct render_snapshots_s * snapshots;
+   atomic_uint keys_down;
+   // >> Replay playback speed multiplier, zero runs as many ticks as fit a frame
+   atomic_int replay_speed;
+   atomic_int replay_seek_delta;
+   atomic_bool close_requested;
+   // >> Registered event pushed on publish to wake an idle main thread, zero when ticked on the main thread
+   Uint32 wake_event_type;
+   atomic_bool wake_pending;
+};
+
+void help_game_loop_publish(struct game_loop_s * loop)
+{
+   // Volumes only matter while the overlay shows them
+   struct render_volumes_s volumes;
+   const bool VOLUMES_KNOWN = (
+      sim_volume_overlay_visible(&loop->sim) &&
+      audio_mixer_get_volume_music(loop->audio_mixer, &volumes.music) &&
+      audio_mixer_get_volume_sfx(loop->audio_mixer, &volumes.sfx)
+   );
+   *help_render_snapshots_back(loop->snapshots) = render_state_make(&loop->sim, VOLUMES_KNOWN ? &volumes : NULL);
+   help_render_snapshots_publish(loop->snapshots);
+
+   // One wake up until the main thread acquires again, however many ticks publish meanwhile
+   if (loop->wake_event_type && false == atomic_exchange(&loop->wake_pending, true))
+   {
+      SDL_Event wake_event;
+      SDL_zero(wake_event);
+      wake_event.type = loop->wake_event_type;
+      SDL_PushEvent(&wake_event);
+   }
+}
+
+void help_game_loop_advance(struct game_loop_s * loop)
+{
+   const double FIXED_DELTA_TIME = SIM_FIXED_DELTA_TIME;
+   const float VOLUME_ADJUST_STEP_PER_PRESS = 0.1f;
+   const int REPLAY_SPEED = atomic_load(&loop->replay_speed);
+
+   // Replay seeks requested by the main thread
+   const int SEEK_DELTA = atomic_exchange(&loop->replay_seek_delta, 0);
+   bool is_changed = false;
+   if (SEEK_DELTA && loop->replay)
+   {
+      const uint32_t SEEK_TICK = (uint32_t)help_minmax_max_2i(0, (int)loop->replay_cursor.tick + SEEK_DELTA);
+      if (replay_seek(loop->replay, &loop->sim, &loop->replay_cursor, SEEK_TICK))
+      {
+         // Restart the music of the state sought to, the events that started it were skipped
+         loop->replay_finished = false;
+         audio_mixer_stop_music_and_sfx(loop->audio_mixer);
+         bool music_loop = true;
+         const enum sim_music_e MUSIC = sim_current_music(&loop->sim, &music_loop);
+         if (SIM_MUSIC_NONE != MUSIC)
+         {
+            audio_mixer_queue_sample_music(loop->audio_mixer, loop->music_samples[MUSIC], music_loop);
+         }
+         if (GAME_STATE_PAUSE == sim_game_state(&loop->sim))
+         {
+            audio_mixer_pause_music(loop->audio_mixer);
+         }
+         else
+         {
+            audio_mixer_resume_music(loop->audio_mixer);
+         }
+         is_changed = true;
+      }
+   }
+
+   // Ticks due since the last call
+   const double NEW_TIME = help_sdl_time_in_seconds();
+   const double LAST_FRAME_DURATION = NEW_TIME - loop->last_time_tick;
+   loop->last_time_tick = NEW_TIME;
+   const bool REPLAY_UNTHROTTLED = loop->replay && 0 == REPLAY_SPEED;
+   const bool REPLAY_FAST_FORWARD = loop->replay && 1 != REPLAY_SPEED;
+   loop->fixed_delta_time_accumulator += LAST_FRAME_DURATION * (REPLAY_SPEED ? REPLAY_SPEED : 1);
+   if (loop->is_lockstep)
+   {
+      loop->fixed_delta_time_accumulator = FIXED_DELTA_TIME;
+   }
+
+   // Iterative fixed time step integration - Only the last tick is rendered
+   while (
+      loop->fixed_delta_time_accumulator >= FIXED_DELTA_TIME ||
+      (REPLAY_UNTHROTTLED && false == loop->replay_finished && help_sdl_time_in_seconds() < NEW_TIME + REPLAY_UNTHROTTLED_FRAME_BUDGET)
+   )
+   {
+      // Tick housekeeping
+      loop->fixed_delta_time_accumulator -= FIXED_DELTA_TIME;
+
+      // Input from replay, bot or keyboard
+      sim_input_t tick_input = 0;
+      if (loop->bot_player)
+      {
+         tick_input = player_input(loop->bot_player, &loop->sim);
+      }
+      else if (NULL == loop->replay)
+      {
+         tick_input = (sim_input_t)atomic_load(&loop->keys_down);
+      }
+      else if (false == loop->replay_finished && false == replay_cursor_next(loop->replay, &loop->replay_cursor, &tick_input))
+      {
+         loop->replay_finished = true;
+         printf("\nReplay finished after %u ticks - %s", loop->replay_cursor.tick, (sim_state_hash(&loop->sim) == loop->replay->header->final_state_hash) ? "matches recording" : "diverged from recording");
+      }
+      if (loop->replay_recorder)
+      {
+         replay_recorder_push(loop->replay_recorder, &loop->sim, tick_input);
+      }
+
+      // Simulate with current input state
+      sim_step(&loop->sim, tick_input, &loop->sim_events);
+      loop->keys_ticked = tick_input;
+      is_changed = true;
+
+      // Present simulation events
+      for (int i_event = 0; i_event < loop->sim_events.count; ++i_event)
+      {
+         const struct sim_event_s * EVENT = loop->sim_events.list + i_event;
+         switch (EVENT->type)
+         {
+            case SIM_EVENT_SFX:
+               if (false == REPLAY_FAST_FORWARD)
+               {
+                  audio_mixer_queue_sample_sfx(loop->audio_mixer, loop->sfx_samples[EVENT->value]);
+               }
+               break;
+            case SIM_EVENT_MUSIC_PLAY:
+               audio_mixer_queue_sample_music(loop->audio_mixer, loop->music_samples[EVENT->value], EVENT->loop);
+               break;
+            case SIM_EVENT_MUSIC_STOP:
+               audio_mixer_stop_music(loop->audio_mixer);
+               break;
+            case SIM_EVENT_MUSIC_PAUSE:
+               audio_mixer_pause_music(loop->audio_mixer);
+               break;
+            case SIM_EVENT_MUSIC_RESUME:
+               audio_mixer_resume_music(loop->audio_mixer);
+               break;
+            case SIM_EVENT_AUDIO_STOP_ALL:
+               audio_mixer_stop_music_and_sfx(loop->audio_mixer);
+               break;
+            case SIM_EVENT_AUDIO_RESUME_ALL:
+               audio_mixer_resume_music_and_sfx(loop->audio_mixer);
+               break;
+            case SIM_EVENT_VOLUME_ADJUST:
+            {
+               float adjusted_volume_music, adjusted_volume_sfx;
+               audio_mixer_increase_volume_music_and_sfx_by(loop->audio_mixer, EVENT->value * VOLUME_ADJUST_STEP_PER_PRESS, &adjusted_volume_music, &adjusted_volume_sfx);
+               break;
+            }
+            case SIM_EVENT_QUIT:
+               atomic_store(&loop->close_requested, true);
+               break;
+            default:
+               break;
+         }
+      }
+   }
+
+   // Unthrottled replay ticks are not paid back by later frames
+   if (REPLAY_UNTHROTTLED && loop->fixed_delta_time_accumulator < 0.0)
+   {
+      loop->fixed_delta_time_accumulator = 0.0;
+   }
+
+   // Only the last tick is rendered
+   if (is_changed)
+   {
+      help_game_loop_publish(loop);
+   }
+}
+
+double help_game_loop_seconds_until_change(struct game_loop_s * loop)
+{
+   // Lockstep and unthrottled replays never idle
+   const double FIXED_DELTA_TIME = SIM_FIXED_DELTA_TIME;
+   const int REPLAY_SPEED = atomic_load(&loop->replay_speed);
+   const bool REPLAY_PLAYING = loop->replay && false == loop->replay_finished;
+   if (loop->is_lockstep || (REPLAY_PLAYING && 0 == REPLAY_SPEED)) return 0.0;
+
+   // Played input may change any tick, steady input only matters to timers
+   const bool INPUT_STEADY = (
+      NULL == loop->bot_player &&
+      false == REPLAY_PLAYING &&
+      (loop->replay || atomic_load(&loop->keys_down) == loop->keys_ticked)
+   );
+   const uint32_t TICKS_UNTIL_CHANGE = INPUT_STEADY ? sim_ticks_until_timer(&loop->sim) : 1;
+   if (SIM_TICKS_NEVER == TICKS_UNTIL_CHANGE) return -1.0;
+
+   return (TICKS_UNTIL_CHANGE * FIXED_DELTA_TIME - loop->fixed_delta_time_accumulator) / (REPLAY_SPEED ? REPLAY_SPEED : 1);
+}
+
+void help_game_loop_wait_idle(struct game_loop_s * loop, bool is_threaded)
+{
+   // A simulation on its own thread wakes this one when it publishes
+   const double UNTIL_CHANGE = is_threaded ? -1.0 : help_game_loop_seconds_until_change(loop);
+   const int WAIT_MS = (UNTIL_CHANGE < 0.0) ? IDLE_WAIT_MAX_MS : help_limit_clamp_i(0, (int)ceil(UNTIL_CHANGE * 1000.0), IDLE_WAIT_MAX_MS);
+
+   // Any event wakes up early, it is consumed by the next frame
+   SDL_WaitEventTimeout(NULL, WAIT_MS);
+}
+
+int help_game_loop_thread(void * data)
+{
+   struct game_loop_s * loop = data;
+   const double FIXED_DELTA_TIME = SIM_FIXED_DELTA_TIME;
+   while (false == atomic_load(&loop->close_requested))
+   {
+      help_game_loop_advance(loop);
+
+      // Sleep until the next tick is due, unthrottled replays only yield
+      const int REPLAY_SPEED = atomic_load(&loop->replay_speed);
+      if (loop->replay && 0 == REPLAY_SPEED && false == loop->replay_finished)
+      {
+         SDL_Delay(0);
+         continue;
+      }
+      const double UNTIL_NEXT_TICK = (FIXED_DELTA_TIME - loop->fixed_delta_time_accumulator) / (REPLAY_SPEED ? REPLAY_SPEED : 1);
+      if (UNTIL_NEXT_TICK > 0.0)
+      {
+         SDL_DelayPrecise((Uint64)(UNTIL_NEXT_TICK * 1000000000.0));
+      }
+   }
+
+   return 0;
 }
 
-bool audio_mixer_stop_sfx(struct audio_mixer_s * instance)
-{
-   if (NULL == instance) return false;
+// Logic - Backend comparison
+//
+// The CPU compositor against the geometry batch on one renderer, drawing the
+// same bot played frames at several window sizes with vsync off. The compositor
+// composes the whole frame, uploads it and scales it, the batch records the
+// frame and draws its quads. Every frame is presented.
+#define BACKEND_BENCH_FRAMES (600)
+#define BACKEND_BENCH_TICK_STRIDE (10)
+const int BACKEND_BENCH_WINDOW_SIZES[][2] = { { 160, 144 }, { 640, 576 }, { 1280, 720 }, { 1920, 1080 } };
 
-   // De-activate all music samples
-   for (int i_sample = 0; i_sample < AUDIO_MIXER_MAX_SAMPLE_QUEUED_COUNT; ++i_sample)
+double help_backend_bench_frames(SDL_Renderer * sdl_renderer, SDL_Texture * sdl_texture, struct engine_s * engine, struct render_geometry_s * geometry, const struct render_state_s * states, int state_count, SDL_FRect virtual_region)
+{
+   // Seconds per frame - The texture is the online one for the compositor and the atlas for the batch
+   const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(engine->tex_virtual);
+   const double TIME_START = help_sdl_time_in_seconds();
+   for (int i_state = 0; i_state < state_count; ++i_state)
    {
-      struct audio_mixer_sample_s * const sample = instance->samples_queued + i_sample;
-      const bool SAMPLE_IS_SFX = (false == sample->is_music);
-      if (SAMPLE_IS_SFX)
+      SDL_SetRenderDrawColor(sdl_renderer, 0x00, 0x00, 0x00, 0xFF);
+      SDL_RenderClear(sdl_renderer);
+      if (geometry)
       {
-         sample->active = false;
+         help_engine_record_state(engine, states + i_state);
+         help_render_geometry_build(geometry, engine->commands, engine->sprite_map, VIRTUAL_SIZE.y, virtual_region.x, virtual_region.y, virtual_region.w / VIRTUAL_SIZE.x);
+         help_sdl_render_geometry(sdl_renderer, sdl_texture, geometry, virtual_region);
       }
+      else
+      {
+         help_engine_render_state(engine, states + i_state);
+         SDL_UpdateTexture(sdl_texture, NULL, engine->tex_virtual->texels, sizeof(color_rgba_t) * VIRTUAL_SIZE.x);
+         SDL_RenderTexture(sdl_renderer, sdl_texture, NULL, &virtual_region);
+      }
+      SDL_RenderPresent(sdl_renderer);
    }
 
-   return true;
+   return (help_sdl_time_in_seconds() - TIME_START) / state_count;
 }
 
-bool audio_mixer_stop_music_and_sfx(struct audio_mixer_s * instance)
+bool help_backend_bench_run(SDL_Window * sdl_window, SDL_Renderer * sdl_renderer, SDL_Texture * sdl_texture_online, SDL_Texture * sdl_texture_atlas, struct engine_s * engine, struct layer_cache_s * layer_cache, struct render_geometry_s * geometry, uint32_t seed)
 {
-   return audio_mixer_stop_music(instance) && audio_mixer_stop_sfx(instance);
-}
+   if (NULL == sdl_renderer || NULL == sdl_texture_online || NULL == sdl_texture_atlas || NULL == engine || NULL == geometry) return false;
 
-bool audio_mixer_pause_music_and_sfx(struct audio_mixer_s * instance)
-{
-   return audio_mixer_pause_music(instance) && audio_mixer_pause_sfx(instance);
+   // Bot play through menus and gameplay
+   struct render_state_s * states = malloc(sizeof(struct render_state_s) * BACKEND_BENCH_FRAMES);
+   if (NULL == states) return false;
+   struct sim_s sim;
+   struct player_s player;
+   sim_init(&sim, seed, TETRO_RANDOMIZER_CLASSIC);
+   player_init(&player, PLAYER_KIND_BOT, seed);
+   for (int i_state = 0; i_state < BACKEND_BENCH_FRAMES; ++i_state)
+   {
+      states[i_state] = render_state_make(&sim, NULL);
+      for (int i_tick = 0; i_tick < BACKEND_BENCH_TICK_STRIDE; ++i_tick)
+      {
+         sim_step(&sim, player_input(&player, &sim), NULL);
+      }
+   }
+
+   // Windowed at each size, nothing waits for the display
+   SDL_SetRenderVSync(sdl_renderer, 0);
+   SDL_SetWindowFullscreen(sdl_window, false);
+   const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(engine->tex_virtual);
+   const int SIZE_COUNT = sizeof(BACKEND_BENCH_WINDOW_SIZES) / sizeof(BACKEND_BENCH_WINDOW_SIZES[0]);
+   printf("\n\nBackend comparison [ms/frame] (%s renderer, %d frames)", SDL_GetRendererName(sdl_renderer), BACKEND_BENCH_FRAMES);
+   printf("\n\t%-12s %6s %14s %14s %8s", "window", "scale", "cpu composite", "geometry", "speedup");
+   for (int i_size = 0; i_size < SIZE_COUNT; ++i_size)
+   {
+      SDL_SetWindowSize(sdl_window, BACKEND_BENCH_WINDOW_SIZES[i_size][0], BACKEND_BENCH_WINDOW_SIZES[i_size][1]);
+      SDL_SyncWindow(sdl_window);
+      const struct vec_2i_s WINDOW_SIZE = help_sdl_window_size(sdl_window);
+      const SDL_FRect VIRTUAL_REGION = help_virtual_max_render_scale_region_aligned(WINDOW_SIZE, VIRTUAL_SIZE);
+
+      // Compositor with its static layers, the batch draws layers as quads
+      engine->layer_cache = layer_cache;
+      const double SECONDS_COMPOSITE = help_backend_bench_frames(sdl_renderer, sdl_texture_online, engine, NULL, states, BACKEND_BENCH_FRAMES, VIRTUAL_REGION);
+      engine->layer_cache = NULL;
+      const double SECONDS_GEOMETRY = help_backend_bench_frames(sdl_renderer, sdl_texture_atlas, engine, geometry, states, BACKEND_BENCH_FRAMES, VIRTUAL_REGION);
+
+      char str_window[32];
+      snprintf(str_window, sizeof(str_window), "%dx%d", WINDOW_SIZE.x, WINDOW_SIZE.y);
+      printf(
+         "\n\t%-12s %5dx %14.3f %14.3f %7.2fx",
+         str_window,
+         help_virtual_max_render_scale(WINDOW_SIZE, VIRTUAL_SIZE),
+         SECONDS_COMPOSITE * 1000.0,
+         SECONDS_GEOMETRY * 1000.0,
+         SECONDS_COMPOSITE / SECONDS_GEOMETRY
+      );
+   }
+   printf("\n\t%-*s: %.1f quads in one batch", 20, "geometry per frame", geometry->batches ? (double)geometry->quads_total / geometry->batches : 0.0);
+   printf("\n");
+   free(states);
+
+   // Success
+   return true;
 }
 
 // Logic - Main
@@ -2507,6 +1252,16 @@ int main(int argc, char * argv[])
       return EXIT_FAILURE;
    }
 
+   // Capture runs without a display or audio device, composing one frame per tick
+   const char * ARG_CAPTURE = help_args_key_value_first(argc, argv, ARG_KEY_CAPTURE);
+   const char * ARG_CAPTURE_FRAMES = help_args_key_value_first(argc, argv, ARG_KEY_CAPTURE_FRAMES);
+   const bool CAPTURE = ARG_CAPTURE || ARG_CAPTURE_FRAMES;
+   if (CAPTURE)
+   {
+      SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+      SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+   }
+
    // Initialize SDL
    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
    {
@@ -2522,21 +1277,86 @@ int main(int argc, char * argv[])
       return EXIT_FAILURE;
    }
 
+   // Present through the window surface when asked and its pixels are packed like ours - No renderer on that window then
+   enum color_packing_e surface_packing = COLOR_PACKING_RGBA;
+   bool present_surface = false;
+   if (help_args_key_present(argc, argv, ARG_KEY_SURFACE) && false == CAPTURE)
+   {
+      SDL_Surface * sdl_surface = SDL_GetWindowSurface(sdl_window);
+      present_surface = (NULL != sdl_surface && help_sdl_format_color_packing(sdl_surface->format, &surface_packing));
+      if (false == present_surface)
+      {
+         printf("\nWindow surface unusable, presenting through the renderer instead");
+         SDL_DestroyWindowSurface(sdl_window);
+      }
+   }
+   const bool PRESENT_SURFACE = present_surface;
+
    // Create SDL renderer
-   SDL_Renderer * sdl_renderer = SDL_CreateRenderer(sdl_window, NULL);
-   if (NULL == sdl_renderer)
+   SDL_Renderer * sdl_renderer = NULL;
+   if (false == PRESENT_SURFACE)
    {
-      printf("\nFailed to create SDL renderer - Error: %s", SDL_GetError());
-      return EXIT_FAILURE;
+      sdl_renderer = SDL_CreateRenderer(sdl_window, NULL);
+      if (NULL == sdl_renderer)
+      {
+         printf("\nFailed to create SDL renderer - Error: %s", SDL_GetError());
+         return EXIT_FAILURE;
+      }
    }
 
-   // Enable renderer VSYNC
-   const bool SUCCESS_USE_VSYNC = SDL_SetRenderVSync(sdl_renderer, 1);
+   // Enable renderer VSYNC unless pacing for low latency
+   const char * ARG_PACING = help_args_key_value_first(argc, argv, ARG_KEY_PACING);
+   const bool PACING_LOW_LATENCY = ARG_PACING && strcmp(ARG_PACING, ARG_VALUE_PACING_LOW_LATENCY) == 0;
+   const bool SUCCESS_USE_VSYNC = sdl_renderer && false == PACING_LOW_LATENCY && false == CAPTURE && SDL_SetRenderVSync(sdl_renderer, 1);
+   if (sdl_renderer && (PACING_LOW_LATENCY || CAPTURE))
+   {
+      SDL_SetRenderVSync(sdl_renderer, 0);
+   }
+
+   // Frame pacing - Limit to the display refresh wherever vsync does not
+   const SDL_DisplayMode * DISPLAY_MODE = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(sdl_window));
+   const double DISPLAY_REFRESH_RATE = (DISPLAY_MODE && DISPLAY_MODE->refresh_rate > 0.0f) ? DISPLAY_MODE->refresh_rate : 60.0;
+   struct frame_pacing_s pacing;
+   pacing.is_limited = false == SUCCESS_USE_VSYNC && false == CAPTURE;
+   pacing.is_late_sampling = PACING_LOW_LATENCY;
+   pacing.period = 1.0 / DISPLAY_REFRESH_RATE;
+   pacing.next_present = 0.0;
+   pacing.work_estimate = 0.0;
+   pacing.time_input_sample = 0.0;
+   pacing.log = NULL;
+   pacing.latency_total = 0.0;
+   pacing.latency_max = 0.0;
+   pacing.frames = 0;
+   const char * ARG_LATENCY_LOG = help_args_key_value_first(argc, argv, ARG_KEY_LATENCY_LOG);
+   if (ARG_LATENCY_LOG)
+   {
+      pacing.log = fopen(ARG_LATENCY_LOG, "w");
+      if (NULL == pacing.log)
+      {
+         printf("\nFailed to open latency log '%s'", ARG_LATENCY_LOG);
+         return EXIT_FAILURE;
+      }
+      fprintf(pacing.log, "frame,input_sample_s,present_s,latency_ms\n");
+   }
 
    // Other window related configuration
    SDL_SetWindowMouseGrab(sdl_window, true);
    SDL_HideCursor();
 
+   // Zero copy composes into the locked online texture - Pack colors like the renderer wants them
+   const bool ZERO_COPY = help_args_key_present(argc, argv, ARG_KEY_ZERO_COPY) && false == PRESENT_SURFACE && false == CAPTURE;
+   SDL_PixelFormat online_format = SDL_PIXELFORMAT_RGBA8888;
+   if (ZERO_COPY)
+   {
+      enum color_packing_e packing;
+      online_format = help_sdl_renderer_negotiate_format(sdl_renderer, &packing);
+      color_packing_select(packing);
+   }
+   else if (PRESENT_SURFACE)
+   {
+      color_packing_select(surface_packing);
+   }
+
    // Create offline rendering resources
    struct texture_rgba_s * tex_virtual = help_texture_rgba_make(160, 144, color_rgba_make_rgba(0x00, 0x00, 0x00, 0xFF));
    if (NULL == tex_virtual)
@@ -2546,34 +1366,30 @@ int main(int argc, char * argv[])
    }
    const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(tex_virtual);
 
-   // Create online rendering texture
-   SDL_Texture * sdl_texture_online = SDL_CreateTexture(
-      sdl_renderer,
-      SDL_PIXELFORMAT_RGBA8888,
-      SDL_TEXTUREACCESS_STREAMING,
-      VIRTUAL_SIZE.x,
-      VIRTUAL_SIZE.y
-   );
-   if (NULL == sdl_texture_online)
-   {
-      printf("\nFailed to create sdl online texture - Error: %s", SDL_GetError());
-      return EXIT_FAILURE;
-   }
-
-   // Set online texture filtering
-   const bool SUCCESS_TEXTURE_NEAREST = SDL_SetTextureScaleMode(sdl_texture_online, SDL_SCALEMODE_NEAREST);
-   if (!SUCCESS_TEXTURE_NEAREST)
+   // Create online rendering texture - Renderer presentation only
+   SDL_Texture * sdl_texture_online = NULL;
+   if (sdl_renderer)
    {
-      printf("\nFailed to set online texture filtering to nearest - Error: %s", SDL_GetError());
-      return EXIT_FAILURE;
-   }
+      sdl_texture_online = SDL_CreateTexture(
+         sdl_renderer,
+         online_format,
+         SDL_TEXTUREACCESS_STREAMING,
+         VIRTUAL_SIZE.x,
+         VIRTUAL_SIZE.y
+      );
+      if (NULL == sdl_texture_online)
+      {
+         printf("\nFailed to create sdl online texture - Error: %s", SDL_GetError());
+         return EXIT_FAILURE;
+      }
 
-   // Create input
-   struct input_s * input = help_input_make();
-   if (NULL == input)
-   {
-      printf("\nFailed to create input");
-      return EXIT_FAILURE;
+      // Set online texture filtering
+      const bool SUCCESS_TEXTURE_NEAREST = SDL_SetTextureScaleMode(sdl_texture_online, SDL_SCALEMODE_NEAREST);
+      if (!SUCCESS_TEXTURE_NEAREST)
+      {
+         printf("\nFailed to set online texture filtering to nearest - Error: %s", SDL_GetError());
+         return EXIT_FAILURE;
+      }
    }
 
    // Prepare resource strings
@@ -2591,12 +1407,61 @@ int main(int argc, char * argv[])
       return EXIT_FAILURE;
    }
 
-   // Set random rand() seed ?
-   if (CONFIG_DO_SET_RANDOM_SEED)
+   // Simulation seed
+   uint32_t sim_seed = 0;
+   const char * ARG_SEED = help_args_key_value_first(argc, argv, ARG_KEY_SEED);
+   if (ARG_SEED)
+   {
+      sim_seed = (uint32_t)strtoul(ARG_SEED, NULL, 10);
+   }
+   else if (CONFIG_DO_SET_RANDOM_SEED)
+   {
+      // @Warning: Safer i.e. higher resolution seed ?
+      sim_seed = (uint32_t)SDL_GetTicks();
+   }
+   const char * ARG_RANDOMIZER = help_args_key_value_first(argc, argv, ARG_KEY_RANDOMIZER);
+   const enum tetro_randomizer_e SIM_RANDOMIZER = (ARG_RANDOMIZER && strcmp(ARG_RANDOMIZER, ARG_VALUE_RANDOMIZER_BAG) == 0) ? TETRO_RANDOMIZER_BAG_7 : TETRO_RANDOMIZER_CLASSIC;
+
+   // Replay playback replaces keyboard input, seed and randomizer
+   const char * ARG_PLAY = help_args_key_value_first(argc, argv, ARG_KEY_PLAY);
+   struct replay_s * replay = NULL;
+   if (ARG_PLAY)
+   {
+      replay = replay_open(ARG_PLAY);
+      if (NULL == replay)
+      {
+         printf("\nFailed to open replay for playback");
+         return EXIT_FAILURE;
+      }
+      sim_seed = replay->header->seed;
+   }
+
+   // Replay recording
+   const char * ARG_RECORD = help_args_key_value_first(argc, argv, ARG_KEY_RECORD);
+   struct replay_recorder_s * replay_recorder = NULL;
+   if (ARG_RECORD)
+   {
+      replay_recorder = replay_recorder_create(sim_seed, replay ? (enum tetro_randomizer_e)replay->header->randomizer : SIM_RANDOMIZER, REPLAY_KEYFRAME_INTERVAL_DEFAULT);
+      if (NULL == replay_recorder)
+      {
+         printf("\nFailed to create replay recorder");
+         return EXIT_FAILURE;
+      }
+   }
+
+   // Lookahead bot replaces keyboard input, searching on every core
+   const bool BOT_PLAYS = help_args_key_present(argc, argv, ARG_KEY_BOT) && NULL == replay;
+   struct pool_s * bot_pool = NULL;
+   struct player_s bot_player;
+   if (BOT_PLAYS)
    {
-      // @Warning: Safer i.e. higher resolution argument fort srand() ?
-      const unsigned int SEED_RANDOM = (unsigned int)SDL_GetTicks();
-      srand(SEED_RANDOM);
+      player_init(&bot_player, PLAYER_KIND_LOOKAHEAD, sim_seed);
+      // Recordings and captures must come out the same on any machine - Depth limited unless told otherwise
+      const char * ARG_BUDGET_MS = help_args_key_value_first(argc, argv, ARG_KEY_BUDGET_MS);
+      const bool IS_REPRODUCED = ARG_RECORD || CAPTURE;
+      bot_player.bot_search.time_budget_ms = ARG_BUDGET_MS ? strtod(ARG_BUDGET_MS, NULL) : (IS_REPRODUCED ? 0.0 : bot_player.bot_search.time_budget_ms);
+      bot_pool = pool_create(pool_hardware_thread_count());
+      bot_player.bot_pool = bot_pool;
    }
 
    // Log engine status
@@ -2604,6 +1469,45 @@ int main(int argc, char * argv[])
    printf("\n\nEngine Information");
    printf("\n\t%-*s: %s", DW, "resource directory", DIR_ABS_RES);
    printf("\n\t%-*s: %s", DW, "VSYNC", SUCCESS_USE_VSYNC ? "enabled" : "disabled");
+   if (pacing.is_limited)
+   {
+      printf("\n\t%-*s: %s at %.2f Hz", DW, "pacing", pacing.is_late_sampling ? "low latency" : "limiter", DISPLAY_REFRESH_RATE);
+   }
+   else
+   {
+      printf("\n\t%-*s: vsync", DW, "pacing");
+   }
+   printf("\n\t%-*s: %u", DW, "seed", sim_seed);
+   printf("\n\t%-*s: %s", DW, "randomizer", (TETRO_RANDOMIZER_BAG_7 == SIM_RANDOMIZER) ? "7-bag" : "classic");
+   printf("\n\t%-*s: %s", DW, "replay playback", ARG_PLAY ? ARG_PLAY : "none");
+   printf("\n\t%-*s: %s", DW, "replay recording", ARG_RECORD ? ARG_RECORD : "none");
+   if (BOT_PLAYS)
+   {
+      printf("\n\t%-*s: lookahead, %.1f ms budget", DW, "bot", bot_player.bot_search.time_budget_ms);
+   }
+   else
+   {
+      printf("\n\t%-*s: none", DW, "bot");
+   }
+   if (PRESENT_SURFACE)
+   {
+      printf("\n\t%-*s: window surface (%s, %s upscale)", DW, "present", color_packing_name(surface_packing), help_upscale_kernel_name(help_upscale_kernel_best()));
+   }
+   else
+   {
+      printf("\n\t%-*s: %s (%s)", DW, "present", ZERO_COPY ? "zero-copy" : "copy", SDL_GetPixelFormatName(online_format));
+   }
+   const bool INDEXED = help_args_key_present(argc, argv, ARG_KEY_INDEXED);
+   printf("\n\t%-*s: %s", DW, "framebuffer", INDEXED ? "2bpp indexed" : "rgba");
+   // Sprites batched into renderer geometry - Needs the renderer to draw them and the recorded commands of a whole frame
+   const bool BACKEND_BENCH = help_args_key_present(argc, argv, ARG_KEY_BACKEND_BENCH);
+   const bool GEOMETRY = (help_args_key_present(argc, argv, ARG_KEY_GEOMETRY) || BACKEND_BENCH) && sdl_renderer && false == ZERO_COPY && false == INDEXED && false == CAPTURE;
+   if (BACKEND_BENCH && false == GEOMETRY)
+   {
+      printf("\nBackend comparison needs the renderer without '%s', '%s', '%s' or capture", ARG_KEY_SURFACE, ARG_KEY_ZERO_COPY, ARG_KEY_INDEXED);
+      return EXIT_FAILURE;
+   }
+   printf("\n\t%-*s: %s", DW, "sprites", GEOMETRY ? "geometry batch" : "cpu composite");
 
    // Create sprite map
    struct sprite_map_s * sprite_map = help_sprite_map_create(tex_sprites, 13, 13, 8);
@@ -2612,1071 +1516,465 @@ int main(int argc, char * argv[])
       printf("\nFailed to create sprite map");
       return EXIT_FAILURE;
    }
-   // >> Register tetro sprites
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_I, 0, 6);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_O, 1, 6);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_Lr, 2, 6);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_L, 3, 6);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_S, 4, 6);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_T, 5, 6);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_TETRO_BLOCK_Z, 6, 6);
-   // >> Register play field sprites
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_BRICK, 0, 4);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_HIGHLIGHT, 9, 4);   
-   // >> Register font rendering sprites
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_A, 0, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_B, 1, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_C, 2, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_D, 3, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_E, 4, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_F, 5, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_G, 6, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_H, 7, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_I, 8, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_J, 9, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_K, 10, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_L, 11, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_M, 12, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_N, 13, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_O, 14, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_P, 15, 0);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_Q, 0, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_R, 1, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_S, 2, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_T, 3, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_U, 4, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_V, 5, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_W, 6, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_X, 7, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_Y, 8, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_Z, 9, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_0, 0, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_1, 1, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_2, 2, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_3, 3, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_4, 4, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_5, 5, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_6, 6, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_7, 7, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_8, 8, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_9, 9, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_PERIOD, 10, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_HYPHEN, 11, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_COMMA, 12, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_COLON, 15, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_OPEN, 13, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_CLOSED, 14, 1);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_PIPE, 13, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_GLYPH_PLUS, 15, 1);
-   // >> Register additional sprites
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_COPYRIGHT, 10, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_FONT_ARROW_RIGHT, 11, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_GAME_OVER_FILL, 5, 4);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_HEART, 12, 2);
-   help_sprite_map_tile(sprite_map, SPRITE_MAP_TILE_SPEAKER, 14, 2);
-   // >> Register extended background sprites
-   help_sprite_map_tile_extended(sprite_map, SPRITE_MAP_TILE_BG_TITLE_SCREEN, 16, 0, 20, 18);
-   help_sprite_map_tile_extended(sprite_map, SPRITE_MAP_TILE_BG_CONFIG_SCREEN, 36, 0, 20, 18);
-   help_sprite_map_tile_extended(sprite_map, SPRITE_MAP_TILE_BG_PLAY_SCREEN, 16, 18, 20, 18);
-   help_sprite_map_tile_extended(sprite_map, SPRITE_MAP_TILE_BG_INPUT_MAPPING_SCREEN, 36, 18, 20, 18);
-
-   // Create font render
-   struct font_render_s font_render;
-   if (false == font_render_make(&font_render))
-   {
-      printf("\nFailed to create font render component");
-      return EXIT_FAILURE;
-   }
-   // >> map font render ascii codes to renderable sprites
-   help_font_render_map_ascii_to_sprite(&font_render, 'A', SPRITE_MAP_TILE_FONT_GLYPH_A);
-   help_font_render_map_ascii_to_sprite(&font_render, 'B', SPRITE_MAP_TILE_FONT_GLYPH_B);
-   help_font_render_map_ascii_to_sprite(&font_render, 'C', SPRITE_MAP_TILE_FONT_GLYPH_C);
-   help_font_render_map_ascii_to_sprite(&font_render, 'D', SPRITE_MAP_TILE_FONT_GLYPH_D);
-   help_font_render_map_ascii_to_sprite(&font_render, 'E', SPRITE_MAP_TILE_FONT_GLYPH_E);
-   help_font_render_map_ascii_to_sprite(&font_render, 'F', SPRITE_MAP_TILE_FONT_GLYPH_F);
-   help_font_render_map_ascii_to_sprite(&font_render, 'G', SPRITE_MAP_TILE_FONT_GLYPH_G);
-   help_font_render_map_ascii_to_sprite(&font_render, 'H', SPRITE_MAP_TILE_FONT_GLYPH_H);
-   help_font_render_map_ascii_to_sprite(&font_render, 'I', SPRITE_MAP_TILE_FONT_GLYPH_I);
-   help_font_render_map_ascii_to_sprite(&font_render, 'J', SPRITE_MAP_TILE_FONT_GLYPH_J);
-   help_font_render_map_ascii_to_sprite(&font_render, 'K', SPRITE_MAP_TILE_FONT_GLYPH_K);
-   help_font_render_map_ascii_to_sprite(&font_render, 'L', SPRITE_MAP_TILE_FONT_GLYPH_L);
-   help_font_render_map_ascii_to_sprite(&font_render, 'M', SPRITE_MAP_TILE_FONT_GLYPH_M);
-   help_font_render_map_ascii_to_sprite(&font_render, 'N', SPRITE_MAP_TILE_FONT_GLYPH_N);
-   help_font_render_map_ascii_to_sprite(&font_render, 'O', SPRITE_MAP_TILE_FONT_GLYPH_O);
-   help_font_render_map_ascii_to_sprite(&font_render, 'P', SPRITE_MAP_TILE_FONT_GLYPH_P);
-   help_font_render_map_ascii_to_sprite(&font_render, 'Q', SPRITE_MAP_TILE_FONT_GLYPH_Q);
-   help_font_render_map_ascii_to_sprite(&font_render, 'R', SPRITE_MAP_TILE_FONT_GLYPH_R);
-   help_font_render_map_ascii_to_sprite(&font_render, 'S', SPRITE_MAP_TILE_FONT_GLYPH_S);
-   help_font_render_map_ascii_to_sprite(&font_render, 'T', SPRITE_MAP_TILE_FONT_GLYPH_T);
-   help_font_render_map_ascii_to_sprite(&font_render, 'U', SPRITE_MAP_TILE_FONT_GLYPH_U);
-   help_font_render_map_ascii_to_sprite(&font_render, 'V', SPRITE_MAP_TILE_FONT_GLYPH_V);
-   help_font_render_map_ascii_to_sprite(&font_render, 'W', SPRITE_MAP_TILE_FONT_GLYPH_W);
-   help_font_render_map_ascii_to_sprite(&font_render, 'X', SPRITE_MAP_TILE_FONT_GLYPH_X);
-   help_font_render_map_ascii_to_sprite(&font_render, 'Y', SPRITE_MAP_TILE_FONT_GLYPH_Y);
-   help_font_render_map_ascii_to_sprite(&font_render, 'Z', SPRITE_MAP_TILE_FONT_GLYPH_Z);
-   help_font_render_map_ascii_to_sprite(&font_render, '0', SPRITE_MAP_TILE_FONT_GLYPH_0);
-   help_font_render_map_ascii_to_sprite(&font_render, '1', SPRITE_MAP_TILE_FONT_GLYPH_1);
-   help_font_render_map_ascii_to_sprite(&font_render, '2', SPRITE_MAP_TILE_FONT_GLYPH_2);
-   help_font_render_map_ascii_to_sprite(&font_render, '3', SPRITE_MAP_TILE_FONT_GLYPH_3);
-   help_font_render_map_ascii_to_sprite(&font_render, '4', SPRITE_MAP_TILE_FONT_GLYPH_4);
-   help_font_render_map_ascii_to_sprite(&font_render, '5', SPRITE_MAP_TILE_FONT_GLYPH_5);
-   help_font_render_map_ascii_to_sprite(&font_render, '6', SPRITE_MAP_TILE_FONT_GLYPH_6);
-   help_font_render_map_ascii_to_sprite(&font_render, '7', SPRITE_MAP_TILE_FONT_GLYPH_7);
-   help_font_render_map_ascii_to_sprite(&font_render, '8', SPRITE_MAP_TILE_FONT_GLYPH_8);
-   help_font_render_map_ascii_to_sprite(&font_render, '9', SPRITE_MAP_TILE_FONT_GLYPH_9);
-   help_font_render_map_ascii_to_sprite(&font_render, '.', SPRITE_MAP_TILE_FONT_GLYPH_PERIOD);
-   help_font_render_map_ascii_to_sprite(&font_render, '-', SPRITE_MAP_TILE_FONT_GLYPH_HYPHEN);
-   help_font_render_map_ascii_to_sprite(&font_render, ',', SPRITE_MAP_TILE_FONT_GLYPH_COMMA);
-   help_font_render_map_ascii_to_sprite(&font_render, '(', SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_OPEN);
-   help_font_render_map_ascii_to_sprite(&font_render, ')', SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_CLOSED);
-   help_font_render_map_ascii_to_sprite(&font_render, '|', SPRITE_MAP_TILE_FONT_GLYPH_PIPE);
-   help_font_render_map_ascii_to_sprite(&font_render, '+', SPRITE_MAP_TILE_FONT_GLYPH_PLUS);
-   help_font_render_map_ascii_to_sprite(&font_render, ':', SPRITE_MAP_TILE_FONT_GLYPH_COLON);
-
-   // Map score to level
-   struct score_level_mapping_s score_level_mapping[] = {
-      score_level_mapping_make(0, 0),
-      score_level_mapping_make(20, 1),
-      score_level_mapping_make(40, 2),
-      score_level_mapping_make(60, 3),
-      score_level_mapping_make(80, 4),
-      score_level_mapping_make(100, 5),
-      score_level_mapping_make(120, 6),
-      score_level_mapping_make(140, 7),
-      score_level_mapping_make(160, 8),
-      score_level_mapping_make(180, 9)
-   };
-
-   // Setup audio mixer
-   struct audio_mixer_s * audio_mixer = audio_mixer_create(audio_mixer_callback);
-   if (NULL == audio_mixer)
+   if (false == help_sprite_map_register_tiles(sprite_map))
    {
-      printf("\nFailed to create audio mixer");
+      printf("\nFailed to register sprite map tiles");
       return EXIT_FAILURE;
    }
-   // >> Register audio mixer music and sound effects
-   const audio_mixer_sample_id_t AMSID_MUSIC_TITLE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "title"));
-   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_A_TYPE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "a-type"));
-   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_B_TYPE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "b-type"));
-   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_C_TYPE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "c-type"));
-   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_OVER = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "game-over"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_SPLASH = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "splash"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_INVALID = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "invalid"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_SELECT = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "select"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_MOVE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "move"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_ROTATE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "rotate"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_PLACE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "place"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_HIGHLIGHT = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "highlight"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_DESTROY = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "destroy"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_GAME_OVER = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "game-over"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_DROP = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "drop"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_BLIP = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "blip"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_INCREASE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "increase"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_DECREASE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "decrease"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_PAUSE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "pause"));
-   const audio_mixer_sample_id_t AMSID_EFFECT_UN_PAUSE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "un-pause"));
-
-   // Specify Game Boy colors palette used in imported artworkd
-   const color_rgba_t COL_PAL_LIGHTEST = color_rgba_make_rgba(248, 248, 248, 0xFF);
-   const color_rgba_t COL_PAL_LIGHT = color_rgba_make_rgba(168, 168, 168, 0xFF);
-   const color_rgba_t COL_PAL_DARK = color_rgba_make_rgba(96, 96, 96, 0xFF);
-   const color_rgba_t COL_PAL_DARKEST = color_rgba_make_rgba(0x00, 0x00, 0x00, 0xFF);
-
-   // Package engine components for easier use
-   struct engine_s engine;
-   engine.tex_virtual = tex_virtual;
-   engine.tex_sprites = tex_sprites;
-   engine.sprite_map = sprite_map;
-   engine.font_render = &font_render;
-
-   // Game state
-   // >> Game state transitions
-   enum game_state_e game_state = GAME_STATE_SPLASH;
-   enum game_state_e next_game_state = GAME_STATE_NONE;
-   // >> Playing field
-   struct play_field_s play_field = help_play_field_make_non_occupied();
-   // >> Active tetro
-   struct tetro_world_s tetro_active = help_tetro_world_make_random_at_spawn();
-   struct tetro_world_s tetro_next = help_tetro_world_make_random_at_spawn();
-   // >> Splash screen
-   double time_splash_start = help_sdl_time_in_seconds();
-   // >> Gameplay controls
-   double time_last_tetro_drop = help_sdl_time_in_seconds();
-   double time_last_tetro_player_move = help_sdl_time_in_seconds();
-   double time_last_tetro_player_drop = help_sdl_time_in_seconds();
-   // >> Play field row highlighting and removal   
-   double time_last_removal_flash_timer = help_sdl_time_in_seconds();
-   double time_last_row_deletion_timer = help_sdl_time_in_seconds();
-   int plot_row_min, plot_row_max;
-   struct list_of_rows_s list_of_full_rows;
-   // >> Game over
-   const double TIME_SEC_GAME_OVER_TRANSITION_FILL = 1.5;
-   const double TIME_SEC_GAME_OVER_TRANSITION_FILL_ROW = TIME_SEC_GAME_OVER_TRANSITION_FILL / PLAY_FIELD_HEIGHT;
-   double time_last_game_over_transition_row = help_sdl_time_in_seconds();
-   // >> Gameplay stats
-   int stat_score = 0;
-   int stat_lines = 0;
-   int stat_level = 0;
-   // >> Quitting the game
-   const double TIME_SEC_QUIT = 3.0;
-   double time_last_quit = help_sdl_time_in_seconds();
-   // >> Game type and music config
-   audio_mixer_sample_id_t configured_game_music = AMSID_MUSIC_GAME_A_TYPE;
-   const int GAME_MUSIC_TYPE_WIDTH = 2;
-   const int GAME_MUSIC_TYPE_HEIGHT = 2;
-   struct vec_2i_s game_music_cursor = vec_2i_make_xy(0, 0);
-   // >> Game over transition
-   int game_over_transition_field_lines_filled = 0;
-   int game_over_transition_field_lines_cleared = 0;
-   // >> Input mapping
-   bool keybr_key_confirmed[CUSTOM_KEY_COUNT];
-   for (size_t keybr = 0; keybr < sizeof(keybr_key_confirmed) / sizeof(keybr_key_confirmed[0]); ++keybr)
-   {
-      keybr_key_confirmed[keybr] = false;
-   }
-   // >> Volume
-   const float VOLUME_ADJUST_STEP_PER_PRESS = 0.1f;
-   const double TIME_SEC_VOLUME_OVERLAY_SHOW = 1.0f;
-   double time_until_show_volume_overlay = help_sdl_time_in_seconds();
-
-   // FPS counter
-   double last_time_fps = help_sdl_time_in_seconds();
-   int frames_per_second = 0;
-
-   // Integration
-   const int TICKS_PER_SECOND = 50;
-   const double FIXED_DELTA_TIME = 1.0 / TICKS_PER_SECOND;
-   double time_simulated = 0.0;
-   double last_time_tick = help_sdl_time_in_seconds();
-   double fixed_delta_time_accumulator = 0.0;
-
-   // Game loop
-   bool tetris_close_requested = false;
-   while (false == tetris_close_requested)
-   {
-      // Consume window events
-      SDL_Event window_event;
-      while (SDL_PollEvent(&window_event))
-         ;
-
-      // Tick
-      const double NEW_TIME = help_sdl_time_in_seconds();
-      const double LAST_FRAME_DURATION = help_sdl_time_in_seconds() - last_time_tick;
-      last_time_tick = NEW_TIME;
-      fixed_delta_time_accumulator += LAST_FRAME_DURATION;
-
-      // Iterative fixed time step integration
-      while (fixed_delta_time_accumulator >= FIXED_DELTA_TIME)
-      {
-         // Update input state
-         help_input_determine_intermediate_state(input);
-
-         // Tick housekeeping
-         time_simulated += FIXED_DELTA_TIME;
-         fixed_delta_time_accumulator -= FIXED_DELTA_TIME;
-
-         // Tick based on game state
-         if (GAME_STATE_INPUT_MAPPING != game_state)
-         {
-            // Volume adjustable at any time out of the input mapping screen
-            if (help_input_key_pressed(input, CUSTOM_KEY_VOLUME_UP))
-            {
-               float adjusted_volume_music, adjusted_volume_sfx;
-               if (audio_mixer_increase_volume_music_and_sfx_by(audio_mixer, VOLUME_ADJUST_STEP_PER_PRESS, &adjusted_volume_music, &adjusted_volume_sfx))
-               {
-                  audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_INCREASE);
-                  time_until_show_volume_overlay = help_sdl_time_in_seconds() + TIME_SEC_VOLUME_OVERLAY_SHOW;
-               }
-            }
-            if (help_input_key_pressed(input, CUSTOM_KEY_VOLUME_DOWN))
-            {
-               float adjusted_volume_music, adjusted_volume_sfx;
-               if (audio_mixer_increase_volume_music_and_sfx_by(audio_mixer, -VOLUME_ADJUST_STEP_PER_PRESS, &adjusted_volume_music, &adjusted_volume_sfx))
-               {
-                  audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_DECREASE);
-                  time_until_show_volume_overlay = help_sdl_time_in_seconds() + TIME_SEC_VOLUME_OVERLAY_SHOW;
-               }
-            }
-         }
-         if (GAME_STATE_SPLASH == game_state)
-         {
-            // SFX
-            static bool init_splash = true;
-            if (init_splash)
-            {
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_SPLASH);
-               init_splash = false;
-            }
-
-            // Wait until game start or press button
-            const float CONTINUE_TIME = 6.0f;
-            const bool CONTINUE_TIME_PASSED = (help_sdl_time_in_seconds() >= (time_splash_start + CONTINUE_TIME));
-
-            if (CONTINUE_TIME_PASSED || help_input_key_pressed(input, CUSTOM_KEY_START))
-            {
-               // Show and check game controls
-               next_game_state = GAME_STATE_INPUT_MAPPING;
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-            }
-         }
-         if (GAME_STATE_INPUT_MAPPING == game_state)
-         {
-            // Confirm input mapping
-            bool valid_keybr_confirmed = false;
-            if (false == keybr_key_confirmed[CUSTOM_KEY_UP] && help_input_key_pressed(input, CUSTOM_KEY_UP))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_UP] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_DOWN] && help_input_key_pressed(input, CUSTOM_KEY_DOWN))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_DOWN] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_LEFT] && help_input_key_pressed(input, CUSTOM_KEY_LEFT))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_LEFT] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_RIGHT] && help_input_key_pressed(input, CUSTOM_KEY_RIGHT))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_RIGHT] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_A] && help_input_key_pressed(input, CUSTOM_KEY_A))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_A] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_B] && help_input_key_pressed(input, CUSTOM_KEY_B))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_B] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_START] && help_input_key_pressed(input, CUSTOM_KEY_START))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_START] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_SELECT] && help_input_key_pressed(input, CUSTOM_KEY_SELECT))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_SELECT] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_VOLUME_UP] && help_input_key_pressed(input, CUSTOM_KEY_VOLUME_UP))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_VOLUME_UP] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-            if (false == keybr_key_confirmed[CUSTOM_KEY_VOLUME_DOWN] && help_input_key_pressed(input, CUSTOM_KEY_VOLUME_DOWN))
-            {
-               keybr_key_confirmed[CUSTOM_KEY_VOLUME_DOWN] = true;
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_BLIP);
-               valid_keybr_confirmed = true;
-            }
-
-            bool all_mapped_controls_confirmed = true;
-            for (size_t keybr = 0; keybr < sizeof(keybr_key_confirmed) / sizeof(keybr_key_confirmed[0]); ++keybr)
-            {
-               if (false == keybr_key_confirmed[keybr])
-               {
-                  all_mapped_controls_confirmed = false;
-                  break;
-               }
-            }
-            if (all_mapped_controls_confirmed)
-            {
-               // Go to title screen
-               next_game_state = GAME_STATE_TITLE;
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-               audio_mixer_queue_sample_music(audio_mixer, AMSID_MUSIC_TITLE, true);
-            }
-         }
-         if (GAME_STATE_TITLE == game_state)
-         {
-            // Player count select
-            if (help_input_key_pressed(input, CUSTOM_KEY_LEFT) || help_input_key_pressed(input, CUSTOM_KEY_RIGHT))
-            {
-               // @Note: Grey out 2 player mode as it's currently not supported
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_INVALID);
-            }
-
-            // Start game (for now in single player more)
-            if (help_input_key_pressed(input, CUSTOM_KEY_START))
-            {
-               // Stop title music
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-               // Play selection to config screen
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_SELECT);
-               // Init config screen state
-               next_game_state = GAME_STATE_GAME_MUSIC_CONFIG;
-               // Config music off
-               configured_game_music = AUDIO_MIXER_SAMPLE_ID_INVALID;
-               game_music_cursor = vec_2i_make_xy(1, 0);
-            }
-
-            // Quit game
-            if (help_input_key_pressed(input, CUSTOM_KEY_SELECT))
-            {
-               next_game_state = GAME_STATE_QUIT;
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_SELECT);
-               time_last_quit = help_sdl_time_in_seconds();
-            }
-         }
-         if (GAME_STATE_QUIT == game_state)
-         {
-            // Quit game after timer runs out
-            if (help_sdl_time_in_seconds() > time_last_quit + TIME_SEC_QUIT)
-            {
-               tetris_close_requested = true;
-            }
-         }
-         if (GAME_STATE_GAME_MUSIC_CONFIG == game_state)
-         {
-            // Move music type cursor
-            bool music_type_changed = false;
-            if (help_input_key_pressed(input, CUSTOM_KEY_UP))
-            {
-               const int NEW_GAME_CURSOR_Y = help_limit_clamp_i(0, game_music_cursor.y + 1, GAME_MUSIC_TYPE_HEIGHT - 1);
-               if (NEW_GAME_CURSOR_Y != game_music_cursor.y) music_type_changed = true;
-               game_music_cursor.y = NEW_GAME_CURSOR_Y;
-            }
-            if (help_input_key_pressed(input, CUSTOM_KEY_DOWN))
-            {
-               const int NEW_GAME_CURSOR_Y = help_limit_clamp_i(0, game_music_cursor.y - 1, GAME_MUSIC_TYPE_HEIGHT - 1);
-               if (NEW_GAME_CURSOR_Y != game_music_cursor.y) music_type_changed = true;
-               game_music_cursor.y = NEW_GAME_CURSOR_Y;
-            }
-            if (help_input_key_pressed(input, CUSTOM_KEY_LEFT))
-            {
-               const int NEW_GAME_CURSOR_X = help_limit_clamp_i(0, game_music_cursor.x - 1, GAME_MUSIC_TYPE_WIDTH - 1);
-               if (NEW_GAME_CURSOR_X != game_music_cursor.x) music_type_changed = true;
-               game_music_cursor.x = NEW_GAME_CURSOR_X;
-            }
-            if (help_input_key_pressed(input, CUSTOM_KEY_RIGHT))
-            {
-               const int NEW_GAME_CURSOR_X = help_limit_clamp_i(0, game_music_cursor.x + 1, GAME_MUSIC_TYPE_WIDTH - 1);
-               if (NEW_GAME_CURSOR_X != game_music_cursor.x) music_type_changed = true;
-               game_music_cursor.x = NEW_GAME_CURSOR_X;
-            }
-
-            // Select music type if selection changed or checked the first time
-            if (music_type_changed)
-            {
-               if (vec_2i_equals_xy(game_music_cursor, 0, 1))
-               {
-                  // Selected music type A
-                  audio_mixer_stop_music(audio_mixer);
-                  audio_mixer_queue_sample_music(audio_mixer, AMSID_MUSIC_GAME_A_TYPE, true);
-                  configured_game_music = AMSID_MUSIC_GAME_A_TYPE;
-               }
-
-               if (vec_2i_equals_xy(game_music_cursor, 1, 1))
-               {
-                  // Selected music type B
-                  audio_mixer_stop_music(audio_mixer);
-                  audio_mixer_queue_sample_music(audio_mixer, AMSID_MUSIC_GAME_B_TYPE, true);
-                  configured_game_music = AMSID_MUSIC_GAME_B_TYPE;
-               }
-
-               if (vec_2i_equals_xy(game_music_cursor, 0, 0))
-               {
-                  // Selected music type C
-                  audio_mixer_stop_music(audio_mixer);
-                  audio_mixer_queue_sample_music(audio_mixer, AMSID_MUSIC_GAME_C_TYPE, true);
-                  configured_game_music = AMSID_MUSIC_GAME_C_TYPE;
-               }
-
-               if (vec_2i_equals_xy(game_music_cursor, 1, 0))
-               {
-                  // Selected music type Off
-                  audio_mixer_stop_music(audio_mixer);
-                  configured_game_music = AUDIO_MIXER_SAMPLE_ID_INVALID;
-               }
-            }
 
-            // Start game with selected music
-            if (help_input_key_pressed(input, CUSTOM_KEY_START))
-            {
-               next_game_state = GAME_STATE_NEW_GAME;
-            }
-         }
-         if (GAME_STATE_NEW_GAME == game_state)
-         {
-            // Reset stats
-            stat_score = 0;
-            stat_lines = 0;
-            stat_level = 0;
+   // Create font render
+   struct font_render_s font_render;
+   if (false == font_render_make(&font_render))
+   {
+      printf("\nFailed to create font render component");
+      return EXIT_FAILURE;
+   }
+   help_font_render_map_glyphs(&font_render);
 
-            // Kickstart next tetro
-            tetro_next = help_tetro_world_make_random_at_spawn();
+   // Bake tinted glyphs for every palette shade
+   struct tint_cache_s * tint_cache = help_tint_cache_create(8);
+   if (NULL == tint_cache || false == help_tint_cache_bake_font_palette(tint_cache, sprite_map, &font_render))
+   {
+      printf("\nFailed to create tint cache");
+      return EXIT_FAILURE;
+   }
 
-            // Action - New game
-            play_field = help_play_field_make_non_occupied();
-            tetro_active = help_tetro_world_make_random_at_spawn();
+   // Frames are recorded as commands and executed in a second pass
+   struct render_commands_s * commands = help_render_commands_create();
+   if (NULL == commands)
+   {
+      printf("\nFailed to create render commands");
+      return EXIT_FAILURE;
+   }
 
-            // Start gameplay
-            next_game_state = GAME_STATE_CONTROL;
-            time_last_tetro_drop = help_sdl_time_in_seconds();
-         }
-         else if (GAME_STATE_CONTROL == game_state)
-         {
-            // Action - Rotate tetro
-            if (help_input_key_pressed(input, CUSTOM_KEY_A))
-            {
-               if (!help_tetro_rotation_collides(&tetro_active, &play_field, ROTATION_CW))
-               {
-                  help_tetro_world_rotate_cw(&tetro_active);
-                  audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_ROTATE);
-               }
-            }
-            if (help_input_key_pressed(input, CUSTOM_KEY_B))
-            {
-               if (!help_tetro_rotation_collides(&tetro_active, &play_field, ROTATION_CCW))
-               {
-                  help_tetro_world_rotate_ccw(&tetro_active);
-                  audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_ROTATE);
-               }
-            }
+   // Track changed tiles so only those are composed and uploaded
+   struct nametable_s * nametable = help_nametable_create(VIRTUAL_SIZE.x, VIRTUAL_SIZE.y, PLAY_FIELD_TILE_SIZE);
+   if (NULL == nametable)
+   {
+      printf("\nFailed to create nametable");
+      return EXIT_FAILURE;
+   }
 
-            // Action - Drop tetro
-            const double TIME_DELTA_TETRO_DROP = 0.85;
-            if (help_sdl_time_in_seconds() >= time_last_tetro_drop + TIME_DELTA_TETRO_DROP)
-            {
-               // Drop tetro if possible
-               if (help_tetro_move_collides(&tetro_active, &play_field, 0, -1))
-               {
-                  // Drop collision - Place the tetro
-                  next_game_state = GAME_STATE_PLACE;
-               }
-               else
-               {
-                  // No drop collision
-                  --tetro_active.tile_pos.y;
-                  audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_DROP);
-               }
+   // Static screen layers, composed once per screen
+   struct layer_cache_s * layer_cache = help_layer_cache_create(VIRTUAL_SIZE.x, VIRTUAL_SIZE.y);
+   if (NULL == layer_cache)
+   {
+      printf("\nFailed to create layer cache");
+      return EXIT_FAILURE;
+   }
 
-               // Update drop timer
-               time_last_tetro_drop = help_sdl_time_in_seconds();
-            }
+   // Create text layout cache
+   struct text_cache_s * text_cache = help_text_cache_create();
+   if (NULL == text_cache)
+   {
+      printf("\nFailed to create text cache");
+      return EXIT_FAILURE;
+   }
 
-            // Action - Control tetro horizontally
-            const double TIME_DELTA_TETRO_MOVE = 0.15;
-            const bool MOVE_LEFT = help_input_key_pressed_or_held(input, CUSTOM_KEY_LEFT);
-            const bool MOVE_RIGHT = help_input_key_pressed_or_held(input, CUSTOM_KEY_RIGHT);
-            const bool DO_MOVE = MOVE_LEFT || MOVE_RIGHT;
+   // Sprite atlas uploaded once, frames are drawn from it as one batch
+   struct render_geometry_s * geometry = NULL;
+   SDL_Texture * sdl_texture_atlas = NULL;
+   if (GEOMETRY)
+   {
+      geometry = help_render_geometry_create(tex_sprites);
+      sdl_texture_atlas = geometry ? help_sdl_geometry_atlas_upload(sdl_renderer, geometry->atlas, online_format) : NULL;
+      if (NULL == sdl_texture_atlas)
+      {
+         printf("\nFailed to create geometry atlas - Error: %s", SDL_GetError());
+         return EXIT_FAILURE;
+      }
+   }
 
-            if (DO_MOVE && help_sdl_time_in_seconds() >= (time_last_tetro_player_move + TIME_DELTA_TETRO_MOVE))
-            {
-               // Movement direction ?
-               int move_direction = 0;
-               move_direction -= MOVE_LEFT ? 1 : 0;
-               move_direction += MOVE_RIGHT ? 1 : 0;
-               
-               // Move only if no collision occurs
-               if (false == help_tetro_move_collides(&tetro_active, &play_field, move_direction, 0))
-               {
-                  tetro_active.tile_pos.x += move_direction;
-                  audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_MOVE);
-               }
+   // Palette indexed framebuffer and sprites, resolved to rgba once per frame
+   struct render_indexed_s * indexed = NULL;
+   if (INDEXED)
+   {
+      indexed = help_render_indexed_create(tex_virtual, tex_sprites);
+      if (NULL == indexed)
+      {
+         printf("\nFailed to create indexed framebuffer");
+         return EXIT_FAILURE;
+      }
+   }
 
-               // Update movement timer
-               time_last_tetro_player_move = help_sdl_time_in_seconds();
-            }
+   // Setup audio mixer
+   struct audio_mixer_s * audio_mixer = audio_mixer_create(audio_mixer_callback);
+   if (NULL == audio_mixer)
+   {
+      printf("\nFailed to create audio mixer");
+      return EXIT_FAILURE;
+   }
+   // >> Register audio mixer music and sound effects
+   const audio_mixer_sample_id_t AMSID_MUSIC_TITLE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "title"));
+   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_A_TYPE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "a-type"));
+   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_B_TYPE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "b-type"));
+   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_C_TYPE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "c-type"));
+   const audio_mixer_sample_id_t AMSID_MUSIC_GAME_OVER = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "music", "game-over"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_SPLASH = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "splash"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_INVALID = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "invalid"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_SELECT = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "select"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_MOVE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "move"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_ROTATE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "rotate"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_PLACE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "place"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_HIGHLIGHT = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "highlight"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_DESTROY = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "destroy"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_GAME_OVER = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "game-over"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_DROP = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "drop"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_BLIP = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "blip"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_INCREASE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "increase"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_DECREASE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "decrease"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_PAUSE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "pause"));
+   const audio_mixer_sample_id_t AMSID_EFFECT_UN_PAUSE = audio_mixer_register_WAV(audio_mixer, audio_mixer_build_res_path(DIR_ABS_RES, "effects", "un-pause"));
 
-            // Action - Control tetro drop
-            const double TIME_DELTA_TETRO_PLAYER_DROP = 0.1;
-            if (help_sdl_time_in_seconds() >= time_last_tetro_player_drop + TIME_DELTA_TETRO_PLAYER_DROP)
-            {
-               if (help_input_key_pressed_or_held(input, CUSTOM_KEY_DOWN))
-               {
-                  // Place tetro if collision occurse
-                  if (help_tetro_move_collides(&tetro_active, &play_field, 0, -1))
-                  {
-                     // Drop collision - Place the tetro
-                     next_game_state = GAME_STATE_PLACE;
-                  }
-                  else
-                  {
-                     // No drop collision
-                     --tetro_active.tile_pos.y;
-                     audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_DROP);
-                  }
-               }
+   // Package engine components for easier use
+   struct engine_s engine;
+   engine.tex_virtual = tex_virtual;
+   engine.tex_sprites = tex_sprites;
+   engine.sprite_map = sprite_map;
+   engine.font_render = &font_render;
+   engine.tint_cache = tint_cache;
+   engine.commands = commands;
+   // Locked texels are write only and indices are resolved whole, so both compose whole frames
+   engine.nametable = (ZERO_COPY || INDEXED || GEOMETRY) ? NULL : nametable;
+   // >> Batches draw the layers as quads, the layer texture only exists on the CPU
+   engine.layer_cache = GEOMETRY ? NULL : layer_cache;
+   engine.indexed = indexed;
+   engine.text_cache = text_cache;
+   engine.blitter = RENDER_BLITTER_TILE_KERNEL;
+
+   // Backend comparison instead of a game
+   if (BACKEND_BENCH)
+   {
+      const bool SUCCESS_BENCH = help_backend_bench_run(sdl_window, sdl_renderer, sdl_texture_online, sdl_texture_atlas, &engine, layer_cache, geometry, sim_seed);
+      SDL_Quit();
+      return SUCCESS_BENCH ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+
+   // Game loop state - Simulation and its input sources
+   struct game_loop_s loop;
+   const bool SUCCESS_SIM_INIT = replay ? replay_sim_init(replay, &loop.sim) : sim_init(&loop.sim, sim_seed, SIM_RANDOMIZER);
+   if (false == SUCCESS_SIM_INIT)
+   {
+      printf("\nFailed to initialize game simulation");
+      return EXIT_FAILURE;
+   }
+   loop.replay = replay;
+   loop.replay_cursor = replay_cursor_make();
+   loop.replay_finished = false;
+   loop.replay_recorder = replay_recorder;
+   loop.bot_player = BOT_PLAYS ? &bot_player : NULL;
+   loop.is_lockstep = CAPTURE;
+   loop.keys_ticked = 0;
+   loop.audio_mixer = audio_mixer;
+   // >> Map simulation audio to registered samples
+   loop.sfx_samples[SIM_SFX_SPLASH] = AMSID_EFFECT_SPLASH;
+   loop.sfx_samples[SIM_SFX_INVALID] = AMSID_EFFECT_INVALID;
+   loop.sfx_samples[SIM_SFX_SELECT] = AMSID_EFFECT_SELECT;
+   loop.sfx_samples[SIM_SFX_MOVE] = AMSID_EFFECT_MOVE;
+   loop.sfx_samples[SIM_SFX_ROTATE] = AMSID_EFFECT_ROTATE;
+   loop.sfx_samples[SIM_SFX_PLACE] = AMSID_EFFECT_PLACE;
+   loop.sfx_samples[SIM_SFX_HIGHLIGHT] = AMSID_EFFECT_HIGHLIGHT;
+   loop.sfx_samples[SIM_SFX_DESTROY] = AMSID_EFFECT_DESTROY;
+   loop.sfx_samples[SIM_SFX_GAME_OVER] = AMSID_EFFECT_GAME_OVER;
+   loop.sfx_samples[SIM_SFX_DROP] = AMSID_EFFECT_DROP;
+   loop.sfx_samples[SIM_SFX_BLIP] = AMSID_EFFECT_BLIP;
+   loop.sfx_samples[SIM_SFX_INCREASE] = AMSID_EFFECT_INCREASE;
+   loop.sfx_samples[SIM_SFX_DECREASE] = AMSID_EFFECT_DECREASE;
+   loop.sfx_samples[SIM_SFX_PAUSE] = AMSID_EFFECT_PAUSE;
+   loop.sfx_samples[SIM_SFX_UN_PAUSE] = AMSID_EFFECT_UN_PAUSE;
+   loop.music_samples[SIM_MUSIC_NONE] = AUDIO_MIXER_SAMPLE_ID_INVALID;
+   loop.music_samples[SIM_MUSIC_TITLE] = AMSID_MUSIC_TITLE;
+   loop.music_samples[SIM_MUSIC_GAME_A_TYPE] = AMSID_MUSIC_GAME_A_TYPE;
+   loop.music_samples[SIM_MUSIC_GAME_B_TYPE] = AMSID_MUSIC_GAME_B_TYPE;
+   loop.music_samples[SIM_MUSIC_GAME_C_TYPE] = AMSID_MUSIC_GAME_C_TYPE;
+   loop.music_samples[SIM_MUSIC_GAME_OVER] = AMSID_MUSIC_GAME_OVER;
+
+   loop.last_time_tick = help_sdl_time_in_seconds();
+   loop.fixed_delta_time_accumulator = 0.0;
+   loop.snapshots = help_render_snapshots_create();
+   if (NULL == loop.snapshots)
+   {
+      printf("\nFailed to create render state snapshots");
+      return EXIT_FAILURE;
+   }
+   atomic_init(&loop.keys_down, 0);
+   atomic_init(&loop.replay_speed, 1);
+   atomic_init(&loop.replay_seek_delta, 0);
+   atomic_init(&loop.close_requested, false);
+   loop.wake_event_type = 0;
+   atomic_init(&loop.wake_pending, false);
+   help_game_loop_publish(&loop);
+
+   // Simulation thread - Ticks at its own pace while this thread composes and presents
+   SDL_Thread * sim_thread = NULL;
+   if (help_args_key_present(argc, argv, ARG_KEY_SIM_THREAD) && false == CAPTURE)
+   {
+      loop.wake_event_type = SDL_RegisterEvents(1);
+      sim_thread = SDL_CreateThread(help_game_loop_thread, "tetris-sim", &loop);
+      if (NULL == sim_thread)
+      {
+         printf("\nFailed to create simulation thread - Error: %s", SDL_GetError());
+         return EXIT_FAILURE;
+      }
+   }
+   printf("\n\t%-*s: %s", DW, "simulation", sim_thread ? "own thread" : "main thread");
 
-               // Update drop timer
-               time_last_tetro_player_drop = help_sdl_time_in_seconds();
-            }
+   // Capture - Until the replay ends or the tick count is reached
+   struct capture_s * capture = NULL;
+   const char * ARG_CAPTURE_TICKS = help_args_key_value_first(argc, argv, ARG_KEY_CAPTURE_TICKS);
+   const uint32_t CAPTURE_TICKS = ARG_CAPTURE_TICKS ? (uint32_t)strtoul(ARG_CAPTURE_TICKS, NULL, 10) : (replay ? 0 : CAPTURE_TICKS_DEFAULT);
+   if (CAPTURE)
+   {
+      capture = capture_create(ARG_CAPTURE, ARG_CAPTURE_FRAMES, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y, SIM_TICKS_PER_SECOND);
+      if (NULL == capture)
+      {
+         printf("\nFailed to create capture");
+         return EXIT_FAILURE;
+      }
+      printf("\n\t%-*s: hashes %s, frames %s (%s)", DW, "capture", ARG_CAPTURE ? ARG_CAPTURE : "none", ARG_CAPTURE_FRAMES ? ARG_CAPTURE_FRAMES : "none", capture_format_name(capture_format_from_path(ARG_CAPTURE_FRAMES)));
+   }
 
-            // Pause
-            if (help_input_key_pressed(input, CUSTOM_KEY_START))
-            {
-               next_game_state = GAME_STATE_PAUSE;
+   // Presentation - Surface borders and time spent from composition to present
+   SDL_Surface * surface_bordered = NULL;
+   struct vec_2i_s surface_bordered_size = vec_2i_make_xy(0, 0);
+   double present_seconds_total = 0.0;
+   unsigned long frames_presented = 0;
+   // >> Unchanged frames are neither uploaded nor presented unless the window needs them again
+   bool present_requested = true;
+   unsigned long frames_elided = 0;
 
-               // Pause music but let sfx ring out
-               audio_mixer_pause_music(audio_mixer);
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_PAUSE);
-            }
-         }
-         else if (GAME_STATE_PAUSE == game_state)
-         {
-            // Un-pause
-            if (help_input_key_pressed(input, CUSTOM_KEY_START))
-            {
-               next_game_state = GAME_STATE_CONTROL;
+   // FPS counter
+   double last_time_fps = help_sdl_time_in_seconds();
+   int frames_per_second = 0;
 
-               // Resume music
-               audio_mixer_resume_music(audio_mixer);
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_UN_PAUSE);
-            }
+   // Game loop
+   bool tetris_close_requested = false;
+   while (false == tetris_close_requested)
+   {
+      // Wait for the frame slot - Events, input and ticks follow as late as pacing allows
+      help_frame_pacing_wait(&pacing);
 
-            // Quit
-            if (help_input_key_pressed(input, CUSTOM_KEY_SELECT))
-            {
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-               audio_mixer_queue_sample_music(audio_mixer, AMSID_MUSIC_TITLE, true);
-               audio_mixer_resume_music_and_sfx(audio_mixer);
-               next_game_state = GAME_STATE_TITLE;
-            }
+      // Consume window events
+      SDL_Event window_event;
+      while (SDL_PollEvent(&window_event))
+      {
+         // Window contents lost or rescaled - Present the next frame even if it repeats
+         if (
+            SDL_EVENT_WINDOW_EXPOSED == window_event.type ||
+            SDL_EVENT_WINDOW_RESIZED == window_event.type ||
+            SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED == window_event.type
+         )
+         {
+            present_requested = true;
          }
-         else if (GAME_STATE_PLACE == game_state)
+
+         // Replay controls - 1 to 4 select speed, page up and down seek
+         if (NULL == replay || SDL_EVENT_KEY_DOWN != window_event.type || window_event.key.repeat)
          {
-            // Action - Place
-            help_tetro_drop(&tetro_active, &play_field, &plot_row_min, &plot_row_max);
-            audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_PLACE);
+            continue;
+         }
 
-            // Line deletion required ?
-            list_of_full_rows = help_play_field_list_of_full_rows(&play_field);
-            if (0 == list_of_full_rows.count)
+         const SDL_Scancode SCANCODE = window_event.key.scancode;
+         if (SCANCODE >= SDL_SCANCODE_1 && SCANCODE <= SDL_SCANCODE_4)
+         {
+            const int REPLAY_SPEED = REPLAY_SPEEDS[SCANCODE - SDL_SCANCODE_1];
+            atomic_store(&loop.replay_speed, REPLAY_SPEED);
+            if (REPLAY_SPEED)
             {
-               // No rows to delete - Spawn new tetro and take it from there
-               next_game_state = GAME_STATE_RESPAWN;
+               printf("\nReplay speed: %dx", REPLAY_SPEED);
             }
             else
             {
-               // There are rows to delete
-               // Start deletion timers
-               next_game_state = GAME_STATE_REMOVE_LINES;
-               time_last_removal_flash_timer = help_sdl_time_in_seconds();
-               time_last_row_deletion_timer = help_sdl_time_in_seconds();
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_HIGHLIGHT);
+               printf("\nReplay speed: unthrottled");
             }
          }
-         else if (GAME_STATE_REMOVE_LINES == game_state)
+         else if ((SDL_SCANCODE_PAGEUP == SCANCODE || SDL_SCANCODE_PAGEDOWN == SCANCODE) && NULL == replay_recorder)
          {
-            // Action - Remove lines
-            const double TIME_DELTA_ROW_DELETION = 2.0;
-            if (help_sdl_time_in_seconds() >= time_last_row_deletion_timer + TIME_DELTA_ROW_DELETION)
-            {
-               // Time to delete rows
-               // Clear all rows that were detected full on tetro placement
-               for (int i_del_row = 0; i_del_row < list_of_full_rows.count; ++i_del_row)
-               {
-                  const int DELETION_ROW = list_of_full_rows.list[i_del_row];
-                  if (help_play_field_clear_row(&play_field, DELETION_ROW))
-                  {
-                     // Reflect in stats
-                     ++stat_lines;
-                     stat_score += 10;
-                  }
-               }
-
-               // Consolidate play field
-               next_game_state = GAME_STATE_CONSOLIDATE_PLAY_FIELD;
-            }
+            // Applied by the simulation before its next tick
+            atomic_fetch_add(&loop.replay_seek_delta, (SDL_SCANCODE_PAGEUP == SCANCODE) ? REPLAY_SEEK_STEP_TICKS : -REPLAY_SEEK_STEP_TICKS);
          }
-         else if (GAME_STATE_CONSOLIDATE_PLAY_FIELD == game_state)
-         {
-            // Action - Consolidate play field after full row deletion - Until no more rows are moved
-            help_play_field_consolidate(&play_field);
-            audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_DESTROY);
+      }
 
-            // Spawn new tetro
-            next_game_state = GAME_STATE_RESPAWN;
-         }
-         else if (GAME_STATE_RESPAWN == game_state)
-         {
-            // Select active and next tetro
-            tetro_active = tetro_next;
-            tetro_next = help_tetro_world_make_random_at_spawn();
+      // Keyboard state for the ticks to come
+      atomic_store(&loop.keys_down, help_input_sample_keyboard());
+      help_frame_pacing_input_sampled(&pacing);
 
-            // Game over if new tetro overlaps any occupied play field cell
-            if (help_tetro_move_collides(&tetro_active, &play_field, 0, 0))
-            {
-               // Transition to game over
-               next_game_state = GAME_STATE_GAME_OVER_TRANSITION_FILL;
-               time_last_game_over_transition_row = help_sdl_time_in_seconds();
-               game_over_transition_field_lines_filled = 0;
-               audio_mixer_stop_music_and_sfx(audio_mixer);
-               audio_mixer_queue_sample_sfx(audio_mixer, AMSID_EFFECT_GAME_OVER);
-            }
-            else
-            {
-               // No collision on spawn - Back to gameplay
-               next_game_state = GAME_STATE_CONTROL;
-            }
-         }
-         else if (GAME_STATE_GAME_OVER_TRANSITION_FILL == game_state)
+      // Tick here unless the simulation has a thread of its own
+      if (NULL == sim_thread)
+      {
+         help_game_loop_advance(&loop);
+      }
+      tetris_close_requested = atomic_load(&loop.close_requested);
+
+      // Render to scene - Newest published tick, all game states
+      atomic_store(&loop.wake_pending, false);
+      bool is_new_state = false;
+      const struct render_state_s * RENDER_STATE = help_render_snapshots_acquire(loop.snapshots, &is_new_state);
+      if (false == is_new_state && false == present_requested)
+      {
+         // Nothing ticked - Same frame as before
+         ++frames_elided;
+         help_game_loop_wait_idle(&loop, NULL != sim_thread);
+         continue;
+      }
+      const double TIME_PRESENT_START = help_sdl_time_in_seconds();
+      const SDL_FRect VIRTUAL_REGION_ALIGNED = help_virtual_max_render_scale_region_aligned(help_sdl_window_size(sdl_window), VIRTUAL_SIZE);
+      bool is_batched = false;
+      if (geometry)
+      {
+         // Commands straight into quads, frames too large to batch are composed below
+         is_batched = (
+            help_engine_record_state(&engine, RENDER_STATE) &&
+            help_render_geometry_build(
+               geometry,
+               commands,
+               sprite_map,
+               VIRTUAL_SIZE.y,
+               VIRTUAL_REGION_ALIGNED.x,
+               VIRTUAL_REGION_ALIGNED.y,
+               VIRTUAL_REGION_ALIGNED.w / VIRTUAL_SIZE.x
+            )
+         );
+      }
+      bool presented_zero_copy = false;
+      if (ZERO_COPY)
+      {
+         // Compose straight into the online texture when its rows are packed like ours
+         void * locked_texels = NULL;
+         int locked_pitch = 0;
+         if (SDL_LockTexture(sdl_texture_online, NULL, &locked_texels, &locked_pitch))
          {
-            if (help_sdl_time_in_seconds() >= time_last_game_over_transition_row + TIME_SEC_GAME_OVER_TRANSITION_FILL_ROW)
+            if (locked_pitch == (int)sizeof(color_rgba_t) * VIRTUAL_SIZE.x)
             {
-               ++game_over_transition_field_lines_filled;
-               if (game_over_transition_field_lines_filled > PLAY_FIELD_HEIGHT)
-               {
-                     audio_mixer_stop_music_and_sfx(audio_mixer);
-                     audio_mixer_queue_sample_music(audio_mixer, AMSID_MUSIC_GAME_OVER, false);
-                     time_last_game_over_transition_row = help_sdl_time_in_seconds();
-                     game_over_transition_field_lines_cleared = PLAY_FIELD_HEIGHT;
-                     next_game_state = GAME_STATE_GAME_OVER_TRANSITION_CLEAR;
-               }
-
-               // Track timer
-               time_last_game_over_transition_row = help_sdl_time_in_seconds();
+               struct texture_rgba_s tex_locked;
+               tex_locked.texels = locked_texels;
+               tex_locked.width = VIRTUAL_SIZE.x;
+               tex_locked.height = VIRTUAL_SIZE.y;
+               engine.tex_virtual = &tex_locked;
+               presented_zero_copy = help_engine_render_state(&engine, RENDER_STATE);
+               engine.tex_virtual = tex_virtual;
             }
+            SDL_UnlockTexture(sdl_texture_online);
          }
-         else if (GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state)
+      }
+      if (false == presented_zero_copy && false == is_batched)
+      {
+         help_engine_render_state(&engine, RENDER_STATE);
+
+         // Window surface presentation scales the offline texture directly, repeats are uploaded already
+         if (sdl_texture_online && false == commands->is_repeat)
          {
-            if (help_sdl_time_in_seconds() >= time_last_game_over_transition_row + TIME_SEC_GAME_OVER_TRANSITION_FILL_ROW)
+            // Copy offline to online texture - Dirty rectangles only when tracked, rows are stored top down
+            bool success_update_texture = true;
+            if (NULL == engine.nametable)
             {
-               --game_over_transition_field_lines_cleared;
-               if (game_over_transition_field_lines_cleared < 0)
-               {
-                  help_play_field_clear(&play_field);
-                  next_game_state = GAME_STATE_GAME_OVER;
-               }
-
-               // Track timer
-               time_last_game_over_transition_row = help_sdl_time_in_seconds();
+               success_update_texture = SDL_UpdateTexture(
+                  sdl_texture_online,
+                  NULL,
+                  tex_virtual->texels,
+                  sizeof(color_rgba_t) * VIRTUAL_SIZE.x
+               );
             }
-         }
-         else if (GAME_STATE_GAME_OVER == game_state)
-         {
-            // Action - Game over
-            if (help_input_key_pressed(input, CUSTOM_KEY_START))
+            for (int i_rect = 0; engine.nametable && i_rect < nametable->rect_count; ++i_rect)
             {
-               next_game_state = GAME_STATE_NEW_GAME;
-               audio_mixer_queue_sample_music(audio_mixer, configured_game_music, true);
+               const struct region_2d_s DIRTY = help_nametable_rect_texels(nametable, nametable->rects[i_rect]);
+               const int DIRTY_TOP = VIRTUAL_SIZE.y - 1 - help_minmax_min_2i(DIRTY.max.y, VIRTUAL_SIZE.y - 1);
+               SDL_Rect dirty_rect;
+               dirty_rect.x = DIRTY.min.x;
+               dirty_rect.y = DIRTY_TOP;
+               dirty_rect.w = help_minmax_min_2i(DIRTY.max.x, VIRTUAL_SIZE.x - 1) - DIRTY.min.x + 1;
+               dirty_rect.h = VIRTUAL_SIZE.y - DIRTY.min.y - DIRTY_TOP;
+               success_update_texture = SDL_UpdateTexture(
+                  sdl_texture_online,
+                  &dirty_rect,
+                  tex_virtual->texels + (DIRTY_TOP * VIRTUAL_SIZE.x) + DIRTY.min.x,
+                  sizeof(color_rgba_t) * VIRTUAL_SIZE.x
+               ) && success_update_texture;
             }
-            
-         }
-         else if (GAME_STATE_NONE == game_state)
-         {
-            // Action - None - Should never happen
-            printf("\nGame state NONE - Nothing to simulate");
-            tetris_close_requested = true;
-         }
-
-         // Level detection
-         const struct score_level_mapping_s * ACTIVE_SCORE_MAPPING = NULL;
-         for (size_t i = 0; i < (sizeof(score_level_mapping) / sizeof(score_level_mapping[0])); ++i)
-         {
-            const struct score_level_mapping_s * SCORE_MAPPING_CANDIDATE = score_level_mapping + i;
-            if (stat_score >= SCORE_MAPPING_CANDIDATE->threshold_score)
+            if (!success_update_texture)
             {
-               ACTIVE_SCORE_MAPPING = SCORE_MAPPING_CANDIDATE;
+               printf("\nFailed to update online texture - Error: %s", SDL_GetError());
+               break;
             }
          }
+      }
 
-         // Set level based on found mapping
-         if (ACTIVE_SCORE_MAPPING)
-         {
-            stat_level = ACTIVE_SCORE_MAPPING->mapped_level;
-         }
-         else
-         {
-            stat_level = -1;
-         }
-
-         // Game state housekeeping
-         if (GAME_STATE_NONE != next_game_state)
+      // Capture every composed tick, repeats included - Capture never batches
+      if (capture && is_new_state)
+      {
+         capture_frame(capture, tex_virtual, RENDER_STATE->tick);
+         const bool CAPTURE_TICKS_REACHED = CAPTURE_TICKS && RENDER_STATE->tick >= CAPTURE_TICKS;
+         if (CAPTURE_TICKS_REACHED || (replay && loop.replay_finished))
          {
-            game_state = next_game_state;
-            next_game_state = GAME_STATE_NONE;
+            tetris_close_requested = true;
          }
       }
 
-      // Render to scene - All game states
-      // ----> Clear offline texture
-      help_texture_rgba_clear(engine.tex_virtual, COL_PAL_LIGHTEST);
-      // >> Render based on active game mode
-      if (GAME_STATE_SPLASH == game_state)
+      // Ticked without visible change - Same frame as before
+      if (commands->is_repeat && false == present_requested)
       {
-         // Background
-         help_texture_rgba_plot_aabb(tex_virtual, 0, 0, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y, COL_PAL_LIGHTEST);
-
-         const char * const SPLASH_TEXT = "Just another\nunfinished TETRIS\nclone made for the\nlove of coding."
-                                          "\n\nThis, is a work\nof fiction and\nnon-commercial."
-                                          "\n\n\nWait or hit start."
-                                          "\n\n\n\nSven Garson - 2025";
-         help_engine_render_text_at_tile(&engine, SPLASH_TEXT, 1, PLAY_FIELD_HEIGHT - 2);
-      }
-      if (GAME_STATE_TITLE == game_state)
-      { 
-         // Background art
-         help_render_engine_sprite_at_tile(&engine, 0, 0, SPRITE_MAP_TILE_BG_TITLE_SCREEN);
-
-         // Player select
-         const char * STR_PLAYER_1 = "1PLAYER";
-         help_engine_render_text_at_tile(&engine, STR_PLAYER_1, 2, 3);
-         help_engine_render_tinted_text_at_tile(&engine, "2PLAYER", 2 + 1 + strlen(STR_PLAYER_1) + 2, 3, COL_PAL_LIGHT);
-         help_render_engine_sprite_at_tile(&engine, 1, 3, SPRITE_MAP_TILE_FONT_ARROW_RIGHT);
-         help_engine_render_text_at_tile(&engine, "SELECT TO QUIT", 3, 1);
+         ++frames_elided;
+         help_game_loop_wait_idle(&loop, NULL != sim_thread);
+         continue;
       }
-      if (GAME_STATE_GAME_MUSIC_CONFIG == game_state)
-      {
-         // Background art
-         help_render_engine_sprite_at_tile(&engine, 0, 0, SPRITE_MAP_TILE_BG_CONFIG_SCREEN);
-
-         // Game type
-         help_engine_render_text_at_tile(&engine, "GAME TYPE", 5, PLAY_FIELD_HEIGHT - 4);
-         help_engine_render_text_at_tile(&engine, "A-TYPE", 3, PLAY_FIELD_HEIGHT - 6);
-         help_engine_render_tinted_text_at_tile(&engine, "B-TYPE", 11, PLAY_FIELD_HEIGHT - 6, COL_PAL_LIGHT);
-
-         // Music type based on selection
-         help_engine_render_text_at_tile(&engine, "MUSIC TYPE", 5, 7);
-
-         // A-Type
-         if (vec_2i_equals_xy(game_music_cursor, 0, 1))
-         {
-            help_engine_render_text_at_tile(&engine, "A-TYPE", 3, 5);
-         }
-         else
-         {
-            help_engine_render_tinted_text_at_tile(&engine, "A-TYPE", 3, 5, COL_PAL_LIGHT);
-         }
-
-         // B-Type
-         if (vec_2i_equals_xy(game_music_cursor, 1, 1))
-         {
-            help_engine_render_text_at_tile(&engine, "B-TYPE", 11, 5);
-         }
-         else
-         {
-            help_engine_render_tinted_text_at_tile(&engine, "B-TYPE", 11, 5, COL_PAL_LIGHT);
-         }
-
-         // C-Type
-         if (vec_2i_equals_xy(game_music_cursor, 0, 0))
-         {
-            help_engine_render_text_at_tile(&engine, "C-TYPE", 3, 3);
-         }
-         else
-         {
-            help_engine_render_tinted_text_at_tile(&engine, "C-TYPE", 3, 3, COL_PAL_LIGHT);
-         }
+      present_requested = false;
 
-         // Off
-         if (vec_2i_equals_xy(game_music_cursor, 1, 0))
-         {
-            help_engine_render_text_at_tile(&engine, "OFF", 12, 3);
-         }
-         else
-         {
-            help_engine_render_tinted_text_at_tile(&engine, "OFF", 12, 3, COL_PAL_LIGHT);
-         }
-      }
-      if (
-         GAME_STATE_CONTROL == game_state ||
-         GAME_STATE_PLACE == game_state ||
-         GAME_STATE_REMOVE_LINES == game_state ||
-         GAME_STATE_CONSOLIDATE_PLAY_FIELD == game_state ||
-         GAME_STATE_RESPAWN == game_state ||
-         GAME_STATE_GAME_OVER == game_state ||
-         GAME_STATE_GAME_OVER_TRANSITION_FILL == game_state ||
-         GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state ||
-         GAME_STATE_PAUSE == game_state
-      )
+      if (PRESENT_SURFACE)
       {
-         // >> Background art
-         help_render_engine_sprite_at_tile(&engine, 0, 0, SPRITE_MAP_TILE_BG_PLAY_SCREEN);
-
-         // >> Active stuff
-         if (GAME_STATE_GAME_OVER != game_state && GAME_STATE_GAME_OVER_TRANSITION_CLEAR != game_state && GAME_STATE_PAUSE != game_state)
+         // Scale into the window surface on the CPU
+         if (false == help_sdl_window_surface_present(sdl_window, tex_virtual, &surface_bordered, &surface_bordered_size))
          {
-            // >> Render play field
-            help_play_field_render_to_texture(&play_field, &engine);
-            // >> Active tetro
-            help_tetro_render_to_texture(&tetro_active, &engine);
-            // >> Next tetro
-            help_tetro_render_to_texture_at_tile_without_position(&tetro_next, &engine, 14 + 1, 1);
+            printf("\nFailed to present window surface - Error: %s", SDL_GetError());
+            break;
          }
-         // >> Gameplay stats
-         const char * STR_LABEL_SCORE = "SCORE";
-         help_engine_render_text_at_tile(&engine, STR_LABEL_SCORE, 14, PLAY_FIELD_HEIGHT - 2);
-         char str_stat_score[32];
-         snprintf(str_stat_score, sizeof(str_stat_score), "%*d", strlen(STR_LABEL_SCORE), stat_score);
-         help_engine_render_text_at_tile(&engine, str_stat_score, 14, PLAY_FIELD_HEIGHT - 4);
-
-         const char * STR_LABEL_LEVEL = "LEVEL";
-         help_engine_render_text_at_tile(&engine, STR_LABEL_LEVEL, 14, PLAY_FIELD_HEIGHT - 7);
-         char str_stat_level[32];
-         snprintf(str_stat_level, sizeof(str_stat_level), "%*d", strlen(STR_LABEL_LEVEL), stat_level);
-         help_engine_render_text_at_tile(&engine, str_stat_level, 14, PLAY_FIELD_HEIGHT - 8);
-
-         const char * STR_LABEL_LINES = "LINES";
-         help_engine_render_text_at_tile(&engine, STR_LABEL_LINES, 14, PLAY_FIELD_HEIGHT - 10);
-         char str_stat_lines[32];
-         snprintf(str_stat_lines, sizeof(str_stat_lines), "%*d", strlen(STR_LABEL_LINES), stat_lines);
-         help_engine_render_text_at_tile(&engine, str_stat_lines, 14, PLAY_FIELD_HEIGHT - 11);
-
       }
-      if (GAME_STATE_REMOVE_LINES == game_state)
+      else
       {
-         // Latch highlight rendering
-         const double TIME_DELTA_ROW_FLASH = 0.22;
-         static bool highlight_latch = true;
-         if (help_sdl_time_in_seconds() >= time_last_removal_flash_timer + TIME_DELTA_ROW_FLASH)
+         // Clear backbuffer
+         SDL_SetRenderDrawColor(sdl_renderer, 0x00, 0x00, 0x00, 0xFF);
+         const bool SUCCESS_BACKBUFFER_CLEAR = SDL_RenderClear(sdl_renderer);
+         if (!SUCCESS_BACKBUFFER_CLEAR)
          {
-            // Latch
-            highlight_latch = !highlight_latch;
-
-            // Update timer
-            time_last_removal_flash_timer = help_sdl_time_in_seconds();
+            printf("\nFailed to clear backbuffer - Error: %s", SDL_GetError());
+            break;
          }
 
-         // Highlight rows on timer
-         if (highlight_latch)
-         {
-            for (int i_full_rows = 0; i_full_rows < list_of_full_rows.count; ++i_full_rows)
-            {
-               const int DELETION_ROW = list_of_full_rows.list[i_full_rows];
-               for (int deletion_col = 0; deletion_col < PLAY_FIELD_WIDTH; ++deletion_col)
-               {
-                  help_render_engine_sprite(
-                     &engine,
-                     PLAY_FIELD_OFFSET_HORI_PIXELS + (deletion_col * PLAY_FIELD_TILE_SIZE),
-                     DELETION_ROW * PLAY_FIELD_TILE_SIZE,
-                     SPRITE_MAP_TILE_HIGHLIGHT
-                  );
-               }
-            }
-         }
-      }
-      if (GAME_STATE_GAME_OVER_TRANSITION_FILL == game_state)
-      {
-         for (int game_over_row = 0; game_over_row < game_over_transition_field_lines_filled; ++game_over_row)
+         // Render the batch, or the scaled virtual texture
+         if (is_batched)
          {
-            for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
+            if (false == help_sdl_render_geometry(sdl_renderer, sdl_texture_atlas, geometry, VIRTUAL_REGION_ALIGNED))
             {
-               help_render_engine_sprite(
-                  &engine,
-                  PLAY_FIELD_OFFSET_HORI_PIXELS + (col * PLAY_FIELD_TILE_SIZE),
-                  game_over_row * PLAY_FIELD_TILE_SIZE,
-                  SPRITE_MAP_TILE_GAME_OVER_FILL
-               );
+               printf("\nFailed to render geometry - Error: %s", SDL_GetError());
+               break;
             }
          }
-      }
-      if (GAME_STATE_GAME_OVER == game_state || GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state)
-      {
-         help_engine_render_text_at_tile(&engine, "GAME\n\n OVER", 4, PLAY_FIELD_HEIGHT - 4);
-         help_engine_render_text_at_tile(&engine, " HIT\n\nSTART\n\n TO TRY\n\nAGAIN", 4, 8);
-      }
-      if (GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state)
-      {
-         for (int game_over_row = 0; game_over_row < game_over_transition_field_lines_cleared; ++game_over_row)
+         else
          {
-            for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
+            const SDL_FRect VIRTUAL_REGION = help_virtual_max_render_scale_region(help_sdl_window_size(sdl_window), VIRTUAL_SIZE);
+            const bool SUCCESS_RENDER_TEXTURE = SDL_RenderTexture(
+               sdl_renderer,
+               sdl_texture_online,
+               NULL,
+               &VIRTUAL_REGION
+            );
+            if (!SUCCESS_RENDER_TEXTURE)
             {
-               help_render_engine_sprite(
-                  &engine,
-                  PLAY_FIELD_OFFSET_HORI_PIXELS + (col * PLAY_FIELD_TILE_SIZE),
-                  (PLAY_FIELD_HEIGHT * PLAY_FIELD_TILE_SIZE) - (game_over_row * PLAY_FIELD_TILE_SIZE),
-                  SPRITE_MAP_TILE_GAME_OVER_FILL
-               );
+               printf("\nFailed to render online texture - Error: %s", SDL_GetError());
+               break;
             }
          }
-      }
-      if (GAME_STATE_PAUSE == game_state)
-      {
-         help_engine_render_text_at_tile(&engine, " HIT\n\n START\n\n   TO\n\nCONTINUE\n\n   OR\n\n SELECT\n\n TO QUIT", 3, PLAY_FIELD_HEIGHT - 4);
-      }
-      if (GAME_STATE_QUIT == game_state)
-      {
-         help_engine_render_text_at_tile(&engine, "THANK YOU FOR\n\n  PLAYING", 3, PLAY_FIELD_HEIGHT - 8);
-         help_render_engine_sprite_at_tile(&engine, 3 + 10, PLAY_FIELD_HEIGHT - 10, SPRITE_MAP_TILE_HEART);
-      }
-      if (GAME_STATE_INPUT_MAPPING == game_state)
-      {
-         // Background art
-         help_render_engine_sprite_at_tile(&engine, 0, 0, SPRITE_MAP_TILE_BG_INPUT_MAPPING_SCREEN);
-
-         // Mapping
-         help_engine_render_text_at_tile(&engine, " GAME BOY    KEYBRD ", 0, PLAY_FIELD_HEIGHT - 1);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_UP]          ? "UP             OK   " : "UP          W       ", 0, PLAY_FIELD_HEIGHT - 3);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_DOWN]        ? "DOWN           OK   " : "DOWN        S       ", 0, PLAY_FIELD_HEIGHT - 4);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_LEFT]        ? "LEFT           OK   " : "LEFT        A       ", 0, PLAY_FIELD_HEIGHT - 5);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_RIGHT]       ? "RIGHT          OK   " : "RIGHT       D       ", 0, PLAY_FIELD_HEIGHT - 6);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_A]           ? "A              OK   " : "A           UP ARR  ", 0, PLAY_FIELD_HEIGHT - 7);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_B]           ? "B              OK   " : "B           LEFT ARR", 0, PLAY_FIELD_HEIGHT - 8);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_START]       ? "START          OK   " : "START       ENTER   ", 0, PLAY_FIELD_HEIGHT - 9);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_SELECT]      ? "SELECT         OK   " : "SELECT      DELETE  ", 0, PLAY_FIELD_HEIGHT - 10);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_VOLUME_UP]   ? "VOLUME UP      OK   " : "VOLUME UP   PLUS KP ", 0, PLAY_FIELD_HEIGHT - 11);
-         help_engine_render_text_at_tile(&engine, keybr_key_confirmed[CUSTOM_KEY_VOLUME_DOWN] ? "VOLUME DOWN    OK   " : "VOLUME DOWN MINUS KP", 0, PLAY_FIELD_HEIGHT - 12);
-
-         help_engine_render_text_at_tile(&engine, "   HIT ALL KEYBRD   ", 0, PLAY_FIELD_HEIGHT - 13 - 2);
-         help_engine_render_text_at_tile(&engine, "  KEYS TO CONTINUE  ", 0, PLAY_FIELD_HEIGHT - 13 - 4);
-      }
-      if (help_sdl_time_in_seconds() <= time_until_show_volume_overlay)
-      {
-         float volume_music, volume_sfx;
-         if (audio_mixer_get_volume_music(audio_mixer, &volume_music) && audio_mixer_get_volume_sfx(audio_mixer, &volume_sfx))
+
+         // Swap buffers
+         const bool SUCCESS_RENDER = SDL_RenderPresent(sdl_renderer);
+         if (!SUCCESS_RENDER)
          {
-            static char str_volumes[64];
-            snprintf(str_volumes, sizeof(str_volumes), "Volume\n  Music: %.2f\n  Sfx  : %.2f", volume_music, volume_sfx);
-            help_engine_render_tinted_text_at_tile(&engine, str_volumes, 0, PLAY_FIELD_HEIGHT - 1, COL_PAL_DARK);
+            printf("\nFailed to render - Error: %s", SDL_GetError());
+            break;
          }
       }
-
-      // Copy offline to online texture
-      const bool SUCCESS_UPDATE_TEXTURE = SDL_UpdateTexture(
-         sdl_texture_online,
-         NULL,
-         tex_virtual->texels,
-         sizeof(color_rgba_t) * VIRTUAL_SIZE.x
-      );
-
-      // Clear backbuffer
-      SDL_SetRenderDrawColor(sdl_renderer, 0x00, 0x00, 0x00, 0xFF);
-      const bool SUCCESS_BACKBUFFER_CLEAR = SDL_RenderClear(sdl_renderer);
-      if (!SUCCESS_BACKBUFFER_CLEAR)
-      {
-         printf("\nFailed to clear backbuffer - Error: %s", SDL_GetError());
-         break;
-      }
-
-      // Render scaled virtual texture
-      const SDL_FRect VIRTUAL_REGION = help_virtual_max_render_scale_region(help_sdl_window_size(sdl_window), VIRTUAL_SIZE);
-      const bool SUCCESS_RENDER_TEXTURE = SDL_RenderTexture(
-         sdl_renderer,
-         sdl_texture_online,
-         NULL,
-         &VIRTUAL_REGION
-      );
-      if (!SUCCESS_RENDER_TEXTURE)
-      {
-         printf("\nFailed to render online texture - Error: %s", SDL_GetError());
-         break;
-      }
-
-      // Swap buffers
-      const bool SUCCESS_RENDER = SDL_RenderPresent(sdl_renderer);
-      if (!SUCCESS_RENDER)
-      {
-         printf("\nFailed to render - Error: %s", SDL_GetError());
-         break;
-      }
+      present_seconds_total += help_sdl_time_in_seconds() - TIME_PRESENT_START;
+      ++frames_presented;
+      help_frame_pacing_presented(&pacing);
 
       // Determine FPS
       if (help_sdl_time_in_seconds() >= (last_time_fps + 1.0))
@@ -3691,13 +1989,87 @@ int main(int argc, char * argv[])
       ++frames_per_second;
    }
 
+   // Stop the simulation before touching its state
+   atomic_store(&loop.close_requested, true);
+   SDL_WaitThread(sim_thread, NULL);
+
+   // Log render statistics
+   printf("\n\nRender Statistics");
+   printf("\n\t%-*s: %lu", DW, "frames", commands->frames);
+   printf(
+      "\n\t%-*s: %.1f commands, %.1f runs, %.1f culled",
+      DW,
+      "per frame",
+      commands->frames ? (double)commands->commands_total / commands->frames : 0.0,
+      commands->frames ? (double)commands->runs_total / commands->frames : 0.0,
+      commands->frames ? (double)commands->culled_total / commands->frames : 0.0
+   );
+   printf("\n\t%-*s: %.1f of %d", DW, "tiles redrawn/frame", nametable->frames ? (double)nametable->tiles_redrawn_total / nametable->frames : 0.0, nametable->tiles_wide * nametable->tiles_high);
+   printf("\n\t%-*s: %.2f", DW, "dirty rects/frame", nametable->frames ? (double)nametable->rects_total / nametable->frames : 0.0);
+   printf("\n\t%-*s: %d", DW, "layer rebuilds", layer_cache->rebuilds);
+   printf("\n\t%-*s: %lu laid out, %lu reused", DW, "text runs", text_cache->layouts, text_cache->hits);
+   if (geometry)
+   {
+      printf("\n\t%-*s: %lu batches, %.1f quads each", DW, "geometry", geometry->batches, geometry->batches ? (double)geometry->quads_total / geometry->batches : 0.0);
+   }
+   printf("\n\t%-*s: %lu presented, %lu elided", DW, "frames shown", frames_presented, frames_elided);
+   printf(
+      "\n\t%-*s: %.3f ms average, %.3f ms max (%s)",
+      DW,
+      "input to present",
+      pacing.frames ? pacing.latency_total * 1000.0 / pacing.frames : 0.0,
+      pacing.latency_max * 1000.0,
+      pacing.is_limited ? (pacing.is_late_sampling ? "low latency pacing" : "limiter pacing") : "vsync pacing"
+   );
+   printf(
+      "\n\t%-*s: %.3f ms/frame at %dx%d (%s%s)",
+      DW,
+      "compose + present",
+      frames_presented ? present_seconds_total * 1000.0 / frames_presented : 0.0,
+      help_sdl_window_size(sdl_window).x,
+      help_sdl_window_size(sdl_window).y,
+      PRESENT_SURFACE ? "window surface" : "renderer",
+      SUCCESS_USE_VSYNC ? ", vsync wait included" : ""
+   );
+
+   // Persist replay
+   if (replay_recorder)
+   {
+      replay_recorder_write(replay_recorder, ARG_RECORD, sim_state_hash(&loop.sim));
+   }
+
+   // Log capture, the writer drains what is left first
+   if (capture)
+   {
+      printf("\n\nCapture");
+      printf("\n\t%-*s: %lu", DW, "frames", capture_frame_count(capture));
+      printf("\n\t%-*s: %016llx", DW, "combined hash", (unsigned long long)capture_hash_combined(capture));
+      printf("\n\t%-*s: %lu", DW, "ring full stalls", capture_stall_count(capture));
+   }
+
    // Cleanup custom
+   capture_destroy(capture);
+   if (pacing.log)
+   {
+      fclose(pacing.log);
+   }
+   help_render_snapshots_destroy(loop.snapshots);
+   replay_recorder_destroy(replay_recorder);
+   replay_destroy(replay);
+   pool_destroy(bot_pool);
    audio_mixer_destroy(audio_mixer);
-   help_input_destroy(input);
+   help_tint_cache_destroy(tint_cache);
+   help_text_cache_destroy(text_cache);
+   help_nametable_destroy(nametable);
+   help_render_commands_destroy(commands);
+   help_layer_cache_destroy(layer_cache);
+   help_render_indexed_destroy(indexed);
+   help_render_geometry_destroy(geometry);
    help_texture_rgba_destroy(tex_virtual);
    help_texture_rgba_destroy(tex_sprites);
 
    // Cleanup SDL
+   SDL_DestroyTexture(sdl_texture_atlas);
    SDL_DestroyTexture(sdl_texture_online);
    SDL_DestroyWindow(sdl_window);
    SDL_DestroyRenderer(sdl_renderer);
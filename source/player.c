@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <string.h>
+#include "player.h"
+
+// Player - Scripted
+uint32_t help_script_random(uint32_t * state)
+{
+   // xorshift32 - Only drives the scripted player, not the simulation
+   uint32_t x = *state;
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   *state = x;
+   return x;
+}
+
+sim_input_t help_player_scripted_input(const struct sim_s * sim, uint32_t * script_state)
+{
+   // Keys are released every other tick so that each hold registers as a fresh press
+   const bool PRESS_TICK = (sim_tick(sim) & 1) ? true : false;
+   if (false == PRESS_TICK) return 0;
+
+   switch (sim_game_state(sim))
+   {
+      case GAME_STATE_SPLASH:
+      case GAME_STATE_TITLE:
+      case GAME_STATE_GAME_MUSIC_CONFIG:
+      case GAME_STATE_GAME_OVER:
+         return SIM_INPUT_KEY(CUSTOM_KEY_START);
+      case GAME_STATE_INPUT_MAPPING:
+         // Confirm every mapped key once
+         for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
+         {
+            if (false == sim_key_confirmed(sim, key))
+            {
+               return SIM_INPUT_KEY(key);
+            }
+         }
+         return 0;
+      case GAME_STATE_CONTROL:
+      {
+         // Mash gameplay keys but never pause
+         const sim_input_t GAMEPLAY_KEYS[] = {
+            SIM_INPUT_KEY(CUSTOM_KEY_LEFT),
+            SIM_INPUT_KEY(CUSTOM_KEY_RIGHT),
+            SIM_INPUT_KEY(CUSTOM_KEY_DOWN),
+            SIM_INPUT_KEY(CUSTOM_KEY_A),
+            SIM_INPUT_KEY(CUSTOM_KEY_B),
+            0
+         };
+         const uint32_t PICK = help_script_random(script_state) % (sizeof(GAMEPLAY_KEYS) / sizeof(GAMEPLAY_KEYS[0]));
+         return GAMEPLAY_KEYS[PICK];
+      }
+      default:
+         return 0;
+   }
+}
+
+// Player - Bot
+sim_input_t help_player_bot_input(struct player_s * player, const struct sim_s * sim)
+{
+   // Menus are navigated like the scripted player
+   if (GAME_STATE_CONTROL != sim_game_state(sim))
+   {
+      player->bot_controller.active = false;
+      return help_player_scripted_input(sim, &player->script_state);
+   }
+
+   // Plan once per spawned tetro
+   const struct tetro_world_s * TETRO = sim_tetro_active(sim);
+   if (false == player->bot_controller.active)
+   {
+      struct ai_decision_s decision;
+      const bool DECIDED = (PLAYER_KIND_LOOKAHEAD == player->kind)
+         ? ai_decide_lookahead(&player->bot_ai, player->bot_pool, &player->bot_search, sim_play_field(sim), TETRO, sim_tetro_next(sim), &decision)
+         : ai_decide(&player->bot_ai, sim_play_field(sim), TETRO, &decision);
+      if (DECIDED)
+      {
+         ai_controller_follow(&player->bot_controller, &decision);
+      }
+   }
+
+   return ai_controller_input(&player->bot_controller, TETRO);
+}
+
+// Player - API
+bool player_init(struct player_s * player, enum player_kind_e kind, uint32_t seed)
+{
+   if (NULL == player) return false;
+
+   player->kind = kind;
+   player->script_state = seed ? seed : 1;
+   player->bot_weights = ai_weights_make_default();
+   ai_init(&player->bot_ai, ai_heuristic_weighted, &player->bot_weights);
+   ai_controller_init(&player->bot_controller);
+   player->bot_search = ai_search_config_make_default();
+   player->bot_pool = NULL;
+
+   // Success
+   return true;
+}
+
+sim_input_t player_input(struct player_s * player, const struct sim_s * sim)
+{
+   if (NULL == player || NULL == sim) return 0;
+
+   switch (player->kind)
+   {
+      case PLAYER_KIND_SCRIPTED:
+         return help_player_scripted_input(sim, &player->script_state);
+      case PLAYER_KIND_BOT:
+      case PLAYER_KIND_LOOKAHEAD:
+         return help_player_bot_input(player, sim);
+      default:
+         return 0;
+   }
+}
+
+const char * player_kind_name(enum player_kind_e kind)
+{
+   switch (kind)
+   {
+      case PLAYER_KIND_SCRIPTED:
+         return "scripted";
+      case PLAYER_KIND_BOT:
+         return "bot";
+      case PLAYER_KIND_LOOKAHEAD:
+         return "lookahead";
+      default:
+         return "unknown";
+   }
+}
+
+bool player_kind_from_name(const char * name, enum player_kind_e * out_kind)
+{
+   if (NULL == name || NULL == out_kind) return false;
+
+   for (int kind = 0; kind < PLAYER_KIND_COUNT; ++kind)
+   {
+      if (0 == strcmp(name, player_kind_name(kind)))
+      {
+         *out_kind = kind;
+         return true;
+      }
+   }
+
+   return false;
+}
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "pool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Constants
+#define POOL_THREADS_MAX (64)
+
+// Pool - Internals
+struct pool_slice_s {
+   // Owner takes from begin, thieves shrink end, both under lock
+   // Atomic so that thieves may peek at the remaining count without locking
+   pthread_mutex_t lock;
+   atomic_int begin;
+   atomic_int end;
+   // Keep slices of different workers on different cache lines
+   char padding[64];
+};
+
+struct pool_worker_s {
+   struct pool_s * pool;
+   pthread_t thread;
+   int index;
+};
+
+struct pool_s {
+   int thread_count;
+   struct pool_worker_s workers[POOL_THREADS_MAX];
+   struct pool_slice_s slices[POOL_THREADS_MAX];
+   // Current job
+   pool_task_fn task;
+   void * context;
+   // Job hand-off
+   pthread_mutex_t job_lock;
+   pthread_cond_t job_started;
+   pthread_cond_t job_finished;
+   uint64_t job_generation;
+   int workers_busy;
+   bool shutdown;
+   atomic_int indices_remaining;
+};
+
+bool help_pool_take_own(struct pool_s * pool, int worker, int * out_index)
+{
+   struct pool_slice_s * slice = pool->slices + worker;
+   pthread_mutex_lock(&slice->lock);
+   const int BEGIN = atomic_load_explicit(&slice->begin, memory_order_relaxed);
+   const bool TAKEN = BEGIN < atomic_load_explicit(&slice->end, memory_order_relaxed);
+   if (TAKEN)
+   {
+      *out_index = BEGIN;
+      atomic_store_explicit(&slice->begin, BEGIN + 1, memory_order_relaxed);
+   }
+   pthread_mutex_unlock(&slice->lock);
+
+   return TAKEN;
+}
+
+bool help_pool_steal(struct pool_s * pool, int thief, int * out_index)
+{
+   // Pick the victim with the most remaining work, unlocked reads are only a hint
+   int victim = -1;
+   int victim_remaining = 0;
+   for (int i_offset = 1; i_offset < pool->thread_count; ++i_offset)
+   {
+      const int CANDIDATE = (thief + i_offset) % pool->thread_count;
+      struct pool_slice_s * slice = pool->slices + CANDIDATE;
+      const int REMAINING = atomic_load_explicit(&slice->end, memory_order_relaxed) - atomic_load_explicit(&slice->begin, memory_order_relaxed);
+      if (REMAINING > victim_remaining)
+      {
+         victim = CANDIDATE;
+         victim_remaining = REMAINING;
+      }
+   }
+   if (victim < 0) return false;
+
+   // Steal back half of the victim slice
+   int stolen_begin = 0;
+   int stolen_end = 0;
+   struct pool_slice_s * slice_victim = pool->slices + victim;
+   pthread_mutex_lock(&slice_victim->lock);
+   const int VICTIM_BEGIN = atomic_load_explicit(&slice_victim->begin, memory_order_relaxed);
+   const int VICTIM_END = atomic_load_explicit(&slice_victim->end, memory_order_relaxed);
+   if (VICTIM_END > VICTIM_BEGIN)
+   {
+      stolen_end = VICTIM_END;
+      stolen_begin = stolen_end - ((VICTIM_END - VICTIM_BEGIN + 1) / 2);
+      atomic_store_explicit(&slice_victim->end, stolen_begin, memory_order_relaxed);
+   }
+   pthread_mutex_unlock(&slice_victim->lock);
+   if (stolen_begin == stolen_end) return false;
+
+   // First stolen index is run right away, rest becomes own work
+   struct pool_slice_s * slice_thief = pool->slices + thief;
+   pthread_mutex_lock(&slice_thief->lock);
+   atomic_store_explicit(&slice_thief->begin, stolen_begin + 1, memory_order_relaxed);
+   atomic_store_explicit(&slice_thief->end, stolen_end, memory_order_relaxed);
+   pthread_mutex_unlock(&slice_thief->lock);
+   *out_index = stolen_begin;
+
+   return true;
+}
+
+void help_pool_work(struct pool_s * pool, int worker)
+{
+   int index;
+   while (atomic_load_explicit(&pool->indices_remaining, memory_order_acquire) > 0)
+   {
+      if (help_pool_take_own(pool, worker, &index) || help_pool_steal(pool, worker, &index))
+      {
+         pool->task(pool->context, index, worker);
+         atomic_fetch_sub_explicit(&pool->indices_remaining, 1, memory_order_acq_rel);
+      }
+      else
+      {
+         // Remaining indices are in flight on other workers
+         sched_yield();
+      }
+   }
+}
+
+void * help_pool_thread_main(void * argument)
+{
+   struct pool_worker_s * worker = argument;
+   struct pool_s * pool = worker->pool;
+   uint64_t generation_seen = 0;
+
+   for (;;)
+   {
+      // Wait for next job or shutdown
+      pthread_mutex_lock(&pool->job_lock);
+      while (false == pool->shutdown && pool->job_generation == generation_seen)
+      {
+         pthread_cond_wait(&pool->job_started, &pool->job_lock);
+      }
+      if (pool->shutdown)
+      {
+         pthread_mutex_unlock(&pool->job_lock);
+         break;
+      }
+      generation_seen = pool->job_generation;
+      pthread_mutex_unlock(&pool->job_lock);
+
+      help_pool_work(pool, worker->index);
+
+      // Report done
+      pthread_mutex_lock(&pool->job_lock);
+      if (0 == --pool->workers_busy)
+      {
+         pthread_cond_signal(&pool->job_finished);
+      }
+      pthread_mutex_unlock(&pool->job_lock);
+   }
+
+   return NULL;
+}
+
+// Pool - API
+int pool_hardware_thread_count(void)
+{
+#ifdef _WIN32
+   // mingw-w64 has no sysconf processor count
+   SYSTEM_INFO system_info;
+   GetSystemInfo(&system_info);
+   const long COUNT = (long)system_info.dwNumberOfProcessors;
+#else
+   const long COUNT = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+   return (COUNT < 1) ? 1 : (COUNT > POOL_THREADS_MAX) ? POOL_THREADS_MAX : (int)COUNT;
+}
+
+struct pool_s * pool_create(int thread_count)
+{
+   if (thread_count < 1 || thread_count > POOL_THREADS_MAX)
+   {
+      printf("\nPool thread count %d out of range [1, %d]", thread_count, POOL_THREADS_MAX);
+      return NULL;
+   }
+
+   // Allocate instance
+   struct pool_s * instance = calloc(1, sizeof(struct pool_s));
+   if (NULL == instance)
+   {
+      printf("\nFailed to create pool instance");
+      return NULL;
+   }
+
+   // Synchronization
+   pthread_mutex_init(&instance->job_lock, NULL);
+   pthread_cond_init(&instance->job_started, NULL);
+   pthread_cond_init(&instance->job_finished, NULL);
+   for (int i_slice = 0; i_slice < POOL_THREADS_MAX; ++i_slice)
+   {
+      pthread_mutex_init(&instance->slices[i_slice].lock, NULL);
+      atomic_init(&instance->slices[i_slice].begin, 0);
+      atomic_init(&instance->slices[i_slice].end, 0);
+   }
+   atomic_init(&instance->indices_remaining, 0);
+
+   // Worker zero is the calling thread
+   instance->thread_count = 1;
+   for (int i_worker = 1; i_worker < thread_count; ++i_worker)
+   {
+      struct pool_worker_s * worker = instance->workers + i_worker;
+      worker->pool = instance;
+      worker->index = i_worker;
+      if (pthread_create(&worker->thread, NULL, help_pool_thread_main, worker) != 0)
+      {
+         printf("\nFailed to create pool worker thread %d", i_worker);
+         return pool_destroy(instance);
+      }
+      ++instance->thread_count;
+   }
+
+   // Success
+   return instance;
+}
+
+void * pool_destroy(struct pool_s * instance)
+{
+   if (instance)
+   {
+      // Wake and join workers
+      pthread_mutex_lock(&instance->job_lock);
+      instance->shutdown = true;
+      pthread_cond_broadcast(&instance->job_started);
+      pthread_mutex_unlock(&instance->job_lock);
+      for (int i_worker = 1; i_worker < instance->thread_count; ++i_worker)
+      {
+         pthread_join(instance->workers[i_worker].thread, NULL);
+      }
+
+      for (int i_slice = 0; i_slice < POOL_THREADS_MAX; ++i_slice)
+      {
+         pthread_mutex_destroy(&instance->slices[i_slice].lock);
+      }
+      pthread_cond_destroy(&instance->job_finished);
+      pthread_cond_destroy(&instance->job_started);
+      pthread_mutex_destroy(&instance->job_lock);
+   }
+
+   free(instance);
+
+   return NULL;
+}
+
+int pool_thread_count(const struct pool_s * instance)
+{
+   return instance ? instance->thread_count : 0;
+}
+
+bool pool_parallel_for(struct pool_s * instance, int count, pool_task_fn task, void * context)
+{
+   if (NULL == instance || NULL == task || count < 0) return false;
+   if (0 == count) return true;
+
+   // Even initial split, stealing balances uneven task cost
+   const int THREADS = instance->thread_count;
+   for (int i_worker = 0; i_worker < THREADS; ++i_worker)
+   {
+      struct pool_slice_s * slice = instance->slices + i_worker;
+      pthread_mutex_lock(&slice->lock);
+      atomic_store_explicit(&slice->begin, (int)(((int64_t)count * i_worker) / THREADS), memory_order_relaxed);
+      atomic_store_explicit(&slice->end, (int)(((int64_t)count * (i_worker + 1)) / THREADS), memory_order_relaxed);
+      pthread_mutex_unlock(&slice->lock);
+   }
+   instance->task = task;
+   instance->context = context;
+   atomic_store_explicit(&instance->indices_remaining, count, memory_order_release);
+
+   // Start workers
+   pthread_mutex_lock(&instance->job_lock);
+   instance->workers_busy = THREADS - 1;
+   ++instance->job_generation;
+   pthread_cond_broadcast(&instance->job_started);
+   pthread_mutex_unlock(&instance->job_lock);
+
+   // Participate, then wait for stragglers
+   help_pool_work(instance, 0);
+   pthread_mutex_lock(&instance->job_lock);
+   while (instance->workers_busy > 0)
+   {
+      pthread_cond_wait(&instance->job_finished, &instance->job_lock);
+   }
+   pthread_mutex_unlock(&instance->job_lock);
+
+   // Success
+   return true;
+}
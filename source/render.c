@@ -0,0 +1,3059 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdatomic.h>
+#include "render.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RENDER_TILE_KERNEL_X86
+#endif
+
+// Constants
+static const bool CONFIG_DO_RENDER_TETRO_COLLISION_MASKS = false;
+// >> Arrays so their lengths are constants, stats are right aligned under them
+static const char STR_LABEL_SCORE[] = "SCORE";
+static const char STR_LABEL_LEVEL[] = "LEVEL";
+static const char STR_LABEL_LINES[] = "LINES";
+
+// Helpers - Colors
+struct color_packing_shifts_s {
+   int red;
+   int green;
+   int blue;
+   int alpha;
+};
+
+static const struct color_packing_shifts_s COLOR_PACKING_SHIFTS[COLOR_PACKING_COUNT] = {
+   { 24, 16, 8, 0 },
+   { 16, 8, 0, 24 },
+   { 8, 16, 24, 0 },
+   { 0, 8, 16, 24 }
+};
+static enum color_packing_e color_packing = COLOR_PACKING_RGBA;
+
+bool color_packing_select(enum color_packing_e packing)
+{
+   if (packing < 0 || packing >= COLOR_PACKING_COUNT) return false;
+
+   color_packing = packing;
+   return true;
+}
+
+enum color_packing_e color_packing_selected(void)
+{
+   return color_packing;
+}
+
+const char * color_packing_name(enum color_packing_e packing)
+{
+   switch (packing)
+   {
+      case COLOR_PACKING_RGBA:
+         return "RGBA";
+      case COLOR_PACKING_ARGB:
+         return "ARGB";
+      case COLOR_PACKING_BGRA:
+         return "BGRA";
+      case COLOR_PACKING_ABGR:
+         return "ABGR";
+      default:
+         return "unknown";
+   }
+}
+
+color_rgba_t color_rgba_alpha_mask(void)
+{
+   return (color_rgba_t)0xFF << COLOR_PACKING_SHIFTS[color_packing].alpha;
+}
+
+color_rgba_t color_rgba_make_rgba(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+   const struct color_packing_shifts_s SHIFTS = COLOR_PACKING_SHIFTS[color_packing];
+   return (
+      ((color_rgba_t)red << SHIFTS.red) |
+      ((color_rgba_t)green << SHIFTS.green) |
+      ((color_rgba_t)blue << SHIFTS.blue) |
+      ((color_rgba_t)alpha << SHIFTS.alpha)
+   );
+}
+
+uint8_t color_rgba_channel_red(color_rgba_t color)
+{
+   return (uint8_t)(color >> COLOR_PACKING_SHIFTS[color_packing].red);
+}
+
+uint8_t color_rgba_channel_green(color_rgba_t color)
+{
+   return (uint8_t)(color >> COLOR_PACKING_SHIFTS[color_packing].green);
+}
+
+uint8_t color_rgba_channel_blue(color_rgba_t color)
+{
+   return (uint8_t)(color >> COLOR_PACKING_SHIFTS[color_packing].blue);
+}
+
+uint8_t color_rgba_channel_alpha(color_rgba_t color)
+{
+   return (uint8_t)(color >> COLOR_PACKING_SHIFTS[color_packing].alpha);
+}
+
+// Helpers - Palette
+color_rgba_t help_palette_shade_color(enum palette_shade_e shade)
+{
+   switch (shade)
+   {
+      case PALETTE_SHADE_LIGHTEST:
+         return color_rgba_make_rgba(248, 248, 248, 0xFF);
+      case PALETTE_SHADE_LIGHT:
+         return color_rgba_make_rgba(168, 168, 168, 0xFF);
+      case PALETTE_SHADE_DARK:
+         return color_rgba_make_rgba(96, 96, 96, 0xFF);
+      case PALETTE_SHADE_DARKEST:
+      default:
+         return color_rgba_make_rgba(0x00, 0x00, 0x00, 0xFF);
+   }
+}
+
+enum palette_shade_e help_palette_shade_nearest(color_rgba_t color)
+{
+   // Exact shades first, anything else by distance
+   enum palette_shade_e nearest = PALETTE_SHADE_DARKEST;
+   int nearest_distance = 0x7FFFFFFF;
+   for (int i_shade = 0; i_shade < PALETTE_SHADE_COUNT; ++i_shade)
+   {
+      const color_rgba_t SHADE = help_palette_shade_color((enum palette_shade_e)i_shade);
+      const int DELTA_RED = (int)color_rgba_channel_red(color) - (int)color_rgba_channel_red(SHADE);
+      const int DELTA_GREEN = (int)color_rgba_channel_green(color) - (int)color_rgba_channel_green(SHADE);
+      const int DELTA_BLUE = (int)color_rgba_channel_blue(color) - (int)color_rgba_channel_blue(SHADE);
+      const int DISTANCE = (DELTA_RED * DELTA_RED) + (DELTA_GREEN * DELTA_GREEN) + (DELTA_BLUE * DELTA_BLUE);
+      if (DISTANCE < nearest_distance)
+      {
+         nearest = (enum palette_shade_e)i_shade;
+         nearest_distance = DISTANCE;
+      }
+   }
+
+   return nearest;
+}
+
+// Helpers - Texture
+int help_texture_rgba_texel_count(struct texture_rgba_s * instance)
+{
+   return instance ? (instance->width * instance->height) : 0;
+}
+
+struct vec_2i_s help_texture_rgba_size(struct texture_rgba_s * instance)
+{
+   return instance ? vec_2i_make_xy(instance->width, instance->height) : vec_2i_make_xy(0, 0);
+}
+
+void * help_texture_rgba_destroy(struct texture_rgba_s * instance)
+{
+   if (instance)
+   {
+      free(instance->texels);
+   }
+
+   free(instance);
+
+   return NULL;
+}
+
+bool help_texture_rgba_clear(struct texture_rgba_s * instance, color_rgba_t clear_color)
+{
+   if (NULL == instance) return false;
+
+   const int TEXEL_COUNT = help_texture_rgba_texel_count(instance);
+   for (int i = 0; i < TEXEL_COUNT; ++i)
+   {
+      instance->texels[i] = clear_color;
+   }
+
+   return true;
+}
+
+bool help_texture_rgba_coords_out_of_bounds(struct texture_rgba_s * instance, int x, int y)
+{
+   return (
+      NULL == instance ||
+      x < 0 ||
+      x >= instance->width ||
+      y < 0 ||
+      y >= instance->height
+   ) ? true : false;
+}
+
+bool help_texture_rgba_2d_coords_to_linear(struct texture_rgba_s * instance, int x, int y, int * out_linear)
+{
+   if (
+      NULL == instance ||
+      NULL == out_linear ||
+      help_texture_rgba_coords_out_of_bounds(instance, x, y)
+   ) return false;
+
+   *out_linear = (y * instance->width) + x;
+   return true;
+}
+
+bool help_texture_rgba_plot_texel(struct texture_rgba_s * instance, int x, int y, color_rgba_t color)
+{
+   const int FLIPPED_Y = help_texture_rgba_size(instance).y - 1 - y;
+
+   int texel_index;
+   if (help_texture_rgba_2d_coords_to_linear(instance, x, FLIPPED_Y, &texel_index))
+   {
+      instance->texels[texel_index] = color;
+      return true;
+   }
+
+   return false;
+}
+
+void help_texture_rgba_plot_aabb(struct texture_rgba_s * instance, int min_x, int min_y, int width, int height, color_rgba_t color)
+{
+   if (NULL == instance) return;
+
+   // Clip once, then fill row by row
+   const int X_BEGIN = help_minmax_max_2i(0, min_x);
+   const int X_END = help_minmax_min_2i(instance->width, min_x + width);
+   const int Y_BEGIN = help_minmax_max_2i(0, min_y);
+   const int Y_END = help_minmax_min_2i(instance->height, min_y + height);
+   for (int box_y = Y_BEGIN; box_y < Y_END; ++box_y)
+   {
+      color_rgba_t * row = instance->texels + ((instance->height - 1 - box_y) * instance->width);
+      for (int box_x = X_BEGIN; box_x < X_END; ++box_x)
+      {
+         row[box_x] = color;
+      }
+   }
+}
+
+void help_texture_rgba_plot_horizontal_line(struct texture_rgba_s * instance, int min_x, int width, int y, color_rgba_t color)
+{
+   for (int sx = min_x; sx < (min_x + width); ++sx)
+   {
+      help_texture_rgba_plot_texel(instance, sx, y, color);
+   }
+}
+
+void help_texture_rgba_plot_vertical_line(struct texture_rgba_s * instance, int min_y, int height, int x, color_rgba_t color)
+{
+   for (int sy = min_y; sy < (min_y + height); ++sy)
+   {
+      help_texture_rgba_plot_texel(instance, x, sy, color);
+   }
+}
+
+void help_texture_rgba_plot_aabb_outline(struct texture_rgba_s * instance, int min_x, int min_y, int width, int height, color_rgba_t color)
+{
+   help_texture_rgba_plot_horizontal_line(instance, min_x, width, min_y, color);
+   help_texture_rgba_plot_horizontal_line(instance, min_x, width, min_y + height - 1, color);
+
+   help_texture_rgba_plot_vertical_line(instance, min_y, height, min_x, color);
+   help_texture_rgba_plot_vertical_line(instance, min_y, height, min_x + height - 1, color);
+}
+
+bool help_texture_rgba_access_texel(struct texture_rgba_s * instance, int x, int y, color_rgba_t * out_color)
+{
+   if (NULL == instance || NULL == out_color) return false;
+
+   const int FLIPPED_Y = help_texture_rgba_size(instance).y - 1 - y;
+
+   int texel_index;
+   if (help_texture_rgba_2d_coords_to_linear(instance, x, FLIPPED_Y, &texel_index))
+   {
+      *out_color = instance->texels[texel_index];
+      return true;
+   }
+
+   return false;
+}
+
+bool help_texture_rgba_copy_region(struct texture_rgba_s * target, const struct texture_rgba_s * source, struct region_2d_s region)
+{
+   if (NULL == target || NULL == source || target->width != source->width || target->height != source->height) return false;
+
+   const int X_BEGIN = help_minmax_max_2i(0, region.min.x);
+   const int X_END = help_minmax_min_2i(target->width, region.max.x + 1);
+   const int Y_BEGIN = help_minmax_max_2i(0, region.min.y);
+   const int Y_END = help_minmax_min_2i(target->height, region.max.y + 1);
+   if (X_BEGIN >= X_END || Y_BEGIN >= Y_END) return true;
+
+   // Rows are stored flipped, the region is one block when it spans whole rows
+   const int ROW_TOP = target->height - Y_END;
+   const int ROW_COUNT = Y_END - Y_BEGIN;
+   if (0 == X_BEGIN && target->width == X_END)
+   {
+      memcpy(target->texels + (ROW_TOP * target->width), source->texels + (ROW_TOP * source->width), sizeof(color_rgba_t) * target->width * ROW_COUNT);
+      return true;
+   }
+   for (int row = ROW_TOP; row < ROW_TOP + ROW_COUNT; ++row)
+   {
+      memcpy(target->texels + (row * target->width) + X_BEGIN, source->texels + (row * source->width) + X_BEGIN, sizeof(color_rgba_t) * (X_END - X_BEGIN));
+   }
+
+   return true;
+}
+
+struct texture_rgba_s * help_texture_rgba_make(int width, int height, color_rgba_t clear_color)
+{
+   // Allocate instance
+   struct texture_rgba_s * instance = malloc(sizeof(struct texture_rgba_s));
+   if (NULL == instance)
+   {
+      printf("\nFailed to create texture rgba instance");
+      return NULL;
+   }
+
+   // Null instance
+   instance->texels = NULL;
+   instance->width = width;
+   instance->height = height;
+
+   // Allocate texels
+   const int TEXEL_COUNT = width * height;
+   instance->texels = malloc(sizeof(color_rgba_t) * TEXEL_COUNT);
+   if (NULL == instance->texels)
+   {
+      printf("\nFailed to allocate texture rgba for [%d] texels", TEXEL_COUNT);
+      return help_texture_rgba_destroy(instance);
+   }
+
+   // Initial clear
+   help_texture_rgba_clear(instance, clear_color);
+
+   // Success
+   return instance;
+}
+
+// Logic - Sprites
+struct sprite_s sprite_make(int tile_x, int tile_y, int tile_size)
+{
+   struct sprite_s sprite;
+
+   sprite.texture_min = vec_2i_make_xy(tile_x * tile_size, tile_y * tile_size);
+   sprite.texture_size = vec_2i_make_xy(tile_size, tile_size);
+
+   return sprite;
+}
+
+struct sprite_s sprite_make_xy_wh(int tile_x, int tile_y, int tiles_wide, int tiles_high, int tile_size)
+{
+   struct sprite_s sprite;
+
+   sprite.texture_min = vec_2i_make_xy(tile_x * tile_size, tile_y * tile_size);
+   sprite.texture_size = vec_2i_make_xy(tiles_wide * tile_size, tiles_high * tile_size);
+
+   return sprite;
+}
+
+// Logic - Textured Sprite Rendering
+bool help_tex_sprite_render_tinted_per_texel(
+   struct sprite_s sprite,
+   int x,
+   int y,
+   struct texture_rgba_s * texture_sprite,
+   struct texture_rgba_s * texture_target,
+   bool do_tint,
+   color_rgba_t tint_color
+)
+{
+   if (NULL == texture_sprite || NULL == texture_target) return false;
+
+   for (int spr_y = 0; spr_y < sprite.texture_size.y; ++spr_y)
+   {
+      for (int spr_x = 0; spr_x < sprite.texture_size.x; ++spr_x)
+      {
+         // Access sprite source texture texel
+         color_rgba_t source_texel_color;
+         const bool SUCCESS_ACCESS_SOURCE_TEXEL = help_texture_rgba_access_texel(
+            texture_sprite,
+            sprite.texture_min.x + spr_x,
+            sprite.texture_min.y + sprite.texture_size.y - 1 - spr_y,
+            &source_texel_color
+         );
+         const color_rgba_t SAFE_SOURCE_TEXEL_COLOR = SUCCESS_ACCESS_SOURCE_TEXEL ? source_texel_color : color_rgba_make_rgba(0xFF, 0x00, 0xFF, 0xFF);
+
+         const bool DONT_RENDER_TRANSPARENT_TEXELS = true;
+         if (DONT_RENDER_TRANSPARENT_TEXELS && (0x00 == color_rgba_channel_alpha(SAFE_SOURCE_TEXEL_COLOR)))
+         {
+            continue;
+         }
+
+         // Plot sprite source texture color into target texture
+         // Tint target texels here for now
+         help_texture_rgba_plot_texel(
+            texture_target,
+            x + spr_x,
+            y + spr_y,
+            do_tint ? tint_color : SAFE_SOURCE_TEXEL_COLOR
+         );
+      }
+   }
+
+   return true;
+}
+
+bool help_tex_sprite_render_tinted(
+   struct sprite_s sprite,
+   int x,
+   int y,
+   struct texture_rgba_s * texture_sprite,
+   struct texture_rgba_s * texture_target,
+   bool do_tint,
+   color_rgba_t tint_color
+)
+{
+   if (NULL == texture_target) return false;
+
+   return help_tex_sprite_render_tinted_clipped(sprite, x, y, texture_sprite, texture_target, do_tint, tint_color, region_2d_s_make(0, 0, texture_target->width, texture_target->height));
+}
+
+bool help_tex_sprite_render_tinted_clipped(
+   struct sprite_s sprite,
+   int x,
+   int y,
+   struct texture_rgba_s * texture_sprite,
+   struct texture_rgba_s * texture_target,
+   bool do_tint,
+   color_rgba_t tint_color,
+   struct region_2d_s clip
+)
+{
+   if (NULL == texture_sprite || NULL == texture_target) return false;
+
+   // Clip region never reaches outside the target
+   const int CLIP_X_BEGIN = help_minmax_max_2i(0, clip.min.x);
+   const int CLIP_X_END = help_minmax_min_2i(texture_target->width, clip.max.x + 1);
+   const int CLIP_Y_BEGIN = help_minmax_max_2i(0, clip.min.y);
+   const int CLIP_Y_END = help_minmax_min_2i(texture_target->height, clip.max.y + 1);
+
+   // Clip sprite columns against target and source once
+   const int SPRITE_X_BEGIN = help_minmax_max_2i(help_minmax_max_2i(0, CLIP_X_BEGIN - x), -sprite.texture_min.x);
+   const int SPRITE_X_END = help_minmax_min_2i(
+      help_minmax_min_2i(sprite.texture_size.x, CLIP_X_END - x),
+      texture_sprite->width - sprite.texture_min.x
+   );
+
+   // Clip sprite rows, sprite row zero is the bottom one
+   const int SOURCE_BOTTOM_ROW = sprite.texture_min.y + sprite.texture_size.y - 1;
+   const int SPRITE_Y_BEGIN = help_minmax_max_2i(help_minmax_max_2i(0, CLIP_Y_BEGIN - y), SOURCE_BOTTOM_ROW - (texture_sprite->height - 1));
+   const int SPRITE_Y_END = help_minmax_min_2i(
+      help_minmax_min_2i(sprite.texture_size.y, CLIP_Y_END - y),
+      SOURCE_BOTTOM_ROW + 1
+   );
+   if (SPRITE_X_BEGIN >= SPRITE_X_END || SPRITE_Y_BEGIN >= SPRITE_Y_END) return true;
+
+   // Both textures store rows flipped, so sprite rows walk up the source and down the target
+   const int SPAN = SPRITE_X_END - SPRITE_X_BEGIN;
+   const color_rgba_t * source_row = texture_sprite->texels
+      + ((texture_sprite->height - 1 - (SOURCE_BOTTOM_ROW - SPRITE_Y_BEGIN)) * texture_sprite->width)
+      + sprite.texture_min.x + SPRITE_X_BEGIN;
+   color_rgba_t * target_row = texture_target->texels
+      + ((texture_target->height - 1 - (y + SPRITE_Y_BEGIN)) * texture_target->width)
+      + x + SPRITE_X_BEGIN;
+   const int SOURCE_STRIDE = texture_sprite->width;
+   const int TARGET_STRIDE = texture_target->width;
+
+   // Transparent texels have zero alpha and are skipped
+   const color_rgba_t ALPHA_MASK = color_rgba_alpha_mask();
+   if (do_tint)
+   {
+      for (int spr_y = SPRITE_Y_BEGIN; spr_y < SPRITE_Y_END; ++spr_y)
+      {
+         for (int i_texel = 0; i_texel < SPAN; ++i_texel)
+         {
+            if (source_row[i_texel] & ALPHA_MASK)
+            {
+               target_row[i_texel] = tint_color;
+            }
+         }
+         source_row += SOURCE_STRIDE;
+         target_row -= TARGET_STRIDE;
+      }
+   }
+   else
+   {
+      for (int spr_y = SPRITE_Y_BEGIN; spr_y < SPRITE_Y_END; ++spr_y)
+      {
+         for (int i_texel = 0; i_texel < SPAN; ++i_texel)
+         {
+            const color_rgba_t TEXEL = source_row[i_texel];
+            if (TEXEL & ALPHA_MASK)
+            {
+               target_row[i_texel] = TEXEL;
+            }
+         }
+         source_row += SOURCE_STRIDE;
+         target_row -= TARGET_STRIDE;
+      }
+   }
+
+   return true;
+}
+
+// Logic - Tile kernel
+typedef void (*tile_kernel_fn)(const color_rgba_t * source, int source_stride, color_rgba_t * target, int target_stride, const uint8_t * row_masks, bool do_tint, color_rgba_t tint_color);
+
+void help_tile_kernel_scalar(const color_rgba_t * source, int source_stride, color_rgba_t * target, int target_stride, const uint8_t * row_masks, bool do_tint, color_rgba_t tint_color)
+{
+   for (int row = 0; row < SPRITE_MAP_KERNEL_TILE_SIZE; ++row)
+   {
+      const uint8_t MASK = row_masks[row];
+      for (int i_texel = 0; i_texel < SPRITE_MAP_KERNEL_TILE_SIZE; ++i_texel)
+      {
+         if (MASK & (1u << i_texel))
+         {
+            target[i_texel] = do_tint ? tint_color : source[i_texel];
+         }
+      }
+      source += source_stride;
+      target += target_stride;
+   }
+}
+
+#ifdef RENDER_TILE_KERNEL_X86
+void help_tile_kernel_sse2(const color_rgba_t * source, int source_stride, color_rgba_t * target, int target_stride, const uint8_t * row_masks, bool do_tint, color_rgba_t tint_color)
+{
+   // Lane i of each half selects mask bit i
+   const __m128i BITS_LOW = _mm_setr_epi32(0x01, 0x02, 0x04, 0x08);
+   const __m128i BITS_HIGH = _mm_setr_epi32(0x10, 0x20, 0x40, 0x80);
+   const __m128i TINT = _mm_set1_epi32((int)tint_color);
+   for (int row = 0; row < SPRITE_MAP_KERNEL_TILE_SIZE; ++row, source += source_stride, target += target_stride)
+   {
+      const uint8_t MASK = row_masks[row];
+      if (0 == MASK) continue;
+
+      const __m128i SOURCE_LOW = do_tint ? TINT : _mm_loadu_si128((const __m128i *)source);
+      const __m128i SOURCE_HIGH = do_tint ? TINT : _mm_loadu_si128((const __m128i *)(source + 4));
+      if (0xFF == MASK)
+      {
+         _mm_storeu_si128((__m128i *)target, SOURCE_LOW);
+         _mm_storeu_si128((__m128i *)(target + 4), SOURCE_HIGH);
+         continue;
+      }
+
+      // SSE2 has no cheap masked store - Blend with the target instead
+      const __m128i MASK_BROADCAST = _mm_set1_epi32(MASK);
+      const __m128i SELECT_LOW = _mm_cmpeq_epi32(_mm_and_si128(MASK_BROADCAST, BITS_LOW), BITS_LOW);
+      const __m128i SELECT_HIGH = _mm_cmpeq_epi32(_mm_and_si128(MASK_BROADCAST, BITS_HIGH), BITS_HIGH);
+      const __m128i TARGET_LOW = _mm_loadu_si128((const __m128i *)target);
+      const __m128i TARGET_HIGH = _mm_loadu_si128((const __m128i *)(target + 4));
+      _mm_storeu_si128((__m128i *)target, _mm_or_si128(_mm_and_si128(SELECT_LOW, SOURCE_LOW), _mm_andnot_si128(SELECT_LOW, TARGET_LOW)));
+      _mm_storeu_si128((__m128i *)(target + 4), _mm_or_si128(_mm_and_si128(SELECT_HIGH, SOURCE_HIGH), _mm_andnot_si128(SELECT_HIGH, TARGET_HIGH)));
+   }
+}
+
+__attribute__((target("avx2")))
+void help_tile_kernel_avx2(const color_rgba_t * source, int source_stride, color_rgba_t * target, int target_stride, const uint8_t * row_masks, bool do_tint, color_rgba_t tint_color)
+{
+   // One tile row is 32 bytes, exactly one register
+   const __m256i BITS = _mm256_setr_epi32(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+   const __m256i TINT = _mm256_set1_epi32((int)tint_color);
+   for (int row = 0; row < SPRITE_MAP_KERNEL_TILE_SIZE; ++row, source += source_stride, target += target_stride)
+   {
+      const uint8_t MASK = row_masks[row];
+      if (0 == MASK) continue;
+
+      const __m256i SOURCE = do_tint ? TINT : _mm256_loadu_si256((const __m256i *)source);
+      if (0xFF == MASK)
+      {
+         _mm256_storeu_si256((__m256i *)target, SOURCE);
+         continue;
+      }
+
+      const __m256i SELECT = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(MASK), BITS), BITS);
+      _mm256_maskstore_epi32((int *)target, SELECT, SOURCE);
+   }
+}
+#endif
+
+tile_kernel_fn help_tile_kernel_select(const char ** out_name)
+{
+   const char * name = "scalar";
+   tile_kernel_fn kernel = help_tile_kernel_scalar;
+#ifdef RENDER_TILE_KERNEL_X86
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+   {
+      name = "avx2";
+      kernel = help_tile_kernel_avx2;
+   }
+   else
+   {
+      name = "sse2";
+      kernel = help_tile_kernel_sse2;
+   }
+#endif
+   if (out_name)
+   {
+      *out_name = name;
+   }
+   return kernel;
+}
+
+const char * help_tex_tile_kernel_name(void)
+{
+   const char * name;
+   help_tile_kernel_select(&name);
+   return name;
+}
+
+bool help_tex_tile_render_rows(struct sprite_s sprite, const uint8_t * row_masks, const struct texture_rgba_s * texture_sprite, int x, int y, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color)
+{
+   static tile_kernel_fn kernel = NULL;
+   if (NULL == kernel)
+   {
+      kernel = help_tile_kernel_select(NULL);
+   }
+
+   // Whole tiles inside the target only, anything else takes the row span path
+   if (NULL == row_masks || NULL == texture_sprite || NULL == texture_target) return false;
+   if (x < 0 || y < 0 || x + SPRITE_MAP_KERNEL_TILE_SIZE > texture_target->width || y + SPRITE_MAP_KERNEL_TILE_SIZE > texture_target->height) return false;
+
+   // Sprite row zero is the bottom one, rows are stored flipped
+   const int SOURCE_BOTTOM_ROW = sprite.texture_min.y + sprite.texture_size.y - 1;
+   const color_rgba_t * source = texture_sprite->texels + ((texture_sprite->height - 1 - SOURCE_BOTTOM_ROW) * texture_sprite->width) + sprite.texture_min.x;
+   color_rgba_t * target = texture_target->texels + ((texture_target->height - 1 - y) * texture_target->width) + x;
+   kernel(source, texture_sprite->width, target, -texture_target->width, row_masks, do_tint, tint_color);
+
+   return true;
+}
+
+bool help_tex_tile_render_masked(const struct sprite_map_s * sprite_map, int tile, int x, int y, struct texture_rgba_s * texture_target, bool do_tint, color_rgba_t tint_color)
+{
+   if (NULL == sprite_map || tile < 0 || tile >= SPRITE_MAP_TILE_COUNT) return false;
+   if (false == sprite_map->tile_row_masks_valid[tile]) return false;
+
+   return help_tex_tile_render_rows(sprite_map->tile_to_sprite[tile], sprite_map->tile_row_masks[tile], sprite_map->texture, x, y, texture_target, do_tint, tint_color);
+}
+
+// Helpers - Border rendering
+bool help_sprite_map_tile_masks_compute(struct sprite_map_s * instance, enum sprite_map_tile_e tile)
+{
+   // Only 8x8 sprites fully inside the texture take the tile kernel
+   const struct sprite_s SPRITE = instance->tile_to_sprite[tile];
+   instance->tile_row_masks_valid[tile] = false;
+   if (
+      SPRITE_MAP_KERNEL_TILE_SIZE != SPRITE.texture_size.x ||
+      SPRITE_MAP_KERNEL_TILE_SIZE != SPRITE.texture_size.y ||
+      SPRITE.texture_min.x < 0 ||
+      SPRITE.texture_min.y < 0 ||
+      SPRITE.texture_min.x + SPRITE.texture_size.x > instance->texture->width ||
+      SPRITE.texture_min.y + SPRITE.texture_size.y > instance->texture->height
+   ) return false;
+
+   for (int spr_y = 0; spr_y < SPRITE_MAP_KERNEL_TILE_SIZE; ++spr_y)
+   {
+      uint8_t row_mask = 0;
+      for (int spr_x = 0; spr_x < SPRITE_MAP_KERNEL_TILE_SIZE; ++spr_x)
+      {
+         color_rgba_t texel;
+         help_texture_rgba_access_texel(instance->texture, SPRITE.texture_min.x + spr_x, SPRITE.texture_min.y + SPRITE.texture_size.y - 1 - spr_y, &texel);
+         row_mask |= color_rgba_channel_alpha(texel) ? (uint8_t)(1u << spr_x) : 0;
+      }
+      instance->tile_row_masks[tile][spr_y] = row_mask;
+   }
+   instance->tile_row_masks_valid[tile] = true;
+
+   return true;
+}
+
+bool help_sprite_map_tile(struct sprite_map_s * instance, enum sprite_map_tile_e tile, int sprite_tile_x, int sprite_tile_y)
+{
+   if (NULL == instance) return false;
+
+   instance->tile_to_sprite[tile] = sprite_make(sprite_tile_x, sprite_tile_y, instance->tile_size);
+   help_sprite_map_tile_masks_compute(instance, tile);
+
+   return true;
+}
+
+bool help_sprite_map_tile_extended(struct sprite_map_s * instance, enum sprite_map_tile_e tile, int sprite_tile_x, int sprite_tile_y, int sprite_tiles_wide, int sprite_tiles_high)
+{
+   if (NULL == instance) return false;
+
+   instance->tile_to_sprite[tile] = sprite_make_xy_wh(sprite_tile_x, sprite_tile_y, sprite_tiles_wide, sprite_tiles_high, instance->tile_size);
+   help_sprite_map_tile_masks_compute(instance, tile);
+
+   return true;
+}
+
+struct sprite_map_s * help_sprite_map_create(struct texture_rgba_s * texture, int na_tile_x, int na_tile_y, int tile_size)
+{
+   if (NULL == texture) return NULL;
+
+   struct sprite_map_s * instance = malloc(sizeof(struct sprite_map_s));
+
+   if (instance)
+   {
+      instance->texture = texture;
+      instance->tile_size = tile_size;
+      memset(instance->tile_row_masks_valid, 0, sizeof(instance->tile_row_masks_valid));
+      help_sprite_map_tile(instance, SPRITE_MAP_TILE_NA, na_tile_x, na_tile_y);
+   }
+
+   return instance;
+}
+
+struct sprite_s help_sprite_map_sprite_for(const struct sprite_map_s * instance, enum sprite_map_tile_e tile)
+{
+   if (NULL == instance) return sprite_make(7, 4, 8);
+
+   // Assume that all tiles are mapped for now
+   return instance->tile_to_sprite[tile];
+}
+
+bool help_sprite_map_register_tiles(struct sprite_map_s * instance)
+{
+   if (NULL == instance) return false;
+
+   // >> Register tetro sprites
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_I, 0, 6);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_O, 1, 6);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_Lr, 2, 6);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_L, 3, 6);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_S, 4, 6);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_T, 5, 6);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_TETRO_BLOCK_Z, 6, 6);
+   // >> Register play field sprites
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_BRICK, 0, 4);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_HIGHLIGHT, 9, 4);
+   // >> Register font rendering sprites
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_A, 0, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_B, 1, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_C, 2, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_D, 3, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_E, 4, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_F, 5, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_G, 6, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_H, 7, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_I, 8, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_J, 9, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_K, 10, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_L, 11, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_M, 12, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_N, 13, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_O, 14, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_P, 15, 0);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_Q, 0, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_R, 1, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_S, 2, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_T, 3, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_U, 4, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_V, 5, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_W, 6, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_X, 7, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_Y, 8, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_Z, 9, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_0, 0, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_1, 1, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_2, 2, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_3, 3, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_4, 4, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_5, 5, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_6, 6, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_7, 7, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_8, 8, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_9, 9, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_PERIOD, 10, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_HYPHEN, 11, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_COMMA, 12, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_COLON, 15, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_OPEN, 13, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_CLOSED, 14, 1);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_PIPE, 13, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_GLYPH_PLUS, 15, 1);
+   // >> Register additional sprites
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_COPYRIGHT, 10, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_FONT_ARROW_RIGHT, 11, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_GAME_OVER_FILL, 5, 4);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_HEART, 12, 2);
+   help_sprite_map_tile(instance, SPRITE_MAP_TILE_SPEAKER, 14, 2);
+   // >> Register extended background sprites
+   help_sprite_map_tile_extended(instance, SPRITE_MAP_TILE_BG_TITLE_SCREEN, 16, 0, 20, 18);
+   help_sprite_map_tile_extended(instance, SPRITE_MAP_TILE_BG_CONFIG_SCREEN, 36, 0, 20, 18);
+   help_sprite_map_tile_extended(instance, SPRITE_MAP_TILE_BG_PLAY_SCREEN, 16, 18, 20, 18);
+   help_sprite_map_tile_extended(instance, SPRITE_MAP_TILE_BG_INPUT_MAPPING_SCREEN, 36, 18, 20, 18);
+
+   return true;
+}
+
+// Logic - Tint cache
+struct tint_cache_s * help_tint_cache_create(int tile_size)
+{
+   if (tile_size <= 0) return NULL;
+
+   struct tint_cache_s * instance = malloc(sizeof(struct tint_cache_s));
+   if (NULL == instance) return NULL;
+
+   // One tile slot per entry, fully transparent until baked
+   const int SLOT_ROWS = TINT_CACHE_CAPACITY / TINT_CACHE_SLOTS_PER_ROW;
+   instance->texture = help_texture_rgba_make(TINT_CACHE_SLOTS_PER_ROW * tile_size, SLOT_ROWS * tile_size, color_rgba_make_rgba(0, 0, 0, 0));
+   if (NULL == instance->texture)
+   {
+      free(instance);
+      return NULL;
+   }
+   instance->tile_size = tile_size;
+   instance->entry_count = 0;
+   instance->misses = 0;
+   instance->bypasses = 0;
+   memset(instance->entries, 0, sizeof(instance->entries));
+
+   return instance;
+}
+
+void * help_tint_cache_destroy(struct tint_cache_s * instance)
+{
+   if (instance)
+   {
+      help_texture_rgba_destroy(instance->texture);
+      free(instance);
+   }
+
+   return NULL;
+}
+
+int help_tint_cache_slot_first(enum sprite_map_tile_e tile, color_rgba_t tint)
+{
+   uint32_t hash = ((uint32_t)tile * 0x9E3779B1u) ^ (tint * 0x85EBCA6Bu);
+   hash ^= hash >> 16;
+   return (int)(hash % TINT_CACHE_CAPACITY);
+}
+
+bool help_tint_cache_tile_fits(const struct tint_cache_s * instance, const struct sprite_map_s * sprite_map, enum sprite_map_tile_e tile)
+{
+   const struct sprite_s SOURCE = sprite_map->tile_to_sprite[tile];
+   return instance->tile_size == SOURCE.texture_size.x && instance->tile_size == SOURCE.texture_size.y;
+}
+
+bool help_tint_cache_bake(struct tint_cache_s * instance, const struct sprite_map_s * sprite_map, struct tint_cache_entry_s * entry)
+{
+   const struct sprite_s SOURCE = sprite_map->tile_to_sprite[entry->tile];
+   const int SLOT = (int)(entry - instance->entries);
+   entry->sprite = sprite_make(SLOT % TINT_CACHE_SLOTS_PER_ROW, SLOT / TINT_CACHE_SLOTS_PER_ROW, instance->tile_size);
+   for (int spr_y = 0; spr_y < instance->tile_size; ++spr_y)
+   {
+      for (int spr_x = 0; spr_x < instance->tile_size; ++spr_x)
+      {
+         color_rgba_t texel;
+         if (false == help_texture_rgba_access_texel(sprite_map->texture, SOURCE.texture_min.x + spr_x, SOURCE.texture_min.y + spr_y, &texel)) continue;
+
+         // Opaque texels take the tint, transparent ones stay skipped by every blitter
+         const color_rgba_t BAKED = color_rgba_channel_alpha(texel) ? entry->tint : color_rgba_make_rgba(0, 0, 0, 0);
+         help_texture_rgba_plot_texel(instance->texture, entry->sprite.texture_min.x + spr_x, entry->sprite.texture_min.y + spr_y, BAKED);
+      }
+   }
+
+   // Opacity is the same as the source tile
+   entry->row_masks_valid = sprite_map->tile_row_masks_valid[entry->tile];
+   memcpy(entry->row_masks, sprite_map->tile_row_masks[entry->tile], sizeof(entry->row_masks));
+
+   return true;
+}
+
+const struct tint_cache_entry_s * help_tint_cache_entry_for(struct tint_cache_s * instance, const struct sprite_map_s * sprite_map, enum sprite_map_tile_e tile, color_rgba_t tint)
+{
+   if (NULL == instance || NULL == sprite_map || tile < 0 || tile >= SPRITE_MAP_TILE_COUNT) return NULL;
+
+   // Single tile sprites only, larger ones keep the per texel tint without a probe or a miss
+   if (false == help_tint_cache_tile_fits(instance, sprite_map, tile))
+   {
+      instance->bypasses += 1;
+      return NULL;
+   }
+
+   // Open addressing with linear probing
+   const int SLOT_FIRST = help_tint_cache_slot_first(tile, tint);
+   for (int i_probe = 0; i_probe < TINT_CACHE_CAPACITY; ++i_probe)
+   {
+      struct tint_cache_entry_s * entry = instance->entries + ((SLOT_FIRST + i_probe) % TINT_CACHE_CAPACITY);
+      if (entry->is_used)
+      {
+         if (entry->tile == tile && entry->tint == tint) return entry;
+         continue;
+      }
+
+      // Miss - Bake into the free slot
+      instance->misses += 1;
+      entry->tile = tile;
+      entry->tint = tint;
+      if (false == help_tint_cache_bake(instance, sprite_map, entry)) return NULL;
+      entry->is_used = true;
+      instance->entry_count += 1;
+
+      return entry;
+   }
+
+   // Cache full
+   return NULL;
+}
+
+bool help_tint_cache_bake_font_palette(struct tint_cache_s * instance, const struct sprite_map_s * sprite_map, const struct font_render_s * font_render)
+{
+   if (NULL == instance || NULL == sprite_map || NULL == font_render) return false;
+
+   for (int i_shade = 0; i_shade < PALETTE_SHADE_COUNT; ++i_shade)
+   {
+      const color_rgba_t TINT = help_palette_shade_color((enum palette_shade_e)i_shade);
+      for (int ascii_code = 0; ascii_code < FONT_RENDER_MAX_GLYPHS; ++ascii_code)
+      {
+         const struct font_render_glyph_s GLYPH = font_render->glyphs[ascii_code];
+         if (GLYPH.is_mapped && NULL == help_tint_cache_entry_for(instance, sprite_map, GLYPH.sprite_tile, TINT)) return false;
+      }
+   }
+
+   // Success
+   return true;
+}
+
+// Helpers - Signatures
+uint64_t help_signature_fold(uint64_t signature, uint64_t value)
+{
+   // FNV-1a step, order matters since later draws cover earlier ones
+   return (signature ^ value) * 0x100000001b3ull;
+}
+
+// Logic - Render commands
+struct render_commands_s * help_render_commands_create(void)
+{
+   struct render_commands_s * instance = malloc(sizeof(struct render_commands_s));
+   if (NULL == instance) return NULL;
+
+   instance->count = 0;
+   instance->is_recording = false;
+   instance->overflow = false;
+   instance->run_count = 0;
+   instance->signature = 0;
+   instance->is_repeat = false;
+   instance->commands_total = 0;
+   instance->culled_total = 0;
+   instance->runs_total = 0;
+   instance->repeats_total = 0;
+   instance->frames = 0;
+
+   return instance;
+}
+
+void * help_render_commands_destroy(struct render_commands_s * instance)
+{
+   free(instance);
+
+   return NULL;
+}
+
+void help_render_commands_begin(struct render_commands_s * instance)
+{
+   instance->count = 0;
+   instance->run_count = 0;
+   instance->overflow = false;
+   instance->is_recording = true;
+}
+
+bool help_render_commands_push(struct render_commands_s * instance, enum render_command_kind_e kind, int id, int x, int y, int width, int height, bool do_tint, color_rgba_t color)
+{
+   if (NULL == instance) return false;
+   if (instance->count >= RENDER_COMMAND_CAPACITY)
+   {
+      instance->overflow = true;
+      return false;
+   }
+
+   struct render_command_s * command = instance->commands + instance->count++;
+   command->kind = (uint8_t)kind;
+   command->do_tint = do_tint ? 1 : 0;
+   command->id = (uint16_t)id;
+   command->x = (int16_t)x;
+   command->y = (int16_t)y;
+   command->width = (int16_t)width;
+   command->height = (int16_t)height;
+   command->color = (do_tint || RENDER_COMMAND_SPRITE != kind) ? color : 0;
+
+   return true;
+}
+
+struct region_2d_s help_render_command_region(const struct render_command_s * command)
+{
+   return region_2d_s_make(command->x, command->y, command->width, command->height);
+}
+
+void help_render_commands_end(struct render_commands_s * instance, int target_width, int target_height)
+{
+   instance->is_recording = false;
+   instance->run_count = 0;
+   const uint64_t SIGNATURE_PREVIOUS = instance->signature;
+   instance->signature = 0;
+   instance->is_repeat = false;
+   if (instance->overflow) return;
+
+   // FNV-1a over the surviving commands - Equal lists compose equal frames
+   uint64_t signature = 0xcbf29ce484222325ull;
+
+   for (int i_command = 0; i_command < instance->count; ++i_command)
+   {
+      // Cull whatever misses the target entirely
+      const struct render_command_s * COMMAND = instance->commands + i_command;
+      const struct region_2d_s REGION = help_render_command_region(COMMAND);
+      if (REGION.max.x < 0 || REGION.max.y < 0 || REGION.min.x >= target_width || REGION.min.y >= target_height || COMMAND->width <= 0 || COMMAND->height <= 0)
+      {
+         instance->culled_total += 1;
+         continue;
+      }
+      uint64_t command_words[2];
+      memcpy(command_words, COMMAND, sizeof(command_words));
+      signature = help_signature_fold(help_signature_fold(signature, command_words[0]), command_words[1]);
+
+      // Sprites continuing the previous run on the same row with the same tint join it
+      struct render_command_run_s * run = instance->run_count ? instance->runs + instance->run_count - 1 : NULL;
+      const struct render_command_s * PREVIOUS = run ? instance->commands + run->first + run->count - 1 : NULL;
+      if (
+         PREVIOUS &&
+         PREVIOUS == COMMAND - 1 &&
+         RENDER_COMMAND_SPRITE == COMMAND->kind &&
+         RENDER_COMMAND_SPRITE == PREVIOUS->kind &&
+         COMMAND->y == PREVIOUS->y &&
+         COMMAND->height == PREVIOUS->height &&
+         COMMAND->x == PREVIOUS->x + PREVIOUS->width &&
+         COMMAND->do_tint == PREVIOUS->do_tint &&
+         COMMAND->color == PREVIOUS->color
+      )
+      {
+         run->count += 1;
+         run->region = region_2d_s_make(run->region.min.x, run->region.min.y, run->region.size.x + COMMAND->width, run->region.size.y);
+         continue;
+      }
+
+      run = instance->runs + instance->run_count++;
+      run->first = i_command;
+      run->count = 1;
+      run->region = REGION;
+   }
+
+   instance->signature = signature;
+   instance->is_repeat = (SIGNATURE_PREVIOUS == signature);
+   instance->commands_total += instance->count;
+   instance->runs_total += instance->run_count;
+   instance->repeats_total += instance->is_repeat ? 1 : 0;
+   instance->frames += 1;
+}
+
+// Logic - Geometry batches
+struct render_geometry_s * help_render_geometry_create(const struct texture_rgba_s * tex_sprites)
+{
+   if (NULL == tex_sprites) return NULL;
+
+   struct render_geometry_s * instance = malloc(sizeof(struct render_geometry_s));
+   if (NULL == instance) return NULL;
+
+   const int WIDTH = tex_sprites->width;
+   const int SHEET_HEIGHT = tex_sprites->height;
+   instance->atlas = help_texture_rgba_make(WIDTH, SHEET_HEIGHT * 2 + 1, 0);
+   if (NULL == instance->atlas)
+   {
+      free(instance);
+      return NULL;
+   }
+   instance->sheet_height = SHEET_HEIGHT;
+   instance->quad_count = 0;
+   instance->quads_total = 0;
+   instance->batches = 0;
+
+   // Sheet and its white copy - Sprite rows are stored flipped, atlas rows top down
+   const color_rgba_t WHITE = color_rgba_make_rgba(0xFF, 0xFF, 0xFF, 0xFF);
+   for (int row = 0; row < SHEET_HEIGHT; ++row)
+   {
+      const color_rgba_t * SOURCE = tex_sprites->texels + (SHEET_HEIGHT - 1 - row) * WIDTH;
+      color_rgba_t * sheet = instance->atlas->texels + row * WIDTH;
+      color_rgba_t * mask = instance->atlas->texels + (SHEET_HEIGHT + row) * WIDTH;
+      for (int x = 0; x < WIDTH; ++x)
+      {
+         sheet[x] = SOURCE[x];
+         mask[x] = (SOURCE[x] & color_rgba_alpha_mask()) ? WHITE : 0;
+      }
+   }
+   // >> White row sampled by fills
+   color_rgba_t * white_row = instance->atlas->texels + SHEET_HEIGHT * 2 * WIDTH;
+   for (int x = 0; x < WIDTH; ++x)
+   {
+      white_row[x] = WHITE;
+   }
+
+   // Top left, top right, bottom left, bottom right per quad
+   for (int i_quad = 0; i_quad < RENDER_COMMAND_CAPACITY; ++i_quad)
+   {
+      int * indices = instance->indices + i_quad * 6;
+      const int FIRST = i_quad * 4;
+      indices[0] = FIRST + 0;
+      indices[1] = FIRST + 1;
+      indices[2] = FIRST + 2;
+      indices[3] = FIRST + 2;
+      indices[4] = FIRST + 1;
+      indices[5] = FIRST + 3;
+   }
+
+   return instance;
+}
+
+void * help_render_geometry_destroy(struct render_geometry_s * instance)
+{
+   if (instance)
+   {
+      help_texture_rgba_destroy(instance->atlas);
+      free(instance);
+   }
+
+   return NULL;
+}
+
+struct render_vertex_s help_render_vertex_make(float x, float y, color_rgba_t color, float u, float v)
+{
+   struct render_vertex_s vertex;
+   vertex.x = x;
+   vertex.y = y;
+   vertex.red = color_rgba_channel_red(color) / 255.0f;
+   vertex.green = color_rgba_channel_green(color) / 255.0f;
+   vertex.blue = color_rgba_channel_blue(color) / 255.0f;
+   vertex.alpha = color_rgba_channel_alpha(color) / 255.0f;
+   vertex.u = u;
+   vertex.v = v;
+
+   return vertex;
+}
+
+bool help_render_geometry_build(struct render_geometry_s * instance, const struct render_commands_s * commands, const struct sprite_map_s * sprite_map, int virtual_height, float origin_x, float origin_y, float scale)
+{
+   if (NULL == instance || NULL == commands || NULL == sprite_map) return false;
+
+   instance->quad_count = 0;
+   if (commands->is_recording || commands->overflow) return false;
+
+   const float ATLAS_WIDTH = (float)instance->atlas->width;
+   const float ATLAS_HEIGHT = (float)instance->atlas->height;
+   const color_rgba_t WHITE = color_rgba_make_rgba(0xFF, 0xFF, 0xFF, 0xFF);
+   for (int i_run = 0; i_run < commands->run_count; ++i_run)
+   {
+      const struct render_command_run_s * RUN = commands->runs + i_run;
+      for (int i_command = RUN->first; i_command < RUN->first + RUN->count; ++i_command)
+      {
+         // Static layers live in a texture of their own
+         const struct render_command_s * COMMAND = commands->commands + i_command;
+         if (RENDER_COMMAND_LAYER == COMMAND->kind)
+         {
+            instance->quad_count = 0;
+            return false;
+         }
+
+         // Commands grow upwards from the bottom left, quads downwards from the top left
+         const float LEFT = origin_x + COMMAND->x * scale;
+         const float RIGHT = origin_x + (COMMAND->x + COMMAND->width) * scale;
+         const float TOP = origin_y + (virtual_height - COMMAND->y - COMMAND->height) * scale;
+         const float BOTTOM = origin_y + (virtual_height - COMMAND->y) * scale;
+
+         color_rgba_t color = COMMAND->color;
+         float u_min = 0.5f / ATLAS_WIDTH;
+         float u_max = u_min;
+         float v_min = (instance->sheet_height * 2 + 0.5f) / ATLAS_HEIGHT;
+         float v_max = v_min;
+         if (RENDER_COMMAND_SPRITE == COMMAND->kind)
+         {
+            const struct sprite_s SPRITE = help_sprite_map_sprite_for(sprite_map, COMMAND->id);
+            const int ROW_OFFSET = COMMAND->do_tint ? instance->sheet_height : 0;
+            color = COMMAND->do_tint ? COMMAND->color : WHITE;
+            u_min = SPRITE.texture_min.x / ATLAS_WIDTH;
+            u_max = (SPRITE.texture_min.x + SPRITE.texture_size.x) / ATLAS_WIDTH;
+            v_min = (SPRITE.texture_min.y + ROW_OFFSET) / ATLAS_HEIGHT;
+            v_max = (SPRITE.texture_min.y + SPRITE.texture_size.y + ROW_OFFSET) / ATLAS_HEIGHT;
+         }
+
+         struct render_vertex_s * vertices = instance->vertices + instance->quad_count * 4;
+         vertices[0] = help_render_vertex_make(LEFT, TOP, color, u_min, v_min);
+         vertices[1] = help_render_vertex_make(RIGHT, TOP, color, u_max, v_min);
+         vertices[2] = help_render_vertex_make(LEFT, BOTTOM, color, u_min, v_max);
+         vertices[3] = help_render_vertex_make(RIGHT, BOTTOM, color, u_max, v_max);
+         instance->quad_count += 1;
+      }
+   }
+
+   instance->quads_total += instance->quad_count;
+   instance->batches += 1;
+
+   // Success
+   return true;
+}
+
+// Logic - Nametable
+struct nametable_s * help_nametable_create(int width, int height, int tile_size)
+{
+   if (width <= 0 || height <= 0 || tile_size <= 0) return NULL;
+
+   struct nametable_s * instance = malloc(sizeof(struct nametable_s));
+   if (NULL == instance) return NULL;
+
+   // Partial tiles at the top and right count as whole ones
+   instance->tile_size = tile_size;
+   instance->tiles_wide = (width + tile_size - 1) / tile_size;
+   instance->tiles_high = (height + tile_size - 1) / tile_size;
+   const int TILE_COUNT = instance->tiles_wide * instance->tiles_high;
+   instance->signatures = malloc(sizeof(uint64_t) * TILE_COUNT);
+   instance->signatures_previous = malloc(sizeof(uint64_t) * TILE_COUNT);
+   instance->dirty = malloc(sizeof(bool) * TILE_COUNT);
+   instance->rects = malloc(sizeof(struct nametable_rect_s) * TILE_COUNT);
+   if (NULL == instance->signatures || NULL == instance->signatures_previous || NULL == instance->dirty || NULL == instance->rects)
+   {
+      return help_nametable_destroy(instance);
+   }
+
+   instance->is_valid = false;
+   instance->rect_count = 0;
+   instance->tiles_redrawn = 0;
+   instance->tiles_redrawn_total = 0;
+   instance->rects_total = 0;
+   instance->frames = 0;
+
+   return instance;
+}
+
+void * help_nametable_destroy(struct nametable_s * instance)
+{
+   if (instance)
+   {
+      free(instance->signatures);
+      free(instance->signatures_previous);
+      free(instance->dirty);
+      free(instance->rects);
+      free(instance);
+   }
+
+   return NULL;
+}
+
+void help_nametable_invalidate(struct nametable_s * instance)
+{
+   // Anything else wrote the target - Redraw every tile next frame
+   if (instance)
+   {
+      instance->is_valid = false;
+   }
+}
+
+void help_nametable_fold(struct nametable_s * instance, const struct render_command_s * command)
+{
+   // Fold the draw into every tile it covers, relative to the tile origin
+   const struct region_2d_s REGION = help_render_command_region(command);
+   const int TILE_SIZE = instance->tile_size;
+   const int TILE_X_BEGIN = help_minmax_max_2i(0, REGION.min.x / TILE_SIZE);
+   const int TILE_X_END = help_minmax_min_2i(instance->tiles_wide - 1, REGION.max.x / TILE_SIZE);
+   const int TILE_Y_BEGIN = help_minmax_max_2i(0, REGION.min.y / TILE_SIZE);
+   const int TILE_Y_END = help_minmax_min_2i(instance->tiles_high - 1, REGION.max.y / TILE_SIZE);
+
+   // Color in bits 0-31, the 16-bit id in 32-47, kind in 48-55 and the tint flag in 63
+   const uint64_t COMMAND_VALUE = ((uint64_t)command->do_tint << 63) ^ ((uint64_t)command->kind << 48) ^ ((uint64_t)command->id << 32) ^ command->color;
+   const uint64_t SIZE_VALUE = ((uint64_t)(uint32_t)REGION.size.x << 32) ^ (uint32_t)REGION.size.y;
+   for (int tile_y = TILE_Y_BEGIN; tile_y <= TILE_Y_END; ++tile_y)
+   {
+      for (int tile_x = TILE_X_BEGIN; tile_x <= TILE_X_END; ++tile_x)
+      {
+         const uint64_t OFFSET_VALUE = ((uint64_t)(uint32_t)(REGION.min.x - tile_x * TILE_SIZE) << 32) ^ (uint32_t)(REGION.min.y - tile_y * TILE_SIZE);
+         uint64_t * signature = instance->signatures + (tile_y * instance->tiles_wide) + tile_x;
+         *signature = help_signature_fold(help_signature_fold(help_signature_fold(*signature, COMMAND_VALUE), SIZE_VALUE), OFFSET_VALUE);
+      }
+   }
+}
+
+void help_nametable_resolve(struct nametable_s * instance, const struct render_commands_s * commands)
+{
+   if (NULL == instance) return;
+
+   // Signatures of this frame from the surviving commands, no commands at all means everything changed
+   const bool EVERYTHING_DIRTY = (NULL == commands || commands->overflow);
+   const int TILE_COUNT = instance->tiles_wide * instance->tiles_high;
+   for (int i_tile = 0; i_tile < TILE_COUNT; ++i_tile)
+   {
+      instance->signatures[i_tile] = 0xcbf29ce484222325ull;
+   }
+   for (int i_run = 0; false == EVERYTHING_DIRTY && i_run < commands->run_count; ++i_run)
+   {
+      const struct render_command_run_s * RUN = commands->runs + i_run;
+      for (int i_command = RUN->first; i_command < RUN->first + RUN->count; ++i_command)
+      {
+         help_nametable_fold(instance, commands->commands + i_command);
+      }
+   }
+
+   // Compare against the previous frame and keep the signatures for the next one
+   instance->tiles_redrawn = 0;
+   instance->rect_count = 0;
+   for (int tile_y = 0; tile_y < instance->tiles_high; ++tile_y)
+   {
+      int run_x = -1;
+      for (int tile_x = 0; tile_x <= instance->tiles_wide; ++tile_x)
+      {
+         bool is_dirty = false;
+         if (tile_x < instance->tiles_wide)
+         {
+            const int TILE_INDEX = (tile_y * instance->tiles_wide) + tile_x;
+            is_dirty = (false == instance->is_valid || EVERYTHING_DIRTY || instance->signatures[TILE_INDEX] != instance->signatures_previous[TILE_INDEX]);
+            instance->dirty[TILE_INDEX] = is_dirty;
+            instance->signatures_previous[TILE_INDEX] = instance->signatures[TILE_INDEX];
+            instance->tiles_redrawn += is_dirty ? 1 : 0;
+         }
+
+         if (is_dirty && run_x < 0)
+         {
+            run_x = tile_x;
+         }
+         else if (false == is_dirty && run_x >= 0)
+         {
+            // Run ended - Grow the rectangle right below when it spans the same columns
+            // Rects are in creation order, not by end row, so closed ones are skipped rather than ending the search
+            const int RUN_WIDE = tile_x - run_x;
+            bool merged = false;
+            for (int i_rect = instance->rect_count - 1; i_rect >= 0; --i_rect)
+            {
+               struct nametable_rect_s * rect = instance->rects + i_rect;
+               if (rect->tile_y + rect->tiles_high < tile_y) continue;
+               if (rect->tile_y + rect->tiles_high == tile_y && rect->tile_x == run_x && rect->tiles_wide == RUN_WIDE)
+               {
+                  rect->tiles_high += 1;
+                  merged = true;
+                  break;
+               }
+            }
+            if (false == merged)
+            {
+               struct nametable_rect_s * rect = instance->rects + instance->rect_count++;
+               rect->tile_x = run_x;
+               rect->tile_y = tile_y;
+               rect->tiles_wide = RUN_WIDE;
+               rect->tiles_high = 1;
+            }
+            run_x = -1;
+         }
+      }
+   }
+
+   instance->is_valid = (false == EVERYTHING_DIRTY);
+   instance->tiles_redrawn_total += instance->tiles_redrawn;
+   instance->rects_total += (unsigned long long)instance->rect_count;
+   instance->frames += 1;
+}
+
+struct region_2d_s help_nametable_rect_texels(const struct nametable_s * instance, struct nametable_rect_s rect)
+{
+   return region_2d_s_make(
+      rect.tile_x * instance->tile_size,
+      rect.tile_y * instance->tile_size,
+      rect.tiles_wide * instance->tile_size,
+      rect.tiles_high * instance->tile_size
+   );
+}
+
+// Logic - Static layers
+enum render_layer_e help_render_layer_for_state(enum game_state_e game_state)
+{
+   switch (game_state)
+   {
+      case GAME_STATE_SPLASH:
+         return RENDER_LAYER_SPLASH;
+      case GAME_STATE_INPUT_MAPPING:
+         return RENDER_LAYER_INPUT_MAPPING;
+      case GAME_STATE_TITLE:
+         return RENDER_LAYER_TITLE;
+      case GAME_STATE_GAME_MUSIC_CONFIG:
+         return RENDER_LAYER_CONFIG;
+      case GAME_STATE_CONTROL:
+      case GAME_STATE_PLACE:
+      case GAME_STATE_REMOVE_LINES:
+      case GAME_STATE_CONSOLIDATE_PLAY_FIELD:
+      case GAME_STATE_RESPAWN:
+      case GAME_STATE_GAME_OVER:
+      case GAME_STATE_GAME_OVER_TRANSITION_FILL:
+      case GAME_STATE_GAME_OVER_TRANSITION_CLEAR:
+      case GAME_STATE_PAUSE:
+         return RENDER_LAYER_PLAY;
+      default:
+         return RENDER_LAYER_BLANK;
+   }
+}
+
+struct layer_cache_s * help_layer_cache_create(int width, int height)
+{
+   struct layer_cache_s * instance = malloc(sizeof(struct layer_cache_s));
+   if (NULL == instance) return NULL;
+
+   instance->texture = help_texture_rgba_make(width, height, help_palette_shade_color(PALETTE_SHADE_LIGHTEST));
+   if (NULL == instance->texture)
+   {
+      free(instance);
+      return NULL;
+   }
+   instance->layer = RENDER_LAYER_BLANK;
+   instance->is_valid = false;
+   instance->rebuilds = 0;
+
+   return instance;
+}
+
+void * help_layer_cache_destroy(struct layer_cache_s * instance)
+{
+   if (instance)
+   {
+      help_texture_rgba_destroy(instance->texture);
+      free(instance);
+   }
+
+   return NULL;
+}
+
+void help_layer_cache_invalidate(struct layer_cache_s * instance)
+{
+   if (instance)
+   {
+      instance->is_valid = false;
+   }
+}
+
+// Logic - Indexed textures
+#define TEXTURE_2BPP_GROUP_TEXELS (8)
+#define TEXTURE_2BPP_GROUP_BYTES (3)
+
+struct texture_2bpp_s * help_texture_2bpp_make(int width, int height, enum palette_shade_e clear_shade)
+{
+   if (width <= 0 || height <= 0) return NULL;
+
+   struct texture_2bpp_s * instance = malloc(sizeof(struct texture_2bpp_s));
+   if (NULL == instance) return NULL;
+
+   instance->width = width;
+   instance->height = height;
+   instance->groups_per_row = (width + TEXTURE_2BPP_GROUP_TEXELS - 1) / TEXTURE_2BPP_GROUP_TEXELS;
+   instance->groups = malloc(TEXTURE_2BPP_GROUP_BYTES * instance->groups_per_row * height);
+   if (NULL == instance->groups)
+   {
+      free(instance);
+      return NULL;
+   }
+   help_texture_2bpp_fill(instance, 0, 0, width, height, clear_shade);
+
+   return instance;
+}
+
+void * help_texture_2bpp_destroy(struct texture_2bpp_s * instance)
+{
+   if (instance)
+   {
+      free(instance->groups);
+   }
+
+   free(instance);
+
+   return NULL;
+}
+
+struct texture_2bpp_s * help_texture_2bpp_from_rgba(const struct texture_rgba_s * source)
+{
+   if (NULL == source) return NULL;
+
+   struct texture_2bpp_s * instance = help_texture_2bpp_make(source->width, source->height, PALETTE_SHADE_LIGHTEST);
+   if (NULL == instance) return NULL;
+
+   // Same storage rows, every opaque texel mapped to its shade
+   const color_rgba_t ALPHA_MASK = color_rgba_alpha_mask();
+   for (int row = 0; row < source->height; ++row)
+   {
+      uint8_t * group_row = instance->groups + (row * instance->groups_per_row * TEXTURE_2BPP_GROUP_BYTES);
+      memset(group_row, 0, instance->groups_per_row * TEXTURE_2BPP_GROUP_BYTES);
+      for (int x = 0; x < source->width; ++x)
+      {
+         const color_rgba_t TEXEL = source->texels[(row * source->width) + x];
+         if (0 == (TEXEL & ALPHA_MASK)) continue;
+
+         const enum palette_shade_e SHADE = help_palette_shade_nearest(TEXEL);
+         const uint8_t BIT = (uint8_t)(0x80 >> (x % TEXTURE_2BPP_GROUP_TEXELS));
+         uint8_t * group = group_row + ((x / TEXTURE_2BPP_GROUP_TEXELS) * TEXTURE_2BPP_GROUP_BYTES);
+         group[0] |= (SHADE & 1) ? BIT : 0;
+         group[1] |= (SHADE & 2) ? BIT : 0;
+         group[2] |= BIT;
+      }
+   }
+
+   return instance;
+}
+
+void help_texture_2bpp_group_write(uint8_t * group_row, int groups_per_row, int group, uint8_t plane_0, uint8_t plane_1, uint8_t mask)
+{
+   if (0 == mask || group < 0 || group >= groups_per_row) return;
+
+   uint8_t * target = group_row + (group * TEXTURE_2BPP_GROUP_BYTES);
+   target[0] = (uint8_t)((target[0] & ~mask) | (plane_0 & mask));
+   target[1] = (uint8_t)((target[1] & ~mask) | (plane_1 & mask));
+   target[2] |= mask;
+}
+
+void help_texture_2bpp_fill(struct texture_2bpp_s * instance, int min_x, int min_y, int width, int height, enum palette_shade_e shade)
+{
+   if (NULL == instance) return;
+
+   const int X_BEGIN = help_minmax_max_2i(0, min_x);
+   const int X_END = help_minmax_min_2i(instance->width, min_x + width);
+   const int Y_BEGIN = help_minmax_max_2i(0, min_y);
+   const int Y_END = help_minmax_min_2i(instance->height, min_y + height);
+   if (X_BEGIN >= X_END || Y_BEGIN >= Y_END) return;
+
+   // Partial groups only at both ends, whole groups in between are stored outright
+   const uint8_t PLANE_0 = (shade & 1) ? 0xFF : 0x00;
+   const uint8_t PLANE_1 = (shade & 2) ? 0xFF : 0x00;
+   const int GROUP_FIRST = X_BEGIN / TEXTURE_2BPP_GROUP_TEXELS;
+   const int GROUP_LAST = (X_END - 1) / TEXTURE_2BPP_GROUP_TEXELS;
+   uint8_t mask_first = (uint8_t)(0xFF >> (X_BEGIN % TEXTURE_2BPP_GROUP_TEXELS));
+   const uint8_t MASK_LAST = (uint8_t)(0xFF << ((TEXTURE_2BPP_GROUP_TEXELS - (X_END % TEXTURE_2BPP_GROUP_TEXELS)) % TEXTURE_2BPP_GROUP_TEXELS));
+   if (GROUP_FIRST == GROUP_LAST)
+   {
+      mask_first &= MASK_LAST;
+   }
+   const int ROW_BYTES = instance->groups_per_row * TEXTURE_2BPP_GROUP_BYTES;
+   for (int y = Y_BEGIN; y < Y_END; ++y)
+   {
+      uint8_t * group_row = instance->groups + ((instance->height - 1 - y) * ROW_BYTES);
+      help_texture_2bpp_group_write(group_row, instance->groups_per_row, GROUP_FIRST, PLANE_0, PLANE_1, mask_first);
+      for (int group = GROUP_FIRST + 1; group < GROUP_LAST; ++group)
+      {
+         uint8_t * target = group_row + (group * TEXTURE_2BPP_GROUP_BYTES);
+         target[0] = PLANE_0;
+         target[1] = PLANE_1;
+         target[2] = 0xFF;
+      }
+      if (GROUP_FIRST != GROUP_LAST)
+      {
+         help_texture_2bpp_group_write(group_row, instance->groups_per_row, GROUP_LAST, PLANE_0, PLANE_1, MASK_LAST);
+      }
+   }
+}
+
+bool help_tex_2bpp_sprite_render(struct sprite_s sprite, int x, int y, const struct texture_2bpp_s * texture_sprite, struct texture_2bpp_s * texture_target, bool do_tint, enum palette_shade_e tint_shade)
+{
+   if (NULL == texture_sprite || NULL == texture_target) return false;
+   if (0 != sprite.texture_min.x % TEXTURE_2BPP_GROUP_TEXELS || 0 != sprite.texture_size.x % TEXTURE_2BPP_GROUP_TEXELS) return false;
+
+   // Clip sprite rows like the row span blitter, sprite row zero is the bottom one
+   const int SOURCE_BOTTOM_ROW = sprite.texture_min.y + sprite.texture_size.y - 1;
+   const int SPRITE_Y_BEGIN = help_minmax_max_2i(help_minmax_max_2i(0, -y), SOURCE_BOTTOM_ROW - (texture_sprite->height - 1));
+   const int SPRITE_Y_END = help_minmax_min_2i(
+      help_minmax_min_2i(sprite.texture_size.y, texture_target->height - y),
+      SOURCE_BOTTOM_ROW + 1
+   );
+
+   // Source groups inside the atlas, target groups are clipped per write
+   const int SOURCE_GROUP_FIRST = sprite.texture_min.x / TEXTURE_2BPP_GROUP_TEXELS;
+   const int GROUP_BEGIN = help_minmax_max_2i(0, -SOURCE_GROUP_FIRST);
+   const int GROUP_END = help_minmax_min_2i(sprite.texture_size.x / TEXTURE_2BPP_GROUP_TEXELS, texture_sprite->groups_per_row - SOURCE_GROUP_FIRST);
+   if (SPRITE_Y_BEGIN >= SPRITE_Y_END || GROUP_BEGIN >= GROUP_END) return true;
+
+   // Unaligned targets straddle two groups
+   const int SHIFT = ((x % TEXTURE_2BPP_GROUP_TEXELS) + TEXTURE_2BPP_GROUP_TEXELS) % TEXTURE_2BPP_GROUP_TEXELS;
+   const int TARGET_GROUP_FIRST = (x - SHIFT) / TEXTURE_2BPP_GROUP_TEXELS;
+   const uint8_t TINT_0 = (tint_shade & 1) ? 0xFF : 0x00;
+   const uint8_t TINT_1 = (tint_shade & 2) ? 0xFF : 0x00;
+   const int SOURCE_ROW_BYTES = texture_sprite->groups_per_row * TEXTURE_2BPP_GROUP_BYTES;
+   const int TARGET_ROW_BYTES = texture_target->groups_per_row * TEXTURE_2BPP_GROUP_BYTES;
+   const uint8_t * source_row = texture_sprite->groups + ((texture_sprite->height - 1 - (SOURCE_BOTTOM_ROW - SPRITE_Y_BEGIN)) * SOURCE_ROW_BYTES);
+   uint8_t * target_row = texture_target->groups + ((texture_target->height - 1 - (y + SPRITE_Y_BEGIN)) * TARGET_ROW_BYTES);
+   for (int spr_y = SPRITE_Y_BEGIN; spr_y < SPRITE_Y_END; ++spr_y)
+   {
+      for (int group = GROUP_BEGIN; group < GROUP_END; ++group)
+      {
+         const uint8_t * SOURCE = source_row + ((SOURCE_GROUP_FIRST + group) * TEXTURE_2BPP_GROUP_BYTES);
+         const uint8_t MASK = SOURCE[2];
+         if (0 == MASK) continue;
+
+         const uint8_t PLANE_0 = do_tint ? TINT_0 : SOURCE[0];
+         const uint8_t PLANE_1 = do_tint ? TINT_1 : SOURCE[1];
+         const int TARGET_GROUP = TARGET_GROUP_FIRST + group;
+         help_texture_2bpp_group_write(target_row, texture_target->groups_per_row, TARGET_GROUP, PLANE_0 >> SHIFT, PLANE_1 >> SHIFT, MASK >> SHIFT);
+         if (SHIFT)
+         {
+            const int SHIFT_NEXT = TEXTURE_2BPP_GROUP_TEXELS - SHIFT;
+            help_texture_2bpp_group_write(target_row, texture_target->groups_per_row, TARGET_GROUP + 1, (uint8_t)(PLANE_0 << SHIFT_NEXT), (uint8_t)(PLANE_1 << SHIFT_NEXT), (uint8_t)(MASK << SHIFT_NEXT));
+         }
+      }
+      source_row += SOURCE_ROW_BYTES;
+      target_row -= TARGET_ROW_BYTES;
+   }
+
+   return true;
+}
+
+bool help_texture_2bpp_resolve(const struct texture_2bpp_s * source, const color_rgba_t palette[PALETTE_SHADE_COUNT], struct texture_rgba_s * target)
+{
+   if (NULL == source || NULL == palette || NULL == target || source->width != target->width || source->height != target->height) return false;
+
+   // Four texels per lookup - Plane 1 nibble high, plane 0 nibble low
+   color_rgba_t lut[256][4];
+   for (int entry = 0; entry < 256; ++entry)
+   {
+      for (int i_texel = 0; i_texel < 4; ++i_texel)
+      {
+         const int BIT = 3 - i_texel;
+         lut[entry][i_texel] = palette[(((entry >> (4 + BIT)) & 1) << 1) | ((entry >> BIT) & 1)];
+      }
+   }
+
+   const int FULL_GROUPS = source->width / TEXTURE_2BPP_GROUP_TEXELS;
+   for (int row = 0; row < source->height; ++row)
+   {
+      const uint8_t * group = source->groups + (row * source->groups_per_row * TEXTURE_2BPP_GROUP_BYTES);
+      color_rgba_t * texel = target->texels + (row * target->width);
+      for (int i_group = 0; i_group < FULL_GROUPS; ++i_group, group += TEXTURE_2BPP_GROUP_BYTES, texel += TEXTURE_2BPP_GROUP_TEXELS)
+      {
+         memcpy(texel, lut[(group[1] & 0xF0) | (group[0] >> 4)], sizeof(lut[0]));
+         memcpy(texel + 4, lut[((group[1] & 0x0F) << 4) | (group[0] & 0x0F)], sizeof(lut[0]));
+      }
+
+      // Trailing texels of a width that is no multiple of 8
+      for (int x = FULL_GROUPS * TEXTURE_2BPP_GROUP_TEXELS; x < source->width; ++x)
+      {
+         const int BIT = 7 - (x % TEXTURE_2BPP_GROUP_TEXELS);
+         *texel++ = palette[(((group[1] >> BIT) & 1) << 1) | ((group[0] >> BIT) & 1)];
+      }
+   }
+
+   return true;
+}
+
+struct render_indexed_s * help_render_indexed_create(const struct texture_rgba_s * tex_virtual, const struct texture_rgba_s * tex_sprites)
+{
+   if (NULL == tex_virtual || NULL == tex_sprites) return NULL;
+
+   struct render_indexed_s * instance = malloc(sizeof(struct render_indexed_s));
+   if (NULL == instance) return NULL;
+
+   instance->tex_virtual = help_texture_2bpp_make(tex_virtual->width, tex_virtual->height, PALETTE_SHADE_LIGHTEST);
+   instance->tex_sprites = help_texture_2bpp_from_rgba(tex_sprites);
+   if (NULL == instance->tex_virtual || NULL == instance->tex_sprites)
+   {
+      return help_render_indexed_destroy(instance);
+   }
+   for (int i_shade = 0; i_shade < PALETTE_SHADE_COUNT; ++i_shade)
+   {
+      instance->palette[i_shade] = help_palette_shade_color((enum palette_shade_e)i_shade);
+   }
+
+   return instance;
+}
+
+void * help_render_indexed_destroy(struct render_indexed_s * instance)
+{
+   if (instance)
+   {
+      help_texture_2bpp_destroy(instance->tex_virtual);
+      help_texture_2bpp_destroy(instance->tex_sprites);
+      free(instance);
+   }
+
+   return NULL;
+}
+
+// Logic - Upscale
+typedef void (*upscale_row_fn)(const color_rgba_t * source, int count, int scale, color_rgba_t * target);
+
+void help_upscale_row_scalar(const color_rgba_t * source, int count, int scale, color_rgba_t * target)
+{
+   for (int i_texel = 0; i_texel < count; ++i_texel)
+   {
+      const color_rgba_t TEXEL = source[i_texel];
+      for (int i_copy = 0; i_copy < scale; ++i_copy)
+      {
+         *target++ = TEXEL;
+      }
+   }
+}
+
+#ifdef RENDER_TILE_KERNEL_X86
+void help_upscale_row_sse2(const color_rgba_t * source, int count, int scale, color_rgba_t * target)
+{
+   // Whole vectors per texel, the overshoot is overwritten by the next texel
+   const int STORES = (scale + 3) / 4;
+   const color_rgba_t * TARGET_END = target + (count * scale);
+   int i_texel = 0;
+   for (; i_texel < count && target + (STORES * 4) <= TARGET_END; ++i_texel, target += scale)
+   {
+      const __m128i TEXEL = _mm_set1_epi32((int)source[i_texel]);
+      for (int i_store = 0; i_store < STORES; ++i_store)
+      {
+         _mm_storeu_si128((__m128i *)(target + (i_store * 4)), TEXEL);
+      }
+   }
+
+   // Texels whose overshoot would leave the row
+   help_upscale_row_scalar(source + i_texel, count - i_texel, scale, target);
+}
+
+__attribute__((target("avx2")))
+void help_upscale_row_avx2(const color_rgba_t * source, int count, int scale, color_rgba_t * target)
+{
+   const int STORES = (scale + 7) / 8;
+   const color_rgba_t * TARGET_END = target + (count * scale);
+   int i_texel = 0;
+   for (; i_texel < count && target + (STORES * 8) <= TARGET_END; ++i_texel, target += scale)
+   {
+      const __m256i TEXEL = _mm256_set1_epi32((int)source[i_texel]);
+      for (int i_store = 0; i_store < STORES; ++i_store)
+      {
+         _mm256_storeu_si256((__m256i *)(target + (i_store * 8)), TEXEL);
+      }
+   }
+
+   help_upscale_row_scalar(source + i_texel, count - i_texel, scale, target);
+}
+#endif
+
+bool help_upscale_kernel_supported(enum upscale_kernel_e kernel)
+{
+   switch (kernel)
+   {
+      case UPSCALE_KERNEL_PER_PIXEL:
+      case UPSCALE_KERNEL_SCALAR:
+         return true;
+#ifdef RENDER_TILE_KERNEL_X86
+      case UPSCALE_KERNEL_SSE2:
+         return true;
+      case UPSCALE_KERNEL_AVX2:
+         __builtin_cpu_init();
+         return __builtin_cpu_supports("avx2");
+#endif
+      default:
+         return false;
+   }
+}
+
+enum upscale_kernel_e help_upscale_kernel_best(void)
+{
+   for (int kernel = UPSCALE_KERNEL_COUNT - 1; kernel > UPSCALE_KERNEL_SCALAR; --kernel)
+   {
+      if (help_upscale_kernel_supported((enum upscale_kernel_e)kernel))
+      {
+         return (enum upscale_kernel_e)kernel;
+      }
+   }
+
+   return UPSCALE_KERNEL_SCALAR;
+}
+
+const char * help_upscale_kernel_name(enum upscale_kernel_e kernel)
+{
+   switch (kernel)
+   {
+      case UPSCALE_KERNEL_PER_PIXEL:
+         return "per-pixel";
+      case UPSCALE_KERNEL_SCALAR:
+         return "scalar";
+      case UPSCALE_KERNEL_SSE2:
+         return "sse2";
+      case UPSCALE_KERNEL_AVX2:
+         return "avx2";
+      default:
+         return "unknown";
+   }
+}
+
+int help_upscale_scale_max(int target_width, int target_height, int source_width, int source_height)
+{
+   if (source_width <= 0 || source_height <= 0) return 0;
+
+   return help_minmax_min_2i(target_width / source_width, target_height / source_height);
+}
+
+void help_upscale_fill_span(color_rgba_t * target, int count, color_rgba_t color)
+{
+   for (int i_texel = 0; i_texel < count; ++i_texel)
+   {
+      target[i_texel] = color;
+   }
+}
+
+bool help_texture_rgba_upscale(const struct texture_rgba_s * source, void * target_pixels, int target_pitch, int target_width, int target_height, bool do_borders, color_rgba_t border_color, enum upscale_kernel_e kernel)
+{
+   if (NULL == source || NULL == target_pixels || false == help_upscale_kernel_supported(kernel)) return false;
+
+   const int SCALE = help_upscale_scale_max(target_width, target_height, source->width, source->height);
+   if (SCALE < 1) return false;
+
+   // Centered like the renderer path, storage rows are already top down
+   const int SCALED_WIDTH = source->width * SCALE;
+   const int SCALED_HEIGHT = source->height * SCALE;
+   const int OFFSET_X = (target_width - SCALED_WIDTH) / 2;
+   const int OFFSET_Y = (target_height - SCALED_HEIGHT) / 2;
+   uint8_t * target_bytes = target_pixels;
+
+   if (do_borders)
+   {
+      for (int row = 0; row < target_height; ++row)
+      {
+         color_rgba_t * target_row = (color_rgba_t *)(target_bytes + ((size_t)row * target_pitch));
+         if (row < OFFSET_Y || row >= OFFSET_Y + SCALED_HEIGHT)
+         {
+            help_upscale_fill_span(target_row, target_width, border_color);
+            continue;
+         }
+         help_upscale_fill_span(target_row, OFFSET_X, border_color);
+         help_upscale_fill_span(target_row + OFFSET_X + SCALED_WIDTH, target_width - OFFSET_X - SCALED_WIDTH, border_color);
+      }
+   }
+
+   if (UPSCALE_KERNEL_PER_PIXEL == kernel)
+   {
+      for (int row = 0; row < SCALED_HEIGHT; ++row)
+      {
+         color_rgba_t * target_row = (color_rgba_t *)(target_bytes + ((size_t)(OFFSET_Y + row) * target_pitch)) + OFFSET_X;
+         for (int x = 0; x < SCALED_WIDTH; ++x)
+         {
+            target_row[x] = source->texels[((row / SCALE) * source->width) + (x / SCALE)];
+         }
+      }
+      return true;
+   }
+
+   upscale_row_fn row_kernel = help_upscale_row_scalar;
+#ifdef RENDER_TILE_KERNEL_X86
+   if (UPSCALE_KERNEL_SSE2 == kernel)
+   {
+      row_kernel = help_upscale_row_sse2;
+   }
+   else if (UPSCALE_KERNEL_AVX2 == kernel)
+   {
+      row_kernel = help_upscale_row_avx2;
+   }
+#endif
+
+   // Widen each source row once, the remaining copies of it are plain row copies
+   const size_t ROW_BYTES = (size_t)SCALED_WIDTH * sizeof(color_rgba_t);
+   for (int source_row = 0; source_row < source->height; ++source_row)
+   {
+      uint8_t * target_first = target_bytes + ((size_t)(OFFSET_Y + (source_row * SCALE)) * target_pitch) + (OFFSET_X * sizeof(color_rgba_t));
+      row_kernel(source->texels + (source_row * source->width), source->width, SCALE, (color_rgba_t *)target_first);
+      for (int i_repeat = 1; i_repeat < SCALE; ++i_repeat)
+      {
+         memcpy(target_first + ((size_t)i_repeat * target_pitch), target_first, ROW_BYTES);
+      }
+   }
+
+   return true;
+}
+
+// Helpers - Engine
+struct texture_rgba_s * help_engine_get_tex_virtual(struct engine_s * engine)
+{
+   return engine ? engine->tex_virtual : NULL;
+}
+
+struct texture_rgba_s * help_engine_get_tex_sprites(struct engine_s * engine)
+{
+   return engine ? engine->tex_sprites : NULL;
+}
+
+struct sprite_map_s * help_engine_get_sprite_map(struct engine_s * engine)
+{
+   return engine ? engine->sprite_map : NULL;
+}
+
+// Helpers - Rendering (Simplified)
+typedef bool (*blit_fn)(struct sprite_s, int, int, struct texture_rgba_s *, struct texture_rgba_s *, bool, color_rgba_t);
+
+bool help_render_engine_sprite(struct engine_s * engine, int x, int y, enum sprite_map_tile_e tile_type)
+{
+   return help_render_engine_sprite_tinted(engine, x, y, tile_type, false, color_rgba_make_rgba(0, 0, 0, 0xFF));
+}
+
+// Helpers - Play field
+bool help_render_engine_sprite_at_tile(struct engine_s * engine, int tile_x, int tile_y, enum sprite_map_tile_e tile_type)
+{
+   return help_render_engine_sprite(engine, tile_x * PLAY_FIELD_TILE_SIZE, tile_y * PLAY_FIELD_TILE_SIZE, tile_type);
+}
+
+bool help_render_engine_sprite_tinted(struct engine_s * engine, int x, int y, enum sprite_map_tile_e tile_type, bool do_tint, color_rgba_t tint)
+{
+   if (NULL == engine) return false;
+
+   // Recording frame - Keep the draw for the execution pass
+   if (engine->commands && engine->commands->is_recording)
+   {
+      const struct sprite_s SPRITE = help_sprite_map_sprite_for(help_engine_get_sprite_map(engine), tile_type);
+      return help_render_commands_push(engine->commands, RENDER_COMMAND_SPRITE, tile_type, x, y, SPRITE.texture_size.x, SPRITE.texture_size.y, do_tint, tint);
+   }
+
+   // Indexed frame - Tints are just another index
+   if (engine->indexed)
+   {
+      return help_tex_2bpp_sprite_render(
+         help_sprite_map_sprite_for(help_engine_get_sprite_map(engine), tile_type),
+         x,
+         y,
+         engine->indexed->tex_sprites,
+         engine->indexed->tex_virtual,
+         do_tint,
+         do_tint ? help_palette_shade_nearest(tint) : PALETTE_SHADE_DARKEST
+      );
+   }
+
+   // Tinted sprites as plain blits from the baked copy, the per texel reference keeps tinting itself
+   const struct tint_cache_entry_s * TINTED = (do_tint && RENDER_BLITTER_PER_TEXEL != engine->blitter) ? help_tint_cache_entry_for(engine->tint_cache, engine->sprite_map, tile_type, tint) : NULL;
+   if (TINTED)
+   {
+      if (RENDER_BLITTER_TILE_KERNEL == engine->blitter && TINTED->row_masks_valid && help_tex_tile_render_rows(TINTED->sprite, TINTED->row_masks, engine->tint_cache->texture, x, y, help_engine_get_tex_virtual(engine), false, 0))
+      {
+         return true;
+      }
+      return help_tex_sprite_render_tinted(TINTED->sprite, x, y, engine->tint_cache->texture, help_engine_get_tex_virtual(engine), false, 0);
+   }
+
+   // Unclipped 8x8 tiles through the vector kernel
+   if (RENDER_BLITTER_TILE_KERNEL == engine->blitter && help_tex_tile_render_masked(help_engine_get_sprite_map(engine), tile_type, x, y, help_engine_get_tex_virtual(engine), do_tint, tint))
+   {
+      return true;
+   }
+
+   const blit_fn BLIT = (RENDER_BLITTER_PER_TEXEL == engine->blitter) ? help_tex_sprite_render_tinted_per_texel : help_tex_sprite_render_tinted;
+   return BLIT(
+      help_sprite_map_sprite_for(help_engine_get_sprite_map(engine), tile_type),
+      x,
+      y,
+      help_engine_get_tex_sprites(engine),
+      help_engine_get_tex_virtual(engine),
+      do_tint,
+      tint
+   );
+}
+
+bool help_render_engine_fill(struct engine_s * engine, int min_x, int min_y, int width, int height, color_rgba_t color)
+{
+   if (NULL == engine) return false;
+
+   if (engine->commands && engine->commands->is_recording)
+   {
+      return help_render_commands_push(engine->commands, RENDER_COMMAND_FILL, SPRITE_MAP_TILE_NA, min_x, min_y, width, height, false, color);
+   }
+
+   if (engine->indexed)
+   {
+      help_texture_2bpp_fill(engine->indexed->tex_virtual, min_x, min_y, width, height, help_palette_shade_nearest(color));
+      return true;
+   }
+
+   help_texture_rgba_plot_aabb(help_engine_get_tex_virtual(engine), min_x, min_y, width, height, color);
+   return true;
+}
+
+bool help_render_engine_aabb_outline(struct engine_s * engine, int min_x, int min_y, int width, int height, color_rgba_t color)
+{
+   // Same edges as help_texture_rgba_plot_aabb_outline
+   return (
+      help_render_engine_fill(engine, min_x, min_y, width, 1, color) &&
+      help_render_engine_fill(engine, min_x, min_y + height - 1, width, 1, color) &&
+      help_render_engine_fill(engine, min_x, min_y, 1, height, color) &&
+      help_render_engine_fill(engine, min_x + height - 1, min_y, 1, height, color)
+   );
+}
+
+enum sprite_map_tile_e help_tetro_type_to_sprite_tile(enum tetro_type_e tetro_type)
+{
+   switch(tetro_type)
+   {
+      case TETRO_TYPE_I:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_I;
+         break;
+      case TETRO_TYPE_O:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_O;
+         break;
+      case TETRO_TYPE_L:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_L;
+         break;
+      case TETRO_TYPE_Lr:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_Lr;
+         break;
+      case TETRO_TYPE_S:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_S;
+         break;
+      case TETRO_TYPE_Z:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_Z;
+         break;
+      case TETRO_TYPE_T:
+         return SPRITE_MAP_TILE_TETRO_BLOCK_T;
+         break;
+      default:
+         return SPRITE_MAP_TILE_NA;
+         break;
+   }
+}
+
+void help_play_field_render_to_texture(const struct play_field_s * play_field, struct engine_s * engine)
+{
+   if (NULL == play_field || NULL == engine) return;
+
+   // Render with play field offset
+   for (int y = 0; y < PLAY_FIELD_HEIGHT; ++y)
+   {
+      for (int x = 0; x < PLAY_FIELD_WIDTH; ++x)
+      {
+         /*
+         // Render background
+         help_texture_rgba_plot_aabb(
+            help_engine_get_tex_virtual(engine),
+            PLAY_FIELD_OFFSET_HORI_PIXELS + (x * PLAY_FIELD_TILE_SIZE),
+            y * PLAY_FIELD_TILE_SIZE,
+            PLAY_FIELD_TILE_SIZE,
+            PLAY_FIELD_TILE_SIZE,
+            color_rgba_make_rgba(0, 50, 0, 0xFF)
+         );
+         */
+
+         // Render placed cell by type
+         if (false == help_play_field_cell_occupied(play_field, x, y))
+         {
+            // Don't render non-occupied cells
+            continue;
+         }
+
+         // Cell occupied
+         help_render_engine_sprite(
+            engine,
+            PLAY_FIELD_OFFSET_HORI_PIXELS + (x * PLAY_FIELD_TILE_SIZE),
+            y * PLAY_FIELD_TILE_SIZE,
+            help_tetro_type_to_sprite_tile(help_play_field_cell_type(play_field, x, y))
+         );
+      }
+   }
+}
+
+// Helpers - Rendering stuff
+void help_tetro_render_to_texture_at_tile_without_position(const struct tetro_world_s * tetro, struct engine_s * engine, int tile_x, int tile_y)
+{
+   if (NULL == tetro || NULL == engine) return;
+
+   const int TETRO_SIZE = help_tetro_size(tetro->type);
+   const tetro_mask DESIGN = help_tetro_world_mask(tetro, TETRO_MASK_DESIGN);
+   const tetro_mask LEFT = help_tetro_world_mask(tetro, TETRO_MASK_LEFT);
+   const tetro_mask RIGHT = help_tetro_world_mask(tetro, TETRO_MASK_RIGHT);
+
+   // Render tetro at tile position
+   for (int ty = 0; ty < TETRO_SIZE; ++ty)
+   {
+      for (int tx = 0; tx < TETRO_SIZE; ++tx)
+      {
+         // Design cells
+         const bool IS_DESIGN_CELL = help_tetro_mask_cell(DESIGN, tx, ty);
+         if (IS_DESIGN_CELL)
+         {
+            help_render_engine_sprite(
+               engine,
+               (tile_x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
+               (tile_y* PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
+               help_tetro_type_to_sprite_tile(tetro->type)
+            );
+         }
+
+         // Tetro debug rendering configured ?
+         if (false == CONFIG_DO_RENDER_TETRO_COLLISION_MASKS)
+         {
+            continue;
+         }
+
+         // CCW collision mask
+         const bool IS_CCW_COLLISION_CELL = help_tetro_mask_cell(LEFT, tx, ty);
+         if (IS_CCW_COLLISION_CELL)
+         {
+            // Render CCW cells a full-sized tile
+            help_render_engine_aabb_outline(
+               engine,
+               (tile_x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
+               (tile_y* PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
+               PLAY_FIELD_TILE_SIZE,
+               PLAY_FIELD_TILE_SIZE,
+               color_rgba_make_rgba(150, 0, 0, 255)
+            );
+         }
+
+         // CW collision mask
+         const bool IS_CW_COLLISION_CELL = help_tetro_mask_cell(RIGHT, tx, ty);
+         if (IS_CW_COLLISION_CELL)
+         {
+            // Render CW cells a less than tile-size tile
+            const int INSET = 2;
+            help_render_engine_aabb_outline(
+               engine,
+               (tile_x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE) + INSET,
+               (tile_y* PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE) + INSET,
+               PLAY_FIELD_TILE_SIZE - (2 * INSET),
+               PLAY_FIELD_TILE_SIZE - (2 * INSET),
+               color_rgba_make_rgba(0, 150, 0, 255)
+            );
+         }
+      }
+   }
+}
+
+void help_tetro_render_to_texture(const struct tetro_world_s * tetro, struct engine_s * engine)
+{
+   if (NULL == tetro || NULL == engine) return;
+
+   const int TETRO_SIZE = help_tetro_size(tetro->type);
+   const tetro_mask DESIGN = help_tetro_world_mask(tetro, TETRO_MASK_DESIGN);
+   const tetro_mask LEFT = help_tetro_world_mask(tetro, TETRO_MASK_LEFT);
+   const tetro_mask RIGHT = help_tetro_world_mask(tetro, TETRO_MASK_RIGHT);
+
+   // Render tetro at position with play field offset
+   for (int ty = 0; ty < TETRO_SIZE; ++ty)
+   {
+      for (int tx = 0; tx < TETRO_SIZE; ++tx)
+      {
+         // Design cells
+         const bool IS_DESIGN_CELL = help_tetro_mask_cell(DESIGN, tx, ty);
+         if (IS_DESIGN_CELL)
+         {
+            help_render_engine_sprite(
+               engine,
+               PLAY_FIELD_OFFSET_HORI_PIXELS + (tetro->tile_pos.x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
+               (tetro->tile_pos.y * PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
+               help_tetro_type_to_sprite_tile(tetro->type)
+            );
+         }
+
+         // Tetro debug rendering configured ?
+         if (false == CONFIG_DO_RENDER_TETRO_COLLISION_MASKS)
+         {
+            continue;
+         }
+
+         // CCW collision mask
+         const bool IS_CCW_COLLISION_CELL = help_tetro_mask_cell(LEFT, tx, ty);
+         if (IS_CCW_COLLISION_CELL)
+         {
+            // Render CCW cells a full-sized tile
+            help_render_engine_aabb_outline(
+               engine,
+               PLAY_FIELD_OFFSET_HORI_PIXELS + (tetro->tile_pos.x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE),
+               (tetro->tile_pos.y * PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE),
+               PLAY_FIELD_TILE_SIZE,
+               PLAY_FIELD_TILE_SIZE,
+               color_rgba_make_rgba(150, 0, 0, 255)
+            );
+         }
+
+         // CW collision mask
+         const bool IS_CW_COLLISION_CELL = help_tetro_mask_cell(RIGHT, tx, ty);
+         if (IS_CW_COLLISION_CELL)
+         {
+            // Render CW cells a less than tile-size tile
+            const int INSET = 2;
+            help_render_engine_aabb_outline(
+               engine,
+               PLAY_FIELD_OFFSET_HORI_PIXELS + (tetro->tile_pos.x * PLAY_FIELD_TILE_SIZE) + (tx * PLAY_FIELD_TILE_SIZE) + INSET,
+               (tetro->tile_pos.y * PLAY_FIELD_TILE_SIZE) + (ty * PLAY_FIELD_TILE_SIZE) + INSET,
+               PLAY_FIELD_TILE_SIZE - (2 * INSET),
+               PLAY_FIELD_TILE_SIZE - (2 * INSET),
+               color_rgba_make_rgba(0, 150, 0, 255)
+            );
+         }
+      }
+   }
+}
+
+// Helpers - Font rendering
+struct font_render_glyph_s font_render_glyph_make_mapped(enum sprite_map_tile_e sprite_tile)
+{
+   struct font_render_glyph_s glyph;
+
+   glyph.is_mapped = true;
+   glyph.sprite_tile = sprite_tile;
+
+   return glyph;
+}
+
+bool font_render_make(struct font_render_s * instance)
+{
+   if (NULL == instance) return false;
+
+   // Start with all glyphs as non-mapped
+   for (int ascii_code = 0; ascii_code < FONT_RENDER_MAX_GLYPHS; ++ascii_code)
+   {
+      struct font_render_glyph_s * new_glyph = instance->glyphs + ascii_code;
+
+      // Un-mapped glyphs are un-usable, so the type does not matter
+      new_glyph->is_mapped = false;
+   }
+
+   return true;
+}
+
+bool help_font_render_ascii_code_in_valid(int ascii_code)
+{
+   return (ascii_code < 0 || ascii_code >= FONT_RENDER_MAX_GLYPHS) ? true : false;
+}
+
+bool help_font_render_map_ascii_to_sprite(struct font_render_s * instance, char character, enum sprite_map_tile_e sprite_tile)
+{
+   const int ASCII_CODE = (int)character;
+   if (NULL == instance || help_font_render_ascii_code_in_valid(ASCII_CODE)) return false;
+
+   instance->glyphs[ASCII_CODE] = font_render_glyph_make_mapped(sprite_tile);
+
+   return true;
+}
+
+bool help_font_render_char_mapped(struct font_render_s * instance, char character)
+{
+   return instance && instance->glyphs[(int)character].is_mapped;
+}
+
+bool help_font_render_map_glyphs(struct font_render_s * instance)
+{
+   if (NULL == instance) return false;
+
+   // Map ascii codes to renderable sprites
+   help_font_render_map_ascii_to_sprite(instance, 'A', SPRITE_MAP_TILE_FONT_GLYPH_A);
+   help_font_render_map_ascii_to_sprite(instance, 'B', SPRITE_MAP_TILE_FONT_GLYPH_B);
+   help_font_render_map_ascii_to_sprite(instance, 'C', SPRITE_MAP_TILE_FONT_GLYPH_C);
+   help_font_render_map_ascii_to_sprite(instance, 'D', SPRITE_MAP_TILE_FONT_GLYPH_D);
+   help_font_render_map_ascii_to_sprite(instance, 'E', SPRITE_MAP_TILE_FONT_GLYPH_E);
+   help_font_render_map_ascii_to_sprite(instance, 'F', SPRITE_MAP_TILE_FONT_GLYPH_F);
+   help_font_render_map_ascii_to_sprite(instance, 'G', SPRITE_MAP_TILE_FONT_GLYPH_G);
+   help_font_render_map_ascii_to_sprite(instance, 'H', SPRITE_MAP_TILE_FONT_GLYPH_H);
+   help_font_render_map_ascii_to_sprite(instance, 'I', SPRITE_MAP_TILE_FONT_GLYPH_I);
+   help_font_render_map_ascii_to_sprite(instance, 'J', SPRITE_MAP_TILE_FONT_GLYPH_J);
+   help_font_render_map_ascii_to_sprite(instance, 'K', SPRITE_MAP_TILE_FONT_GLYPH_K);
+   help_font_render_map_ascii_to_sprite(instance, 'L', SPRITE_MAP_TILE_FONT_GLYPH_L);
+   help_font_render_map_ascii_to_sprite(instance, 'M', SPRITE_MAP_TILE_FONT_GLYPH_M);
+   help_font_render_map_ascii_to_sprite(instance, 'N', SPRITE_MAP_TILE_FONT_GLYPH_N);
+   help_font_render_map_ascii_to_sprite(instance, 'O', SPRITE_MAP_TILE_FONT_GLYPH_O);
+   help_font_render_map_ascii_to_sprite(instance, 'P', SPRITE_MAP_TILE_FONT_GLYPH_P);
+   help_font_render_map_ascii_to_sprite(instance, 'Q', SPRITE_MAP_TILE_FONT_GLYPH_Q);
+   help_font_render_map_ascii_to_sprite(instance, 'R', SPRITE_MAP_TILE_FONT_GLYPH_R);
+   help_font_render_map_ascii_to_sprite(instance, 'S', SPRITE_MAP_TILE_FONT_GLYPH_S);
+   help_font_render_map_ascii_to_sprite(instance, 'T', SPRITE_MAP_TILE_FONT_GLYPH_T);
+   help_font_render_map_ascii_to_sprite(instance, 'U', SPRITE_MAP_TILE_FONT_GLYPH_U);
+   help_font_render_map_ascii_to_sprite(instance, 'V', SPRITE_MAP_TILE_FONT_GLYPH_V);
+   help_font_render_map_ascii_to_sprite(instance, 'W', SPRITE_MAP_TILE_FONT_GLYPH_W);
+   help_font_render_map_ascii_to_sprite(instance, 'X', SPRITE_MAP_TILE_FONT_GLYPH_X);
+   help_font_render_map_ascii_to_sprite(instance, 'Y', SPRITE_MAP_TILE_FONT_GLYPH_Y);
+   help_font_render_map_ascii_to_sprite(instance, 'Z', SPRITE_MAP_TILE_FONT_GLYPH_Z);
+   help_font_render_map_ascii_to_sprite(instance, '0', SPRITE_MAP_TILE_FONT_GLYPH_0);
+   help_font_render_map_ascii_to_sprite(instance, '1', SPRITE_MAP_TILE_FONT_GLYPH_1);
+   help_font_render_map_ascii_to_sprite(instance, '2', SPRITE_MAP_TILE_FONT_GLYPH_2);
+   help_font_render_map_ascii_to_sprite(instance, '3', SPRITE_MAP_TILE_FONT_GLYPH_3);
+   help_font_render_map_ascii_to_sprite(instance, '4', SPRITE_MAP_TILE_FONT_GLYPH_4);
+   help_font_render_map_ascii_to_sprite(instance, '5', SPRITE_MAP_TILE_FONT_GLYPH_5);
+   help_font_render_map_ascii_to_sprite(instance, '6', SPRITE_MAP_TILE_FONT_GLYPH_6);
+   help_font_render_map_ascii_to_sprite(instance, '7', SPRITE_MAP_TILE_FONT_GLYPH_7);
+   help_font_render_map_ascii_to_sprite(instance, '8', SPRITE_MAP_TILE_FONT_GLYPH_8);
+   help_font_render_map_ascii_to_sprite(instance, '9', SPRITE_MAP_TILE_FONT_GLYPH_9);
+   help_font_render_map_ascii_to_sprite(instance, '.', SPRITE_MAP_TILE_FONT_GLYPH_PERIOD);
+   help_font_render_map_ascii_to_sprite(instance, '-', SPRITE_MAP_TILE_FONT_GLYPH_HYPHEN);
+   help_font_render_map_ascii_to_sprite(instance, ',', SPRITE_MAP_TILE_FONT_GLYPH_COMMA);
+   help_font_render_map_ascii_to_sprite(instance, '(', SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_OPEN);
+   help_font_render_map_ascii_to_sprite(instance, ')', SPRITE_MAP_TILE_FONT_GLYPH_PARENTHESES_CLOSED);
+   help_font_render_map_ascii_to_sprite(instance, '|', SPRITE_MAP_TILE_FONT_GLYPH_PIPE);
+   help_font_render_map_ascii_to_sprite(instance, '+', SPRITE_MAP_TILE_FONT_GLYPH_PLUS);
+   help_font_render_map_ascii_to_sprite(instance, ':', SPRITE_MAP_TILE_FONT_GLYPH_COLON);
+
+   return true;
+}
+
+// Additional engine based rendering
+bool help_engine_render_tinted_text_at_tile_internal(struct engine_s * engine, const char * text, int tile_x, int tile_y, bool do_tint, color_rgba_t tint)
+{
+   if (NULL == engine || NULL == text) return false;
+
+   // Run sized chunks, each laid out before, cached now or laid out uncached
+   struct text_run_s run;
+   struct vec_2i_s tile_cursor = vec_2i_make_xy(tile_x, tile_y);
+   while (*text)
+   {
+      const int LENGTH = (int)strnlen(text, TEXT_RUN_CAPACITY);
+      const struct text_run_s * RUN = help_text_cache_lookup(engine->text_cache, engine->font_render, text, LENGTH, tile_x, &tile_cursor);
+      if (NULL == RUN)
+      {
+         run.count = 0;
+         help_text_run_append(&run, engine->font_render, text, LENGTH, tile_x, &tile_cursor);
+         RUN = &run;
+      }
+      help_engine_render_text_run(engine, RUN, do_tint, tint);
+      text += LENGTH;
+   }
+
+   // Success
+   return true;
+}
+
+bool help_engine_render_text_at_tile(struct engine_s * engine, const char * text, int tile_x, int tile_y)
+{
+   return help_engine_render_tinted_text_at_tile_internal(engine, text, tile_x, tile_y, false, color_rgba_make_rgba(0xFF, 0, 0xFF, 0xFF));
+}
+
+bool help_engine_render_tinted_text_at_tile(struct engine_s * engine, const char * text, int tile_x, int tile_y, color_rgba_t tint)
+{
+   return help_engine_render_tinted_text_at_tile_internal(engine, text, tile_x, tile_y, true, tint);
+}
+
+bool help_engine_render_number_at_tile(struct engine_s * engine, int number, int width, int tile_x, int tile_y)
+{
+   if (NULL == engine) return false;
+
+   const struct text_run_s * RUN = help_text_cache_lookup_number(engine->text_cache, engine->font_render, number, width, tile_x, tile_y);
+   if (RUN)
+   {
+      return help_engine_render_text_run(engine, RUN, false, color_rgba_make_rgba(0xFF, 0, 0xFF, 0xFF));
+   }
+
+   struct text_run_s run;
+   help_text_run_layout_number(&run, engine->font_render, number, width, tile_x, tile_y);
+   return help_engine_render_text_run(engine, &run, false, color_rgba_make_rgba(0xFF, 0, 0xFF, 0xFF));
+}
+
+// Logic - Text layout
+struct text_cache_s * help_text_cache_create(void)
+{
+   struct text_cache_s * instance = malloc(sizeof(struct text_cache_s));
+   if (NULL == instance) return NULL;
+
+   memset(instance->entries, 0, sizeof(instance->entries));
+   memset(instance->next_evicted, 0, sizeof(instance->next_evicted));
+   instance->hits = 0;
+   instance->layouts = 0;
+
+   return instance;
+}
+
+void * help_text_cache_destroy(struct text_cache_s * instance)
+{
+   free(instance);
+
+   return NULL;
+}
+
+void help_text_run_push_glyph(struct text_run_s * run, const struct font_render_s * font_render, char character, int tile_x, int tile_y)
+{
+   struct text_glyph_s * glyph = run->glyphs + run->count++;
+   glyph->x = (int16_t)(tile_x * PLAY_FIELD_TILE_SIZE);
+   glyph->y = (int16_t)(tile_y * PLAY_FIELD_TILE_SIZE);
+   glyph->is_placeholder = false == font_render->glyphs[(unsigned char)character].is_mapped;
+   if (glyph->is_placeholder)
+   {
+      // Not supported - Reported once per layout, drawn as the debug thing
+      printf("\nCannot render un-supported ascii glyph '%d'", (int)character);
+      glyph->sprite_tile = SPRITE_MAP_TILE_NA;
+   }
+   else
+   {
+      glyph->sprite_tile = (uint16_t)font_render->glyphs[(unsigned char)character].sprite_tile;
+   }
+}
+
+void help_text_run_append(struct text_run_s * run, const struct font_render_s * font_render, const char * text, int length, int origin_x, struct vec_2i_s * cursor)
+{
+   for (int i_char = 0; i_char < length; ++i_char)
+   {
+      const char TEXT_CHAR_UPPERCASED = toupper((unsigned char)text[i_char]);
+
+      if ('\n' == TEXT_CHAR_UPPERCASED)
+      {
+         // Newline
+         cursor->x = origin_x;
+         cursor->y -= 1;
+      }
+      else if ('\t' == TEXT_CHAR_UPPERCASED)
+      {
+         // Horizontal tab
+         const int SPACES_PER_TAB = 1;
+         cursor->x += SPACES_PER_TAB;
+      }
+      else if (' ' == TEXT_CHAR_UPPERCASED)
+      {
+         // Space
+         cursor->x += 1;
+      }
+      else
+      {
+         // Font character or its placeholder
+         help_text_run_push_glyph(run, font_render, TEXT_CHAR_UPPERCASED, cursor->x, cursor->y);
+         cursor->x += 1;
+      }
+   }
+}
+
+void help_text_run_layout_number(struct text_run_s * run, const struct font_render_s * font_render, int number, int width, int tile_x, int tile_y)
+{
+   // Digits from the least significant up, no format string involved
+   char digits[12];
+   int digit_count = 0;
+   unsigned int magnitude = (number < 0) ? 0u - (unsigned int)number : (unsigned int)number;
+   do
+   {
+      digits[digit_count++] = (char)('0' + magnitude % 10);
+      magnitude /= 10;
+   } while (magnitude);
+   if (number < 0)
+   {
+      digits[digit_count++] = '-';
+   }
+
+   // Padding is blank, only the digits become glyphs
+   const int FIRST_X = tile_x + help_minmax_max_2i(0, width - digit_count);
+   run->count = 0;
+   for (int i_digit = 0; i_digit < digit_count; ++i_digit)
+   {
+      help_text_run_push_glyph(run, font_render, digits[digit_count - 1 - i_digit], FIRST_X + i_digit, tile_y);
+   }
+}
+
+uint32_t help_text_cache_hash_u32(uint32_t hash, uint32_t value)
+{
+   for (int i_byte = 0; i_byte < 4; ++i_byte)
+   {
+      hash ^= (value >> (i_byte * 8)) & 0xFF;
+      hash *= 0x01000193u;
+   }
+
+   return hash;
+}
+
+uint32_t help_text_cache_key_hash(bool is_number, int tile_x, int tile_y, int extra)
+{
+   // FNV-1a, the text hash continues from here
+   uint32_t hash = 0x811C9DC5u;
+   hash = help_text_cache_hash_u32(hash, is_number);
+   hash = help_text_cache_hash_u32(hash, (uint32_t)tile_x);
+   hash = help_text_cache_hash_u32(hash, (uint32_t)tile_y);
+   return help_text_cache_hash_u32(hash, (uint32_t)extra);
+}
+
+struct text_cache_entry_s * help_text_cache_entry_take(struct text_cache_s * instance, uint32_t key_hash)
+{
+   // Free way of the set first, then the oldest laid out
+   const int SET = (int)(key_hash % TEXT_CACHE_SETS);
+   struct text_cache_entry_s * ways = instance->entries + SET * TEXT_CACHE_WAYS;
+   for (int i_way = 0; i_way < TEXT_CACHE_WAYS; ++i_way)
+   {
+      if (false == ways[i_way].is_used) return ways + i_way;
+   }
+   struct text_cache_entry_s * entry = ways + instance->next_evicted[SET];
+   instance->next_evicted[SET] = (instance->next_evicted[SET] + 1) % TEXT_CACHE_WAYS;
+   return entry;
+}
+
+const struct text_run_s * help_text_cache_lookup(struct text_cache_s * instance, const struct font_render_s * font_render, const char * text, int length, int origin_x, struct vec_2i_s * cursor)
+{
+   if (NULL == instance || NULL == text || NULL == cursor || length < 0 || length > TEXT_RUN_CAPACITY) return NULL;
+
+   uint32_t hash = help_text_cache_key_hash(false, cursor->x, cursor->y, origin_x);
+   for (int i_char = 0; i_char < length; ++i_char)
+   {
+      hash = (hash ^ (uint8_t)text[i_char]) * 0x01000193u;
+   }
+
+   // Only the ways of one set, contents compared on a hash match
+   struct text_cache_entry_s * ways = instance->entries + (hash % TEXT_CACHE_SETS) * TEXT_CACHE_WAYS;
+   for (int i_way = 0; i_way < TEXT_CACHE_WAYS; ++i_way)
+   {
+      const struct text_cache_entry_s * WAY = ways + i_way;
+      const bool KEY_MATCHES = (
+         WAY->is_used && WAY->key_hash == hash && false == WAY->is_number &&
+         WAY->tile_x == cursor->x && WAY->tile_y == cursor->y && WAY->origin_x == origin_x &&
+         WAY->length == length && memcmp(WAY->text, text, (size_t)length) == 0
+      );
+      if (KEY_MATCHES)
+      {
+         instance->hits += 1;
+         *cursor = WAY->cursor_end;
+         return &WAY->run;
+      }
+   }
+
+   // New or changed chunk
+   struct text_cache_entry_s * entry = help_text_cache_entry_take(instance, hash);
+   entry->is_used = true;
+   entry->key_hash = hash;
+   entry->tile_x = cursor->x;
+   entry->tile_y = cursor->y;
+   entry->origin_x = origin_x;
+   entry->is_number = false;
+   entry->length = length;
+   memcpy(entry->text, text, (size_t)length);
+   entry->run.count = 0;
+   help_text_run_append(&entry->run, font_render, text, length, origin_x, cursor);
+   entry->cursor_end = *cursor;
+   instance->layouts += 1;
+
+   return &entry->run;
+}
+
+const struct text_run_s * help_text_cache_lookup_number(struct text_cache_s * instance, const struct font_render_s * font_render, int number, int width, int tile_x, int tile_y)
+{
+   if (NULL == instance) return NULL;
+
+   // One entry per number slot, laid out again when the value changes
+   const uint32_t HASH = help_text_cache_key_hash(true, tile_x, tile_y, width);
+   struct text_cache_entry_s * ways = instance->entries + (HASH % TEXT_CACHE_SETS) * TEXT_CACHE_WAYS;
+   struct text_cache_entry_s * entry = NULL;
+   for (int i_way = 0; NULL == entry && i_way < TEXT_CACHE_WAYS; ++i_way)
+   {
+      struct text_cache_entry_s * candidate = ways + i_way;
+      if (candidate->is_used && candidate->is_number && candidate->tile_x == tile_x && candidate->tile_y == tile_y && candidate->number_width == width)
+      {
+         entry = candidate;
+      }
+   }
+   if (entry && entry->number == number)
+   {
+      instance->hits += 1;
+      return &entry->run;
+   }
+
+   if (NULL == entry)
+   {
+      entry = help_text_cache_entry_take(instance, HASH);
+      entry->is_used = true;
+      entry->key_hash = HASH;
+      entry->tile_x = tile_x;
+      entry->tile_y = tile_y;
+      entry->is_number = true;
+      entry->number_width = width;
+   }
+   entry->number = number;
+   help_text_run_layout_number(&entry->run, font_render, number, width, tile_x, tile_y);
+   instance->layouts += 1;
+
+   return &entry->run;
+}
+
+bool help_engine_render_text_run(struct engine_s * engine, const struct text_run_s * run, bool do_tint, color_rgba_t tint)
+{
+   if (NULL == engine || NULL == run) return false;
+
+   for (int i_glyph = 0; i_glyph < run->count; ++i_glyph)
+   {
+      const struct text_glyph_s * GLYPH = run->glyphs + i_glyph;
+      if (GLYPH->is_placeholder)
+      {
+         help_render_engine_sprite(engine, GLYPH->x, GLYPH->y, GLYPH->sprite_tile);
+      }
+      else
+      {
+         help_render_engine_sprite_tinted(engine, GLYPH->x, GLYPH->y, GLYPH->sprite_tile, do_tint, tint);
+      }
+   }
+
+   // Success
+   return true;
+}
+
+// Logic - Frame composition
+bool help_engine_compose_layer(struct engine_s * engine, enum render_layer_e layer)
+{
+   if (NULL == engine) return false;
+
+   // Game Boy palette
+   const color_rgba_t COL_PAL_LIGHTEST = help_palette_shade_color(PALETTE_SHADE_LIGHTEST);
+   const color_rgba_t COL_PAL_LIGHT = help_palette_shade_color(PALETTE_SHADE_LIGHT);
+   const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(engine->tex_virtual);
+
+   // ----> Clear offline texture
+   help_render_engine_fill(engine, 0, 0, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y, COL_PAL_LIGHTEST);
+   // >> Static parts of the active screen
+   if (RENDER_LAYER_SPLASH == layer)
+   {
+      const char * const SPLASH_TEXT = "Just another\nunfinished TETRIS\nclone made for the\nlove of coding."
+                                       "\n\nThis, is a work\nof fiction and\nnon-commercial."
+                                       "\n\n\nWait or hit start."
+                                       "\n\n\n\nSven Garson - 2025";
+      help_engine_render_text_at_tile(engine, SPLASH_TEXT, 1, PLAY_FIELD_HEIGHT - 2);
+   }
+   if (RENDER_LAYER_TITLE == layer)
+   { 
+      // Background art
+      help_render_engine_sprite_at_tile(engine, 0, 0, SPRITE_MAP_TILE_BG_TITLE_SCREEN);
+
+      // Player select
+      const char * STR_PLAYER_1 = "1PLAYER";
+      help_engine_render_text_at_tile(engine, STR_PLAYER_1, 2, 3);
+      help_engine_render_tinted_text_at_tile(engine, "2PLAYER", 2 + 1 + strlen(STR_PLAYER_1) + 2, 3, COL_PAL_LIGHT);
+      help_render_engine_sprite_at_tile(engine, 1, 3, SPRITE_MAP_TILE_FONT_ARROW_RIGHT);
+      help_engine_render_text_at_tile(engine, "SELECT TO QUIT", 3, 1);
+   }
+   if (RENDER_LAYER_CONFIG == layer)
+   {
+      // Background art
+      help_render_engine_sprite_at_tile(engine, 0, 0, SPRITE_MAP_TILE_BG_CONFIG_SCREEN);
+
+      // Game type
+      help_engine_render_text_at_tile(engine, "GAME TYPE", 5, PLAY_FIELD_HEIGHT - 4);
+      help_engine_render_text_at_tile(engine, "A-TYPE", 3, PLAY_FIELD_HEIGHT - 6);
+      help_engine_render_tinted_text_at_tile(engine, "B-TYPE", 11, PLAY_FIELD_HEIGHT - 6, COL_PAL_LIGHT);
+
+      // Music type label, the choices follow the cursor
+      help_engine_render_text_at_tile(engine, "MUSIC TYPE", 5, 7);
+   }
+   if (RENDER_LAYER_PLAY == layer)
+   {
+      // >> Background art
+      help_render_engine_sprite_at_tile(engine, 0, 0, SPRITE_MAP_TILE_BG_PLAY_SCREEN);
+
+      // >> Gameplay stat labels
+      help_engine_render_text_at_tile(engine, STR_LABEL_SCORE, 14, PLAY_FIELD_HEIGHT - 2);
+      help_engine_render_text_at_tile(engine, STR_LABEL_LEVEL, 14, PLAY_FIELD_HEIGHT - 7);
+      help_engine_render_text_at_tile(engine, STR_LABEL_LINES, 14, PLAY_FIELD_HEIGHT - 10);
+   }
+   if (RENDER_LAYER_INPUT_MAPPING == layer)
+   {
+      // Background art
+      help_render_engine_sprite_at_tile(engine, 0, 0, SPRITE_MAP_TILE_BG_INPUT_MAPPING_SCREEN);
+
+      // Table header and footer, the key rows follow the confirmations
+      help_engine_render_text_at_tile(engine, " GAME BOY    KEYBRD ", 0, PLAY_FIELD_HEIGHT - 1);
+      help_engine_render_text_at_tile(engine, "   HIT ALL KEYBRD   ", 0, PLAY_FIELD_HEIGHT - 13 - 2);
+      help_engine_render_text_at_tile(engine, "  KEYS TO CONTINUE  ", 0, PLAY_FIELD_HEIGHT - 13 - 4);
+   }
+
+   // Success
+   return true;
+}
+
+bool help_render_engine_layer(struct engine_s * engine, enum render_layer_e layer)
+{
+   if (NULL == engine) return false;
+
+   // Without a cache the layer is drawn like any other content, indexed layers are cheap enough
+   struct layer_cache_s * layer_cache = engine->layer_cache;
+   if (NULL == layer_cache || engine->indexed)
+   {
+      return help_engine_compose_layer(engine, layer);
+   }
+
+   // Rebuild into the cache texture when the screen changed
+   if (false == layer_cache->is_valid || layer_cache->layer != layer)
+   {
+      struct texture_rgba_s * tex_virtual = engine->tex_virtual;
+      struct render_commands_s * commands = engine->commands;
+      engine->tex_virtual = layer_cache->texture;
+      engine->commands = NULL;
+      const bool SUCCESS_COMPOSE = help_engine_compose_layer(engine, layer);
+      engine->tex_virtual = tex_virtual;
+      engine->commands = commands;
+      if (false == SUCCESS_COMPOSE) return false;
+
+      layer_cache->layer = layer;
+      layer_cache->is_valid = true;
+      layer_cache->rebuilds += 1;
+   }
+
+   // Recording frame - One operation for the whole layer
+   const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(engine->tex_virtual);
+   if (engine->commands && engine->commands->is_recording)
+   {
+      return help_render_commands_push(engine->commands, RENDER_COMMAND_LAYER, layer, 0, 0, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y, false, 0);
+   }
+
+   return help_texture_rgba_copy_region(engine->tex_virtual, layer_cache->texture, region_2d_s_make(0, 0, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y));
+}
+
+struct render_state_s render_state_make(const struct sim_s * sim, const struct render_volumes_s * volumes)
+{
+   struct render_state_s state;
+   memset(&state, 0, sizeof(state));
+   if (NULL == sim) return state;
+
+   state.game_state = sim_game_state(sim);
+   state.play_field = *sim_play_field(sim);
+   state.tetro_active = *sim_tetro_active(sim);
+   state.tetro_next = *sim_tetro_next(sim);
+   state.full_rows = *sim_full_rows(sim);
+   state.full_rows_highlighted = sim_full_rows_highlighted(sim);
+   state.stats = sim_stats(sim);
+   state.game_music_cursor = sim_game_music_cursor(sim);
+   state.game_over_lines_filled = sim_game_over_lines_filled(sim);
+   state.game_over_lines_cleared = sim_game_over_lines_cleared(sim);
+   for (int i_key = 0; i_key < CUSTOM_KEY_COUNT; ++i_key)
+   {
+      state.keys_confirmed[i_key] = sim_key_confirmed(sim, (enum custom_key_e)i_key);
+   }
+   state.volume_overlay_visible = sim_volume_overlay_visible(sim);
+   state.volumes_known = (NULL != volumes);
+   if (volumes)
+   {
+      state.volumes = *volumes;
+   }
+   state.tick = sim_tick(sim);
+
+   return state;
+}
+
+bool help_engine_compose_state(struct engine_s * engine, const struct render_state_s * state)
+{
+   if (NULL == engine || NULL == state) return false;
+
+   // Game Boy palette
+   const color_rgba_t COL_PAL_LIGHT = help_palette_shade_color(PALETTE_SHADE_LIGHT);
+   const color_rgba_t COL_PAL_DARK = help_palette_shade_color(PALETTE_SHADE_DARK);
+
+   // Snapshot of the simulation state for rendering
+   const enum game_state_e game_state = state->game_state;
+   const struct play_field_s * play_field = &state->play_field;
+   const struct tetro_world_s * tetro_active = &state->tetro_active;
+   const struct tetro_world_s * tetro_next = &state->tetro_next;
+   const struct list_of_rows_s * list_of_full_rows = &state->full_rows;
+   const struct sim_stats_s STATS = state->stats;
+   const struct vec_2i_s game_music_cursor = state->game_music_cursor;
+
+   // ----> Background art and fixed labels
+   help_render_engine_layer(engine, help_render_layer_for_state(game_state));
+   // >> Render based on active game mode
+   if (GAME_STATE_GAME_MUSIC_CONFIG == game_state)
+   {
+      // A-Type
+      if (vec_2i_equals_xy(game_music_cursor, 0, 1))
+      {
+         help_engine_render_text_at_tile(engine, "A-TYPE", 3, 5);
+      }
+      else
+      {
+         help_engine_render_tinted_text_at_tile(engine, "A-TYPE", 3, 5, COL_PAL_LIGHT);
+      }
+
+      // B-Type
+      if (vec_2i_equals_xy(game_music_cursor, 1, 1))
+      {
+         help_engine_render_text_at_tile(engine, "B-TYPE", 11, 5);
+      }
+      else
+      {
+         help_engine_render_tinted_text_at_tile(engine, "B-TYPE", 11, 5, COL_PAL_LIGHT);
+      }
+
+      // C-Type
+      if (vec_2i_equals_xy(game_music_cursor, 0, 0))
+      {
+         help_engine_render_text_at_tile(engine, "C-TYPE", 3, 3);
+      }
+      else
+      {
+         help_engine_render_tinted_text_at_tile(engine, "C-TYPE", 3, 3, COL_PAL_LIGHT);
+      }
+
+      // Off
+      if (vec_2i_equals_xy(game_music_cursor, 1, 0))
+      {
+         help_engine_render_text_at_tile(engine, "OFF", 12, 3);
+      }
+      else
+      {
+         help_engine_render_tinted_text_at_tile(engine, "OFF", 12, 3, COL_PAL_LIGHT);
+      }
+   }
+   if (RENDER_LAYER_PLAY == help_render_layer_for_state(game_state))
+   {
+      // >> Active stuff
+      if (GAME_STATE_GAME_OVER != game_state && GAME_STATE_GAME_OVER_TRANSITION_CLEAR != game_state && GAME_STATE_PAUSE != game_state)
+      {
+         // >> Render play field
+         help_play_field_render_to_texture(play_field, engine);
+         // >> Active tetro
+         help_tetro_render_to_texture(tetro_active, engine);
+         // >> Next tetro
+         help_tetro_render_to_texture_at_tile_without_position(tetro_next, engine, 14 + 1, 1);
+      }
+      // >> Gameplay stats
+      help_engine_render_number_at_tile(engine, STATS.score, (int)sizeof(STR_LABEL_SCORE) - 1, 14, PLAY_FIELD_HEIGHT - 4);
+      help_engine_render_number_at_tile(engine, STATS.level, (int)sizeof(STR_LABEL_LEVEL) - 1, 14, PLAY_FIELD_HEIGHT - 8);
+      help_engine_render_number_at_tile(engine, STATS.lines, (int)sizeof(STR_LABEL_LINES) - 1, 14, PLAY_FIELD_HEIGHT - 11);
+
+   }
+   if (GAME_STATE_REMOVE_LINES == game_state)
+   {
+      // Highlight rows on simulation flash timer
+      if (state->full_rows_highlighted)
+      {
+         for (int i_full_rows = 0; i_full_rows < list_of_full_rows->count; ++i_full_rows)
+         {
+            const int DELETION_ROW = list_of_full_rows->list[i_full_rows];
+            for (int deletion_col = 0; deletion_col < PLAY_FIELD_WIDTH; ++deletion_col)
+            {
+               help_render_engine_sprite(
+                  engine,
+                  PLAY_FIELD_OFFSET_HORI_PIXELS + (deletion_col * PLAY_FIELD_TILE_SIZE),
+                  DELETION_ROW * PLAY_FIELD_TILE_SIZE,
+                  SPRITE_MAP_TILE_HIGHLIGHT
+               );
+            }
+         }
+      }
+   }
+   if (GAME_STATE_GAME_OVER_TRANSITION_FILL == game_state)
+   {
+      for (int game_over_row = 0; game_over_row < state->game_over_lines_filled; ++game_over_row)
+      {
+         for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
+         {
+            help_render_engine_sprite(
+               engine,
+               PLAY_FIELD_OFFSET_HORI_PIXELS + (col * PLAY_FIELD_TILE_SIZE),
+               game_over_row * PLAY_FIELD_TILE_SIZE,
+               SPRITE_MAP_TILE_GAME_OVER_FILL
+            );
+         }
+      }
+   }
+   if (GAME_STATE_GAME_OVER == game_state || GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state)
+   {
+      help_engine_render_text_at_tile(engine, "GAME\n\n OVER", 4, PLAY_FIELD_HEIGHT - 4);
+      help_engine_render_text_at_tile(engine, " HIT\n\nSTART\n\n TO TRY\n\nAGAIN", 4, 8);
+   }
+   if (GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state)
+   {
+      for (int game_over_row = 0; game_over_row < state->game_over_lines_cleared; ++game_over_row)
+      {
+         for (int col = 0; col < PLAY_FIELD_WIDTH; ++col)
+         {
+            help_render_engine_sprite(
+               engine,
+               PLAY_FIELD_OFFSET_HORI_PIXELS + (col * PLAY_FIELD_TILE_SIZE),
+               (PLAY_FIELD_HEIGHT * PLAY_FIELD_TILE_SIZE) - (game_over_row * PLAY_FIELD_TILE_SIZE),
+               SPRITE_MAP_TILE_GAME_OVER_FILL
+            );
+         }
+      }
+   }
+   if (GAME_STATE_PAUSE == game_state)
+   {
+      help_engine_render_text_at_tile(engine, " HIT\n\n START\n\n   TO\n\nCONTINUE\n\n   OR\n\n SELECT\n\n TO QUIT", 3, PLAY_FIELD_HEIGHT - 4);
+   }
+   if (GAME_STATE_QUIT == game_state)
+   {
+      help_engine_render_text_at_tile(engine, "THANK YOU FOR\n\n  PLAYING", 3, PLAY_FIELD_HEIGHT - 8);
+      help_render_engine_sprite_at_tile(engine, 3 + 10, PLAY_FIELD_HEIGHT - 10, SPRITE_MAP_TILE_HEART);
+   }
+   if (GAME_STATE_INPUT_MAPPING == game_state)
+   {
+      // Mapping
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_UP]          ? "UP             OK   " : "UP          W       ", 0, PLAY_FIELD_HEIGHT - 3);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_DOWN]        ? "DOWN           OK   " : "DOWN        S       ", 0, PLAY_FIELD_HEIGHT - 4);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_LEFT]        ? "LEFT           OK   " : "LEFT        A       ", 0, PLAY_FIELD_HEIGHT - 5);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_RIGHT]       ? "RIGHT          OK   " : "RIGHT       D       ", 0, PLAY_FIELD_HEIGHT - 6);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_A]           ? "A              OK   " : "A           UP ARR  ", 0, PLAY_FIELD_HEIGHT - 7);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_B]           ? "B              OK   " : "B           LEFT ARR", 0, PLAY_FIELD_HEIGHT - 8);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_START]       ? "START          OK   " : "START       ENTER   ", 0, PLAY_FIELD_HEIGHT - 9);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_SELECT]      ? "SELECT         OK   " : "SELECT      DELETE  ", 0, PLAY_FIELD_HEIGHT - 10);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_VOLUME_UP]   ? "VOLUME UP      OK   " : "VOLUME UP   PLUS KP ", 0, PLAY_FIELD_HEIGHT - 11);
+      help_engine_render_text_at_tile(engine, state->keys_confirmed[CUSTOM_KEY_VOLUME_DOWN] ? "VOLUME DOWN    OK   " : "VOLUME DOWN MINUS KP", 0, PLAY_FIELD_HEIGHT - 12);
+   }
+   if (state->volume_overlay_visible)
+   {
+      if (state->volumes_known)
+      {
+         char str_volumes[64];
+         snprintf(str_volumes, sizeof(str_volumes), "Volume\n  Music: %.2f\n  Sfx  : %.2f", state->volumes.music, state->volumes.sfx);
+         help_engine_render_tinted_text_at_tile(engine, str_volumes, 0, PLAY_FIELD_HEIGHT - 1, COL_PAL_DARK);
+      }
+   }
+
+   // Success
+   return true;
+}
+
+void help_engine_execute_command(struct engine_s * engine, const struct render_command_s * command, struct region_2d_s clip, bool is_inside_clip)
+{
+   const struct region_2d_s REGION = help_render_command_region(command);
+   if (RENDER_COMMAND_LAYER == command->kind)
+   {
+      help_texture_rgba_copy_region(help_engine_get_tex_virtual(engine), engine->layer_cache->texture, clip);
+   }
+   else if (RENDER_COMMAND_FILL == command->kind)
+   {
+      const int MIN_X = help_minmax_max_2i(REGION.min.x, clip.min.x);
+      const int MIN_Y = help_minmax_max_2i(REGION.min.y, clip.min.y);
+      const int MAX_X = help_minmax_min_2i(REGION.max.x, clip.max.x);
+      const int MAX_Y = help_minmax_min_2i(REGION.max.y, clip.max.y);
+      if (MIN_X > MAX_X || MIN_Y > MAX_Y) return;
+
+      help_render_engine_fill(engine, MIN_X, MIN_Y, MAX_X - MIN_X + 1, MAX_Y - MIN_Y + 1, command->color);
+   }
+   else if (is_inside_clip || engine->indexed)
+   {
+      // Regular blitter choice, indexed frames only execute whole and clip against their target
+      help_render_engine_sprite_tinted(engine, REGION.min.x, REGION.min.y, command->id, command->do_tint, command->color);
+   }
+   else
+   {
+      help_tex_sprite_render_tinted_clipped(
+         help_sprite_map_sprite_for(help_engine_get_sprite_map(engine), command->id),
+         REGION.min.x,
+         REGION.min.y,
+         help_engine_get_tex_sprites(engine),
+         help_engine_get_tex_virtual(engine),
+         command->do_tint,
+         command->color,
+         clip
+      );
+   }
+}
+
+bool help_engine_region_inside(struct region_2d_s region, struct region_2d_s clip)
+{
+   return (region.min.x >= clip.min.x && region.max.x <= clip.max.x && region.min.y >= clip.min.y && region.max.y <= clip.max.y);
+}
+
+bool help_engine_execute_commands(struct engine_s * engine, const struct render_commands_s * commands, struct region_2d_s clip)
+{
+   if (NULL == engine || NULL == commands || commands->is_recording || commands->overflow) return false;
+
+   // Every run touching the region in recording order, whole runs inside skip the per command tests
+   for (int i_run = 0; i_run < commands->run_count; ++i_run)
+   {
+      const struct render_command_run_s * RUN = commands->runs + i_run;
+      if (RUN->region.max.x < clip.min.x || RUN->region.min.x > clip.max.x || RUN->region.max.y < clip.min.y || RUN->region.min.y > clip.max.y) continue;
+
+      const bool RUN_INSIDE = help_engine_region_inside(RUN->region, clip);
+      for (int i_command = RUN->first; i_command < RUN->first + RUN->count; ++i_command)
+      {
+         const struct render_command_s * COMMAND = commands->commands + i_command;
+         if (RUN_INSIDE)
+         {
+            help_engine_execute_command(engine, COMMAND, clip, true);
+            continue;
+         }
+
+         const struct region_2d_s REGION = help_render_command_region(COMMAND);
+         if (REGION.max.x < clip.min.x || REGION.min.x > clip.max.x || REGION.max.y < clip.min.y || REGION.min.y > clip.max.y) continue;
+         help_engine_execute_command(engine, COMMAND, clip, help_engine_region_inside(REGION, clip));
+      }
+   }
+
+   // Success
+   return true;
+}
+
+bool help_engine_render_sim(struct engine_s * engine, const struct sim_s * sim, const struct render_volumes_s * volumes)
+{
+   if (NULL == engine || NULL == sim) return false;
+
+   const struct render_state_s STATE = render_state_make(sim, volumes);
+   return help_engine_render_state(engine, &STATE);
+}
+
+bool help_engine_record_state(struct engine_s * engine, const struct render_state_s * state)
+{
+   if (NULL == engine || NULL == engine->commands || NULL == state) return false;
+
+   const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(engine->tex_virtual);
+   help_render_commands_begin(engine->commands);
+   help_engine_compose_state(engine, state);
+   help_render_commands_end(engine->commands, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y);
+
+   return false == engine->commands->overflow;
+}
+
+bool help_engine_render_state(struct engine_s * engine, const struct render_state_s * state)
+{
+   if (NULL == engine || NULL == state) return false;
+
+   // Record the frame, without commands every draw is issued right away
+   struct render_commands_s * commands = engine->commands;
+   const struct vec_2i_s VIRTUAL_SIZE = help_texture_rgba_size(engine->tex_virtual);
+   bool success_compose = true;
+   help_engine_record_state(engine, state);
+
+   // Find the tiles that changed - Indexed frames are resolved whole
+   struct nametable_s * nametable = engine->indexed ? NULL : engine->nametable;
+   help_nametable_resolve(nametable, commands);
+
+   if (NULL == commands || commands->overflow)
+   {
+      // Too many draws to keep - Compose everything directly, all tiles are dirty already
+      success_compose = help_engine_compose_state(engine, state);
+   }
+   else if (nametable)
+   {
+      // Re-composite dirty rectangles only
+      for (int i_rect = 0; i_rect < nametable->rect_count; ++i_rect)
+      {
+         help_engine_execute_commands(engine, commands, help_nametable_rect_texels(nametable, nametable->rects[i_rect]));
+      }
+   }
+   else
+   {
+      help_engine_execute_commands(engine, commands, region_2d_s_make(0, 0, VIRTUAL_SIZE.x, VIRTUAL_SIZE.y));
+   }
+
+   // Indices through the palette once
+   if (engine->indexed)
+   {
+      return success_compose && help_texture_2bpp_resolve(engine->indexed->tex_virtual, engine->indexed->palette, engine->tex_virtual);
+   }
+
+   return success_compose;
+}
+
+// Logic - Render state snapshots
+#define RENDER_SNAPSHOTS_SLOT_MASK (0x3)
+#define RENDER_SNAPSHOTS_FRESH (0x4)
+
+struct render_snapshots_s {
+   struct render_state_s slots[3];
+   // Slot index of the middle buffer, flagged fresh when published and not yet acquired
+   atomic_int middle;
+   // Owned by the simulation thread
+   int back;
+   // Owned by the composing thread
+   int front;
+};
+
+struct render_snapshots_s * help_render_snapshots_create(void)
+{
+   struct render_snapshots_s * instance = malloc(sizeof(struct render_snapshots_s));
+   if (NULL == instance) return NULL;
+
+   memset(instance->slots, 0, sizeof(instance->slots));
+   instance->back = 0;
+   atomic_init(&instance->middle, 1);
+   instance->front = 2;
+
+   return instance;
+}
+
+void * help_render_snapshots_destroy(struct render_snapshots_s * instance)
+{
+   free(instance);
+
+   return NULL;
+}
+
+struct render_state_s * help_render_snapshots_back(struct render_snapshots_s * instance)
+{
+   return instance ? instance->slots + instance->back : NULL;
+}
+
+void help_render_snapshots_publish(struct render_snapshots_s * instance)
+{
+   if (NULL == instance) return;
+
+   // Release the filled slot, whatever was in the middle becomes the next back slot
+   const int PREVIOUS = atomic_exchange_explicit(&instance->middle, instance->back | RENDER_SNAPSHOTS_FRESH, memory_order_acq_rel);
+   instance->back = PREVIOUS & RENDER_SNAPSHOTS_SLOT_MASK;
+}
+
+const struct render_state_s * help_render_snapshots_acquire(struct render_snapshots_s * instance, bool * out_is_new)
+{
+   if (NULL == instance) return NULL;
+
+   const bool IS_NEW = (atomic_load_explicit(&instance->middle, memory_order_relaxed) & RENDER_SNAPSHOTS_FRESH);
+   if (IS_NEW)
+   {
+      const int PREVIOUS = atomic_exchange_explicit(&instance->middle, instance->front, memory_order_acq_rel);
+      instance->front = PREVIOUS & RENDER_SNAPSHOTS_SLOT_MASK;
+   }
+   if (out_is_new)
+   {
+      *out_is_new = IS_NEW;
+   }
+
+   return instance->slots + instance->front;
+}
@@ -0,0 +1,509 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include "sim.h"
+#include "rng.h"
+#include "player.h"
+#include "render.h"
+#include "cli.h"
+
+// Constants
+const char * ARG_KEY_SEED = "-seed";
+const char * ARG_KEY_TICKS = "-ticks";
+const char * ARG_KEY_STRIDE = "-stride";
+const char * ARG_KEY_PASSES = "-passes";
+const char * ARG_KEY_PACKING = "-packing";
+const int ATLAS_SIZE = 512;
+const int VIRTUAL_WIDTH = 160;
+const int VIRTUAL_HEIGHT = 144;
+
+// Helpers - Hashing
+uint64_t help_hash_texture(uint64_t hash, const struct texture_rgba_s * texture)
+{
+   // FNV-1a over every texel
+   const int TEXEL_COUNT = texture->width * texture->height;
+   for (int i_texel = 0; i_texel < TEXEL_COUNT; ++i_texel)
+   {
+      hash ^= texture->texels[i_texel];
+      hash *= 0x100000001b3ull;
+   }
+   return hash;
+}
+
+// Bench - Atlas
+struct texture_rgba_s * help_bench_atlas_make(uint32_t seed)
+{
+   // Stand-in for tiles.png without an image decoder - Four shades, glyph tiles half transparent
+   struct texture_rgba_s * atlas = help_texture_rgba_make(ATLAS_SIZE, ATLAS_SIZE, help_palette_shade_color(PALETTE_SHADE_LIGHTEST));
+   if (NULL == atlas) return NULL;
+
+   struct rng_s rng;
+   rng_seed(&rng, seed, 0);
+   for (int y = 0; y < ATLAS_SIZE; ++y)
+   {
+      for (int x = 0; x < ATLAS_SIZE; ++x)
+      {
+         const bool GLYPH_TILE = (x / PLAY_FIELD_TILE_SIZE) < 16 && (y / PLAY_FIELD_TILE_SIZE) < 3;
+         const bool TRANSPARENT = GLYPH_TILE && 0 == rng_next_below(&rng, 2);
+         const color_rgba_t SHADE = help_palette_shade_color((enum palette_shade_e)rng_next_below(&rng, PALETTE_SHADE_COUNT));
+         help_texture_rgba_plot_texel(atlas, x, y, TRANSPARENT ? (SHADE & ~color_rgba_alpha_mask()) : SHADE);
+      }
+   }
+
+   return atlas;
+}
+
+// Bench - Frames
+struct sim_s * help_bench_frames_collect(uint32_t seed, unsigned long ticks, unsigned long stride, int * out_frame_count)
+{
+   // Bot play passes through menus, gameplay, line clears and game over
+   const int FRAME_CAPACITY = (int)(ticks / stride) + 1;
+   struct sim_s * frames = malloc(sizeof(struct sim_s) * FRAME_CAPACITY);
+   if (NULL == frames) return NULL;
+
+   struct sim_s sim;
+   struct player_s player;
+   sim_init(&sim, seed, TETRO_RANDOMIZER_CLASSIC);
+   player_init(&player, PLAYER_KIND_BOT, seed);
+
+   int frame_count = 0;
+   for (unsigned long tick = 0; tick < ticks; ++tick)
+   {
+      if (0 == tick % stride && frame_count < FRAME_CAPACITY)
+      {
+         frames[frame_count++] = sim;
+      }
+      sim_step(&sim, player_input(&player, &sim), NULL);
+   }
+
+   *out_frame_count = frame_count;
+   return frames;
+}
+
+struct bench_result_s {
+   double seconds;
+   uint64_t hash;
+};
+
+struct bench_result_s help_bench_compose(struct engine_s * engine, const struct sim_s * frames, int frame_count, int passes)
+{
+   struct bench_result_s result;
+   result.seconds = 0.0;
+   result.hash = 0xcbf29ce484222325ull;
+
+   // Only composition is timed, hashing happens in between
+   struct render_volumes_s volumes;
+   volumes.music = 1.0f;
+   volumes.sfx = 1.0f;
+   for (int pass = 0; pass < passes; ++pass)
+   {
+      for (int i_frame = 0; i_frame < frame_count; ++i_frame)
+      {
+         const double TIME_START = help_time_in_seconds();
+         help_engine_render_sim(engine, frames + i_frame, &volumes);
+         result.seconds += help_time_in_seconds() - TIME_START;
+
+         if (0 == pass)
+         {
+            result.hash = help_hash_texture(result.hash, engine->tex_virtual);
+         }
+      }
+   }
+
+   return result;
+}
+
+void help_bench_geometry_rasterize(const struct render_geometry_s * geometry, struct texture_rgba_s * target)
+{
+   // What a renderer does with the batch at scale 1 - Nearest sampling at texel centers, vertex colors multiply, alpha 0 discarded
+   help_texture_rgba_clear(target, color_rgba_make_rgba(0x00, 0x00, 0x00, 0xFF));
+   const struct texture_rgba_s * ATLAS = geometry->atlas;
+   for (int i_quad = 0; i_quad < geometry->quad_count; ++i_quad)
+   {
+      const struct render_vertex_s * TOP_LEFT = geometry->vertices + i_quad * 4;
+      const struct render_vertex_s * BOTTOM_RIGHT = TOP_LEFT + 3;
+      const int MIN_X = (int)TOP_LEFT->x < 0 ? 0 : (int)TOP_LEFT->x;
+      const int MIN_Y = (int)TOP_LEFT->y < 0 ? 0 : (int)TOP_LEFT->y;
+      const int MAX_X = (int)BOTTOM_RIGHT->x > target->width ? target->width : (int)BOTTOM_RIGHT->x;
+      const int MAX_Y = (int)BOTTOM_RIGHT->y > target->height ? target->height : (int)BOTTOM_RIGHT->y;
+      for (int y = MIN_Y; y < MAX_Y; ++y)
+      {
+         const float V = TOP_LEFT->v + (y + 0.5f - TOP_LEFT->y) / (BOTTOM_RIGHT->y - TOP_LEFT->y) * (BOTTOM_RIGHT->v - TOP_LEFT->v);
+         for (int x = MIN_X; x < MAX_X; ++x)
+         {
+            const float U = TOP_LEFT->u + (x + 0.5f - TOP_LEFT->x) / (BOTTOM_RIGHT->x - TOP_LEFT->x) * (BOTTOM_RIGHT->u - TOP_LEFT->u);
+            const color_rgba_t TEXEL = ATLAS->texels[(int)(V * ATLAS->height) * ATLAS->width + (int)(U * ATLAS->width)];
+            const uint8_t ALPHA = (uint8_t)(color_rgba_channel_alpha(TEXEL) * TOP_LEFT->alpha + 0.5f);
+            if (0 == ALPHA) continue;
+
+            target->texels[y * target->width + x] = color_rgba_make_rgba(
+               (uint8_t)(color_rgba_channel_red(TEXEL) * TOP_LEFT->red + 0.5f),
+               (uint8_t)(color_rgba_channel_green(TEXEL) * TOP_LEFT->green + 0.5f),
+               (uint8_t)(color_rgba_channel_blue(TEXEL) * TOP_LEFT->blue + 0.5f),
+               ALPHA
+            );
+         }
+      }
+   }
+}
+
+struct bench_result_s help_bench_geometry(struct engine_s * engine, struct render_geometry_s * geometry, struct texture_rgba_s * target, const struct sim_s * frames, int frame_count, int passes)
+{
+   struct bench_result_s result;
+   result.seconds = 0.0;
+   result.hash = 0xcbf29ce484222325ull;
+
+   // Recording and batching are timed, the stand-in rasterizer only checks the quads
+   struct render_volumes_s volumes;
+   volumes.music = 1.0f;
+   volumes.sfx = 1.0f;
+   for (int pass = 0; pass < passes; ++pass)
+   {
+      for (int i_frame = 0; i_frame < frame_count; ++i_frame)
+      {
+         const double TIME_START = help_time_in_seconds();
+         const struct render_state_s STATE = render_state_make(frames + i_frame, &volumes);
+         help_engine_record_state(engine, &STATE);
+         help_render_geometry_build(geometry, engine->commands, engine->sprite_map, target->height, 0.0f, 0.0f, 1.0f);
+         result.seconds += help_time_in_seconds() - TIME_START;
+
+         if (0 == pass)
+         {
+            help_bench_geometry_rasterize(geometry, target);
+            result.hash = help_hash_texture(result.hash, target);
+         }
+      }
+   }
+
+   return result;
+}
+
+struct bench_result_s help_bench_upscale(const struct texture_rgba_s * source, struct texture_rgba_s * target, enum upscale_kernel_e kernel, int repeats)
+{
+   struct bench_result_s result;
+   result.seconds = 0.0;
+   result.hash = 0xcbf29ce484222325ull;
+
+   // Borders once like a new window surface, then only the scaled image per frame
+   help_texture_rgba_clear(target, color_rgba_make_rgba(0xFF, 0x00, 0xFF, 0xFF));
+   const color_rgba_t BORDER = color_rgba_make_rgba(0x00, 0x00, 0x00, 0xFF);
+   const int PITCH = target->width * (int)sizeof(color_rgba_t);
+   help_texture_rgba_upscale(source, target->texels, PITCH, target->width, target->height, true, BORDER, kernel);
+   const double TIME_START = help_time_in_seconds();
+   for (int i_repeat = 0; i_repeat < repeats; ++i_repeat)
+   {
+      help_texture_rgba_upscale(source, target->texels, PITCH, target->width, target->height, false, BORDER, kernel);
+   }
+   result.seconds = (help_time_in_seconds() - TIME_START) / repeats;
+   result.hash = help_hash_texture(result.hash, target);
+
+   return result;
+}
+
+double help_bench_sprite(struct engine_s * engine, enum sprite_map_tile_e tile, bool do_tint, int blits)
+{
+   // Nanoseconds per blit, sweeping positions so some blits are clipped
+   const color_rgba_t TINT = help_palette_shade_color(PALETTE_SHADE_LIGHT);
+   const double TIME_START = help_time_in_seconds();
+   for (int i_blit = 0; i_blit < blits; ++i_blit)
+   {
+      const int X = (i_blit * 7) % (VIRTUAL_WIDTH + PLAY_FIELD_TILE_SIZE) - PLAY_FIELD_TILE_SIZE / 2;
+      const int Y = (i_blit * 5) % (VIRTUAL_HEIGHT + PLAY_FIELD_TILE_SIZE) - PLAY_FIELD_TILE_SIZE / 2;
+      help_render_engine_sprite_tinted(engine, X, Y, tile, do_tint, TINT);
+   }
+   return (help_time_in_seconds() - TIME_START) * 1000000000.0 / blits;
+}
+
+const char * help_blitter_name(enum render_blitter_e blitter)
+{
+   switch (blitter)
+   {
+      case RENDER_BLITTER_ROW_SPAN:
+         return "row span";
+      case RENDER_BLITTER_PER_TEXEL:
+         return "per texel";
+      case RENDER_BLITTER_TILE_KERNEL:
+         return "tile";
+      default:
+         return "unknown";
+   }
+}
+
+// Logic - Main
+int main(int argc, char * argv[])
+{
+   const uint32_t SEED = (uint32_t)help_args_unsigned_or(argc, argv, ARG_KEY_SEED, 1);
+   const unsigned long TICKS = help_args_unsigned_or(argc, argv, ARG_KEY_TICKS, SIM_TICKS_PER_SECOND * 60 * 10);
+   const unsigned long STRIDE = help_args_unsigned_or(argc, argv, ARG_KEY_STRIDE, 10);
+   const int PASSES = (int)help_args_unsigned_or(argc, argv, ARG_KEY_PASSES, 3);
+   if (0 == STRIDE || PASSES <= 0)
+   {
+      printf("\nStride and passes must be positive");
+      return EXIT_FAILURE;
+   }
+
+   // Color packing as a presenter would negotiate it
+   const char * ARG_PACKING = help_args_key_value_first(argc, argv, ARG_KEY_PACKING);
+   if (ARG_PACKING)
+   {
+      enum color_packing_e packing = COLOR_PACKING_COUNT;
+      for (int i_packing = 0; i_packing < COLOR_PACKING_COUNT; ++i_packing)
+      {
+         if (strcasecmp(ARG_PACKING, color_packing_name((enum color_packing_e)i_packing)) == 0)
+         {
+            packing = (enum color_packing_e)i_packing;
+         }
+      }
+      if (false == color_packing_select(packing))
+      {
+         printf("\nUnknown color packing '%s' (Use rgba, argb, bgra or abgr)", ARG_PACKING);
+         return EXIT_FAILURE;
+      }
+   }
+
+   // Engine around a synthetic atlas
+   struct texture_rgba_s * tex_sprites = help_bench_atlas_make(SEED);
+   struct texture_rgba_s * tex_virtual = help_texture_rgba_make(VIRTUAL_WIDTH, VIRTUAL_HEIGHT, help_palette_shade_color(PALETTE_SHADE_LIGHTEST));
+   struct sprite_map_s * sprite_map = help_sprite_map_create(tex_sprites, 13, 13, PLAY_FIELD_TILE_SIZE);
+   struct font_render_s font_render;
+   if (NULL == tex_sprites || NULL == tex_virtual || NULL == sprite_map || false == font_render_make(&font_render))
+   {
+      printf("\nFailed to create render engine");
+      return EXIT_FAILURE;
+   }
+   help_sprite_map_register_tiles(sprite_map);
+   help_font_render_map_glyphs(&font_render);
+   struct tint_cache_s * tint_cache = help_tint_cache_create(PLAY_FIELD_TILE_SIZE);
+   if (NULL == tint_cache || false == help_tint_cache_bake_font_palette(tint_cache, sprite_map, &font_render))
+   {
+      printf("\nFailed to create tint cache");
+      return EXIT_FAILURE;
+   }
+   const int TINTS_BAKED = tint_cache->entry_count;
+
+   struct engine_s engine;
+   engine.tex_virtual = tex_virtual;
+   engine.tex_sprites = tex_sprites;
+   engine.sprite_map = sprite_map;
+   engine.font_render = &font_render;
+   engine.tint_cache = tint_cache;
+   engine.commands = NULL;
+   engine.nametable = NULL;
+   engine.layer_cache = NULL;
+   engine.indexed = NULL;
+   engine.text_cache = NULL;
+   engine.blitter = RENDER_BLITTER_ROW_SPAN;
+
+   // Frames from bot play
+   int frame_count = 0;
+   struct sim_s * frames = help_bench_frames_collect(SEED, TICKS, STRIDE, &frame_count);
+   if (NULL == frames)
+   {
+      printf("\nFailed to collect frames");
+      return EXIT_FAILURE;
+   }
+
+   const int DW = 20;
+   printf("Render Benchmark");
+   printf("\n\t%-*s: %u", DW, "seed", SEED);
+   printf("\n\t%-*s: %d (every %lu ticks)", DW, "frames", frame_count, STRIDE);
+   printf("\n\t%-*s: %d", DW, "passes", PASSES);
+   printf("\n\t%-*s: %s", DW, "color packing", color_packing_name(color_packing_selected()));
+   printf("\n\t%-*s: %s", DW, "tile kernel", help_tex_tile_kernel_name());
+   printf("\n\t%-*s: %d", DW, "tints baked", TINTS_BAKED);
+
+   // Whole frames through every blitter, reference first
+   printf("\n\nFrame composition");
+   printf("\n\t%-10s %12s %12s %8s  %s", "blitter", "us/frame", "frames/s", "speedup", "frames");
+   const enum render_blitter_e BLITTERS[] = { RENDER_BLITTER_PER_TEXEL, RENDER_BLITTER_ROW_SPAN, RENDER_BLITTER_TILE_KERNEL };
+   const int BLITTER_COUNT = sizeof(BLITTERS) / sizeof(BLITTERS[0]);
+   struct bench_result_s reference;
+   bool identical_all = true;
+   for (int i_blitter = 0; i_blitter < BLITTER_COUNT; ++i_blitter)
+   {
+      engine.blitter = BLITTERS[i_blitter];
+      const struct bench_result_s RESULT = help_bench_compose(&engine, frames, frame_count, PASSES);
+      if (0 == i_blitter)
+      {
+         reference = RESULT;
+      }
+      const bool IDENTICAL = (RESULT.hash == reference.hash);
+      identical_all = identical_all && IDENTICAL;
+
+      const double FRAMES = (double)frame_count * PASSES;
+      printf(
+         "\n\t%-10s %12.2f %12.0f %7.2fx  %s",
+         help_blitter_name(BLITTERS[i_blitter]),
+         RESULT.seconds * 1000000.0 / FRAMES,
+         FRAMES / RESULT.seconds,
+         reference.seconds / RESULT.seconds,
+         IDENTICAL ? "identical" : "DIFFER"
+      );
+   }
+
+   // Single sprites
+   const int BLITS = 200000;
+   printf("\n\nSprite blits [ns]");
+   printf("\n\t%-10s %12s %12s %12s", "blitter", "tile 8x8", "glyph tint", "bg 160x144");
+   for (int i_blitter = 0; i_blitter < BLITTER_COUNT; ++i_blitter)
+   {
+      engine.blitter = BLITTERS[i_blitter];
+      printf(
+         "\n\t%-10s %12.1f %12.1f %12.1f",
+         help_blitter_name(BLITTERS[i_blitter]),
+         help_bench_sprite(&engine, SPRITE_MAP_TILE_TETRO_BLOCK_T, false, BLITS),
+         help_bench_sprite(&engine, SPRITE_MAP_TILE_FONT_GLYPH_A, true, BLITS),
+         help_bench_sprite(&engine, SPRITE_MAP_TILE_BG_PLAY_SCREEN, false, BLITS / 100)
+      );
+   }
+   printf("\n\n\t%-*s: %d entries, %d baked on first use, %d larger sprite draws bypassed", DW, "tint cache", tint_cache->entry_count, tint_cache->entry_count - TINTS_BAKED, tint_cache->bypasses);
+
+   // Consecutive ticks like the game loop, whole frames against dirty tiles only
+   int tick_count = 0;
+   struct sim_s * ticks = help_bench_frames_collect(SEED, (unsigned long)frame_count, 1, &tick_count);
+   struct nametable_s * nametable = help_nametable_create(VIRTUAL_WIDTH, VIRTUAL_HEIGHT, PLAY_FIELD_TILE_SIZE);
+   struct layer_cache_s * layer_cache = help_layer_cache_create(VIRTUAL_WIDTH, VIRTUAL_HEIGHT);
+   struct render_indexed_s * indexed = help_render_indexed_create(tex_virtual, tex_sprites);
+   struct render_commands_s * commands = help_render_commands_create();
+   struct text_cache_s * text_cache = help_text_cache_create();
+   struct render_geometry_s * geometry = help_render_geometry_create(tex_sprites);
+   struct texture_rgba_s * geometry_target = help_texture_rgba_make(VIRTUAL_WIDTH, VIRTUAL_HEIGHT, 0);
+   if (NULL == ticks || NULL == nametable || NULL == layer_cache || NULL == indexed || NULL == commands || NULL == text_cache || NULL == geometry || NULL == geometry_target)
+   {
+      printf("\nFailed to create frame caches");
+      return EXIT_FAILURE;
+   }
+   engine.blitter = RENDER_BLITTER_TILE_KERNEL;
+   const struct bench_result_s WHOLE = help_bench_compose(&engine, ticks, tick_count, PASSES);
+   engine.commands = commands;
+   const struct bench_result_s COMMANDS = help_bench_compose(&engine, ticks, tick_count, PASSES);
+   engine.commands = NULL;
+   engine.layer_cache = layer_cache;
+   const struct bench_result_s LAYERS = help_bench_compose(&engine, ticks, tick_count, PASSES);
+   engine.commands = commands;
+   engine.nametable = nametable;
+   const struct bench_result_s DIRTY = help_bench_compose(&engine, ticks, tick_count, PASSES);
+   engine.nametable = NULL;
+   engine.layer_cache = NULL;
+   // Same commands executed into the indexed backend
+   engine.indexed = indexed;
+   const struct bench_result_s INDEXED = help_bench_compose(&engine, ticks, tick_count, PASSES);
+   engine.indexed = NULL;
+   engine.commands = NULL;
+   // Text laid out once instead of per draw
+   engine.text_cache = text_cache;
+   const struct bench_result_s TEXT = help_bench_compose(&engine, ticks, tick_count, PASSES);
+   engine.text_cache = NULL;
+   // Commands batched into quads for a triangle renderer
+   engine.commands = commands;
+   const struct bench_result_s GEOMETRY = help_bench_geometry(&engine, geometry, geometry_target, ticks, tick_count, PASSES);
+   engine.commands = NULL;
+   const bool COMMANDS_IDENTICAL = (WHOLE.hash == COMMANDS.hash);
+   const bool LAYERS_IDENTICAL = (WHOLE.hash == LAYERS.hash);
+   const bool DIRTY_IDENTICAL = (WHOLE.hash == DIRTY.hash);
+   const bool INDEXED_IDENTICAL = (WHOLE.hash == INDEXED.hash);
+   const bool TEXT_IDENTICAL = (WHOLE.hash == TEXT.hash);
+   const bool GEOMETRY_IDENTICAL = (WHOLE.hash == GEOMETRY.hash);
+   identical_all = identical_all && COMMANDS_IDENTICAL && LAYERS_IDENTICAL && DIRTY_IDENTICAL && INDEXED_IDENTICAL && TEXT_IDENTICAL && GEOMETRY_IDENTICAL;
+
+   const double TICK_FRAMES = (double)tick_count * PASSES;
+   const double TILES_PER_FRAME = (double)nametable->tiles_redrawn_total / nametable->frames;
+   const int TILES_ALL = nametable->tiles_wide * nametable->tiles_high;
+   printf("\n\nFrame caching (%d consecutive ticks)", tick_count);
+   printf("\n\t%-10s %12s %12s %8s  %s", "frame", "us/frame", "tiles/frame", "speedup", "frames");
+   printf("\n\t%-10s %12.2f %12d %7.2fx  %s", "whole", WHOLE.seconds * 1000000.0 / TICK_FRAMES, TILES_ALL, 1.0, "reference");
+   printf("\n\t%-10s %12.2f %12d %7.2fx  %s", "commands", COMMANDS.seconds * 1000000.0 / TICK_FRAMES, TILES_ALL, WHOLE.seconds / COMMANDS.seconds, COMMANDS_IDENTICAL ? "identical" : "DIFFER");
+   printf("\n\t%-10s %12.2f %12d %7.2fx  %s", "layers", LAYERS.seconds * 1000000.0 / TICK_FRAMES, TILES_ALL, WHOLE.seconds / LAYERS.seconds, LAYERS_IDENTICAL ? "identical" : "DIFFER");
+   printf("\n\t%-10s %12.2f %12.1f %7.2fx  %s", "dirty", DIRTY.seconds * 1000000.0 / TICK_FRAMES, TILES_PER_FRAME, WHOLE.seconds / DIRTY.seconds, DIRTY_IDENTICAL ? "identical" : "DIFFER");
+   printf("\n\t%-10s %12.2f %12d %7.2fx  %s", "indexed", INDEXED.seconds * 1000000.0 / TICK_FRAMES, TILES_ALL, WHOLE.seconds / INDEXED.seconds, INDEXED_IDENTICAL ? "identical" : "DIFFER");
+   printf("\n\t%-10s %12.2f %12d %7.2fx  %s", "text", TEXT.seconds * 1000000.0 / TICK_FRAMES, TILES_ALL, WHOLE.seconds / TEXT.seconds, TEXT_IDENTICAL ? "identical" : "DIFFER");
+   printf("\n\t%-10s %12.2f %12d %7.2fx  %s", "geometry", GEOMETRY.seconds * 1000000.0 / TICK_FRAMES, TILES_ALL, WHOLE.seconds / GEOMETRY.seconds, GEOMETRY_IDENTICAL ? "identical" : "DIFFER");
+   printf("\n\t%-*s: %.2f", DW, "dirty rects/frame", (double)nametable->rects_total / nametable->frames);
+   printf("\n\t%-*s: %d", DW, "layer rebuilds", layer_cache->rebuilds);
+   printf("\n\t%-*s: %lu laid out, %lu reused", DW, "text runs", text_cache->layouts, text_cache->hits);
+   printf(
+      "\n\t%-*s: %.1f commands, %.1f runs, %.1f culled (%d bytes each)",
+      DW,
+      "recorded per frame",
+      (double)commands->commands_total / commands->frames,
+      (double)commands->runs_total / commands->frames,
+      (double)commands->culled_total / commands->frames,
+      (int)sizeof(struct render_command_s)
+   );
+   printf(
+      "\n\t%-*s: %.1f quads in one batch, %dx%d atlas",
+      DW,
+      "geometry per frame",
+      geometry->batches ? (double)geometry->quads_total / geometry->batches : 0.0,
+      geometry->atlas->width,
+      geometry->atlas->height
+   );
+   printf("\n\t%-*s: %.1f KB of %.1f KB", DW, "upload per frame", TILES_PER_FRAME * PLAY_FIELD_TILE_SIZE * PLAY_FIELD_TILE_SIZE * sizeof(color_rgba_t) / 1024.0, (double)VIRTUAL_WIDTH * VIRTUAL_HEIGHT * sizeof(color_rgba_t) / 1024.0);
+   printf(
+      "\n\t%-*s: %.1f KB indexed, %.1f KB rgba",
+      DW,
+      "sprite atlas",
+      (double)indexed->tex_sprites->groups_per_row * indexed->tex_sprites->height * 3 / 1024.0,
+      (double)tex_sprites->width * tex_sprites->height * sizeof(color_rgba_t) / 1024.0
+   );
+
+   // Window surface presentation, the last composed frame scaled to common displays
+   printf("\n\nUpscale to window surface [ms/frame]");
+   printf("\n\t%-10s", "kernel");
+   const int UPSCALE_SIZES[][2] = { { 1920, 1080 }, { 3840, 2160 } };
+   const int UPSCALE_SIZE_COUNT = sizeof(UPSCALE_SIZES) / sizeof(UPSCALE_SIZES[0]);
+   struct texture_rgba_s * upscale_targets[2];
+   struct bench_result_s upscale_references[2];
+   for (int i_size = 0; i_size < UPSCALE_SIZE_COUNT; ++i_size)
+   {
+      upscale_targets[i_size] = help_texture_rgba_make(UPSCALE_SIZES[i_size][0], UPSCALE_SIZES[i_size][1], 0);
+      if (NULL == upscale_targets[i_size])
+      {
+         printf("\nFailed to create upscale target");
+         return EXIT_FAILURE;
+      }
+      printf("%13s%4dp", "", UPSCALE_SIZES[i_size][1]);
+   }
+   for (int kernel = 0; kernel < UPSCALE_KERNEL_COUNT; ++kernel)
+   {
+      if (false == help_upscale_kernel_supported((enum upscale_kernel_e)kernel)) continue;
+
+      printf("\n\t%-10s", help_upscale_kernel_name((enum upscale_kernel_e)kernel));
+      for (int i_size = 0; i_size < UPSCALE_SIZE_COUNT; ++i_size)
+      {
+         const struct bench_result_s RESULT = help_bench_upscale(tex_virtual, upscale_targets[i_size], (enum upscale_kernel_e)kernel, 20 * PASSES);
+         if (UPSCALE_KERNEL_PER_PIXEL == kernel)
+         {
+            upscale_references[i_size] = RESULT;
+         }
+         const bool IDENTICAL = (RESULT.hash == upscale_references[i_size].hash);
+         identical_all = identical_all && IDENTICAL;
+         printf(" %8.3f %6.2fx%s", RESULT.seconds * 1000.0, upscale_references[i_size].seconds / RESULT.seconds, IDENTICAL ? " " : "!");
+      }
+   }
+   printf("\n\t%-*s: scale %d and %d, '!' marks output differing from per-pixel", DW, "upscale", help_upscale_scale_max(1920, 1080, VIRTUAL_WIDTH, VIRTUAL_HEIGHT), help_upscale_scale_max(3840, 2160, VIRTUAL_WIDTH, VIRTUAL_HEIGHT));
+   printf("\n");
+
+   // Cleanup
+   for (int i_size = 0; i_size < UPSCALE_SIZE_COUNT; ++i_size)
+   {
+      help_texture_rgba_destroy(upscale_targets[i_size]);
+   }
+   help_render_indexed_destroy(indexed);
+   help_texture_rgba_destroy(geometry_target);
+   help_render_geometry_destroy(geometry);
+   help_text_cache_destroy(text_cache);
+   help_render_commands_destroy(commands);
+   help_layer_cache_destroy(layer_cache);
+   help_nametable_destroy(nametable);
+   help_tint_cache_destroy(tint_cache);
+   free(ticks);
+   free(frames);
+   free(sprite_map);
+   help_texture_rgba_destroy(tex_virtual);
+   help_texture_rgba_destroy(tex_sprites);
+
+   return identical_all ? EXIT_SUCCESS : EXIT_FAILURE;
+}
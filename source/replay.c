@@ -0,0 +1,536 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+_Static_assert(sizeof(struct replay_header_s) == 80, "Replay header layout changed");
+_Static_assert(sizeof(struct replay_run_s) == 4, "Replay run layout changed");
+_Static_assert(sizeof(struct replay_keyframe_s) == 16 + SIM_STATE_SERIAL_SIZE, "Replay keyframe layout changed");
+
+// Header, runs and keyframe cursors are used in place, only the keyframe
+// snapshots are byte order independent
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Replay files are little-endian and mapped in place"
+#endif
+
+// Constants
+static const char * REPLAY_BUILD_INFO = __DATE__ " " __TIME__;
+static const uint32_t REPLAY_RUN_CAPACITY_INITIAL = 1024;
+static const uint32_t REPLAY_KEYFRAME_CAPACITY_INITIAL = 64;
+static const uint32_t REPLAY_KEYFRAME_ALIGNMENT = 8;
+
+// Replay - Recording
+struct replay_recorder_s * replay_recorder_create(uint32_t seed, enum tetro_randomizer_e randomizer, uint32_t keyframe_interval)
+{
+   // Allocate instance
+   struct replay_recorder_s * instance = malloc(sizeof(struct replay_recorder_s));
+   if (NULL == instance)
+   {
+      printf("\nFailed to create replay recorder instance");
+      return NULL;
+   }
+
+   // Header
+   memset(&instance->header, 0, sizeof(instance->header));
+   memcpy(instance->header.magic, REPLAY_MAGIC, sizeof(instance->header.magic));
+   instance->header.version = REPLAY_VERSION;
+   instance->header.header_size = sizeof(struct replay_header_s);
+   instance->header.seed = seed;
+   instance->header.randomizer = (uint32_t)randomizer;
+   instance->header.runs_offset = sizeof(struct replay_header_s);
+   instance->header.keyframe_interval = keyframe_interval;
+   instance->header.keyframe_size = sizeof(struct replay_keyframe_s);
+   instance->header.state_version = SIM_STATE_VERSION;
+   strncpy(instance->header.build_info, REPLAY_BUILD_INFO, REPLAY_BUILD_INFO_SIZE - 1);
+
+   // Allocate runs and keyframes
+   instance->run_capacity = REPLAY_RUN_CAPACITY_INITIAL;
+   instance->runs = malloc(sizeof(struct replay_run_s) * instance->run_capacity);
+   instance->keyframe_capacity = REPLAY_KEYFRAME_CAPACITY_INITIAL;
+   instance->keyframes = malloc(sizeof(struct replay_keyframe_s) * instance->keyframe_capacity);
+   if (NULL == instance->runs || NULL == instance->keyframes)
+   {
+      printf("\nFailed to allocate replay recorder runs and keyframes");
+      return replay_recorder_destroy(instance);
+   }
+
+   // Success
+   return instance;
+}
+
+void * replay_recorder_destroy(struct replay_recorder_s * instance)
+{
+   if (instance)
+   {
+      free(instance->runs);
+      free(instance->keyframes);
+   }
+
+   free(instance);
+
+   return NULL;
+}
+
+bool help_replay_recorder_push_keyframe(struct replay_recorder_s * instance, const struct sim_s * sim)
+{
+   if (NULL == instance || NULL == sim) return false;
+
+   // Grow keyframe storage
+   struct replay_header_s * header = &instance->header;
+   if (header->keyframe_count == instance->keyframe_capacity)
+   {
+      const uint32_t CAPACITY_GROWN = instance->keyframe_capacity * 2;
+      struct replay_keyframe_s * keyframes_grown = realloc(instance->keyframes, sizeof(struct replay_keyframe_s) * CAPACITY_GROWN);
+      if (NULL == keyframes_grown)
+      {
+         printf("\nFailed to grow replay recorder keyframes to %u", CAPACITY_GROWN);
+         return false;
+      }
+      instance->keyframes = keyframes_grown;
+      instance->keyframe_capacity = CAPACITY_GROWN;
+   }
+
+   // Snapshot taken before the input of the current tick was applied, so the
+   // cursor points past the last recorded tick
+   struct replay_keyframe_s * keyframe = instance->keyframes + header->keyframe_count;
+   memset(keyframe, 0, sizeof(*keyframe));
+   keyframe->tick = header->tick_count;
+   keyframe->run = header->run_count;
+   keyframe->run_tick = 0;
+   if (header->run_count > 0)
+   {
+      keyframe->run = header->run_count - 1;
+      keyframe->run_tick = instance->runs[header->run_count - 1].length;
+   }
+   if (false == sim_state_serialize(sim, keyframe->state))
+   {
+      printf("\nFailed to serialize replay keyframe at tick %u", header->tick_count);
+      return false;
+   }
+   ++header->keyframe_count;
+
+   // Success
+   return true;
+}
+
+bool replay_recorder_push(struct replay_recorder_s * instance, const struct sim_s * sim, sim_input_t input)
+{
+   if (NULL == instance) return false;
+
+   // Periodic snapshot of the state this input is applied to
+   struct replay_header_s * header = &instance->header;
+   if (sim && header->keyframe_interval > 0 && 0 == header->tick_count % header->keyframe_interval)
+   {
+      help_replay_recorder_push_keyframe(instance, sim);
+   }
+
+   // Extend current run while input is unchanged
+   if (header->run_count > 0)
+   {
+      struct replay_run_s * run_last = instance->runs + (header->run_count - 1);
+      if (run_last->input == input && run_last->length < REPLAY_RUN_LENGTH_MAX)
+      {
+         ++run_last->length;
+         ++header->tick_count;
+         return true;
+      }
+   }
+
+   // Grow run storage
+   if (header->run_count == instance->run_capacity)
+   {
+      const uint32_t CAPACITY_GROWN = instance->run_capacity * 2;
+      struct replay_run_s * runs_grown = realloc(instance->runs, sizeof(struct replay_run_s) * CAPACITY_GROWN);
+      if (NULL == runs_grown)
+      {
+         printf("\nFailed to grow replay recorder runs to %u", CAPACITY_GROWN);
+         return false;
+      }
+      instance->runs = runs_grown;
+      instance->run_capacity = CAPACITY_GROWN;
+   }
+
+   // Start new run
+   instance->runs[header->run_count].input = input;
+   instance->runs[header->run_count].length = 1;
+   ++header->run_count;
+   ++header->tick_count;
+
+   // Success
+   return true;
+}
+
+bool replay_recorder_write(struct replay_recorder_s * instance, const char * path, uint64_t final_state_hash)
+{
+   if (NULL == instance || NULL == path) return false;
+
+   FILE * file = fopen(path, "wb");
+   if (NULL == file)
+   {
+      printf("\nFailed to open replay file [%s] for writing", path);
+      return false;
+   }
+
+   // Keyframes follow the runs, aligned for in-place access
+   struct replay_header_s * header = &instance->header;
+   const uint32_t RUNS_END = header->runs_offset + (header->run_count * sizeof(struct replay_run_s));
+   const uint32_t PADDING = (REPLAY_KEYFRAME_ALIGNMENT - (RUNS_END % REPLAY_KEYFRAME_ALIGNMENT)) % REPLAY_KEYFRAME_ALIGNMENT;
+   const uint8_t PADDING_BYTES[8] = { 0 };
+   header->keyframes_offset = RUNS_END + PADDING;
+   header->final_state_hash = final_state_hash;
+
+   const bool SUCCESS_WRITE = (
+      fwrite(header, sizeof(*header), 1, file) == 1 &&
+      fwrite(instance->runs, sizeof(struct replay_run_s), header->run_count, file) == header->run_count &&
+      fwrite(PADDING_BYTES, 1, PADDING, file) == PADDING &&
+      fwrite(instance->keyframes, sizeof(struct replay_keyframe_s), header->keyframe_count, file) == header->keyframe_count
+   );
+   if (false == SUCCESS_WRITE)
+   {
+      printf("\nFailed to write replay file [%s]", path);
+   }
+
+   fclose(file);
+   return SUCCESS_WRITE;
+}
+
+// Replay - Playback
+bool help_replay_bind(struct replay_s * instance)
+{
+   if (NULL == instance || NULL == instance->data) return false;
+
+   // Header
+   if (instance->size < sizeof(struct replay_header_s))
+   {
+      printf("\nReplay too small to contain a header");
+      return false;
+   }
+   const struct replay_header_s * HEADER = instance->data;
+   if (memcmp(HEADER->magic, REPLAY_MAGIC, sizeof(HEADER->magic)) != 0)
+   {
+      printf("\nReplay magic mismatch");
+      return false;
+   }
+   if (HEADER->version < REPLAY_VERSION_MIN || HEADER->version > REPLAY_VERSION || sizeof(struct replay_header_s) != HEADER->header_size)
+   {
+      printf("\nReplay version %u not supported", (unsigned)HEADER->version);
+      return false;
+   }
+
+   // Runs in bounds and aligned
+   const uint64_t RUNS_END = (uint64_t)HEADER->runs_offset + ((uint64_t)HEADER->run_count * sizeof(struct replay_run_s));
+   if (HEADER->runs_offset % sizeof(struct replay_run_s) != 0 || RUNS_END > instance->size)
+   {
+      printf("\nReplay runs out of bounds");
+      return false;
+   }
+
+   instance->header = HEADER;
+   instance->runs = (const struct replay_run_s *)((const uint8_t *)instance->data + HEADER->runs_offset);
+
+   // Keyframes only from builds with a matching simulation state version
+   instance->keyframes = NULL;
+   instance->keyframe_count = 0;
+   const uint64_t KEYFRAMES_END = (uint64_t)HEADER->keyframes_offset + ((uint64_t)HEADER->keyframe_count * sizeof(struct replay_keyframe_s));
+   if (HEADER->keyframe_count > 0)
+   {
+      const bool STATE_MATCHES = (
+         REPLAY_VERSION == HEADER->version &&
+         SIM_STATE_VERSION == HEADER->state_version &&
+         sizeof(struct replay_keyframe_s) == HEADER->keyframe_size
+      );
+      if (false == STATE_MATCHES || 0 == HEADER->keyframe_interval)
+      {
+         printf("\nReplay keyframes with state version %u are ignored", (unsigned)HEADER->state_version);
+      }
+      else if (HEADER->keyframes_offset % REPLAY_KEYFRAME_ALIGNMENT != 0 || KEYFRAMES_END > instance->size)
+      {
+         printf("\nReplay keyframes out of bounds");
+         return false;
+      }
+      else
+      {
+         instance->keyframes = (const struct replay_keyframe_s *)((const uint8_t *)instance->data + HEADER->keyframes_offset);
+         instance->keyframe_count = HEADER->keyframe_count;
+      }
+   }
+
+   // Success
+   return true;
+}
+
+struct replay_s * help_replay_make_empty(void)
+{
+   struct replay_s * instance = malloc(sizeof(struct replay_s));
+   if (NULL == instance)
+   {
+      printf("\nFailed to create replay instance");
+      return NULL;
+   }
+
+   instance->header = NULL;
+   instance->runs = NULL;
+   instance->keyframes = NULL;
+   instance->keyframe_count = 0;
+   instance->data = NULL;
+   instance->size = 0;
+   instance->mapped = false;
+
+   return instance;
+}
+
+struct replay_s * replay_open(const char * path)
+{
+   if (NULL == path) return NULL;
+
+   struct replay_s * instance = help_replay_make_empty();
+   if (NULL == instance) return NULL;
+
+#ifndef _WIN32
+   // Map file read-only, no parsing beyond header checks
+   const int FD = open(path, O_RDONLY);
+   if (FD < 0)
+   {
+      printf("\nFailed to open replay file [%s]", path);
+      return replay_destroy(instance);
+   }
+   struct stat file_stat;
+   if (fstat(FD, &file_stat) != 0 || file_stat.st_size <= 0)
+   {
+      printf("\nFailed to stat replay file [%s]", path);
+      close(FD);
+      return replay_destroy(instance);
+   }
+   void * mapping = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+   close(FD);
+   if (MAP_FAILED == mapping)
+   {
+      printf("\nFailed to map replay file [%s]", path);
+      return replay_destroy(instance);
+   }
+   instance->data = mapping;
+   instance->size = (size_t)file_stat.st_size;
+   instance->mapped = true;
+#else
+   // Map file read-only, the view keeps the mapping alive once both handles are closed
+   const HANDLE FILE_HANDLE = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+   if (INVALID_HANDLE_VALUE == FILE_HANDLE)
+   {
+      printf("\nFailed to open replay file [%s]", path);
+      return replay_destroy(instance);
+   }
+   LARGE_INTEGER file_size;
+   if (false == GetFileSizeEx(FILE_HANDLE, &file_size) || file_size.QuadPart <= 0)
+   {
+      printf("\nFailed to stat replay file [%s]", path);
+      CloseHandle(FILE_HANDLE);
+      return replay_destroy(instance);
+   }
+   const HANDLE MAPPING_HANDLE = CreateFileMappingA(FILE_HANDLE, NULL, PAGE_READONLY, 0, 0, NULL);
+   CloseHandle(FILE_HANDLE);
+   void * mapping = MAPPING_HANDLE ? MapViewOfFile(MAPPING_HANDLE, FILE_MAP_READ, 0, 0, 0) : NULL;
+   if (MAPPING_HANDLE)
+   {
+      CloseHandle(MAPPING_HANDLE);
+   }
+   if (NULL == mapping)
+   {
+      printf("\nFailed to map replay file [%s]", path);
+      return replay_destroy(instance);
+   }
+   instance->data = mapping;
+   instance->size = (size_t)file_size.QuadPart;
+   instance->mapped = true;
+#endif
+
+   if (false == help_replay_bind(instance))
+   {
+      printf("\nInvalid replay file [%s]", path);
+      return replay_destroy(instance);
+   }
+
+   // Success
+   return instance;
+}
+
+struct replay_s * replay_from_memory(const void * data, size_t size)
+{
+   if (NULL == data) return NULL;
+
+   struct replay_s * instance = help_replay_make_empty();
+   if (NULL == instance) return NULL;
+
+   // Borrowed, caller keeps data alive
+   instance->data = (void *)data;
+   instance->size = size;
+   if (false == help_replay_bind(instance))
+   {
+      return replay_destroy(instance);
+   }
+
+   // Success
+   return instance;
+}
+
+void * replay_destroy(struct replay_s * instance)
+{
+   if (instance)
+   {
+      if (instance->mapped)
+      {
+#ifdef _WIN32
+         UnmapViewOfFile(instance->data);
+#else
+         munmap(instance->data, instance->size);
+#endif
+      }
+   }
+
+   free(instance);
+
+   return NULL;
+}
+
+bool replay_sim_init(const struct replay_s * replay, struct sim_s * sim)
+{
+   if (NULL == replay || NULL == sim) return false;
+
+   return sim_init(sim, replay->header->seed, (enum tetro_randomizer_e)replay->header->randomizer);
+}
+
+struct replay_cursor_s replay_cursor_make(void)
+{
+   struct replay_cursor_s cursor;
+
+   cursor.run = 0;
+   cursor.run_tick = 0;
+   cursor.tick = 0;
+
+   return cursor;
+}
+
+bool replay_cursor_next(const struct replay_s * replay, struct replay_cursor_s * cursor, sim_input_t * out_input)
+{
+   if (NULL == replay || NULL == cursor || NULL == out_input) return false;
+
+   // Skip exhausted runs
+   while (cursor->run < replay->header->run_count && cursor->run_tick >= replay->runs[cursor->run].length)
+   {
+      ++cursor->run;
+      cursor->run_tick = 0;
+   }
+
+   // End of replay
+   if (cursor->run >= replay->header->run_count) return false;
+
+   *out_input = replay->runs[cursor->run].input;
+   ++cursor->run_tick;
+   ++cursor->tick;
+
+   // Success
+   return true;
+}
+
+bool replay_seek(const struct replay_s * replay, struct sim_s * sim, struct replay_cursor_s * cursor, uint32_t tick)
+{
+   if (NULL == replay || NULL == sim || NULL == cursor) return false;
+
+   // Clamp to replay
+   if (tick > replay->header->tick_count)
+   {
+      tick = replay->header->tick_count;
+   }
+
+   // Restore nearest keyframe at or before the tick, else start over
+   uint32_t i_keyframe = replay->keyframe_count;
+   if (replay->keyframe_count > 0)
+   {
+      i_keyframe = help_minmax_min_2i(tick / replay->header->keyframe_interval, replay->keyframe_count - 1);
+   }
+   const struct replay_keyframe_s * KEYFRAME = (i_keyframe < replay->keyframe_count) ? replay->keyframes + i_keyframe : NULL;
+   if (KEYFRAME && KEYFRAME->tick <= tick && sim_state_deserialize(sim, KEYFRAME->state))
+   {
+      cursor->run = KEYFRAME->run;
+      cursor->run_tick = KEYFRAME->run_tick;
+      cursor->tick = KEYFRAME->tick;
+   }
+   else
+   {
+      if (false == replay_sim_init(replay, sim)) return false;
+      *cursor = replay_cursor_make();
+   }
+
+   // Simulate the remaining ticks, at most one keyframe interval
+   sim_input_t input;
+   while (cursor->tick < tick && replay_cursor_next(replay, cursor, &input))
+   {
+      sim_step(sim, input, NULL);
+   }
+
+   // Success
+   return true;
+}
+
+bool replay_simulate_to_end(const struct replay_s * replay, struct sim_s * sim)
+{
+   if (false == replay_sim_init(replay, sim)) return false;
+
+   // Whole runs at a time, no events and no rendering
+   for (uint32_t i_run = 0; i_run < replay->header->run_count; ++i_run)
+   {
+      const struct replay_run_s RUN = replay->runs[i_run];
+      for (uint32_t i_tick = 0; i_tick < RUN.length; ++i_tick)
+      {
+         sim_step(sim, RUN.input, NULL);
+      }
+   }
+
+   // Success
+   return true;
+}
+
+bool replay_validate(const struct replay_s * replay)
+{
+   if (NULL == replay) return false;
+
+   struct sim_s sim;
+   if (false == replay_sim_init(replay, &sim)) return false;
+
+   // Re-simulate, checking every keyframe on the way
+   uint32_t i_keyframe = 0;
+   struct replay_cursor_s cursor = replay_cursor_make();
+   sim_input_t input;
+   for (;;)
+   {
+      if (i_keyframe < replay->keyframe_count && replay->keyframes[i_keyframe].tick == cursor.tick)
+      {
+         // Whole snapshot, not just the hashed gameplay fields
+         uint8_t state[SIM_STATE_SERIAL_SIZE];
+         sim_state_serialize(&sim, state);
+         if (memcmp(state, replay->keyframes[i_keyframe].state, SIM_STATE_SERIAL_SIZE) != 0)
+         {
+            printf("\nReplay keyframe at tick %u does not match simulation", cursor.tick);
+            return false;
+         }
+         ++i_keyframe;
+      }
+
+      if (false == replay_cursor_next(replay, &cursor, &input)) break;
+      sim_step(&sim, input, NULL);
+   }
+
+   return (
+      i_keyframe == replay->keyframe_count &&
+      sim_tick(&sim) == replay->header->tick_count &&
+      sim_state_hash(&sim) == replay->header->final_state_hash
+   );
+}
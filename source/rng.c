@@ -0,0 +1,51 @@
+#include <stddef.h>
+#include "rng.h"
+
+// Helpers - Random number generation
+static const uint64_t RNG_MULTIPLIER = 6364136223846793005ULL;
+
+bool rng_seed(struct rng_s * rng, uint64_t seed, uint64_t stream)
+{
+   if (NULL == rng) return false;
+
+   // Stream selects the increment which must be odd
+   rng->state = 0;
+   rng->increment = (stream << 1) | 1;
+   rng_next_u32(rng);
+   rng->state += seed;
+   rng_next_u32(rng);
+
+   // Success
+   return true;
+}
+
+uint32_t rng_next_u32(struct rng_s * rng)
+{
+   const uint64_t STATE_OLD = rng->state;
+   rng->state = STATE_OLD * RNG_MULTIPLIER + rng->increment;
+
+   // Output permutation
+   const uint32_t XOR_SHIFTED = (uint32_t)(((STATE_OLD >> 18) ^ STATE_OLD) >> 27);
+   const uint32_t ROTATION = (uint32_t)(STATE_OLD >> 59);
+   return (XOR_SHIFTED >> ROTATION) | (XOR_SHIFTED << ((0u - ROTATION) & 31));
+}
+
+uint32_t rng_next_below(struct rng_s * rng, uint32_t bound)
+{
+   if (bound <= 1) return 0;
+
+   // Unbiased range reduction - Multiply into 64 bits, reject the short tail
+   uint64_t product = (uint64_t)rng_next_u32(rng) * bound;
+   uint32_t low = (uint32_t)product;
+   if (low < bound)
+   {
+      const uint32_t THRESHOLD = (0u - bound) % bound;
+      while (low < THRESHOLD)
+      {
+         product = (uint64_t)rng_next_u32(rng) * bound;
+         low = (uint32_t)product;
+      }
+   }
+
+   return (uint32_t)(product >> 32);
+}
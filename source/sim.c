@@ -0,0 +1,1693 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+// Helpers - Tetro
+//
+// Every orientation of every tetro, indexed by type and clockwise quarter turns.
+// Per orientation the design mask and the cells swept when rotating
+// counter-clockwise (left) and clockwise (right) out of that orientation.
+// Cell (tx, ty) is bit (ty * TETRO_MAX_SIZE + tx), so every nibble is one tetro row.
+static const tetro_mask TETRO_MASKS[TETRO_TYPE_COUNT][TETRO_ROTATION_COUNT][TETRO_MASK_COUNT] = {
+   // I (size 4)
+   {
+      { 0x4444, 0x3B88, 0x88B3 },
+      { 0x00F0, 0xCC07, 0x330E },
+      { 0x2222, 0x11DC, 0xCD11 },
+      { 0x0F00, 0xE033, 0x70CC },
+   },
+   // Lr (size 3)
+   {
+      { 0x0223, 0x0154, 0x0550 },
+      { 0x0170, 0x0603, 0x0606 },
+      { 0x0622, 0x0154, 0x0055 },
+      { 0x0074, 0x0603, 0x0303 },
+   },
+   // L (size 3)
+   {
+      { 0x0226, 0x0550, 0x0451 },
+      { 0x0071, 0x0606, 0x0306 },
+      { 0x0322, 0x0055, 0x0451 },
+      { 0x0470, 0x0303, 0x0306 },
+   },
+   // S (size 3)
+   {
+      { 0x0063, 0x0604, 0x0114 },
+      { 0x0132, 0x0045, 0x0601 },
+      { 0x0630, 0x0103, 0x0144 },
+      { 0x0264, 0x0510, 0x0403 },
+   },
+   // Z (size 3)
+   {
+      { 0x0036, 0x0441, 0x0301 },
+      { 0x0231, 0x0106, 0x0540 },
+      { 0x0360, 0x0411, 0x0406 },
+      { 0x0462, 0x0304, 0x0015 },
+   },
+   // T (size 3)
+   {
+      { 0x0072, 0x0605, 0x0305 },
+      { 0x0232, 0x0145, 0x0541 },
+      { 0x0270, 0x0503, 0x0506 },
+      { 0x0262, 0x0514, 0x0415 },
+   },
+   // O (size 2)
+   {
+      { 0x0033, 0x0000, 0x0000 },
+      { 0x0033, 0x0000, 0x0000 },
+      { 0x0033, 0x0000, 0x0000 },
+      { 0x0033, 0x0000, 0x0000 },
+   },
+};
+
+static const int TETRO_SIZES[TETRO_TYPE_COUNT] = { 4, 3, 3, 3, 3, 3, 2 };
+
+int help_tetro_size(enum tetro_type_e type)
+{
+   if (type < 0 || type >= TETRO_TYPE_COUNT) return 0;
+
+   return TETRO_SIZES[type];
+}
+
+tetro_mask help_tetro_mask(enum tetro_type_e type, int rotation, enum tetro_mask_e which)
+{
+   if (type < 0 || type >= TETRO_TYPE_COUNT || which < 0 || which >= TETRO_MASK_COUNT) return 0;
+
+   return TETRO_MASKS[type][rotation & (TETRO_ROTATION_COUNT - 1)][which];
+}
+
+bool help_tetro_mask_cell(tetro_mask mask, int tx, int ty)
+{
+   if (tx < 0 || tx >= TETRO_MAX_SIZE || ty < 0 || ty >= TETRO_MAX_SIZE) return false;
+
+   return (mask & TETRO_MASK_BIT(tx, ty)) ? true : false;
+}
+
+tetro_mask help_tetro_world_mask(const struct tetro_world_s * tetro, enum tetro_mask_e which)
+{
+   if (NULL == tetro) return 0;
+
+   return help_tetro_mask(tetro->type, tetro->rotation, which);
+}
+
+struct tetro_world_s tetro_world_make(enum tetro_type_e type, int rotation, int tile_x, int tile_y)
+{
+   struct tetro_world_s tetro_world;
+
+   tetro_world.type = type;
+   tetro_world.rotation = rotation & (TETRO_ROTATION_COUNT - 1);
+   tetro_world.tile_pos = vec_2i_make_xy(tile_x, tile_y);
+
+   return tetro_world;
+}
+
+bool help_tetro_world_rotate_ccw(struct tetro_world_s * tetro)
+{
+   if (NULL == tetro) return false;
+
+   tetro->rotation = (tetro->rotation + TETRO_ROTATION_COUNT - 1) & (TETRO_ROTATION_COUNT - 1);
+
+   // Success
+   return true;
+}
+
+bool help_tetro_world_rotate_cw(struct tetro_world_s * tetro)
+{
+   if (NULL == tetro) return false;
+
+   tetro->rotation = (tetro->rotation + 1) & (TETRO_ROTATION_COUNT - 1);
+
+   // Success
+   return true;
+}
+
+struct tetro_world_s help_tetro_world_make_type_at_tile(enum tetro_type_e type, int tile_x, int tile_y)
+{
+   if (type < 0 || type >= TETRO_TYPE_COUNT)
+   {
+      printf("\nAttempting to spawn un-supported tetro type");
+      type = TETRO_TYPE_O;
+   }
+
+   return tetro_world_make(type, 0, tile_x, tile_y);
+}
+
+// Helpers - Input
+bool help_input_init(struct input_s * instance)
+{
+   if (NULL == instance) return false;
+
+   // Initialize custom key states
+   for (int custom_key = 0; custom_key < CUSTOM_KEY_COUNT; ++custom_key)
+   {
+      instance->key_states[custom_key] = KEY_STATE_NONE;
+   }
+
+   // Success
+   return true;
+}
+
+enum key_state_e help_input_determine_key_state(enum key_state_e current_state, bool currently_pressed)
+{
+   switch (current_state)
+   {
+      case KEY_STATE_NONE:
+         return currently_pressed ? KEY_STATE_PRESSED : KEY_STATE_NONE;
+         break;
+      case KEY_STATE_PRESSED:
+         return currently_pressed ? KEY_STATE_HELD : KEY_STATE_RELEASED;
+         break;
+      case KEY_STATE_HELD:
+         return currently_pressed ? KEY_STATE_HELD : KEY_STATE_RELEASED;
+         break;
+      case KEY_STATE_RELEASED:
+         return currently_pressed ? KEY_STATE_PRESSED : KEY_STATE_NONE;
+         break;
+   }
+}
+
+bool help_input_determine_intermediate_state(struct input_s * instance, sim_input_t keys_down)
+{
+   if (NULL == instance) return false;
+
+   for (int custom_key = 0; custom_key < CUSTOM_KEY_COUNT; ++custom_key)
+   {
+      const bool KEY_DOWN = (keys_down & SIM_INPUT_KEY(custom_key)) ? true : false;
+      instance->key_states[custom_key] = help_input_determine_key_state(instance->key_states[custom_key], KEY_DOWN);
+   }
+
+   // Success
+   return true;
+}
+
+bool help_input_key_in_state(const struct input_s * input, enum custom_key_e key, enum key_state_e state)
+{
+   if (NULL == input) return false;
+
+   return input->key_states[key] == state;
+}
+
+bool help_input_key_none(const struct input_s * input, enum custom_key_e key)
+{
+   return help_input_key_in_state(input, key, KEY_STATE_NONE);
+}
+
+bool help_input_key_pressed(const struct input_s * input, enum custom_key_e key)
+{
+   return help_input_key_in_state(input, key, KEY_STATE_PRESSED);
+}
+
+bool help_input_key_held(const struct input_s * input, enum custom_key_e key)
+{
+   return help_input_key_in_state(input, key, KEY_STATE_HELD);
+}
+
+bool help_input_key_released(const struct input_s * input, enum custom_key_e key)
+{
+   return help_input_key_in_state(input, key, KEY_STATE_RELEASED);
+}
+
+bool help_input_key_pressed_or_held(const struct input_s * input, enum custom_key_e key)
+{
+   return (
+      help_input_key_in_state(input, key, KEY_STATE_PRESSED) ||
+      help_input_key_in_state(input, key, KEY_STATE_HELD)
+   );
+}
+
+bool help_input_any_key_pressed(const struct input_s * input)
+{
+   if (NULL == input) return false;
+
+   for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
+   {
+      if (help_input_key_pressed(input, key))
+      {
+         // At least one of the keys was pressed
+         return true;
+      }
+   }
+
+   // No key was pressed
+   return false;
+}
+
+// Helpers - Play field
+struct play_field_cell_s help_play_field_cell_make(enum tetro_type_e type, bool occupied)
+{
+   struct play_field_cell_s cell;
+
+   cell.type = type;
+   cell.occupied = occupied;
+
+   return cell;
+}
+
+struct play_field_cell_s help_play_field_cell_make_non_occupied(void)
+{
+   return help_play_field_cell_make(TETRO_TYPE_O, false);
+}
+
+struct play_field_s help_play_field_make_non_occupied(void)
+{
+   struct play_field_s fresh_play_field;
+
+   // Nothing occupied, type plane is ignored for non-occupied cells
+   memset(&fresh_play_field, 0, sizeof(fresh_play_field));
+
+   // Success
+   return fresh_play_field;
+}
+
+bool help_play_field_coords_out_of_bounds(const struct play_field_s * play_field, int x, int y)
+{
+   if (NULL == play_field) return true;
+
+   return help_bounds_out_of_region(0, 0, PLAY_FIELD_WIDTH, PLAY_FIELD_HEIGHT, x, y);
+}
+
+bool help_play_field_cell_occupied(const struct play_field_s * play_field, int x, int y)
+{
+   if (help_play_field_coords_out_of_bounds(play_field, x, y)) return false;
+
+   return (play_field->rows[y] & PLAY_FIELD_COLUMN_BIT(x)) ? true : false;
+}
+
+enum tetro_type_e help_play_field_cell_type(const struct play_field_s * play_field, int x, int y)
+{
+   if (help_play_field_coords_out_of_bounds(play_field, x, y)) return TETRO_TYPE_O;
+
+   return (enum tetro_type_e)((play_field->types[y] >> (x * PLAY_FIELD_TYPE_BITS)) & PLAY_FIELD_TYPE_MASK);
+}
+
+bool help_play_field_set_cell(struct play_field_s * play_field, int x, int y, struct play_field_cell_s new_cell)
+{
+   if (help_play_field_coords_out_of_bounds(play_field, x, y)) return false;
+
+   // Occupancy plane
+   if (new_cell.occupied)
+   {
+      play_field->rows[y] |= PLAY_FIELD_COLUMN_BIT(x);
+   }
+   else
+   {
+      play_field->rows[y] &= (play_field_row_t)~PLAY_FIELD_COLUMN_BIT(x);
+   }
+
+   // Type plane
+   const int TYPE_SHIFT = x * PLAY_FIELD_TYPE_BITS;
+   play_field->types[y] &= ~((uint32_t)PLAY_FIELD_TYPE_MASK << TYPE_SHIFT);
+   play_field->types[y] |= ((uint32_t)new_cell.type & PLAY_FIELD_TYPE_MASK) << TYPE_SHIFT;
+
+   return true;
+}
+
+bool help_play_field_access_cell(const struct play_field_s * play_field, int x, int y, struct play_field_cell_s * out_cell)
+{
+   if (NULL == play_field || NULL == out_cell || help_play_field_coords_out_of_bounds(play_field, x, y)) return false;
+
+   *out_cell = help_play_field_cell_make(
+      help_play_field_cell_type(play_field, x, y),
+      help_play_field_cell_occupied(play_field, x, y)
+   );
+
+   return true;
+}
+
+bool help_play_field_clear_row(struct play_field_s * play_field, int row)
+{
+   if (NULL == play_field || row < 0 || row >= PLAY_FIELD_HEIGHT) return false;
+
+   play_field->rows[row] = 0;
+   play_field->types[row] = 0;
+
+   return true;
+}
+
+bool help_play_field_clear(struct play_field_s * play_field)
+{
+   if (NULL == play_field) return false;
+
+   *play_field = help_play_field_make_non_occupied();
+
+   return true;
+}
+
+bool help_play_field_row_empty(const struct play_field_s * play_field, int row)
+{
+   if (
+      NULL == play_field ||
+      row < 0 ||
+      row >= PLAY_FIELD_HEIGHT
+   ) return true;
+
+   return (0 == play_field->rows[row]);
+}
+
+bool help_play_field_row_full(const struct play_field_s * play_field, int row)
+{
+   if (
+      NULL == play_field ||
+      row < 0 ||
+      row >= PLAY_FIELD_HEIGHT
+   ) return false;
+
+   return (PLAY_FIELD_ROW_FULL == play_field->rows[row]);
+}
+
+bool help_play_field_row_mask_collides(const struct play_field_s * play_field, int row, int x, play_field_row_t row_mask)
+{
+   if (NULL == play_field) return true;
+
+   // Nothing to collide with
+   if (0 == row_mask) return false;
+
+   // Out-of play field bounds is considered a collision
+   if (row < 0 || row >= PLAY_FIELD_HEIGHT) return true;
+
+   // Shift mask to column, cells shifted past either wall collide
+   uint32_t shifted_mask;
+   if (x >= 0)
+   {
+      if (x >= PLAY_FIELD_WIDTH) return true;
+      shifted_mask = (uint32_t)row_mask << x;
+   }
+   else
+   {
+      if (-x >= TETRO_MAX_SIZE || (row_mask & ((1u << -x) - 1))) return true;
+      shifted_mask = (uint32_t)row_mask >> -x;
+   }
+   if (shifted_mask & ~(uint32_t)PLAY_FIELD_ROW_FULL) return true;
+
+   // Overlapping occupied play field cell is considered a collision
+   return (shifted_mask & play_field->rows[row]) ? true : false;
+}
+
+bool help_play_field_consolidate(struct play_field_s * play_field)
+{
+   if (NULL == play_field) return false;
+
+   // Compact non-empty rows downwards
+   int row_new = 0;
+   for (int row_old = 0; row_old < PLAY_FIELD_HEIGHT; ++row_old)
+   {
+      // Ignore empty rows
+      if (0 == play_field->rows[row_old])
+      {
+         continue;
+      }
+
+      play_field->rows[row_new] = play_field->rows[row_old];
+      play_field->types[row_new] = play_field->types[row_old];
+      ++row_new;
+   }
+
+   // Vacate rows above the compacted ones
+   for (; row_new < PLAY_FIELD_HEIGHT; ++row_new)
+   {
+      play_field->rows[row_new] = 0;
+      play_field->types[row_new] = 0;
+   }
+
+   // Success
+   return true;
+}
+
+// Helpers - Tetro spawning
+static const uint64_t TETRO_RANDOMIZER_STREAM = 0x7E7215ULL;
+
+bool help_tetro_randomizer_refill_bag(struct tetro_randomizer_s * randomizer)
+{
+   if (NULL == randomizer) return false;
+
+   // Fisher-Yates shuffle of all tetro types
+   for (int i_type = 0; i_type < TETRO_TYPE_COUNT; ++i_type)
+   {
+      randomizer->bag[i_type] = (uint8_t)i_type;
+   }
+   for (int i_type = TETRO_TYPE_COUNT - 1; i_type > 0; --i_type)
+   {
+      const int I_SWAP = (int)rng_next_below(&randomizer->rng, (uint32_t)i_type + 1);
+      const uint8_t TEMP = randomizer->bag[i_type];
+      randomizer->bag[i_type] = randomizer->bag[I_SWAP];
+      randomizer->bag[I_SWAP] = TEMP;
+   }
+   randomizer->bag_remaining = TETRO_TYPE_COUNT;
+
+   // Success
+   return true;
+}
+
+bool help_tetro_randomizer_init(struct tetro_randomizer_s * randomizer, uint64_t seed, enum tetro_randomizer_e policy)
+{
+   if (NULL == randomizer) return false;
+
+   rng_seed(&randomizer->rng, seed, TETRO_RANDOMIZER_STREAM);
+   randomizer->policy = policy;
+   randomizer->bag_remaining = 0;
+
+   // Success
+   return true;
+}
+
+struct tetro_spawn_s help_tetro_randomizer_next(struct tetro_randomizer_s * randomizer)
+{
+   struct tetro_spawn_s spawn;
+
+   // Type by policy
+   if (TETRO_RANDOMIZER_BAG_7 == randomizer->policy)
+   {
+      if (0 == randomizer->bag_remaining)
+      {
+         help_tetro_randomizer_refill_bag(randomizer);
+      }
+      spawn.type = randomizer->bag[--randomizer->bag_remaining];
+   }
+   else
+   {
+      spawn.type = (uint8_t)rng_next_below(&randomizer->rng, TETRO_TYPE_COUNT);
+   }
+
+   // Uniform spawn orientation
+   spawn.rotation = (uint8_t)rng_next_below(&randomizer->rng, TETRO_ROTATION_COUNT);
+
+   return spawn;
+}
+
+int help_tetro_randomizer_fill(struct tetro_randomizer_s * randomizer, struct tetro_spawn_s * out_spawns, int count)
+{
+   if (NULL == randomizer || NULL == out_spawns) return 0;
+
+   for (int i_spawn = 0; i_spawn < count; ++i_spawn)
+   {
+      out_spawns[i_spawn] = help_tetro_randomizer_next(randomizer);
+   }
+
+   return count;
+}
+
+struct tetro_world_s help_tetro_world_make_at_spawn(struct tetro_spawn_s spawn)
+{
+   // Position to spawn based on tetro size
+   const int TETRO_SIZE = help_tetro_size(spawn.type);
+   return tetro_world_make(
+      spawn.type,
+      spawn.rotation,
+      ((PLAY_FIELD_WIDTH - 1) / 2) - (TETRO_SIZE / 2) + 1,
+      (PLAY_FIELD_HEIGHT - 1) - (TETRO_SIZE - 1)
+   );
+}
+
+struct tetro_world_s help_tetro_world_make_random_at_spawn(struct tetro_randomizer_s * randomizer)
+{
+   return help_tetro_world_make_at_spawn(help_tetro_randomizer_next(randomizer));
+}
+
+struct tetro_world_s help_tetro_world_clone_at_position(const struct tetro_world_s * tetro, int x, int y)
+{
+   struct tetro_world_s clone = *tetro;
+
+   clone.tile_pos.x = x;
+   clone.tile_pos.y = y;
+
+   return clone;
+}
+
+// Helpers - Tetro gameplay
+play_field_row_t help_tetro_mask_row(tetro_mask mask, int ty)
+{
+   return (play_field_row_t)((mask >> (ty * TETRO_MAX_SIZE)) & ((1u << TETRO_MAX_SIZE) - 1));
+}
+
+bool help_tetro_mask_collides(tetro_mask mask, const struct play_field_s * play_field, int tile_x, int tile_y)
+{
+   // Does any tetro mask row overlap occupied play field cells ?
+   for (int ty = 0; ty < TETRO_MAX_SIZE; ++ty)
+   {
+      if (help_play_field_row_mask_collides(play_field, tile_y + ty, tile_x, help_tetro_mask_row(mask, ty)))
+      {
+         return true;
+      }
+   }
+
+   // No collision detected
+   return false;
+}
+
+bool help_tetro_move_collides(const struct tetro_world_s * TETRO, const struct play_field_s * play_field, int dx, int dy)
+{
+   if (NULL == TETRO || NULL == play_field) return true;
+
+   return help_tetro_mask_collides(help_tetro_world_mask(TETRO, TETRO_MASK_DESIGN), play_field, TETRO->tile_pos.x + dx, TETRO->tile_pos.y + dy);
+}
+
+bool help_tetro_rotation_collides(const struct tetro_world_s * TETRO, const struct play_field_s * play_field, enum rotation_e rotation)
+{
+   if (NULL == TETRO || NULL == play_field) return true;
+
+   return help_tetro_mask_collides(
+      help_tetro_world_mask(TETRO, (ROTATION_CW == rotation) ? TETRO_MASK_RIGHT : TETRO_MASK_LEFT),
+      play_field,
+      TETRO->tile_pos.x,
+      TETRO->tile_pos.y
+   );
+}
+
+bool help_tetro_drop(const struct tetro_world_s * TETRO, struct play_field_s * play_field, int * out_plot_row_min, int * out_plot_row_max)
+{
+   if (NULL == TETRO || NULL == play_field || NULL == out_plot_row_min || NULL == out_plot_row_max) return false;
+
+   // Keep track of play field region plotted for line deletion
+   int plot_row_min = 0;
+   int plot_row_max = PLAY_FIELD_HEIGHT - 1;
+
+   // Plotting
+   const int TETRO_SIZE = help_tetro_size(TETRO->type);
+   const tetro_mask DESIGN = help_tetro_world_mask(TETRO, TETRO_MASK_DESIGN);
+   for (int ty = 0; ty < TETRO_SIZE; ++ty)
+   {
+      for (int tx = 0; tx < TETRO_SIZE; ++tx)
+      {
+         // Ignore non-plotted design cells
+         const bool DESIGN_CELL_PLOTTED = help_tetro_mask_cell(DESIGN, tx, ty);
+         if (false == DESIGN_CELL_PLOTTED)
+         {
+            continue;
+         }
+
+         // Ignore cells out of play field
+         const struct vec_2i_s TETRO_TILE_CELL_POS = vec_2i_make_xy(TETRO->tile_pos.x + tx, TETRO->tile_pos.y + ty);
+         const bool DESIGN_CELL_OUT_OF_PLAY_FIELD_BOUNDS = help_play_field_coords_out_of_bounds(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y);
+         if (DESIGN_CELL_OUT_OF_PLAY_FIELD_BOUNDS)
+         {
+            continue;
+         }
+
+         // Overlapping occupied play field cell is considered a collision
+         const bool PLAY_FIELD_CELL_OCCUPIED = help_play_field_cell_occupied(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y);
+         if (PLAY_FIELD_CELL_OCCUPIED)
+         {
+            // This should never happen
+            printf("\nPlotting on occupied play field cell!");
+            continue;
+         }
+
+         // Plot design cell into the play field
+         help_play_field_set_cell(play_field, TETRO_TILE_CELL_POS.x, TETRO_TILE_CELL_POS.y, help_play_field_cell_make(TETRO->type, true));
+
+         // Keep track of plotted row range
+         if (TETRO_TILE_CELL_POS.y < plot_row_max)
+         {
+            plot_row_max = TETRO_TILE_CELL_POS.y;
+         }
+         if (TETRO_TILE_CELL_POS.y > plot_row_min)
+         {
+            plot_row_min = TETRO_TILE_CELL_POS.y;
+         }
+      }
+   }
+
+   // Communicate plot region
+   *out_plot_row_min = plot_row_max;
+   *out_plot_row_max = plot_row_min;
+
+   // Success
+   return true;
+}
+
+// Helpers - Lists
+struct list_of_rows_s list_of_rows_make_empty(void)
+{
+   struct list_of_rows_s lor;
+
+   lor.count = 0;
+
+   return lor;
+}
+
+bool list_of_rows_append(struct list_of_rows_s * lor, int row)
+{
+   if (NULL == lor || lor->count >= PLAY_FIELD_HEIGHT) return false;
+
+   lor->list[lor->count++] = row;
+
+   return true;
+}
+
+// Helpers - Line deletion
+struct list_of_rows_s help_play_field_list_of_full_rows(const struct play_field_s * play_field)
+{
+   struct list_of_rows_s lor = list_of_rows_make_empty();
+   if (NULL == play_field) return lor;
+
+   for (int row = 0; row < PLAY_FIELD_HEIGHT; ++row)
+   {
+      if (help_play_field_row_full(play_field, row))
+      {
+         const bool ROW_ADDED = list_of_rows_append(&lor, row);
+         if (false == ROW_ADDED)
+         {
+            // This should never occur
+            printf("\nFull play field row %d could not be added to full list of rows !", row);
+         }
+      }
+   }
+
+   return lor;
+}
+
+// Helpers - Levels
+struct score_level_mapping_s {
+   int threshold_score;
+   int mapped_level;
+};
+
+static const struct score_level_mapping_s SCORE_LEVEL_MAPPING[] = {
+   { 0, 0 },
+   { 20, 1 },
+   { 40, 2 },
+   { 60, 3 },
+   { 80, 4 },
+   { 100, 5 },
+   { 120, 6 },
+   { 140, 7 },
+   { 160, 8 },
+   { 180, 9 }
+};
+
+int help_level_for_score(int score)
+{
+   const struct score_level_mapping_s * ACTIVE_SCORE_MAPPING = NULL;
+   for (size_t i = 0; i < (sizeof(SCORE_LEVEL_MAPPING) / sizeof(SCORE_LEVEL_MAPPING[0])); ++i)
+   {
+      const struct score_level_mapping_s * SCORE_MAPPING_CANDIDATE = SCORE_LEVEL_MAPPING + i;
+      if (score >= SCORE_MAPPING_CANDIDATE->threshold_score)
+      {
+         ACTIVE_SCORE_MAPPING = SCORE_MAPPING_CANDIDATE;
+      }
+   }
+
+   // Set level based on found mapping
+   return ACTIVE_SCORE_MAPPING ? ACTIVE_SCORE_MAPPING->mapped_level : -1;
+}
+
+// Simulation - Timers shared between stepping and idle prediction
+#define SIM_TICKS_SPLASH_CONTINUE SIM_TICKS_FROM_MS(6000)
+#define SIM_TICKS_QUIT SIM_TICKS_FROM_MS(3000)
+
+// Simulation - Events
+bool sim_events_clear(struct sim_events_s * events)
+{
+   if (NULL == events) return false;
+
+   events->count = 0;
+
+   return true;
+}
+
+bool sim_events_push(struct sim_events_s * events, enum sim_event_type_e type, int value, bool loop)
+{
+   if (NULL == events || events->count >= SIM_MAX_EVENTS_PER_TICK) return false;
+
+   struct sim_event_s * event = events->list + events->count++;
+   event->type = type;
+   event->value = value;
+   event->loop = loop;
+
+   return true;
+}
+
+bool sim_events_push_sfx(struct sim_events_s * events, enum sim_sfx_e sfx)
+{
+   return sim_events_push(events, SIM_EVENT_SFX, sfx, false);
+}
+
+bool sim_events_push_music(struct sim_events_s * events, enum sim_music_e music, bool loop)
+{
+   return sim_events_push(events, SIM_EVENT_MUSIC_PLAY, music, loop);
+}
+
+bool sim_events_push_type(struct sim_events_s * events, enum sim_event_type_e type)
+{
+   return sim_events_push(events, type, 0, false);
+}
+
+// Simulation - API
+bool sim_init(struct sim_s * instance, uint32_t seed, enum tetro_randomizer_e randomizer)
+{
+   if (NULL == instance) return false;
+
+   // Input
+   help_input_init(&instance->input);
+   for (int keybr = 0; keybr < CUSTOM_KEY_COUNT; ++keybr)
+   {
+      instance->keybr_key_confirmed[keybr] = false;
+   }
+
+   // Game state transitions
+   instance->game_state = GAME_STATE_SPLASH;
+   instance->next_game_state = GAME_STATE_NONE;
+   instance->init_splash = true;
+   instance->close_requested = false;
+
+   // Play field and tetros
+   instance->play_field = help_play_field_make_non_occupied();
+   help_tetro_randomizer_init(&instance->tetro_randomizer, seed, randomizer);
+   instance->tetro_active = help_tetro_world_make_random_at_spawn(&instance->tetro_randomizer);
+   instance->tetro_next = help_tetro_world_make_random_at_spawn(&instance->tetro_randomizer);
+
+   // Play field row highlighting and removal
+   instance->plot_row_min = 0;
+   instance->plot_row_max = 0;
+   instance->list_of_full_rows = list_of_rows_make_empty();
+
+   // Game over transition
+   instance->game_over_transition_field_lines_filled = 0;
+   instance->game_over_transition_field_lines_cleared = 0;
+
+   // Game type and music config
+   instance->configured_game_music = SIM_MUSIC_GAME_A_TYPE;
+   instance->game_music_cursor = vec_2i_make_xy(0, 0);
+
+   // Stats
+   instance->stats.score = 0;
+   instance->stats.lines = 0;
+   instance->stats.level = 0;
+
+   // Timers
+   instance->tick = 0;
+   instance->tick_splash_start = 0;
+   instance->tick_last_tetro_drop = 0;
+   instance->tick_last_tetro_player_move = 0;
+   instance->tick_last_tetro_player_drop = 0;
+   instance->tick_last_row_deletion_timer = 0;
+   instance->tick_last_game_over_transition_row = 0;
+   instance->tick_last_quit = 0;
+   instance->tick_until_show_volume_overlay = 0;
+
+   // Success
+   return true;
+}
+
+bool sim_step(struct sim_s * instance, sim_input_t keys_down, struct sim_events_s * out_events)
+{
+   if (NULL == instance) return false;
+
+   // Events are optional for hosts that do not present anything
+   struct sim_events_s discarded_events;
+   struct sim_events_s * events = out_events ? out_events : &discarded_events;
+   sim_events_clear(events);
+
+   // Update input state
+   struct input_s * input = &instance->input;
+   help_input_determine_intermediate_state(input, keys_down);
+
+   // Tick housekeeping
+   ++instance->tick;
+   const uint32_t NOW = instance->tick;
+
+   // Tick based on game state
+   const enum game_state_e game_state = instance->game_state;
+   if (GAME_STATE_INPUT_MAPPING != game_state)
+   {
+      // Volume adjustable at any time out of the input mapping screen
+      const uint32_t TICKS_VOLUME_OVERLAY_SHOW = SIM_TICKS_FROM_MS(1000);
+      if (help_input_key_pressed(input, CUSTOM_KEY_VOLUME_UP))
+      {
+         sim_events_push(events, SIM_EVENT_VOLUME_ADJUST, 1, false);
+         sim_events_push_sfx(events, SIM_SFX_INCREASE);
+         instance->tick_until_show_volume_overlay = NOW + TICKS_VOLUME_OVERLAY_SHOW;
+      }
+      if (help_input_key_pressed(input, CUSTOM_KEY_VOLUME_DOWN))
+      {
+         sim_events_push(events, SIM_EVENT_VOLUME_ADJUST, -1, false);
+         sim_events_push_sfx(events, SIM_SFX_DECREASE);
+         instance->tick_until_show_volume_overlay = NOW + TICKS_VOLUME_OVERLAY_SHOW;
+      }
+   }
+   if (GAME_STATE_SPLASH == game_state)
+   {
+      // SFX
+      if (instance->init_splash)
+      {
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+         sim_events_push_sfx(events, SIM_SFX_SPLASH);
+         instance->init_splash = false;
+      }
+
+      // Wait until game start or press button
+      const uint32_t TICKS_CONTINUE = SIM_TICKS_SPLASH_CONTINUE;
+      const bool CONTINUE_TIME_PASSED = (NOW - instance->tick_splash_start >= TICKS_CONTINUE);
+
+      if (CONTINUE_TIME_PASSED || help_input_key_pressed(input, CUSTOM_KEY_START))
+      {
+         // Show and check game controls
+         instance->next_game_state = GAME_STATE_INPUT_MAPPING;
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+      }
+   }
+   if (GAME_STATE_INPUT_MAPPING == game_state)
+   {
+      // Confirm input mapping
+      for (int keybr = 0; keybr < CUSTOM_KEY_COUNT; ++keybr)
+      {
+         if (false == instance->keybr_key_confirmed[keybr] && help_input_key_pressed(input, keybr))
+         {
+            instance->keybr_key_confirmed[keybr] = true;
+            sim_events_push_sfx(events, SIM_SFX_BLIP);
+         }
+      }
+
+      bool all_mapped_controls_confirmed = true;
+      for (int keybr = 0; keybr < CUSTOM_KEY_COUNT; ++keybr)
+      {
+         if (false == instance->keybr_key_confirmed[keybr])
+         {
+            all_mapped_controls_confirmed = false;
+            break;
+         }
+      }
+      if (all_mapped_controls_confirmed)
+      {
+         // Go to title screen
+         instance->next_game_state = GAME_STATE_TITLE;
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+         sim_events_push_music(events, SIM_MUSIC_TITLE, true);
+      }
+   }
+   if (GAME_STATE_TITLE == game_state)
+   {
+      // Player count select
+      if (help_input_key_pressed(input, CUSTOM_KEY_LEFT) || help_input_key_pressed(input, CUSTOM_KEY_RIGHT))
+      {
+         // @Note: Grey out 2 player mode as it's currently not supported
+         sim_events_push_sfx(events, SIM_SFX_INVALID);
+      }
+
+      // Start game (for now in single player more)
+      if (help_input_key_pressed(input, CUSTOM_KEY_START))
+      {
+         // Stop title music
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+         // Play selection to config screen
+         sim_events_push_sfx(events, SIM_SFX_SELECT);
+         // Init config screen state
+         instance->next_game_state = GAME_STATE_GAME_MUSIC_CONFIG;
+         // Config music off
+         instance->configured_game_music = SIM_MUSIC_NONE;
+         instance->game_music_cursor = vec_2i_make_xy(1, 0);
+      }
+
+      // Quit game
+      if (help_input_key_pressed(input, CUSTOM_KEY_SELECT))
+      {
+         instance->next_game_state = GAME_STATE_QUIT;
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+         sim_events_push_sfx(events, SIM_SFX_SELECT);
+         instance->tick_last_quit = NOW;
+      }
+   }
+   if (GAME_STATE_QUIT == game_state)
+   {
+      // Quit game after timer runs out
+      const uint32_t TICKS_QUIT = SIM_TICKS_QUIT;
+      if (NOW - instance->tick_last_quit > TICKS_QUIT && false == instance->close_requested)
+      {
+         instance->close_requested = true;
+         sim_events_push_type(events, SIM_EVENT_QUIT);
+      }
+   }
+   if (GAME_STATE_GAME_MUSIC_CONFIG == game_state)
+   {
+      // Move music type cursor
+      const int GAME_MUSIC_TYPE_WIDTH = 2;
+      const int GAME_MUSIC_TYPE_HEIGHT = 2;
+      struct vec_2i_s * game_music_cursor = &instance->game_music_cursor;
+      bool music_type_changed = false;
+      if (help_input_key_pressed(input, CUSTOM_KEY_UP))
+      {
+         const int NEW_GAME_CURSOR_Y = help_limit_clamp_i(0, game_music_cursor->y + 1, GAME_MUSIC_TYPE_HEIGHT - 1);
+         if (NEW_GAME_CURSOR_Y != game_music_cursor->y) music_type_changed = true;
+         game_music_cursor->y = NEW_GAME_CURSOR_Y;
+      }
+      if (help_input_key_pressed(input, CUSTOM_KEY_DOWN))
+      {
+         const int NEW_GAME_CURSOR_Y = help_limit_clamp_i(0, game_music_cursor->y - 1, GAME_MUSIC_TYPE_HEIGHT - 1);
+         if (NEW_GAME_CURSOR_Y != game_music_cursor->y) music_type_changed = true;
+         game_music_cursor->y = NEW_GAME_CURSOR_Y;
+      }
+      if (help_input_key_pressed(input, CUSTOM_KEY_LEFT))
+      {
+         const int NEW_GAME_CURSOR_X = help_limit_clamp_i(0, game_music_cursor->x - 1, GAME_MUSIC_TYPE_WIDTH - 1);
+         if (NEW_GAME_CURSOR_X != game_music_cursor->x) music_type_changed = true;
+         game_music_cursor->x = NEW_GAME_CURSOR_X;
+      }
+      if (help_input_key_pressed(input, CUSTOM_KEY_RIGHT))
+      {
+         const int NEW_GAME_CURSOR_X = help_limit_clamp_i(0, game_music_cursor->x + 1, GAME_MUSIC_TYPE_WIDTH - 1);
+         if (NEW_GAME_CURSOR_X != game_music_cursor->x) music_type_changed = true;
+         game_music_cursor->x = NEW_GAME_CURSOR_X;
+      }
+
+      // Select music type if selection changed
+      if (music_type_changed)
+      {
+         enum sim_music_e selected_music = SIM_MUSIC_NONE;
+         if (vec_2i_equals_xy(*game_music_cursor, 0, 1)) selected_music = SIM_MUSIC_GAME_A_TYPE;
+         if (vec_2i_equals_xy(*game_music_cursor, 1, 1)) selected_music = SIM_MUSIC_GAME_B_TYPE;
+         if (vec_2i_equals_xy(*game_music_cursor, 0, 0)) selected_music = SIM_MUSIC_GAME_C_TYPE;
+
+         sim_events_push_type(events, SIM_EVENT_MUSIC_STOP);
+         if (SIM_MUSIC_NONE != selected_music)
+         {
+            sim_events_push_music(events, selected_music, true);
+         }
+         instance->configured_game_music = selected_music;
+      }
+
+      // Start game with selected music
+      if (help_input_key_pressed(input, CUSTOM_KEY_START))
+      {
+         instance->next_game_state = GAME_STATE_NEW_GAME;
+      }
+   }
+   if (GAME_STATE_NEW_GAME == game_state)
+   {
+      // Reset stats
+      instance->stats.score = 0;
+      instance->stats.lines = 0;
+      instance->stats.level = 0;
+
+      // Kickstart next tetro
+      instance->tetro_next = help_tetro_world_make_random_at_spawn(&instance->tetro_randomizer);
+
+      // Action - New game
+      instance->play_field = help_play_field_make_non_occupied();
+      instance->tetro_active = help_tetro_world_make_random_at_spawn(&instance->tetro_randomizer);
+      sim_events_push_type(events, SIM_EVENT_TETRO_SPAWNED);
+
+      // Start gameplay
+      instance->next_game_state = GAME_STATE_CONTROL;
+      instance->tick_last_tetro_drop = NOW;
+   }
+   else if (GAME_STATE_CONTROL == game_state)
+   {
+      struct tetro_world_s * tetro_active = &instance->tetro_active;
+      struct play_field_s * play_field = &instance->play_field;
+
+      // Action - Rotate tetro
+      if (help_input_key_pressed(input, CUSTOM_KEY_A))
+      {
+         if (!help_tetro_rotation_collides(tetro_active, play_field, ROTATION_CW))
+         {
+            help_tetro_world_rotate_cw(tetro_active);
+            sim_events_push_sfx(events, SIM_SFX_ROTATE);
+            sim_events_push_type(events, SIM_EVENT_TETRO_MOVED);
+         }
+      }
+      if (help_input_key_pressed(input, CUSTOM_KEY_B))
+      {
+         if (!help_tetro_rotation_collides(tetro_active, play_field, ROTATION_CCW))
+         {
+            help_tetro_world_rotate_ccw(tetro_active);
+            sim_events_push_sfx(events, SIM_SFX_ROTATE);
+            sim_events_push_type(events, SIM_EVENT_TETRO_MOVED);
+         }
+      }
+
+      // Action - Drop tetro
+      const uint32_t TICKS_TETRO_DROP = SIM_TICKS_FROM_MS(850);
+      if (NOW - instance->tick_last_tetro_drop >= TICKS_TETRO_DROP)
+      {
+         // Drop tetro if possible
+         if (help_tetro_move_collides(tetro_active, play_field, 0, -1))
+         {
+            // Drop collision - Place the tetro
+            instance->next_game_state = GAME_STATE_PLACE;
+         }
+         else
+         {
+            // No drop collision
+            --tetro_active->tile_pos.y;
+            sim_events_push_sfx(events, SIM_SFX_DROP);
+            sim_events_push_type(events, SIM_EVENT_TETRO_MOVED);
+         }
+
+         // Update drop timer
+         instance->tick_last_tetro_drop = NOW;
+      }
+
+      // Action - Control tetro horizontally
+      const uint32_t TICKS_TETRO_MOVE = SIM_TICKS_FROM_MS(150);
+      const bool MOVE_LEFT = help_input_key_pressed_or_held(input, CUSTOM_KEY_LEFT);
+      const bool MOVE_RIGHT = help_input_key_pressed_or_held(input, CUSTOM_KEY_RIGHT);
+      const bool DO_MOVE = MOVE_LEFT || MOVE_RIGHT;
+
+      if (DO_MOVE && NOW - instance->tick_last_tetro_player_move >= TICKS_TETRO_MOVE)
+      {
+         // Movement direction ?
+         int move_direction = 0;
+         move_direction -= MOVE_LEFT ? 1 : 0;
+         move_direction += MOVE_RIGHT ? 1 : 0;
+
+         // Move only if no collision occurs
+         if (false == help_tetro_move_collides(tetro_active, play_field, move_direction, 0))
+         {
+            tetro_active->tile_pos.x += move_direction;
+            sim_events_push_sfx(events, SIM_SFX_MOVE);
+            sim_events_push_type(events, SIM_EVENT_TETRO_MOVED);
+         }
+
+         // Update movement timer
+         instance->tick_last_tetro_player_move = NOW;
+      }
+
+      // Action - Control tetro drop
+      const uint32_t TICKS_TETRO_PLAYER_DROP = SIM_TICKS_FROM_MS(100);
+      if (NOW - instance->tick_last_tetro_player_drop >= TICKS_TETRO_PLAYER_DROP)
+      {
+         if (help_input_key_pressed_or_held(input, CUSTOM_KEY_DOWN))
+         {
+            // Place tetro if collision occurse
+            if (help_tetro_move_collides(tetro_active, play_field, 0, -1))
+            {
+               // Drop collision - Place the tetro
+               instance->next_game_state = GAME_STATE_PLACE;
+            }
+            else
+            {
+               // No drop collision
+               --tetro_active->tile_pos.y;
+               sim_events_push_sfx(events, SIM_SFX_DROP);
+               sim_events_push_type(events, SIM_EVENT_TETRO_MOVED);
+            }
+         }
+
+         // Update drop timer
+         instance->tick_last_tetro_player_drop = NOW;
+      }
+
+      // Pause
+      if (help_input_key_pressed(input, CUSTOM_KEY_START))
+      {
+         instance->next_game_state = GAME_STATE_PAUSE;
+
+         // Pause music but let sfx ring out
+         sim_events_push_type(events, SIM_EVENT_MUSIC_PAUSE);
+         sim_events_push_sfx(events, SIM_SFX_PAUSE);
+      }
+   }
+   else if (GAME_STATE_PAUSE == game_state)
+   {
+      // Un-pause
+      if (help_input_key_pressed(input, CUSTOM_KEY_START))
+      {
+         instance->next_game_state = GAME_STATE_CONTROL;
+
+         // Resume music
+         sim_events_push_type(events, SIM_EVENT_MUSIC_RESUME);
+         sim_events_push_sfx(events, SIM_SFX_UN_PAUSE);
+      }
+
+      // Quit
+      if (help_input_key_pressed(input, CUSTOM_KEY_SELECT))
+      {
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+         sim_events_push_music(events, SIM_MUSIC_TITLE, true);
+         sim_events_push_type(events, SIM_EVENT_AUDIO_RESUME_ALL);
+         instance->next_game_state = GAME_STATE_TITLE;
+      }
+   }
+   else if (GAME_STATE_PLACE == game_state)
+   {
+      // Action - Place
+      help_tetro_drop(&instance->tetro_active, &instance->play_field, &instance->plot_row_min, &instance->plot_row_max);
+      sim_events_push_sfx(events, SIM_SFX_PLACE);
+      sim_events_push_type(events, SIM_EVENT_TETRO_PLACED);
+
+      // Line deletion required ?
+      instance->list_of_full_rows = help_play_field_list_of_full_rows(&instance->play_field);
+      if (0 == instance->list_of_full_rows.count)
+      {
+         // No rows to delete - Spawn new tetro and take it from there
+         instance->next_game_state = GAME_STATE_RESPAWN;
+      }
+      else
+      {
+         // There are rows to delete
+         // Start deletion timers
+         instance->next_game_state = GAME_STATE_REMOVE_LINES;
+         instance->tick_last_row_deletion_timer = NOW;
+         sim_events_push_sfx(events, SIM_SFX_HIGHLIGHT);
+         sim_events_push(events, SIM_EVENT_ROWS_FULL, instance->list_of_full_rows.count, false);
+      }
+   }
+   else if (GAME_STATE_REMOVE_LINES == game_state)
+   {
+      // Action - Remove lines
+      const uint32_t TICKS_ROW_DELETION = SIM_TICKS_FROM_MS(2000);
+      if (NOW - instance->tick_last_row_deletion_timer >= TICKS_ROW_DELETION)
+      {
+         // Time to delete rows
+         // Clear all rows that were detected full on tetro placement
+         int rows_cleared = 0;
+         for (int i_del_row = 0; i_del_row < instance->list_of_full_rows.count; ++i_del_row)
+         {
+            const int DELETION_ROW = instance->list_of_full_rows.list[i_del_row];
+            if (help_play_field_clear_row(&instance->play_field, DELETION_ROW))
+            {
+               // Reflect in stats
+               ++instance->stats.lines;
+               instance->stats.score += 10;
+               ++rows_cleared;
+            }
+         }
+         sim_events_push(events, SIM_EVENT_ROWS_CLEARED, rows_cleared, false);
+
+         // Consolidate play field
+         instance->next_game_state = GAME_STATE_CONSOLIDATE_PLAY_FIELD;
+      }
+   }
+   else if (GAME_STATE_CONSOLIDATE_PLAY_FIELD == game_state)
+   {
+      // Action - Consolidate play field after full row deletion - Until no more rows are moved
+      help_play_field_consolidate(&instance->play_field);
+      sim_events_push_sfx(events, SIM_SFX_DESTROY);
+
+      // Spawn new tetro
+      instance->next_game_state = GAME_STATE_RESPAWN;
+   }
+   else if (GAME_STATE_RESPAWN == game_state)
+   {
+      // Select active and next tetro
+      instance->tetro_active = instance->tetro_next;
+      instance->tetro_next = help_tetro_world_make_random_at_spawn(&instance->tetro_randomizer);
+      sim_events_push_type(events, SIM_EVENT_TETRO_SPAWNED);
+
+      // Game over if new tetro overlaps any occupied play field cell
+      if (help_tetro_move_collides(&instance->tetro_active, &instance->play_field, 0, 0))
+      {
+         // Transition to game over
+         instance->next_game_state = GAME_STATE_GAME_OVER_TRANSITION_FILL;
+         instance->tick_last_game_over_transition_row = NOW;
+         instance->game_over_transition_field_lines_filled = 0;
+         sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+         sim_events_push_sfx(events, SIM_SFX_GAME_OVER);
+      }
+      else
+      {
+         // No collision on spawn - Back to gameplay
+         instance->next_game_state = GAME_STATE_CONTROL;
+      }
+   }
+   else if (GAME_STATE_GAME_OVER_TRANSITION_FILL == game_state)
+   {
+      const uint32_t TICKS_GAME_OVER_TRANSITION_FILL_ROW = SIM_TICKS_FROM_MS(1500 / PLAY_FIELD_HEIGHT);
+      if (NOW - instance->tick_last_game_over_transition_row >= TICKS_GAME_OVER_TRANSITION_FILL_ROW)
+      {
+         ++instance->game_over_transition_field_lines_filled;
+         if (instance->game_over_transition_field_lines_filled > PLAY_FIELD_HEIGHT)
+         {
+            sim_events_push_type(events, SIM_EVENT_AUDIO_STOP_ALL);
+            sim_events_push_music(events, SIM_MUSIC_GAME_OVER, false);
+            instance->game_over_transition_field_lines_cleared = PLAY_FIELD_HEIGHT;
+            instance->next_game_state = GAME_STATE_GAME_OVER_TRANSITION_CLEAR;
+         }
+
+         // Track timer
+         instance->tick_last_game_over_transition_row = NOW;
+      }
+   }
+   else if (GAME_STATE_GAME_OVER_TRANSITION_CLEAR == game_state)
+   {
+      const uint32_t TICKS_GAME_OVER_TRANSITION_FILL_ROW = SIM_TICKS_FROM_MS(1500 / PLAY_FIELD_HEIGHT);
+      if (NOW - instance->tick_last_game_over_transition_row >= TICKS_GAME_OVER_TRANSITION_FILL_ROW)
+      {
+         --instance->game_over_transition_field_lines_cleared;
+         if (instance->game_over_transition_field_lines_cleared < 0)
+         {
+            help_play_field_clear(&instance->play_field);
+            instance->next_game_state = GAME_STATE_GAME_OVER;
+         }
+
+         // Track timer
+         instance->tick_last_game_over_transition_row = NOW;
+      }
+   }
+   else if (GAME_STATE_GAME_OVER == game_state)
+   {
+      // Action - Game over
+      if (help_input_key_pressed(input, CUSTOM_KEY_START))
+      {
+         instance->next_game_state = GAME_STATE_NEW_GAME;
+         if (SIM_MUSIC_NONE != instance->configured_game_music)
+         {
+            sim_events_push_music(events, instance->configured_game_music, true);
+         }
+      }
+   }
+   else if (GAME_STATE_NONE == game_state)
+   {
+      // Action - None - Should never happen
+      printf("\nGame state NONE - Nothing to simulate");
+      instance->close_requested = true;
+      sim_events_push_type(events, SIM_EVENT_QUIT);
+   }
+
+   // Level detection
+   instance->stats.level = help_level_for_score(instance->stats.score);
+
+   // Game state housekeeping
+   if (GAME_STATE_NONE != instance->next_game_state)
+   {
+      instance->game_state = instance->next_game_state;
+      instance->next_game_state = GAME_STATE_NONE;
+      sim_events_push(events, SIM_EVENT_GAME_STATE_CHANGED, instance->game_state, false);
+   }
+
+   // Success
+   return true;
+}
+
+enum game_state_e sim_game_state(const struct sim_s * instance)
+{
+   return instance ? instance->game_state : GAME_STATE_NONE;
+}
+
+const struct play_field_s * sim_play_field(const struct sim_s * instance)
+{
+   return instance ? &instance->play_field : NULL;
+}
+
+const struct tetro_world_s * sim_tetro_active(const struct sim_s * instance)
+{
+   return instance ? &instance->tetro_active : NULL;
+}
+
+const struct tetro_world_s * sim_tetro_next(const struct sim_s * instance)
+{
+   return instance ? &instance->tetro_next : NULL;
+}
+
+const struct list_of_rows_s * sim_full_rows(const struct sim_s * instance)
+{
+   return instance ? &instance->list_of_full_rows : NULL;
+}
+
+bool sim_full_rows_highlighted(const struct sim_s * instance)
+{
+   if (NULL == instance) return false;
+
+   // Full rows flash on and off while waiting for deletion
+   const uint32_t TICKS_ROW_FLASH = SIM_TICKS_FROM_MS(220);
+   const uint32_t TICKS_SINCE_FULL = instance->tick - instance->tick_last_row_deletion_timer;
+   return (0 == (TICKS_SINCE_FULL / TICKS_ROW_FLASH) % 2);
+}
+
+struct sim_stats_s sim_stats(const struct sim_s * instance)
+{
+   if (NULL == instance)
+   {
+      struct sim_stats_s empty_stats = { 0, 0, 0 };
+      return empty_stats;
+   }
+
+   return instance->stats;
+}
+
+struct vec_2i_s sim_game_music_cursor(const struct sim_s * instance)
+{
+   return instance ? instance->game_music_cursor : vec_2i_make_xy(0, 0);
+}
+
+enum sim_music_e sim_current_music(const struct sim_s * instance, bool * out_loop)
+{
+   if (out_loop)
+   {
+      *out_loop = true;
+   }
+   if (NULL == instance) return SIM_MUSIC_NONE;
+
+   // What the music events of the ticks so far left playing
+   switch (instance->game_state)
+   {
+      case GAME_STATE_TITLE:
+         return SIM_MUSIC_TITLE;
+      case GAME_STATE_GAME_MUSIC_CONFIG:
+      case GAME_STATE_NEW_GAME:
+      case GAME_STATE_CONTROL:
+      case GAME_STATE_PLACE:
+      case GAME_STATE_REMOVE_LINES:
+      case GAME_STATE_CONSOLIDATE_PLAY_FIELD:
+      case GAME_STATE_RESPAWN:
+      case GAME_STATE_PAUSE:
+         return instance->configured_game_music;
+      case GAME_STATE_GAME_OVER_TRANSITION_CLEAR:
+         if (out_loop)
+         {
+            *out_loop = false;
+         }
+         return SIM_MUSIC_GAME_OVER;
+      default:
+         return SIM_MUSIC_NONE;
+   }
+}
+
+bool sim_key_confirmed(const struct sim_s * instance, enum custom_key_e key)
+{
+   return instance && key >= 0 && key < CUSTOM_KEY_COUNT && instance->keybr_key_confirmed[key];
+}
+
+int sim_game_over_lines_filled(const struct sim_s * instance)
+{
+   return instance ? instance->game_over_transition_field_lines_filled : 0;
+}
+
+int sim_game_over_lines_cleared(const struct sim_s * instance)
+{
+   return instance ? instance->game_over_transition_field_lines_cleared : 0;
+}
+
+bool sim_volume_overlay_visible(const struct sim_s * instance)
+{
+   return instance && instance->tick <= instance->tick_until_show_volume_overlay;
+}
+
+bool sim_close_requested(const struct sim_s * instance)
+{
+   return instance ? instance->close_requested : true;
+}
+
+uint32_t sim_tick(const struct sim_s * instance)
+{
+   return instance ? instance->tick : 0;
+}
+
+uint32_t sim_ticks_until_timer(const struct sim_s * instance)
+{
+   if (NULL == instance) return SIM_TICKS_NEVER;
+
+   // Screens that only react to key presses wait on nothing
+   const uint32_t NOW = instance->tick;
+   uint32_t ticks_until_timer = SIM_TICKS_NEVER;
+   switch (instance->game_state)
+   {
+      case GAME_STATE_SPLASH:
+         // The first tick starts the splash sound
+         ticks_until_timer = instance->init_splash ? 1 : (uint32_t)help_minmax_max_2i(1, (int)(instance->tick_splash_start + SIM_TICKS_SPLASH_CONTINUE - NOW));
+         break;
+      case GAME_STATE_QUIT:
+         ticks_until_timer = instance->close_requested ? SIM_TICKS_NEVER : (uint32_t)help_minmax_max_2i(1, (int)(instance->tick_last_quit + SIM_TICKS_QUIT + 1 - NOW));
+         break;
+      case GAME_STATE_INPUT_MAPPING:
+      case GAME_STATE_TITLE:
+      case GAME_STATE_GAME_MUSIC_CONFIG:
+      case GAME_STATE_PAUSE:
+      case GAME_STATE_GAME_OVER:
+         break;
+      default:
+         // Gameplay and its transitions change every few ticks
+         ticks_until_timer = 1;
+         break;
+   }
+
+   // The volume overlay hides on its own
+   if (sim_volume_overlay_visible(instance))
+   {
+      const uint32_t TICKS_UNTIL_HIDDEN = instance->tick_until_show_volume_overlay + 1 - NOW;
+      ticks_until_timer = (TICKS_UNTIL_HIDDEN < ticks_until_timer) ? TICKS_UNTIL_HIDDEN : ticks_until_timer;
+   }
+
+   return ticks_until_timer;
+}
+
+double sim_time_simulated(const struct sim_s * instance)
+{
+   return instance ? (double)instance->tick / SIM_TICKS_PER_SECOND : 0.0;
+}
+
+uint64_t help_hash_fnv1a_u32(uint64_t hash, uint32_t value)
+{
+   for (int i_byte = 0; i_byte < 4; ++i_byte)
+   {
+      hash ^= (value >> (i_byte * 8)) & 0xFF;
+      hash *= 0x100000001B3ULL;
+   }
+
+   return hash;
+}
+
+uint64_t help_hash_tetro_world(uint64_t hash, const struct tetro_world_s * tetro)
+{
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)tetro->type);
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)tetro->rotation);
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)tetro->tile_pos.x);
+   return help_hash_fnv1a_u32(hash, (uint32_t)tetro->tile_pos.y);
+}
+
+uint64_t sim_state_hash(const struct sim_s * instance)
+{
+   if (NULL == instance) return 0;
+
+   // FNV-1a over gameplay relevant state, field by field to skip padding
+   uint64_t hash = 0xCBF29CE484222325ULL;
+   hash = help_hash_fnv1a_u32(hash, instance->tick);
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)instance->game_state);
+   for (int row = 0; row < PLAY_FIELD_HEIGHT; ++row)
+   {
+      hash = help_hash_fnv1a_u32(hash, instance->play_field.rows[row]);
+      hash = help_hash_fnv1a_u32(hash, instance->play_field.types[row]);
+   }
+   hash = help_hash_tetro_world(hash, &instance->tetro_active);
+   hash = help_hash_tetro_world(hash, &instance->tetro_next);
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)instance->stats.score);
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)instance->stats.lines);
+   hash = help_hash_fnv1a_u32(hash, (uint32_t)instance->stats.level);
+
+   return hash;
+}
+
+void help_sim_serial_put_u32(uint8_t ** cursor, uint32_t value)
+{
+   for (int i_byte = 0; i_byte < 4; ++i_byte)
+   {
+      (*cursor)[i_byte] = (uint8_t)(value >> (i_byte * 8));
+   }
+   *cursor += 4;
+}
+
+void help_sim_serial_put_u64(uint8_t ** cursor, uint64_t value)
+{
+   help_sim_serial_put_u32(cursor, (uint32_t)value);
+   help_sim_serial_put_u32(cursor, (uint32_t)(value >> 32));
+}
+
+void help_sim_serial_put_tetro_world(uint8_t ** cursor, const struct tetro_world_s * tetro)
+{
+   help_sim_serial_put_u32(cursor, (uint32_t)tetro->type);
+   help_sim_serial_put_u32(cursor, (uint32_t)tetro->rotation);
+   help_sim_serial_put_u32(cursor, (uint32_t)tetro->tile_pos.x);
+   help_sim_serial_put_u32(cursor, (uint32_t)tetro->tile_pos.y);
+}
+
+uint32_t help_sim_serial_get_u32(const uint8_t ** cursor)
+{
+   uint32_t value = 0;
+   for (int i_byte = 0; i_byte < 4; ++i_byte)
+   {
+      value |= (uint32_t)(*cursor)[i_byte] << (i_byte * 8);
+   }
+   *cursor += 4;
+
+   return value;
+}
+
+uint64_t help_sim_serial_get_u64(const uint8_t ** cursor)
+{
+   const uint64_t LOW = help_sim_serial_get_u32(cursor);
+   const uint64_t HIGH = help_sim_serial_get_u32(cursor);
+
+   return LOW | (HIGH << 32);
+}
+
+uint32_t help_sim_serial_get_below(const uint8_t ** cursor, uint32_t bound, bool * valid)
+{
+   const uint32_t VALUE = help_sim_serial_get_u32(cursor);
+   if (VALUE >= bound)
+   {
+      *valid = false;
+   }
+
+   return VALUE;
+}
+
+void help_sim_serial_get_tetro_world(const uint8_t ** cursor, struct tetro_world_s * tetro, bool * valid)
+{
+   tetro->type = (enum tetro_type_e)help_sim_serial_get_below(cursor, TETRO_TYPE_COUNT, valid);
+   tetro->rotation = (int)help_sim_serial_get_u32(cursor);
+   tetro->tile_pos.x = (int)help_sim_serial_get_u32(cursor);
+   tetro->tile_pos.y = (int)help_sim_serial_get_u32(cursor);
+}
+
+bool sim_state_serialize(const struct sim_s * instance, uint8_t * out_bytes)
+{
+   if (NULL == instance || NULL == out_bytes) return false;
+
+   uint8_t * cursor = out_bytes;
+
+   // Input
+   for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
+   {
+      help_sim_serial_put_u32(&cursor, (uint32_t)instance->input.key_states[key]);
+   }
+   for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
+   {
+      help_sim_serial_put_u32(&cursor, instance->keybr_key_confirmed[key]);
+   }
+
+   // Game state transitions
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->game_state);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->next_game_state);
+   help_sim_serial_put_u32(&cursor, instance->init_splash);
+   help_sim_serial_put_u32(&cursor, instance->close_requested);
+
+   // Play field and tetros
+   for (int row = 0; row < PLAY_FIELD_HEIGHT; ++row)
+   {
+      help_sim_serial_put_u32(&cursor, instance->play_field.rows[row]);
+      help_sim_serial_put_u32(&cursor, instance->play_field.types[row]);
+   }
+   help_sim_serial_put_tetro_world(&cursor, &instance->tetro_active);
+   help_sim_serial_put_tetro_world(&cursor, &instance->tetro_next);
+   const struct tetro_randomizer_s * RANDOMIZER = &instance->tetro_randomizer;
+   help_sim_serial_put_u64(&cursor, RANDOMIZER->rng.state);
+   help_sim_serial_put_u64(&cursor, RANDOMIZER->rng.increment);
+   help_sim_serial_put_u32(&cursor, (uint32_t)RANDOMIZER->policy);
+   for (int i_bag = 0; i_bag < TETRO_TYPE_COUNT; ++i_bag)
+   {
+      help_sim_serial_put_u32(&cursor, RANDOMIZER->bag[i_bag]);
+   }
+   help_sim_serial_put_u32(&cursor, (uint32_t)RANDOMIZER->bag_remaining);
+
+   // Play field row highlighting and removal
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->plot_row_min);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->plot_row_max);
+   for (int i_row = 0; i_row < PLAY_FIELD_HEIGHT; ++i_row)
+   {
+      help_sim_serial_put_u32(&cursor, (uint32_t)instance->list_of_full_rows.list[i_row]);
+   }
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->list_of_full_rows.count);
+
+   // Game over transition
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->game_over_transition_field_lines_filled);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->game_over_transition_field_lines_cleared);
+
+   // Game type and music config
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->configured_game_music);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->game_music_cursor.x);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->game_music_cursor.y);
+
+   // Stats
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->stats.score);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->stats.lines);
+   help_sim_serial_put_u32(&cursor, (uint32_t)instance->stats.level);
+
+   // Timers
+   help_sim_serial_put_u32(&cursor, instance->tick);
+   help_sim_serial_put_u32(&cursor, instance->tick_splash_start);
+   help_sim_serial_put_u32(&cursor, instance->tick_last_tetro_drop);
+   help_sim_serial_put_u32(&cursor, instance->tick_last_tetro_player_move);
+   help_sim_serial_put_u32(&cursor, instance->tick_last_tetro_player_drop);
+   help_sim_serial_put_u32(&cursor, instance->tick_last_row_deletion_timer);
+   help_sim_serial_put_u32(&cursor, instance->tick_last_game_over_transition_row);
+   help_sim_serial_put_u32(&cursor, instance->tick_last_quit);
+   help_sim_serial_put_u32(&cursor, instance->tick_until_show_volume_overlay);
+
+   return (cursor - out_bytes) == SIM_STATE_SERIAL_SIZE;
+}
+
+bool sim_state_deserialize(struct sim_s * instance, const uint8_t * bytes)
+{
+   if (NULL == instance || NULL == bytes) return false;
+
+   // Decode into a scratch state so a rejected snapshot leaves the instance intact
+   struct sim_s state;
+   memset(&state, 0, sizeof(state));
+   const uint8_t * cursor = bytes;
+   bool valid = true;
+
+   // Input
+   for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
+   {
+      state.input.key_states[key] = (enum key_state_e)help_sim_serial_get_below(&cursor, KEY_STATE_RELEASED + 1, &valid);
+   }
+   for (int key = 0; key < CUSTOM_KEY_COUNT; ++key)
+   {
+      state.keybr_key_confirmed[key] = help_sim_serial_get_below(&cursor, 2, &valid);
+   }
+
+   // Game state transitions
+   state.game_state = (enum game_state_e)help_sim_serial_get_below(&cursor, GAME_STATE_NONE + 1, &valid);
+   state.next_game_state = (enum game_state_e)help_sim_serial_get_below(&cursor, GAME_STATE_NONE + 1, &valid);
+   state.init_splash = help_sim_serial_get_below(&cursor, 2, &valid);
+   state.close_requested = help_sim_serial_get_below(&cursor, 2, &valid);
+
+   // Play field and tetros
+   for (int row = 0; row < PLAY_FIELD_HEIGHT; ++row)
+   {
+      state.play_field.rows[row] = (play_field_row_t)help_sim_serial_get_below(&cursor, PLAY_FIELD_ROW_FULL + 1u, &valid);
+      state.play_field.types[row] = help_sim_serial_get_u32(&cursor);
+   }
+   help_sim_serial_get_tetro_world(&cursor, &state.tetro_active, &valid);
+   help_sim_serial_get_tetro_world(&cursor, &state.tetro_next, &valid);
+   struct tetro_randomizer_s * randomizer = &state.tetro_randomizer;
+   randomizer->rng.state = help_sim_serial_get_u64(&cursor);
+   randomizer->rng.increment = help_sim_serial_get_u64(&cursor);
+   randomizer->policy = (enum tetro_randomizer_e)help_sim_serial_get_below(&cursor, TETRO_RANDOMIZER_BAG_7 + 1, &valid);
+   for (int i_bag = 0; i_bag < TETRO_TYPE_COUNT; ++i_bag)
+   {
+      randomizer->bag[i_bag] = (uint8_t)help_sim_serial_get_below(&cursor, TETRO_TYPE_COUNT, &valid);
+   }
+   randomizer->bag_remaining = (int)help_sim_serial_get_below(&cursor, TETRO_TYPE_COUNT + 1, &valid);
+
+   // Play field row highlighting and removal
+   state.plot_row_min = (int)help_sim_serial_get_u32(&cursor);
+   state.plot_row_max = (int)help_sim_serial_get_u32(&cursor);
+   for (int i_row = 0; i_row < PLAY_FIELD_HEIGHT; ++i_row)
+   {
+      state.list_of_full_rows.list[i_row] = (int)help_sim_serial_get_below(&cursor, PLAY_FIELD_HEIGHT, &valid);
+   }
+   state.list_of_full_rows.count = (int)help_sim_serial_get_below(&cursor, PLAY_FIELD_HEIGHT + 1, &valid);
+
+   // Game over transition
+   state.game_over_transition_field_lines_filled = (int)help_sim_serial_get_u32(&cursor);
+   state.game_over_transition_field_lines_cleared = (int)help_sim_serial_get_u32(&cursor);
+
+   // Game type and music config
+   state.configured_game_music = (enum sim_music_e)help_sim_serial_get_below(&cursor, SIM_MUSIC_COUNT, &valid);
+   state.game_music_cursor.x = (int)help_sim_serial_get_u32(&cursor);
+   state.game_music_cursor.y = (int)help_sim_serial_get_u32(&cursor);
+
+   // Stats
+   state.stats.score = (int)help_sim_serial_get_u32(&cursor);
+   state.stats.lines = (int)help_sim_serial_get_u32(&cursor);
+   state.stats.level = (int)help_sim_serial_get_u32(&cursor);
+
+   // Timers
+   state.tick = help_sim_serial_get_u32(&cursor);
+   state.tick_splash_start = help_sim_serial_get_u32(&cursor);
+   state.tick_last_tetro_drop = help_sim_serial_get_u32(&cursor);
+   state.tick_last_tetro_player_move = help_sim_serial_get_u32(&cursor);
+   state.tick_last_tetro_player_drop = help_sim_serial_get_u32(&cursor);
+   state.tick_last_row_deletion_timer = help_sim_serial_get_u32(&cursor);
+   state.tick_last_game_over_transition_row = help_sim_serial_get_u32(&cursor);
+   state.tick_last_quit = help_sim_serial_get_u32(&cursor);
+   state.tick_until_show_volume_overlay = help_sim_serial_get_u32(&cursor);
+
+   if (false == valid || (cursor - bytes) != SIM_STATE_SERIAL_SIZE) return false;
+
+   // Success
+   *instance = state;
+   return true;
+}
@@ -139,7 +139,7 @@ int main(int argc, char * argv[])
    printf("\n\t%-15s: %s", "lib", str_dir_abs_sdl_image_lib);
 
    // Prepare list of source files to compile
-   char * SOURCE_FILES[] = { "main.c" };
+   char * SOURCE_FILES[] = { "main.c", "helpers.c", "cli.c", "rng.c", "sim.c", "replay.c", "pool.c", "ai.c", "player.c", "render.c", "capture.c" };
    char str_root_source[1024];
    snprintf(str_root_source, sizeof(str_root_source), "%s%s\\", DIR_ABS_ROOT, "source");
    const char * STR_SOURCES = help_string_list_merge_prefixed(SOURCE_FILES, sizeof(SOURCE_FILES) / sizeof(SOURCE_FILES[0]), str_root_source, ' ');
@@ -186,7 +186,7 @@ int main(int argc, char * argv[])
    snprintf(
       str_compilation,
       sizeof(str_compilation),
-      "gcc %s -L%s -L%s -I%s -I%s -I%s -lSDL3 -lSDL3_image -o %s%s\\%s",
+      "gcc %s -pthread -L%s -L%s -I%s -I%s -I%s -lSDL3 -lSDL3_image -o %s%s\\%s",
       STR_SOURCES,
       str_dir_abs_sdl_lib,
       str_dir_abs_sdl_image_lib,